@@ -220,6 +220,8 @@ StatusCode AzureFileSystem::downloadModelVersions(const std::string& path,
         return sc;
     }
 
+    // Files of all versions are downloaded together so that they share download threads
+    azure_downloads_t downloads;
     for (auto& ver : versions) {
         std::string versionpath = path;
         if (!endsWith(versionpath, "/")) {
@@ -242,14 +244,18 @@ StatusCode AzureFileSystem::downloadModelVersions(const std::string& path,
             return status;
         }
 
-        status = azureStorageObj->downloadFileFolderTo(lpath);
+        status = azureStorageObj->collectFileFolderTo(lpath, &downloads);
         if (status != StatusCode::OK) {
             SPDLOG_LOGGER_ERROR(azurestorage_logger, "Failed to download model version {}", versionpath);
             return status;
         }
     }
 
-    return StatusCode::OK;
+    auto status = AzureStorageAdapter::downloadFiles(downloads);
+    if (status != StatusCode::OK) {
+        SPDLOG_LOGGER_ERROR(azurestorage_logger, "Failed to download model versions from {}", path);
+    }
+    return status;
 }
 
 StatusCode AzureFileSystem::downloadFile(const std::string& remote_path,
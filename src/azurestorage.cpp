@@ -16,6 +16,7 @@
 #include "azurestorage.hpp"
 
 #include <memory>
+#include <unordered_map>
 
 #include "azurefilesystem.hpp"
 #include "logging.hpp"
@@ -435,7 +436,64 @@ StatusCode AzureStorageBlob::downloadFile(const std::string& local_path) {
     return StatusCode::AS_FILE_NOT_FOUND;
 }
 
+StatusCode AzureStorageBlob::getFileProperties(uint64_t* size, std::string* version) {
+    try {
+        if (!isPathValidationOk_) {
+            auto status = checkPath(fullUri_);
+            if (status != StatusCode::OK)
+                return status;
+        }
+
+        as_blob_ = as_container_.get_blob_reference(blockpath_);
+        if (!as_blob_.exists()) {
+            SPDLOG_LOGGER_WARN(azurestorage_logger, "Block blob does not exist: {} -> {}", fullPath_, blockpath_);
+            return StatusCode::AS_FILE_NOT_FOUND;
+        }
+
+        as_blob_.download_attributes();
+        *size = as_blob_.properties().size();
+        *version = as_blob_.properties().etag();
+        return StatusCode::OK;
+    } catch (const as::storage_exception& e) {
+        SPDLOG_LOGGER_ERROR(azurestorage_logger, "Unable to access path: {}", extractAzureStorageExceptionMessage(e));
+    } catch (const std::exception& e) {
+        SPDLOG_LOGGER_ERROR(azurestorage_logger, UNAVAILABLE_PATH_ERROR, e.what());
+    }
+
+    return StatusCode::AS_FILE_NOT_FOUND;
+}
+
+StatusCode AzureStorageBlob::downloadFileRange(uint64_t offset, uint64_t size, const range_writer_t& writer) {
+    try {
+        // Called concurrently for parts of the same blob, each with its own blob reference
+        as::cloud_blob blob = as_container_.get_blob_reference(blockpath_);
+        concurrency::streams::container_buffer<std::vector<uint8_t>> buffer;
+        concurrency::streams::ostream output_stream(buffer);
+        blob.download_range_to_stream(output_stream, offset, size);
+        const auto& data = buffer.collection();
+        if (!writer(reinterpret_cast<const char*>(data.data()), data.size())) {
+            return StatusCode::AS_FAILED_GET_OBJECT;
+        }
+        return StatusCode::OK;
+    } catch (const as::storage_exception& e) {
+        SPDLOG_LOGGER_ERROR(azurestorage_logger, "Unable to access path: {}", extractAzureStorageExceptionMessage(e));
+    } catch (const std::exception& e) {
+        SPDLOG_LOGGER_ERROR(azurestorage_logger, UNAVAILABLE_PATH_ERROR, e.what());
+    }
+
+    return StatusCode::AS_FAILED_GET_OBJECT;
+}
+
 StatusCode AzureStorageBlob::downloadFileFolderTo(const std::string& local_path) {
+    azure_downloads_t downloads;
+    auto status = collectFileFolderTo(local_path, &downloads);
+    if (status != StatusCode::OK) {
+        return status;
+    }
+    return downloadFiles(downloads);
+}
+
+StatusCode AzureStorageBlob::collectFileFolderTo(const std::string& local_path, azure_downloads_t* downloads) {
     try {
         if (!isPathValidationOk_) {
             auto status = checkPath(fullUri_);
@@ -488,7 +546,7 @@ StatusCode AzureStorageBlob::downloadFileFolderTo(const std::string& local_path)
                 return status;
             }
             auto download_dir_status =
-                azureSubdirStorageObj->downloadFileFolderTo(local_dir_path);
+                azureSubdirStorageObj->collectFileFolderTo(local_dir_path, downloads);
             if (download_dir_status != StatusCode::OK) {
                 SPDLOG_LOGGER_WARN(azurestorage_logger, "Unable to download directory from {} to {}",
                     remote_dir_path, local_dir_path);
@@ -511,13 +569,15 @@ StatusCode AzureStorageBlob::downloadFileFolderTo(const std::string& local_path)
                 return status;
             }
 
-            auto download_status =
-                azureFiledirStorageObj->downloadFile(local_file_path);
-            if (download_status != StatusCode::OK) {
+            uint64_t size;
+            std::string version;
+            auto size_status = azureFiledirStorageObj->getFileProperties(&size, &version);
+            if (size_status != StatusCode::OK) {
                 SPDLOG_LOGGER_WARN(azurestorage_logger, "Unable to save file from {} to {}", remote_file_path,
                     local_file_path);
-                return download_status;
+                return size_status;
             }
+            downloads->push_back({azureFiledirStorageObj, {remote_file_path, local_file_path, size, version}});
         }
         return StatusCode::OK;
     } catch (const as::storage_exception& e) {
@@ -1029,7 +1089,81 @@ StatusCode AzureStorageFile::downloadFile(const std::string& local_path) {
     return StatusCode::AS_FILE_NOT_FOUND;
 }
 
+StatusCode AzureStorageFile::getFileProperties(uint64_t* size, std::string* version) {
+    try {
+        if (!isPathValidationOk_) {
+            auto status = checkPath(fullUri_);
+            if (status != StatusCode::OK)
+                return status;
+        }
+
+        as::cloud_file_directory as_last_working_subdir;
+        std::string tmp_dir = "";
+
+        try {
+            for (std::vector<std::string>::size_type i = 0; i != subdirs_.size(); i++) {
+                tmp_dir = tmp_dir + (i == 0 ? "" : "/") + subdirs_[i];
+                as::cloud_file_directory as_tmp_subdir = as_share_.get_directory_reference(tmp_dir);
+                if (!as_tmp_subdir.exists()) {
+                    break;
+                }
+
+                as_last_working_subdir = as_tmp_subdir;
+            }
+        } catch (const as::storage_exception& e) {
+        }
+
+        as_file1_ = as_last_working_subdir.get_file_reference(_XPLATSTR(file_));
+        if (!as_file1_.exists()) {
+            SPDLOG_LOGGER_WARN(azurestorage_logger, "File does not exist: {} -> {}", fullPath_, file_);
+            return StatusCode::AS_FILE_NOT_FOUND;
+        }
+
+        as_file1_.download_attributes();
+        *size = as_file1_.properties().length();
+        *version = as_file1_.properties().etag();
+        // Directory is resolved once, ranges are read with their own file references
+        as_directory_ = as_last_working_subdir;
+        return StatusCode::OK;
+    } catch (const as::storage_exception& e) {
+        SPDLOG_LOGGER_ERROR(azurestorage_logger, "Unable to access path: {}", extractAzureStorageExceptionMessage(e));
+    } catch (const std::exception& e) {
+        SPDLOG_LOGGER_ERROR(azurestorage_logger, UNAVAILABLE_PATH_ERROR, e.what());
+    }
+
+    return StatusCode::AS_FILE_NOT_FOUND;
+}
+
+StatusCode AzureStorageFile::downloadFileRange(uint64_t offset, uint64_t size, const range_writer_t& writer) {
+    try {
+        as::cloud_file file = as_directory_.get_file_reference(_XPLATSTR(file_));
+        concurrency::streams::container_buffer<std::vector<uint8_t>> buffer;
+        concurrency::streams::ostream output_stream(buffer);
+        file.download_range_to_stream(output_stream, offset, size);
+        const auto& data = buffer.collection();
+        if (!writer(reinterpret_cast<const char*>(data.data()), data.size())) {
+            return StatusCode::AS_FAILED_GET_OBJECT;
+        }
+        return StatusCode::OK;
+    } catch (const as::storage_exception& e) {
+        SPDLOG_LOGGER_ERROR(azurestorage_logger, "Unable to access path: {}", extractAzureStorageExceptionMessage(e));
+    } catch (const std::exception& e) {
+        SPDLOG_LOGGER_ERROR(azurestorage_logger, UNAVAILABLE_PATH_ERROR, e.what());
+    }
+
+    return StatusCode::AS_FAILED_GET_OBJECT;
+}
+
 StatusCode AzureStorageFile::downloadFileFolderTo(const std::string& local_path) {
+    azure_downloads_t downloads;
+    auto status = collectFileFolderTo(local_path, &downloads);
+    if (status != StatusCode::OK) {
+        return status;
+    }
+    return downloadFiles(downloads);
+}
+
+StatusCode AzureStorageFile::collectFileFolderTo(const std::string& local_path, azure_downloads_t* downloads) {
     try {
         if (!isPathValidationOk_) {
             auto status = checkPath(fullUri_);
@@ -1082,7 +1216,7 @@ StatusCode AzureStorageFile::downloadFileFolderTo(const std::string& local_path)
                 return status;
             }
             auto download_dir_status =
-                azureSubdirStorageObj->downloadFileFolderTo(local_dir_path);
+                azureSubdirStorageObj->collectFileFolderTo(local_dir_path, downloads);
             if (download_dir_status != StatusCode::OK) {
                 SPDLOG_LOGGER_WARN(azurestorage_logger, "Unable to download directory from {} to {}",
                     remote_dir_path, local_dir_path);
@@ -1105,13 +1239,15 @@ StatusCode AzureStorageFile::downloadFileFolderTo(const std::string& local_path)
                 return status;
             }
 
-            auto download_status =
-                azureFileStorageObj->downloadFile(local_file_path);
-            if (download_status != StatusCode::OK) {
+            uint64_t size;
+            std::string version;
+            auto size_status = azureFileStorageObj->getFileProperties(&size, &version);
+            if (size_status != StatusCode::OK) {
                 SPDLOG_LOGGER_WARN(azurestorage_logger, "Unable to save file from {} to {}", remote_file_path,
                     local_file_path);
-                return download_status;
+                return size_status;
             }
+            downloads->push_back({azureFileStorageObj, {remote_file_path, local_file_path, size, version}});
         }
         return StatusCode::OK;
     } catch (const as::storage_exception& e) {
@@ -1123,6 +1259,19 @@ StatusCode AzureStorageFile::downloadFileFolderTo(const std::string& local_path)
     return StatusCode::AS_FILE_NOT_FOUND;
 }
 
+StatusCode AzureStorageAdapter::downloadFiles(const azure_downloads_t& downloads) {
+    std::vector<RangedDownloadFile> files;
+    std::unordered_map<std::string, std::shared_ptr<AzureStorageAdapter>> storages;
+    for (const auto& download : downloads) {
+        files.push_back(download.file);
+        storages.emplace(download.file.remotePath, download.storage);
+    }
+    auto downloader = RangedDownloader::fromConfig();
+    return downloader.download(files, [&storages](const std::string& remotePath, uint64_t offset, uint64_t size, const range_writer_t& writer) {
+        return storages.at(remotePath)->downloadFileRange(offset, size, writer);
+    });
+}
+
 std::vector<std::string> AzureStorageAdapter::FindSubdirectories(std::string path) {
     std::vector<std::string> output;
 
@@ -23,6 +23,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "rangeddownloader.hpp"
 #include "status.hpp"
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wall"
@@ -41,6 +42,18 @@ namespace ovms {
 namespace as = azure::storage;
 using files_list_t = std::set<std::string>;
 
+class AzureStorageAdapter;
+
+/**
+ * @brief File to be downloaded together with storage object reading it
+ */
+struct AzureFileDownload {
+    std::shared_ptr<AzureStorageAdapter> storage;
+    RangedDownloadFile file;
+};
+
+using azure_downloads_t = std::vector<AzureFileDownload>;
+
 class AzureStorageAdapter {
 public:
     AzureStorageAdapter() {}
@@ -57,6 +70,14 @@ public:
     virtual StatusCode downloadFile(const std::string& local_path) = 0;
     virtual StatusCode downloadFileFolderTo(const std::string& local_path) = 0;
     virtual StatusCode checkPath(const std::string& path) = 0;
+    virtual StatusCode getFileProperties(uint64_t* size, std::string* version) = 0;
+    virtual StatusCode downloadFileRange(uint64_t offset, uint64_t size, const range_writer_t& writer) = 0;
+    virtual StatusCode collectFileFolderTo(const std::string& local_path, azure_downloads_t* downloads) = 0;
+
+    /**
+     * @brief Downloads collected files in parallel ranged parts
+     */
+    static StatusCode downloadFiles(const azure_downloads_t& downloads);
 
     std::string joinPath(std::initializer_list<std::string> segments);
     StatusCode CreateLocalDir(const std::string& path);
@@ -98,6 +119,12 @@ public:
 
     StatusCode downloadFileFolderTo(const std::string& local_path) override;
 
+    StatusCode getFileProperties(uint64_t* size, std::string* version) override;
+
+    StatusCode downloadFileRange(uint64_t offset, uint64_t size, const range_writer_t& writer) override;
+
+    StatusCode collectFileFolderTo(const std::string& local_path, azure_downloads_t* downloads) override;
+
 private:
     std::string getLastPathPart(const std::string& path);
 
@@ -156,6 +183,12 @@ public:
 
     StatusCode downloadFileFolderTo(const std::string& local_path) override;
 
+    StatusCode getFileProperties(uint64_t* size, std::string* version) override;
+
+    StatusCode downloadFileRange(uint64_t offset, uint64_t size, const range_writer_t& writer) override;
+
+    StatusCode collectFileFolderTo(const std::string& local_path, azure_downloads_t* downloads) override;
+
 private:
     StatusCode parseFilePath(const std::string& path) override;
 
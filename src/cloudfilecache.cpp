@@ -0,0 +1,163 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "cloudfilecache.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include "config.hpp"
+#include "filehash.hpp"
+
+namespace ovms {
+
+const std::string CloudFileCache::ENTRY_EXTENSION = ".file";
+
+CloudFileCache::CloudFileCache(const std::string& directory, size_t capacityBytes) :
+    directory(directory),
+    capacityBytes(capacityBytes) {
+    if (!isEnabled()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        SPDLOG_ERROR("Could not create cloud files cache directory: {}; error: {}", directory, ec.message());
+    }
+}
+
+CloudFileCache& CloudFileCache::instance() {
+    static CloudFileCache cache(
+        Config::instance().cloudCacheDir(),
+        static_cast<size_t>(Config::instance().cloudCacheSizeMb()) * 1024 * 1024);
+    return cache;
+}
+
+std::string CloudFileCache::getEntryPath(const std::string& key) const {
+    return (std::filesystem::path(directory) / (key + ENTRY_EXTENSION)).string();
+}
+
+std::string CloudFileCache::createKey(const std::string& remotePath, const std::string& version, uint64_t size) {
+    Fnv1aHash hash;
+    hash.update(remotePath);
+    hash.update(version);
+    hash.update(std::to_string(size));
+    return hash.toHexString();
+}
+
+static bool linkOrCopy(const std::string& source, const std::string& destination) {
+    if (linkat(AT_FDCWD, source.c_str(), AT_FDCWD, destination.c_str(), AT_SYMLINK_FOLLOW) == 0) {
+        return true;
+    }
+    // Cache directory may be on different file system than downloaded models, which may also be memory files
+    std::error_code ec;
+    std::filesystem::copy_file(source, destination, std::filesystem::copy_options::overwrite_existing, ec);
+    return !ec;
+}
+
+bool CloudFileCache::restore(const std::string& key, const std::string& localPath) {
+    const auto path = getEntryPath(key);
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) {
+        misses++;
+        SPDLOG_DEBUG("Cloud files cache miss for: {}; hits: {}; misses: {}", localPath, hits.load(), misses.load());
+        return false;
+    }
+    std::filesystem::remove(localPath, ec);
+    if (!linkOrCopy(path, localPath)) {
+        misses++;
+        SPDLOG_WARN("Could not restore cloud files cache entry: {} to: {}", path, localPath);
+        return false;
+    }
+    // Mark entry as recently used
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    hits++;
+    SPDLOG_DEBUG("Cloud files cache hit for: {}; hits: {}; misses: {}", localPath, hits.load(), misses.load());
+    return true;
+}
+
+void CloudFileCache::store(const std::string& key, const std::string& localPath) {
+    const auto path = getEntryPath(key);
+    std::stringstream tmpSuffix;
+    tmpSuffix << ".tmp." << getpid() << "." << std::hash<std::thread::id>{}(std::this_thread::get_id());
+    const auto tmpPath = path + tmpSuffix.str();
+    std::error_code ec;
+    if (!linkOrCopy(localPath, tmpPath)) {
+        SPDLOG_WARN("Could not create cloud files cache entry: {}", tmpPath);
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+    // Rename is atomic so readers never see partially written entries
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        SPDLOG_WARN("Could not store cloud files cache entry: {}; error: {}", path, ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+    stores++;
+    SPDLOG_DEBUG("Stored downloaded file: {} in cloud files cache: {}", localPath, path);
+    evict();
+}
+
+void CloudFileCache::evict() {
+    if (capacityBytes == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(evictionMtx);
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastUsed;
+        uintmax_t size;
+    };
+    std::vector<Entry> entries;
+    uintmax_t totalSize = 0;
+    std::error_code ec;
+    for (const auto& file : std::filesystem::directory_iterator(directory, ec)) {
+        if (!file.is_regular_file(ec) || file.path().extension() != ENTRY_EXTENSION) {
+            continue;
+        }
+        Entry entry{file.path(), file.last_write_time(ec), file.file_size(ec)};
+        if (ec) {
+            continue;
+        }
+        totalSize += entry.size;
+        entries.push_back(std::move(entry));
+    }
+    if (totalSize <= capacityBytes) {
+        return;
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.lastUsed < rhs.lastUsed; });
+    for (const auto& entry : entries) {
+        if (totalSize <= capacityBytes) {
+            break;
+        }
+        SPDLOG_INFO("Evicting cloud files cache entry: {}", entry.path.string());
+        if (std::filesystem::remove(entry.path, ec)) {
+            totalSize -= entry.size;
+        }
+    }
+}
+
+}  // namespace ovms
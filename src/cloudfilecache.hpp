@@ -0,0 +1,99 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace ovms {
+
+/**
+ * @brief On-disk cache of files downloaded from cloud storage, keyed by object path and version reported by the storage (ETag or generation).
+ * Entries are hard linked into model download directories, so removing downloaded models does not remove cached files.
+ */
+class CloudFileCache {
+    const std::string directory;
+    const size_t capacityBytes;
+
+    std::atomic<uint64_t> hits = 0;
+    std::atomic<uint64_t> misses = 0;
+    std::atomic<uint64_t> stores = 0;
+
+    /**
+     * @brief Serializes eviction within the process. Other processes sharing the directory only ever see complete files.
+     */
+    std::mutex evictionMtx;
+
+    std::string getEntryPath(const std::string& key) const;
+    void evict();
+
+public:
+    static const std::string ENTRY_EXTENSION;
+
+    /**
+     * @brief Construct cache in given directory
+     *
+     * @param directory cache location, empty disables the cache
+     * @param capacityBytes maximal size of all cached files, 0 means no limit
+     */
+    CloudFileCache(const std::string& directory, size_t capacityBytes);
+
+    /**
+     * @brief Gets the cache configured with server parameters
+     */
+    static CloudFileCache& instance();
+
+    bool isEnabled() const {
+        return !directory.empty();
+    }
+
+    /**
+     * @brief Creates key identifying content of remote file
+     *
+     * @param remotePath
+     * @param version ETag, generation or content digest reported by the storage
+     * @param size
+     */
+    static std::string createKey(const std::string& remotePath, const std::string& version, uint64_t size);
+
+    /**
+     * @brief Places cached file under local path, hard linked when possible
+     *
+     * @return true on hit
+     */
+    bool restore(const std::string& key, const std::string& localPath);
+
+    /**
+     * @brief Stores downloaded file under given key. The entry becomes visible only when complete.
+     */
+    void store(const std::string& key, const std::string& localPath);
+
+    uint64_t getHits() const {
+        return hits;
+    }
+
+    uint64_t getMisses() const {
+        return misses;
+    }
+
+    uint64_t getStores() const {
+        return stores;
+    }
+};
+
+}  // namespace ovms
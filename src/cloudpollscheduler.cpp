@@ -0,0 +1,74 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "cloudpollscheduler.hpp"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+std::set<std::string> CloudPollScheduler::poll(const std::set<std::string>& basePaths, clock::time_point now, const fingerprinter_t& fingerprinter) {
+    for (auto it = states.begin(); it != states.end();) {
+        if (basePaths.count(it->first) == 0) {
+            it = states.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::vector<std::string> duePaths;
+    for (const auto& basePath : basePaths) {
+        auto it = states.find(basePath);
+        if (it == states.end() || it->second.nextPoll <= now) {
+            duePaths.push_back(basePath);
+        }
+    }
+    std::set<std::string> changedPaths;
+    if (duePaths.empty()) {
+        return changedPaths;
+    }
+
+    fingerprints_t fingerprints;
+    fingerprinter(duePaths, fingerprints);
+    const auto maxInterval = interval * maxBackoffMultiplier;
+    for (const auto& basePath : duePaths) {
+        auto [it, inserted] = states.emplace(basePath, State{"", interval, now});
+        auto& state = it->second;
+        auto fingerprint = fingerprints.find(basePath);
+        if (fingerprint == fingerprints.end()) {
+            state.fingerprint.clear();
+            state.interval = interval;
+            changedPaths.insert(basePath);
+        } else if (state.fingerprint.empty() || state.fingerprint != fingerprint->second) {
+            SPDLOG_DEBUG("Content of {} changed", basePath);
+            state.fingerprint = fingerprint->second;
+            state.interval = interval;
+            changedPaths.insert(basePath);
+        } else {
+            state.interval = std::min<clock::duration>(state.interval * 2, maxInterval);
+        }
+        state.nextPoll = now + state.interval;
+    }
+    SPDLOG_DEBUG("Polled {} of {} cloud model paths, {} require rescan", duePaths.size(), basePaths.size(), changedPaths.size());
+    return changedPaths;
+}
+
+CloudPollScheduler::clock::duration CloudPollScheduler::getInterval(const std::string& basePath) const {
+    auto it = states.find(basePath);
+    return it != states.end() ? it->second.interval : interval;
+}
+
+}  // namespace ovms
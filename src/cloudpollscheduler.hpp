@@ -0,0 +1,77 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ovms {
+
+/**
+ * @brief Decides which model base paths in cloud storage should be rescanned for new versions.
+ * Each base path is checked every interval with a cheap listing which produces its content fingerprint.
+ * Paths are rescanned only when the fingerprint changed, otherwise their interval is doubled up to the limit.
+ */
+class CloudPollScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+    using fingerprints_t = std::map<std::string, std::string>;
+
+    /**
+     * @brief Fills fingerprints of given base paths. Paths without fingerprint are always rescanned.
+     */
+    using fingerprinter_t = std::function<void(const std::vector<std::string>& basePaths, fingerprints_t& fingerprints)>;
+
+    static const uint DEFAULT_MAX_BACKOFF_MULTIPLIER = 8;
+
+private:
+    struct State {
+        std::string fingerprint;
+        clock::duration interval;
+        clock::time_point nextPoll;
+    };
+
+    const clock::duration interval;
+    const uint maxBackoffMultiplier;
+    std::map<std::string, State> states;
+
+public:
+    CloudPollScheduler(clock::duration interval, uint maxBackoffMultiplier = DEFAULT_MAX_BACKOFF_MULTIPLIER) :
+        interval(interval),
+        maxBackoffMultiplier(maxBackoffMultiplier > 0 ? maxBackoffMultiplier : 1) {}
+
+    /**
+     * @brief Checks base paths which are due for polling
+     *
+     * @param basePaths all base paths of models in cloud storage
+     * @param now
+     * @param fingerprinter
+     *
+     * @return base paths which changed since previous check or which changes can not be detected
+     */
+    std::set<std::string> poll(const std::set<std::string>& basePaths, clock::time_point now, const fingerprinter_t& fingerprinter);
+
+    /**
+     * @brief Gets current polling interval of base path, including backoff
+     */
+    clock::duration getInterval(const std::string& basePath) const;
+};
+
+}  // namespace ovms
@@ -0,0 +1,211 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "compilednetworkcache.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include "config.hpp"
+#include "filehash.hpp"
+
+namespace ovms {
+
+const std::string CompiledNetworkCache::ENTRY_EXTENSION = ".blob";
+
+CompiledNetworkCache::CompiledNetworkCache(const std::string& directory, size_t capacityBytes, MetricsRegistry& registry) :
+    directory(directory),
+    capacityBytes(capacityBytes) {
+    const std::string help = "Number of compiled network cache lookups";
+    hits = registry.getCounter("ovms_compiled_network_cache_requests_total", help, {{"result", "hit"}});
+    misses = registry.getCounter("ovms_compiled_network_cache_requests_total", help, {{"result", "miss"}});
+    stores = registry.getCounter("ovms_compiled_network_cache_stores_total", "Number of networks stored in compiled network cache", {});
+    if (!isEnabled()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        SPDLOG_ERROR("Could not create compiled networks cache directory: {}; error: {}", directory, ec.message());
+    }
+}
+
+CompiledNetworkCache& CompiledNetworkCache::instance() {
+    static CompiledNetworkCache cache(
+        Config::instance().compiledNetworkCacheDir(),
+        static_cast<size_t>(Config::instance().compiledNetworkCacheSizeMb()) * 1024 * 1024,
+        MetricsRegistry::instance());
+    return cache;
+}
+
+std::string CompiledNetworkCache::getEntryPath(const std::string& key) const {
+    return (std::filesystem::path(directory) / (key + ENTRY_EXTENSION)).string();
+}
+
+bool CompiledNetworkCache::createKey(const std::vector<std::string>& modelFiles,
+    const std::string& targetDevice,
+    const plugin_config_t& pluginConfig,
+    const InferenceEngine::CNNNetwork& network,
+    std::string& key) {
+    Fnv1aHash hash;
+    const auto version = InferenceEngine::GetInferenceEngineVersion();
+    hash.update(version->buildNumber != nullptr ? version->buildNumber : "");
+    hash.update(Config::instance().cpuExtensionLibraryPath());
+    hash.update(targetDevice);
+    for (const auto& [parameter, value] : pluginConfig) {
+        hash.update(parameter);
+        hash.update(value);
+    }
+    for (const auto& [name, input] : network.getInputsInfo()) {
+        std::stringstream ss;
+        ss << name << ':' << input->getPrecision().name() << ':' << input->getTensorDesc().getLayout();
+        for (const auto& dim : input->getTensorDesc().getDims()) {
+            ss << ',' << dim;
+        }
+        hash.update(ss.str());
+    }
+    for (const auto& [name, output] : network.getOutputsInfo()) {
+        std::stringstream ss;
+        ss << name << ':' << output->getPrecision().name() << ':' << output->getLayout();
+        hash.update(ss.str());
+    }
+    // Content of unchanged model files is not read again on reloads
+    auto& digests = FileDigestCache::instance();
+    for (const auto& file : modelFiles) {
+        uint64_t digest;
+        if (!digests.getDigest(file, digest)) {
+            SPDLOG_WARN("Could not read model file: {} to compute compiled network cache key", file);
+            return false;
+        }
+        hash.update(reinterpret_cast<const char*>(&digest), sizeof(digest));
+    }
+    key = hash.toHexString();
+    return true;
+}
+
+bool CompiledNetworkCache::importNetwork(const std::string& key,
+    InferenceEngine::Core& engine,
+    const std::string& targetDevice,
+    const plugin_config_t& pluginConfig,
+    std::shared_ptr<InferenceEngine::ExecutableNetwork>& execNetwork) {
+    const auto path = getEntryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.good()) {
+        misses->increment();
+        SPDLOG_INFO("Compiled network cache miss for key: {}; hits: {}; misses: {}", key, getHits(), getMisses());
+        return false;
+    }
+    try {
+        execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(engine.ImportNetwork(file, targetDevice, pluginConfig));
+    } catch (const std::exception& e) {
+        misses->increment();
+        SPDLOG_WARN("Could not import compiled network from: {}; error: {}; entry will be removed", path, e.what());
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return false;
+    }
+    // Mark entry as recently used
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    hits->increment();
+    SPDLOG_INFO("Compiled network cache hit for key: {}; hits: {}; misses: {}", key, getHits(), getMisses());
+    return true;
+}
+
+void CompiledNetworkCache::exportNetwork(const std::string& key, InferenceEngine::ExecutableNetwork& execNetwork) {
+    const auto path = getEntryPath(key);
+    std::stringstream tmpSuffix;
+    tmpSuffix << ".tmp." << getpid() << "." << std::hash<std::thread::id>{}(std::this_thread::get_id());
+    const auto tmpPath = path + tmpSuffix.str();
+    std::error_code ec;
+    try {
+        std::ofstream file(tmpPath, std::ios::binary);
+        if (!file.good()) {
+            SPDLOG_WARN("Could not create compiled network cache entry: {}", tmpPath);
+            return;
+        }
+        execNetwork.Export(file);
+        file.close();
+        if (!file.good()) {
+            SPDLOG_WARN("Could not write compiled network cache entry: {}", tmpPath);
+            std::filesystem::remove(tmpPath, ec);
+            return;
+        }
+    } catch (const std::exception& e) {
+        SPDLOG_WARN("Could not export compiled network to cache, device may not support export; error: {}", e.what());
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+    // Rename is atomic so readers never see partially written entries
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        SPDLOG_WARN("Could not store compiled network cache entry: {}; error: {}", path, ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+    stores->increment();
+    SPDLOG_INFO("Stored compiled network in cache: {}", path);
+    evict();
+}
+
+void CompiledNetworkCache::evict() {
+    if (capacityBytes == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(evictionMtx);
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastUsed;
+        uintmax_t size;
+    };
+    std::vector<Entry> entries;
+    uintmax_t totalSize = 0;
+    std::error_code ec;
+    for (const auto& file : std::filesystem::directory_iterator(directory, ec)) {
+        if (!file.is_regular_file(ec) || file.path().extension() != ENTRY_EXTENSION) {
+            continue;
+        }
+        Entry entry{file.path(), file.last_write_time(ec), file.file_size(ec)};
+        if (ec) {
+            continue;
+        }
+        totalSize += entry.size;
+        entries.push_back(std::move(entry));
+    }
+    if (totalSize <= capacityBytes) {
+        return;
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.lastUsed < rhs.lastUsed; });
+    for (const auto& entry : entries) {
+        if (totalSize <= capacityBytes) {
+            break;
+        }
+        SPDLOG_INFO("Evicting compiled network cache entry: {}", entry.path.string());
+        if (std::filesystem::remove(entry.path, ec)) {
+            totalSize -= entry.size;
+        }
+    }
+}
+
+}  // namespace ovms
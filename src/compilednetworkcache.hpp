@@ -0,0 +1,114 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "metrics.hpp"
+#include "modelconfig.hpp"
+
+namespace ovms {
+
+/**
+ * @brief On-disk cache of networks compiled for target device, stored with ExecutableNetwork::Export
+ * and restored with Core::ImportNetwork instead of compiling the network again.
+ */
+class CompiledNetworkCache {
+    const std::string directory;
+    const size_t capacityBytes;
+
+    std::shared_ptr<MetricCounter> hits;
+    std::shared_ptr<MetricCounter> misses;
+    std::shared_ptr<MetricCounter> stores;
+
+    /**
+     * @brief Serializes eviction within the process. Other processes sharing the directory only ever see complete files.
+     */
+    std::mutex evictionMtx;
+
+    std::string getEntryPath(const std::string& key) const;
+    void evict();
+
+public:
+    static const std::string ENTRY_EXTENSION;
+
+    /**
+     * @brief Construct cache in given directory
+     *
+     * @param directory cache location, empty disables the cache
+     * @param capacityBytes maximal size of all cached networks, 0 means no limit
+     * @param registry metrics registry receiving numbers of hits, misses and stored networks
+     */
+    CompiledNetworkCache(const std::string& directory, size_t capacityBytes, MetricsRegistry& registry);
+
+    /**
+     * @brief Gets the cache configured with server parameters
+     */
+    static CompiledNetworkCache& instance();
+
+    bool isEnabled() const {
+        return !directory.empty();
+    }
+
+    /**
+     * @brief Creates key identifying compiled network
+     *
+     * Key depends on model files content, target device, plugin config, network inputs and outputs precision, layout and shape,
+     * OpenVINO version and CPU extension library. Model files are read only when they changed since the previous key creation.
+     *
+     * @return false if model files could not be read
+     */
+    static bool createKey(const std::vector<std::string>& modelFiles,
+        const std::string& targetDevice,
+        const plugin_config_t& pluginConfig,
+        const InferenceEngine::CNNNetwork& network,
+        std::string& key);
+
+    /**
+     * @brief Imports compiled network stored under given key
+     *
+     * @return true on hit, false when there is no valid entry
+     */
+    bool importNetwork(const std::string& key,
+        InferenceEngine::Core& engine,
+        const std::string& targetDevice,
+        const plugin_config_t& pluginConfig,
+        std::shared_ptr<InferenceEngine::ExecutableNetwork>& execNetwork);
+
+    /**
+     * @brief Exports compiled network under given key. The entry becomes visible only when completely written.
+     */
+    void exportNetwork(const std::string& key, InferenceEngine::ExecutableNetwork& execNetwork);
+
+    uint64_t getHits() const {
+        return hits->get();
+    }
+
+    uint64_t getMisses() const {
+        return misses->get();
+    }
+
+    uint64_t getStores() const {
+        return stores->get();
+    }
+};
+
+}  // namespace ovms
@@ -24,6 +24,7 @@
 #include <boost/algorithm/string.hpp>
 #include <sysexits.h>
 
+#include "mappedfile.hpp"
 #include "version.hpp"
 
 namespace ovms {
@@ -75,13 +76,93 @@ Config& Config::parse(int argc, char** argv) {
             ("log_path",
                 "optional path to the log file",
                 cxxopts::value<std::string>(), "LOG_PATH")
+            ("trace_sampling_rate",
+                "Ratio of traced request processing stages written to the log with DEBUG log level, from 0 to 1. Default: 0, none.",
+                cxxopts::value<double>()->default_value("0"),
+                "TRACE_SAMPLING_RATE")
+            ("request_trace_path",
+                "Path to the file receiving traces of sampled predict requests in Chrome trace event format. Default: empty, request tracing disabled.",
+                cxxopts::value<std::string>(),
+                "REQUEST_TRACE_PATH")
+            ("request_trace_sampling_rate",
+                "Ratio of traced predict requests, from 0 to 1. Requests with sampled flag in W3C traceparent header are always traced. Default: 0.",
+                cxxopts::value<double>()->default_value("0"),
+                "REQUEST_TRACE_SAMPLING_RATE")
             ("grpc_channel_arguments",
                 "A comma separated list of arguments to be passed to the grpc server. (e.g. grpc.max_connection_age_ms=2000)",
                 cxxopts::value<std::string>(), "GRPC_CHANNEL_ARGUMENTS")
             ("file_system_poll_wait_seconds",
-                "Time interval between config and model versions changes detection. Default is 1. Zero or negative value disables changes monitoring.",
+                "Time interval between config and model versions changes detection. Local config file and model directories are watched with inotify and this interval applies to models in cloud storage. Default is 1. Zero or negative value disables changes monitoring.",
                 cxxopts::value<uint>()->default_value("1"),
-                "SECONDS");
+                "SECONDS")
+            ("cloud_poll_wait_seconds",
+                "Time interval between checks of model directories in cloud storage. The interval is doubled, up to 8 times, for directories which did not change. Default 0 means file_system_poll_wait_seconds.",
+                cxxopts::value<uint>()->default_value("0"),
+                "CLOUD_POLL_WAIT_SECONDS")
+            ("custom_node_threads",
+                "Number of threads executing custom nodes in DAG pipelines. Default 0 sets it to the number of CPU cores.",
+                cxxopts::value<uint>()->default_value("0"),
+                "CUSTOM_NODE_THREADS")
+            ("model_load_threads",
+                "Number of threads loading models and model versions concurrently at startup and on configuration change. Default 0 sets it to the number of CPU cores.",
+                cxxopts::value<uint>()->default_value("0"),
+                "MODEL_LOAD_THREADS")
+            ("compiled_network_cache_dir",
+                "Directory for caching networks compiled for target devices, reused on model loads with the same model files and parameters. Default: empty, caching disabled.",
+                cxxopts::value<std::string>()->default_value(""),
+                "COMPILED_NETWORK_CACHE_DIR")
+            ("compiled_network_cache_size_mb",
+                "Maximal size of compiled networks cache in megabytes. Least recently used networks are removed when exceeded. Default 0 means no limit.",
+                cxxopts::value<uint>()->default_value("0"),
+                "COMPILED_NETWORK_CACHE_SIZE_MB")
+            ("onnx_conversion_cache_dir",
+                "Directory for caching ONNX models converted to IR, reused on model loads with the same ONNX file. Default: empty, caching disabled.",
+                cxxopts::value<std::string>()->default_value(""),
+                "ONNX_CONVERSION_CACHE_DIR")
+            ("onnx_conversion_cache_size_mb",
+                "Maximal size of ONNX conversion cache in megabytes. Least recently used networks are removed when exceeded. Default 0 means no limit.",
+                cxxopts::value<uint>()->default_value("0"),
+                "ONNX_CONVERSION_CACHE_SIZE_MB")
+            ("load_models_on_demand",
+                "Register models without loading them. Each model version is loaded by the first request using it, unless it is pinned in the configuration.",
+                cxxopts::value<bool>()->default_value("false"),
+                "LOAD_MODELS_ON_DEMAND")
+            ("models_memory_budget_mb",
+                "Estimated memory in megabytes available for loaded models. Least recently used models which are not pinned are unloaded when exceeded and loaded again on demand. Default 0 means no limit.",
+                cxxopts::value<uint>()->default_value("0"),
+                "MODELS_MEMORY_BUDGET_MB")
+            ("weights_mmap_mode",
+                "How IR model weights are read. off - weights are read into memory, lazy - weights file is mapped to memory and used by network without copying, populate - as lazy but whole file is read during mapping, willneed - as lazy with asynchronous read ahead.",
+                cxxopts::value<std::string>()->default_value("lazy"),
+                "WEIGHTS_MMAP_MODE")
+            ("cloud_download_threads",
+                "Number of concurrent requests downloading model files from cloud storage. Files are split into parts downloaded in parallel.",
+                cxxopts::value<uint>()->default_value("8"),
+                "CLOUD_DOWNLOAD_THREADS")
+            ("cloud_download_part_size_mb",
+                "Size in megabytes of model file parts downloaded from cloud storage with separate ranged requests.",
+                cxxopts::value<uint>()->default_value("16"),
+                "CLOUD_DOWNLOAD_PART_SIZE_MB")
+            ("cloud_download_max_connections",
+                "Limit of concurrent requests downloading model files from cloud storage, shared by downloads of all models. Zero value means unlimited.",
+                cxxopts::value<uint>()->default_value("32"),
+                "CLOUD_DOWNLOAD_MAX_CONNECTIONS")
+            ("cloud_download_max_bandwidth_mb",
+                "Limit of total throughput in megabytes per second of downloads from cloud storage, shared by downloads of all models. Default: 0, unlimited.",
+                cxxopts::value<uint>()->default_value("0"),
+                "CLOUD_DOWNLOAD_MAX_BANDWIDTH_MB")
+            ("cloud_cache_dir",
+                "Directory for caching model files downloaded from cloud storage. Unchanged files are reused on subsequent downloads instead of being downloaded again. Default: empty, caching disabled.",
+                cxxopts::value<std::string>()->default_value(""),
+                "CLOUD_CACHE_DIR")
+            ("cloud_cache_size_mb",
+                "Maximal size of cloud files cache in megabytes. Least recently used files are removed when exceeded. Default 0 means no limit.",
+                cxxopts::value<uint>()->default_value("0"),
+                "CLOUD_CACHE_SIZE_MB")
+            ("cloud_models_in_memory",
+                "Download model files from cloud storage to memory instead of a temporary directory on local disk.",
+                cxxopts::value<bool>()->default_value("false"),
+                "CLOUD_MODELS_IN_MEMORY");
         options->add_options("multi model")
             ("config_path",
                 "absolute path to json configuration file",
@@ -237,6 +318,27 @@ void Config::validate() {
         exit(EX_USAGE);
     }
 
+    if (result->count("trace_sampling_rate") && (this->traceSamplingRate() < 0 || this->traceSamplingRate() > 1)) {
+        std::cerr << "trace_sampling_rate should be from 0 to 1" << std::endl;
+        exit(EX_USAGE);
+    }
+
+    if (result->count("request_trace_sampling_rate") && (this->requestTraceSamplingRate() < 0 || this->requestTraceSamplingRate() > 1)) {
+        std::cerr << "request_trace_sampling_rate should be from 0 to 1" << std::endl;
+        exit(EX_USAGE);
+    }
+
+    if (result->count("weights_mmap_mode") && !MappedFile::isValidMode(this->weightsMmapMode())) {
+        std::cerr << "weights_mmap_mode should be one of: off, lazy, populate, willneed" << std::endl;
+        exit(EX_USAGE);
+    }
+
+    if ((result->count("cloud_download_threads") && this->cloudDownloadThreads() == 0) ||
+        (result->count("cloud_download_part_size_mb") && this->cloudDownloadPartSizeMb() == 0)) {
+        std::cerr << "cloud_download_threads and cloud_download_part_size_mb have to be greater than 0" << std::endl;
+        exit(EX_USAGE);
+    }
+
     // check cpu_extension path:
     if (result->count("cpu_extension") && !std::filesystem::exists(this->cpuExtensionLibraryPath())) {
         std::cerr << "File path provided as an --cpu_extension parameter does not exists in the filesystem: " << this->cpuExtensionLibraryPath() << std::endl;
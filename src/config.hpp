@@ -276,6 +276,42 @@ public:
         return empty;
     }
 
+    /**
+     * @brief Get the ratio of traced spans written to the log
+     * 
+     * @return double
+     */
+    double traceSamplingRate() {
+        if (result != nullptr && result->count("trace_sampling_rate")) {
+            return result->operator[]("trace_sampling_rate").as<double>();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the path of request traces file
+     * 
+     * @return const std::string&
+     */
+    const std::string& requestTracePath() {
+        if (result != nullptr && result->count("request_trace_path")) {
+            return result->operator[]("request_trace_path").as<std::string>();
+        }
+        return empty;
+    }
+
+    /**
+     * @brief Get the ratio of traced requests
+     * 
+     * @return double
+     */
+    double requestTraceSamplingRate() {
+        if (result != nullptr && result->count("request_trace_sampling_rate")) {
+            return result->operator[]("request_trace_sampling_rate").as<double>();
+        }
+        return 0;
+    }
+
     /**
         * @brief Get the plugin config
         *
@@ -295,5 +331,209 @@ public:
     uint filesystemPollWaitSeconds() {
         return result->operator[]("file_system_poll_wait_seconds").as<uint>();
     }
+
+    /**
+     * @brief Get the time interval between checks of model directories in cloud storage, 0 means filesystemPollWaitSeconds
+     * 
+     * @return uint 
+     */
+    uint cloudPollWaitSeconds() {
+        if (result != nullptr && result->count("cloud_poll_wait_seconds")) {
+            return result->operator[]("cloud_poll_wait_seconds").as<uint>();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the number of threads executing custom nodes
+     * 
+     * @return uint 
+     */
+    uint customNodeThreads() {
+        if (result != nullptr && result->count("custom_node_threads")) {
+            return result->operator[]("custom_node_threads").as<uint>();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the number of threads loading models
+     * 
+     * @return uint 
+     */
+    uint modelLoadThreads() {
+        if (result != nullptr && result->count("model_load_threads")) {
+            return result->operator[]("model_load_threads").as<uint>();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the compiled networks cache directory
+     * 
+     * @return const std::string 
+     */
+    const std::string compiledNetworkCacheDir() {
+        if (result != nullptr && result->count("compiled_network_cache_dir")) {
+            return result->operator[]("compiled_network_cache_dir").as<std::string>();
+        }
+        return "";
+    }
+
+    /**
+     * @brief Get the compiled networks cache size limit in megabytes
+     * 
+     * @return uint 
+     */
+    uint compiledNetworkCacheSizeMb() {
+        if (result != nullptr && result->count("compiled_network_cache_size_mb")) {
+            return result->operator[]("compiled_network_cache_size_mb").as<uint>();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the ONNX conversion cache directory
+     * 
+     * @return const std::string 
+     */
+    const std::string onnxConversionCacheDir() {
+        if (result != nullptr && result->count("onnx_conversion_cache_dir")) {
+            return result->operator[]("onnx_conversion_cache_dir").as<std::string>();
+        }
+        return "";
+    }
+
+    /**
+     * @brief Get the maximal size of ONNX conversion cache in megabytes
+     * 
+     * @return uint 
+     */
+    uint onnxConversionCacheSizeMb() {
+        if (result != nullptr && result->count("onnx_conversion_cache_size_mb")) {
+            return result->operator[]("onnx_conversion_cache_size_mb").as<uint>();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get whether models are loaded by the first request instead of at startup
+     * 
+     * @return bool 
+     */
+    bool loadModelsOnDemand() {
+        if (result != nullptr && result->count("load_models_on_demand")) {
+            return result->operator[]("load_models_on_demand").as<bool>();
+        }
+        return false;
+    }
+
+    /**
+     * @brief Get the loaded models memory budget in megabytes
+     * 
+     * @return uint 
+     */
+    uint modelsMemoryBudgetMb() {
+        if (result != nullptr && result->count("models_memory_budget_mb")) {
+            return result->operator[]("models_memory_budget_mb").as<uint>();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the weights mmap mode
+     * 
+     * @return const std::string 
+     */
+    const std::string weightsMmapMode() {
+        if (result != nullptr && result->count("weights_mmap_mode")) {
+            return result->operator[]("weights_mmap_mode").as<std::string>();
+        }
+        return "lazy";
+    }
+
+    /**
+     * @brief Get the number of cloud download threads
+     * 
+     * @return uint 
+     */
+    uint cloudDownloadThreads() {
+        if (result != nullptr && result->count("cloud_download_threads")) {
+            return result->operator[]("cloud_download_threads").as<uint>();
+        }
+        return 8;
+    }
+
+    /**
+     * @brief Get the cloud download part size in megabytes
+     * 
+     * @return uint 
+     */
+    uint cloudDownloadPartSizeMb() {
+        if (result != nullptr && result->count("cloud_download_part_size_mb")) {
+            return result->operator[]("cloud_download_part_size_mb").as<uint>();
+        }
+        return 16;
+    }
+
+    /**
+     * @brief Get the limit of concurrent requests downloading model files from cloud storage, 0 means unlimited
+     * 
+     * @return uint 
+     */
+    uint cloudDownloadMaxConnections() {
+        if (result != nullptr && result->count("cloud_download_max_connections")) {
+            return result->operator[]("cloud_download_max_connections").as<uint>();
+        }
+        return 32;
+    }
+
+    /**
+     * @brief Get the limit of total throughput of downloads from cloud storage in megabytes per second, 0 means unlimited
+     * 
+     * @return uint 
+     */
+    uint cloudDownloadMaxBandwidthMb() {
+        if (result != nullptr && result->count("cloud_download_max_bandwidth_mb")) {
+            return result->operator[]("cloud_download_max_bandwidth_mb").as<uint>();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the local cache directory of files downloaded from cloud storage
+     * 
+     * @return const std::string 
+     */
+    const std::string cloudCacheDir() {
+        if (result != nullptr && result->count("cloud_cache_dir")) {
+            return result->operator[]("cloud_cache_dir").as<std::string>();
+        }
+        return "";
+    }
+
+    /**
+     * @brief Get the cloud files cache size limit in megabytes
+     * 
+     * @return uint 
+     */
+    uint cloudCacheSizeMb() {
+        if (result != nullptr && result->count("cloud_cache_size_mb")) {
+            return result->operator[]("cloud_cache_size_mb").as<uint>();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get whether models from cloud storage are downloaded to memory instead of local disk
+     * 
+     * @return bool 
+     */
+    bool cloudModelsInMemory() {
+        if (result != nullptr && result->count("cloud_models_in_memory")) {
+            return result->operator[]("cloud_models_in_memory").as<bool>();
+        }
+        return false;
+    }
 };
 }  // namespace ovms
@@ -0,0 +1,59 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "coreregistry.hpp"
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+CoreRegistry& CoreRegistry::instance() {
+    static CoreRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<InferenceEngine::Core> CoreRegistry::getCore(const std::string& cpuExtensionLibraryPath) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = cores.find(cpuExtensionLibraryPath);
+    if (it != cores.end()) {
+        return it->second;
+    }
+    SPDLOG_INFO("Creating inference engine core shared by all models");
+    auto core = std::make_shared<InferenceEngine::Core>();
+    if (cpuExtensionLibraryPath != "") {
+        SPDLOG_INFO("Loading custom CPU extension from {}", cpuExtensionLibraryPath);
+        try {
+            auto extension_ptr = InferenceEngine::make_so_pointer<InferenceEngine::IExtension>(cpuExtensionLibraryPath.c_str());
+            SPDLOG_INFO("Custom CPU extention loaded. Adding it.");
+            core->AddExtension(extension_ptr, "CPU");
+            SPDLOG_INFO("Extention added.");
+        } catch (std::exception& ex) {
+            SPDLOG_CRITICAL("Custom CPU extention loading has failed! Reason: {}", ex.what());
+            throw;
+        } catch (...) {
+            SPDLOG_CRITICAL("Custom CPU extention loading has failed with an unknown error!");
+            throw;
+        }
+    }
+    cores.emplace(cpuExtensionLibraryPath, core);
+    return core;
+}
+
+size_t CoreRegistry::getCoresCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return cores.size();
+}
+
+}  // namespace ovms
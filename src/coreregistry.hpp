@@ -0,0 +1,54 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <inference_engine.hpp>
+
+namespace ovms {
+
+/**
+ * @brief Process wide registry of InferenceEngine::Core objects shared by all model instances.
+ * Device plugins are loaded once per Core and their thread pools are shared by all networks loaded with it.
+ * Cores are kept for the whole process lifetime, so plugins are not reloaded when models are unloaded.
+ */
+class CoreRegistry {
+    std::unordered_map<std::string, std::shared_ptr<InferenceEngine::Core>> cores;
+    std::mutex mtx;
+
+public:
+    /**
+     * @brief Gets the process wide registry
+     */
+    static CoreRegistry& instance();
+
+    /**
+     * @brief Gets Core with given CPU extension loaded, creates it on first use
+     *
+     * @param cpuExtensionLibraryPath path to CPU extension library, empty if none
+     *
+     * @return shared Core
+     */
+    std::shared_ptr<InferenceEngine::Core> getCore(const std::string& cpuExtensionLibraryPath);
+
+    size_t getCoresCount();
+};
+
+}  // namespace ovms
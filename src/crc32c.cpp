@@ -0,0 +1,205 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "crc32c.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+namespace ovms {
+
+namespace {
+
+const uint32_t POLYNOMIAL = 0x82F63B78;
+
+std::array<uint32_t, 256> createTable() {
+    std::array<uint32_t, 256> table;
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+uint32_t updateSoftware(uint32_t crc, const char* data, size_t size) {
+    static const std::array<uint32_t, 256> table = createTable();
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) uint32_t updateHardware(uint32_t crc, const char* data, size_t size) {
+    uint64_t crc64 = crc;
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = static_cast<uint32_t>(crc64);
+    for (; size > 0; size--, data++) {
+        crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*data));
+    }
+    return crc;
+}
+
+bool isHardwareSupported() {
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+#endif
+
+// Combining checksums follows zlib crc32_combine: zeros appended to the first part are applied as GF(2) matrix operator
+uint32_t gf2MatrixTimes(const uint32_t* matrix, uint32_t vector) {
+    uint32_t sum = 0;
+    for (; vector != 0; vector >>= 1, matrix++) {
+        if (vector & 1) {
+            sum ^= *matrix;
+        }
+    }
+    return sum;
+}
+
+void gf2MatrixSquare(uint32_t* square, const uint32_t* matrix) {
+    for (int i = 0; i < 32; i++) {
+        square[i] = gf2MatrixTimes(matrix, matrix[i]);
+    }
+}
+
+int decodeBase64(char c) {
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z') {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9') {
+        return c - '0' + 52;
+    }
+    if (c == '+') {
+        return 62;
+    }
+    if (c == '/') {
+        return 63;
+    }
+    return -1;
+}
+
+}  // namespace
+
+void Crc32c::update(const char* data, size_t size) {
+#if defined(__x86_64__)
+    if (isHardwareSupported()) {
+        crc = ~updateHardware(~crc, data, size);
+        return;
+    }
+#endif
+    crc = ~updateSoftware(~crc, data, size);
+}
+
+uint32_t Crc32c::combine(uint32_t first, uint32_t second, uint64_t secondSize) {
+    if (secondSize == 0) {
+        return first;
+    }
+    uint32_t even[32];
+    uint32_t odd[32];
+    // Operator for one zero bit
+    odd[0] = POLYNOMIAL;
+    for (int i = 1; i < 32; i++) {
+        odd[i] = 1u << (i - 1);
+    }
+    // Operators for two and four zero bits
+    gf2MatrixSquare(even, odd);
+    gf2MatrixSquare(odd, even);
+    // Apply operators for one zero byte, then for 2, 4, 8... zero bytes matching bits of size
+    do {
+        gf2MatrixSquare(even, odd);
+        if (secondSize & 1) {
+            first = gf2MatrixTimes(even, first);
+        }
+        secondSize >>= 1;
+        if (secondSize == 0) {
+            break;
+        }
+        gf2MatrixSquare(odd, even);
+        if (secondSize & 1) {
+            first = gf2MatrixTimes(odd, first);
+        }
+        secondSize >>= 1;
+    } while (secondSize != 0);
+    return first ^ second;
+}
+
+bool Crc32c::fromHexString(const std::string& hex, uint32_t& crc) {
+    if (hex.size() != 8) {
+        return false;
+    }
+    uint32_t result = 0;
+    for (char c : hex) {
+        uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return false;
+        }
+        result = (result << 4) | digit;
+    }
+    crc = result;
+    return true;
+}
+
+bool Crc32c::fromBase64(const std::string& encoded, uint32_t& crc) {
+    // 4 bytes are encoded as 6 characters followed by 2 padding characters
+    if (encoded.size() != 8 || encoded[6] != '=' || encoded[7] != '=') {
+        return false;
+    }
+    uint64_t bits = 0;
+    for (size_t i = 0; i < 6; i++) {
+        int value = decodeBase64(encoded[i]);
+        if (value < 0) {
+            return false;
+        }
+        bits = (bits << 6) | value;
+    }
+    // 36 decoded bits hold 32 bits of checksum followed by 4 zero bits
+    if (bits & 0xF) {
+        return false;
+    }
+    crc = static_cast<uint32_t>(bits >> 4);
+    return true;
+}
+
+std::string Crc32c::toHexString() const {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(8, '0');
+    for (int i = 7, shift = 0; i >= 0; i--, shift += 4) {
+        hex[i] = digits[(crc >> shift) & 0xF];
+    }
+    return hex;
+}
+
+}  // namespace ovms
@@ -0,0 +1,68 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ovms {
+
+/**
+ * @brief Incremental CRC-32C (Castagnoli) checksum, computed with SSE 4.2 instructions when available.
+ * Checksums of consecutive parts computed independently can be combined into checksum of the whole.
+ */
+class Crc32c {
+    uint32_t crc = 0;
+
+public:
+    Crc32c() = default;
+    explicit Crc32c(uint32_t crc) :
+        crc(crc) {}
+
+    void update(const char* data, size_t size);
+
+    uint32_t get() const {
+        return crc;
+    }
+
+    /**
+     * @brief Gets checksum of data which consists of data with first checksum followed by data with second checksum
+     *
+     * @param first
+     * @param second
+     * @param secondSize size of data with second checksum
+     *
+     * @return combined checksum
+     */
+    static uint32_t combine(uint32_t first, uint32_t second, uint64_t secondSize);
+
+    /**
+     * @brief Parses checksum written as 8 hex digits
+     */
+    static bool fromHexString(const std::string& hex, uint32_t& crc);
+
+    /**
+     * @brief Parses checksum written as base64 of big endian bytes, as reported by cloud storage object metadata
+     */
+    static bool fromBase64(const std::string& encoded, uint32_t& crc);
+
+    /**
+     * @brief Gets checksum as 8 characters hex string
+     */
+    std::string toHexString() const;
+};
+
+}  // namespace ovms
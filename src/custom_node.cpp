@@ -0,0 +1,203 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "custom_node.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/util/threadpool_executor.h"
+#pragma GCC diagnostic pop
+
+#include "config.hpp"
+#include "logging.hpp"
+#include "node_library_utils.hpp"
+
+namespace ovms {
+
+static tensorflow::serving::ThreadPoolExecutor& getCustomNodeExecutor() {
+    static tensorflow::serving::ThreadPoolExecutor executor(
+        tensorflow::Env::Default(),
+        "customnode",
+        Config::instance().customNodeThreads() > 0 ? Config::instance().customNodeThreads() : std::max(1u, std::thread::hardware_concurrency()));
+    return executor;
+}
+
+CustomNode::CustomNode(const std::string& nodeName, const NodeLibrary& library, const parameters_t& parameters,
+    std::unordered_map<std::string, std::string> nodeOutputNameAlias,
+    std::shared_ptr<CNLIMWrapper> customNodeLibraryInternalManager) :
+    Node(nodeName),
+    library(library),
+    parameters(parameters),
+    nodeOutputNameAlias(nodeOutputNameAlias),
+    customNodeLibraryInternalManager(customNodeLibraryInternalManager),
+    libraryParameters(createCustomNodeParamArray(this->parameters)) {
+}
+
+void* CustomNode::getInternalManagerPtr() const {
+    return customNodeLibraryInternalManager ? customNodeLibraryInternalManager->ptr : nullptr;
+}
+
+Status CustomNode::execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) {
+    SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Scheduling custom node: {} execution", getName());
+    getCustomNodeExecutor().Schedule([this, &notifyEndQueue]() {
+        this->executionStatus = this->executeLibrary();
+        // After library execution is completed, input blobs are not needed anymore
+        this->inputBlobs.clear();
+        notifyEndQueue.push(*this);
+    });
+    return StatusCode::OK;
+}
+
+Status CustomNode::executeLibrary() {
+    const size_t inputsCount = this->inputBlobs.size();
+    auto inputs = std::make_unique<struct CustomNodeTensor[]>(inputsCount);
+    std::vector<std::vector<uint64_t>> inputsDims(inputsCount);
+    size_t i = 0;
+    for (const auto& [name, blob] : this->inputBlobs) {
+        const auto& dims = blob->getTensorDesc().getDims();
+        inputsDims[i].assign(dims.begin(), dims.end());
+        inputs[i].name = name.c_str();
+        inputs[i].data = (uint8_t*)blob->buffer();
+        inputs[i].dataBytes = blob->byteSize();
+        inputs[i].dims = inputsDims[i].data();
+        inputs[i].dimsCount = inputsDims[i].size();
+        inputs[i].precision = toCustomNodeTensorPrecision(blob->getTensorDesc().getPrecision());
+        i++;
+    }
+
+    struct CustomNodeTensor* outputs = nullptr;
+    int outputsCount = 0;
+    SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Calling custom node: {} library execute with {} inputs", getName(), inputsCount);
+    int result = this->library.execute(
+        inputs.get(),
+        inputsCount,
+        &outputs,
+        &outputsCount,
+        this->libraryParameters.get(),
+        this->parameters.size(),
+        getInternalManagerPtr());
+    if (result != 0) {
+        SPDLOG_LOGGER_ERROR(dag_executor_logger, "Custom node: {} library execution failed with error code: {}", getName(), result);
+        return StatusCode::NODE_LIBRARY_EXECUTION_FAILED;
+    }
+    if (outputs == nullptr) {
+        SPDLOG_LOGGER_ERROR(dag_executor_logger, "Custom node: {} library has not returned outputs", getName());
+        return StatusCode::NODE_LIBRARY_OUTPUTS_CORRUPTED;
+    }
+
+    // Copy library outputs to blobs and give the memory back to the library regardless of the result
+    Status status = StatusCode::OK;
+    for (int j = 0; j < outputsCount; j++) {
+        if (status.ok()) {
+            InferenceEngine::Blob::Ptr blob;
+            status = createOutputBlob(outputs[j], blob);
+            if (status.ok()) {
+                this->resultBlobs.emplace(std::string(outputs[j].name), std::move(blob));
+            }
+        }
+        this->library.release(outputs[j].data, getInternalManagerPtr());
+        this->library.release(outputs[j].dims, getInternalManagerPtr());
+    }
+    this->library.release(outputs, getInternalManagerPtr());
+    return status;
+}
+
+Status CustomNode::createOutputBlob(const struct CustomNodeTensor& tensor, InferenceEngine::Blob::Ptr& blob) const {
+    if (tensor.name == nullptr || tensor.data == nullptr || tensor.dims == nullptr || tensor.dimsCount == 0) {
+        SPDLOG_LOGGER_ERROR(dag_executor_logger, "Custom node: {} library returned output with missing name, data or shape", getName());
+        return StatusCode::NODE_LIBRARY_OUTPUTS_CORRUPTED;
+    }
+    InferenceEngine::Precision precision = toInferenceEnginePrecision(tensor.precision);
+    InferenceEngine::SizeVector dims(tensor.dims, tensor.dims + tensor.dimsCount);
+    InferenceEngine::TensorDesc desc(precision, dims, InferenceEngine::TensorDesc::getLayoutByDims(dims));
+    try {
+        switch (precision) {
+        case InferenceEngine::Precision::FP32:
+            blob = InferenceEngine::make_shared_blob<float>(desc);
+            break;
+        case InferenceEngine::Precision::FP16:
+        case InferenceEngine::Precision::I16:
+            blob = InferenceEngine::make_shared_blob<int16_t>(desc);
+            break;
+        case InferenceEngine::Precision::U16:
+            blob = InferenceEngine::make_shared_blob<uint16_t>(desc);
+            break;
+        case InferenceEngine::Precision::U8:
+            blob = InferenceEngine::make_shared_blob<uint8_t>(desc);
+            break;
+        case InferenceEngine::Precision::I8:
+            blob = InferenceEngine::make_shared_blob<int8_t>(desc);
+            break;
+        case InferenceEngine::Precision::I32:
+            blob = InferenceEngine::make_shared_blob<int32_t>(desc);
+            break;
+        default:
+            SPDLOG_LOGGER_ERROR(dag_executor_logger, "Custom node: {} library returned output: {} with unsupported precision", getName(), tensor.name);
+            return StatusCode::NODE_LIBRARY_INVALID_PRECISION;
+        }
+        blob->allocate();
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        SPDLOG_LOGGER_ERROR(dag_executor_logger, "Custom node: {} output: {} blob creation failed; exception message: {}", getName(), tensor.name, e.what());
+        return StatusCode::NODE_LIBRARY_OUTPUTS_CORRUPTED;
+    } catch (std::logic_error& e) {
+        SPDLOG_LOGGER_ERROR(dag_executor_logger, "Custom node: {} output: {} blob creation failed; exception message: {}", getName(), tensor.name, e.what());
+        return StatusCode::NODE_LIBRARY_OUTPUTS_CORRUPTED;
+    }
+    if (blob->byteSize() != tensor.dataBytes) {
+        SPDLOG_LOGGER_ERROR(dag_executor_logger, "Custom node: {} output: {} has {} bytes while its shape: {} requires {} bytes",
+            getName(), tensor.name, tensor.dataBytes, TensorInfo::shapeToString(dims), blob->byteSize());
+        blob = nullptr;
+        return StatusCode::NODE_LIBRARY_OUTPUTS_CORRUPTED;
+    }
+    std::memcpy((void*)blob->buffer(), (void*)tensor.data, tensor.dataBytes);
+    return StatusCode::OK;
+}
+
+Status CustomNode::fetchResults(BlobMap& outputs) {
+    if (!this->executionStatus.ok()) {
+        SPDLOG_LOGGER_DEBUG(dag_executor_logger, "[Node: {}] Fetching results failed due to earlier execution failure", getName());
+        this->release();
+        return this->executionStatus;
+    }
+
+    // Fill outputs map with result blobs. Fetch only those that are required in following nodes.
+    for (const auto& node : this->next) {
+        for (const auto& pair : node.get().getMappingByDependency(*this)) {
+            const auto& outputName = pair.first;
+            if (outputs.count(outputName) == 1) {
+                continue;
+            }
+            const auto& realOutputName = getRealOutputName(outputName);
+            auto it = this->resultBlobs.find(realOutputName);
+            if (it == this->resultBlobs.end()) {
+                SPDLOG_LOGGER_ERROR(dag_executor_logger, "[Node: {}] Custom node library has not returned output: {}", getName(), realOutputName);
+                this->release();
+                return StatusCode::NODE_LIBRARY_MISSING_OUTPUT;
+            }
+            outputs.emplace(std::make_pair(outputName, it->second));
+            SPDLOG_LOGGER_DEBUG(dag_executor_logger, "[Node: {}]: Blob with name {} has been prepared", getName(), outputName);
+        }
+    }
+    this->release();
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
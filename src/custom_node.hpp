@@ -0,0 +1,75 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <inference_engine.hpp>
+#include <spdlog/spdlog.h>
+
+#include "custom_node_interface.h"
+#include "node.hpp"
+#include "node_library.hpp"
+
+namespace ovms {
+
+class CustomNode : public Node {
+    NodeLibrary library;
+    const parameters_t parameters;
+    const std::unordered_map<std::string, std::string> nodeOutputNameAlias;
+    std::shared_ptr<CNLIMWrapper> customNodeLibraryInternalManager;
+
+    std::unique_ptr<struct CustomNodeParam[]> libraryParameters;
+
+    // Outputs produced by library, keyed by library output name
+    BlobMap resultBlobs;
+    Status executionStatus;
+
+public:
+    CustomNode(const std::string& nodeName, const NodeLibrary& library, const parameters_t& parameters,
+        std::unordered_map<std::string, std::string> nodeOutputNameAlias = {},
+        std::shared_ptr<CNLIMWrapper> customNodeLibraryInternalManager = nullptr);
+
+    /**
+     * @brief Schedules library execution on custom node thread pool. Node notifies pipeline when library returns.
+     */
+    Status execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) override;
+
+    Status fetchResults(BlobMap& outputs) override;
+
+    void release() override {
+        SPDLOG_DEBUG("Releasing resources for node {}", getName());
+        this->resultBlobs.clear();
+    }
+
+protected:
+    std::unique_ptr<Node> clone() const override {
+        return std::make_unique<CustomNode>(getName(), library, parameters, nodeOutputNameAlias, customNodeLibraryInternalManager);
+    }
+
+private:
+    Status executeLibrary();
+    Status createOutputBlob(const struct CustomNodeTensor& tensor, InferenceEngine::Blob::Ptr& blob) const;
+    void* getInternalManagerPtr() const;
+
+    const std::string& getRealOutputName(const std::string& alias) const {
+        return nodeOutputNameAlias.count(alias) == 1 ? nodeOutputNameAlias.at(alias) : alias;
+    }
+};
+
+}  // namespace ovms
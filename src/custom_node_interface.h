@@ -0,0 +1,92 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <stdint.h>
+
+// Interface of custom node libraries used in DAG pipelines (node type "custom").
+// All functions return 0 on success, any other value is treated as an error.
+// Memory for outputs and tensor infos is allocated by the library and returned
+// back to it with release() once the server does not need it anymore.
+
+typedef enum {
+    UNSPECIFIED,
+    FP32,
+    FP16,
+    U8,
+    I8,
+    I16,
+    U16,
+    I32
+} CustomNodeTensorPrecision;
+
+struct CustomNodeTensor {
+    const char* name;
+    uint8_t* data;
+    uint64_t dataBytes;
+    uint64_t* dims;
+    uint64_t dimsCount;
+    CustomNodeTensorPrecision precision;
+};
+
+struct CustomNodeTensorInfo {
+    const char* name;
+    uint64_t dimsCount;
+    uint64_t* dims;
+    CustomNodeTensorPrecision precision;
+};
+
+struct CustomNodeParam {
+    const char *key, *value;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Called once per pipeline node when pipeline definition gets loaded. Library may store its internal state in customNodeLibraryInternalManager.
+ */
+int initialize(void** customNodeLibraryInternalManager, const struct CustomNodeParam* params, int paramsCount);
+
+/**
+ * @brief Called once per pipeline node when pipeline definition gets reloaded or retired.
+ */
+int deinitialize(void* customNodeLibraryInternalManager);
+
+/**
+ * @brief Processes inputs and allocates outputs. Called for each pipeline request, possibly concurrently.
+ */
+int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager);
+
+/**
+ * @brief Describes inputs expected by the library. Used during pipeline validation.
+ */
+int getInputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager);
+
+/**
+ * @brief Describes outputs produced by the library. Used during pipeline validation.
+ */
+int getOutputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager);
+
+/**
+ * @brief Frees memory allocated by the library in execute, getInputsInfo and getOutputsInfo.
+ */
+int release(void* ptr, void* customNodeLibraryInternalManager);
+
+#ifdef __cplusplus
+}
+#endif
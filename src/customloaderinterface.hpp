@@ -15,6 +15,9 @@
 //*****************************************************************************
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -111,7 +114,74 @@ public:
     virtual CustomLoaderStatus loaderDeInit() = 0;
 };
 
+/**
+     * @brief Model buffers returned by custom loader interface version 2.
+     * Model server keeps the buffers as long as the model uses them and then drops its references,
+     * so the deleters of shared pointers act as release callbacks. This allows loaders to return
+     * memory mapped files or buffers decrypted in place without copying them.
+     */
+struct CustomLoaderModelBuffers {
+    std::shared_ptr<const uint8_t> model;
+    size_t modelSize = 0;
+    std::shared_ptr<const uint8_t> weights;
+    size_t weightsSize = 0;
+
+    /**
+         * @brief Allocates weights buffer owned by model server, which loader can fill in chunks,
+         * e.g. from several threads decrypting parts of the weights file in parallel
+         *
+         * @param size of the weights
+         * @return pointer to the buffer to be filled before loadModelBuffers returns
+         */
+    uint8_t* allocateWeights(size_t size) {
+        std::shared_ptr<uint8_t> buffer(new uint8_t[size], std::default_delete<uint8_t[]>());
+        weights = buffer;
+        weightsSize = size;
+        return buffer.get();
+    }
+};
+
+/**
+     * @brief Custom loader interface version 2 base class.
+     * Instead of filling vectors, which model server copies again, loader returns buffers with shared ownership.
+     * Libraries implementing it shall export getCustomLoaderInterfaceVersion function returning
+     * CUSTOM_LOADER_INTERFACE_VERSION, otherwise the loader is treated as version 1.
+     */
+class CustomLoaderInterfaceV2 : public CustomLoaderInterface {
+public:
+    /**
+         * @brief Not used by model server for version 2 loaders
+         */
+    CustomLoaderStatus loadModel(const std::string& modelName,
+        const std::string& basePath,
+        const int version,
+        const std::string& loaderOptions,
+        std::vector<uint8_t>& modelBuffer,
+        std::vector<uint8_t>& weights) override {
+        return CustomLoaderStatus::INTERNAL_ERROR;
+    }
+
+    /**
+         * @brief Load the model by the custom loader
+         *
+         * @param model name required to be loaded - defined under model config in the config file
+         * @param base path where the required model files are present
+         * @param version of the model
+         * @param loader config parameters json as string
+         * @param model buffers to be set by the loader
+         * @return status (On success, the return value will specify the type of model (IR,ONNX,BLOB) returned in buffers)
+         */
+    virtual CustomLoaderStatus loadModelBuffers(const std::string& modelName,
+        const std::string& basePath,
+        const int version,
+        const std::string& loaderOptions,
+        CustomLoaderModelBuffers& buffers) = 0;
+};
+
+constexpr int CUSTOM_LOADER_INTERFACE_VERSION = 2;
+
 // the types of the class factories
 typedef CustomLoaderInterface* createCustomLoader_t();
+typedef int getCustomLoaderInterfaceVersion_t();
 
 }  // namespace ovms
@@ -16,14 +16,15 @@
 
 #include "customloaders.hpp"
 
+#include <dlfcn.h>
 #include <spdlog/spdlog.h>
 
 #include "customloaderinterface.hpp"
 
 namespace ovms {
 
-Status CustomLoaders::add(std::string name, std::shared_ptr<CustomLoaderInterface> loaderInterface, void* library) {
-    auto loaderIt = newCustomLoaderInterfacePtrs.emplace(name, std::make_pair(library, loaderInterface));
+Status CustomLoaders::add(std::string name, std::shared_ptr<CustomLoaderInterface> loaderInterface, void* library, int interfaceVersion) {
+    auto loaderIt = newCustomLoaderInterfacePtrs.emplace(name, CustomLoaderEntry{library, loaderInterface, interfaceVersion});
     // if the loader already exists, print an error message
     if (!loaderIt.second) {
         SPDLOG_ERROR("The loader {} already exists in the config file", name);
@@ -53,7 +54,26 @@ std::shared_ptr<CustomLoaderInterface> CustomLoaders::find(const std::string& na
         return nullptr;
     }
 
-    return (loaderIt->second).second;
+    return (loaderIt->second).loaderInterface;
+}
+
+std::shared_ptr<CustomLoaderInterfaceV2> CustomLoaders::findV2(const std::string& name) {
+    auto loaderIt = customLoaderInterfacePtrs.find(name);
+
+    if (loaderIt == customLoaderInterfacePtrs.end() || (loaderIt->second).interfaceVersion < 2) {
+        return nullptr;
+    }
+
+    // dynamic_cast is not reliable for classes created in libraries loaded with RTLD_LOCAL
+    return std::static_pointer_cast<CustomLoaderInterfaceV2>((loaderIt->second).loaderInterface);
+}
+
+int CustomLoaders::detectInterfaceVersion(void* library) {
+    auto getVersion = (getCustomLoaderInterfaceVersion_t*)dlsym(library, "getCustomLoaderInterfaceVersion");
+    if (getVersion == nullptr) {
+        return 1;
+    }
+    return getVersion();
 }
 
 Status CustomLoaders::move(const std::string& name) {
@@ -73,7 +93,7 @@ Status CustomLoaders::finalize() {
     // By now the remaining loaders in current list are not there in new config. Delete them
     for (auto it = customLoaderInterfacePtrs.begin(); it != customLoaderInterfacePtrs.end(); it++) {
         SPDLOG_INFO("Loader {} is not there in new list.. deleting the same", it->first);
-        auto loaderPtr = (it->second).second;
+        auto loaderPtr = (it->second).loaderInterface;
         loaderPtr->loaderDeInit();
     }
 
@@ -40,8 +40,14 @@ private:
          */
     CustomLoaders(const CustomLoaders&) = delete;
 
-    std::map<std::string, std::pair<void*, std::shared_ptr<CustomLoaderInterface>>> customLoaderInterfacePtrs;
-    std::map<std::string, std::pair<void*, std::shared_ptr<CustomLoaderInterface>>> newCustomLoaderInterfacePtrs;
+    struct CustomLoaderEntry {
+        void* library;
+        std::shared_ptr<CustomLoaderInterface> loaderInterface;
+        int interfaceVersion;
+    };
+
+    std::map<std::string, CustomLoaderEntry> customLoaderInterfacePtrs;
+    std::map<std::string, CustomLoaderEntry> newCustomLoaderInterfacePtrs;
 
     std::vector<std::string> currentCustomLoaderNames;
 
@@ -59,7 +65,7 @@ public:
          * 
          * @return status 
          */
-    Status add(std::string name, std::shared_ptr<CustomLoaderInterface> loaderInsterface, void* library);
+    Status add(std::string name, std::shared_ptr<CustomLoaderInterface> loaderInsterface, void* library, int interfaceVersion = 1);
 
     /**
          * @brief remove an existing customLoader referenced by it's name
@@ -75,6 +81,20 @@ public:
          */
     std::shared_ptr<CustomLoaderInterface> find(const std::string& name);
 
+    /**
+         * @brief find an existing customLoader implementing interface version 2
+         * 
+         * @return pointer to customloader Interface if found and implements version 2, else NULL
+         */
+    std::shared_ptr<CustomLoaderInterfaceV2> findV2(const std::string& name);
+
+    /**
+         * @brief detects interface version implemented by customloader library
+         * 
+         * @return version exported by the library or 1 if library does not export it
+         */
+    static int detectInterfaceVersion(void* library);
+
     /**
          * @brief move the existing loader from serviced map to new map.
          * 
@@ -0,0 +1,82 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "customnodelibrarymanager.hpp"
+
+#include <mutex>
+
+#include <dlfcn.h>
+
+#include "filesystem.hpp"
+#include "logging.hpp"
+
+namespace ovms {
+
+Status CustomNodeLibraryManager::loadLibrary(const std::string& name, const std::string& basePath) {
+    if (FileSystem::isPathEscaped(basePath)) {
+        SPDLOG_LOGGER_ERROR(modelmanager_logger, "Path {} escape with .. is forbidden.", basePath);
+        return StatusCode::PATH_INVALID;
+    }
+
+    std::unique_lock lock(librariesMtx);
+    auto it = libraries.find(name);
+    if (it != libraries.end()) {
+        if (it->second.first == basePath) {
+            SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Custom node library name: {} is already loaded", name);
+            return StatusCode::OK;
+        }
+        SPDLOG_LOGGER_ERROR(modelmanager_logger, "Custom node library name: {} is already loaded from different path: {}", name, it->second.first);
+        return StatusCode::NODE_LIBRARY_ALREADY_LOADED;
+    }
+
+    SPDLOG_LOGGER_INFO(modelmanager_logger, "Loading custom node library name: {}; base_path: {}", name, basePath);
+    void* handle = dlopen(basePath.c_str(), RTLD_LAZY | RTLD_LOCAL);
+    char* error = dlerror();
+    if (handle == nullptr) {
+        SPDLOG_LOGGER_ERROR(modelmanager_logger, "Cannot open custom node library name: {}; base_path: {}; error: {}", name, basePath, error ? error : "");
+        return StatusCode::NODE_LIBRARY_LOAD_FAILED_OPEN;
+    }
+
+    NodeLibrary library;
+    library.initialize = reinterpret_cast<initialize_fn>(dlsym(handle, "initialize"));
+    library.deinitialize = reinterpret_cast<deinitialize_fn>(dlsym(handle, "deinitialize"));
+    library.execute = reinterpret_cast<execute_fn>(dlsym(handle, "execute"));
+    library.getInputsInfo = reinterpret_cast<metadata_fn>(dlsym(handle, "getInputsInfo"));
+    library.getOutputsInfo = reinterpret_cast<metadata_fn>(dlsym(handle, "getOutputsInfo"));
+    library.release = reinterpret_cast<release_fn>(dlsym(handle, "release"));
+    error = dlerror();
+    if (error || !library.isValid()) {
+        SPDLOG_LOGGER_ERROR(modelmanager_logger, "Cannot load symbols of custom node library name: {}; base_path: {}; error: {}", name, basePath, error ? error : "");
+        dlclose(handle);
+        return StatusCode::NODE_LIBRARY_LOAD_FAILED_SYM;
+    }
+
+    libraries.emplace(name, std::make_pair(basePath, library));
+    SPDLOG_LOGGER_INFO(modelmanager_logger, "Successfully loaded custom node library name: {}; base_path: {}", name, basePath);
+    return StatusCode::OK;
+}
+
+Status CustomNodeLibraryManager::getLibrary(const std::string& name, NodeLibrary& library) const {
+    std::shared_lock lock(librariesMtx);
+    auto it = libraries.find(name);
+    if (it == libraries.end()) {
+        SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Custom node library name: {} is not loaded", name);
+        return StatusCode::NODE_LIBRARY_MISSING;
+    }
+    library = it->second.second;
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
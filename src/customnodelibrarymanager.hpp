@@ -0,0 +1,58 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+
+#include "node_library.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Keeps shared libraries used by custom nodes in DAG pipelines
+ */
+class CustomNodeLibraryManager {
+    // library name -> (base path, library)
+    std::map<std::string, std::pair<std::string, NodeLibrary>> libraries;
+    mutable std::shared_mutex librariesMtx;
+
+public:
+    CustomNodeLibraryManager() = default;
+    ~CustomNodeLibraryManager() = default;
+
+    /**
+     * @brief Opens shared library and resolves symbols defined in custom_node_interface.h
+     *
+     * Libraries are never unloaded since pipelines created earlier may still refer to them.
+     * Loading library with the same name and path again is a no-op.
+     *
+     * @return Status
+     */
+    Status loadLibrary(const std::string& name, const std::string& basePath);
+
+    /**
+     * @brief Finds already loaded library by name
+     *
+     * @return Status
+     */
+    Status getLibrary(const std::string& name, NodeLibrary& library) const;
+};
+
+}  // namespace ovms
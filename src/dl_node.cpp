@@ -15,6 +15,7 @@
 //*****************************************************************************
 #include "dl_node.hpp"
 
+#include <chrono>
 #include <map>
 #include <utility>
 
@@ -25,6 +26,7 @@
 #include "ov_utils.hpp"
 #include "ovinferrequestsqueue.hpp"
 #include "prediction_service_utils.hpp"
+#include "tracing.hpp"
 
 namespace ovms {
 
@@ -38,12 +40,24 @@ Status DLNode::execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQ
             notifyEndQueue.push(*this);
             return status;
         }
+        if (this->resultsFromCache) {
+            this->inputBlobs.clear();
+            notifyEndQueue.push(*this);
+            return status;
+        }
     }
     auto streamId = this->nodeStreamIdGuard->tryGetId(WAIT_FOR_STREAM_ID_TIMEOUT_MICROSECONDS);
     if (!streamId) {
         SPDLOG_DEBUG("[Node: {}] Could not acquire stream Id right away", getName());
+        if (TRACING_ENABLED && this->streamWaitStartNs == 0) {
+            this->streamWaitStartNs = getTraceTimestampNs();
+        }
         return StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET;
     }
+    if (TRACING_ENABLED && this->streamWaitStartNs != 0) {
+        recordSpan(TraceSpan::NODE_STREAM_WAIT, this->streamWaitStartNs, getTraceTimestampNs() - this->streamWaitStartNs, getName());
+        this->streamWaitStartNs = 0;
+    }
     auto& inferRequestsQueue = this->model->getInferRequestsQueue();
     auto& inferRequest = inferRequestsQueue.getInferRequest(streamId.value());
     status = setInputsForInference(inferRequest);
@@ -77,6 +91,16 @@ Status DLNode::requestExecuteRequiredResources() {
     if (!status.ok()) {
         return status;
     }
+    auto resultCache = this->model->getResultCache();
+    if (resultCache != nullptr) {
+        // Do not wait for the same results computed by another node since it may be scheduled by the same pipeline thread
+        const auto key = ResultCache::createKey(this->inputBlobs, this->model->getVersion());
+        if (resultCache->lookup(key, this->cachedResults, this->resultCacheMissGuard, false)) {
+            SPDLOG_DEBUG("[Node: {}] Results found in cache of model: {}", getName(), modelName);
+            this->resultsFromCache = true;
+            return status;
+        }
+    }
     auto& inferRequestsQueue = this->model->getInferRequestsQueue();
     this->nodeStreamIdGuard = std::make_unique<NodeStreamIdGuard>(inferRequestsQueue);
     return status;
@@ -113,8 +137,11 @@ Status DLNode::setInputsForInference(InferenceEngine::InferRequest& infer_reques
 Status DLNode::executeInference(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue, InferenceEngine::InferRequest& infer_request) {
     try {
         SPDLOG_DEBUG("Setting completion callback for node name: {}", this->getName());
-        infer_request.SetCompletionCallback([this, &notifyEndQueue, &infer_request]() {
+        auto inferenceStart = std::chrono::steady_clock::now();
+        infer_request.SetCompletionCallback([this, &notifyEndQueue, &infer_request, inferenceStart]() {
             SPDLOG_DEBUG("Completion callback received for node name: {}", this->getName());
+            this->model->updateInferenceLatencyEstimate(
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - inferenceStart).count());
             // After inference is completed, input blobs are not needed anymore
             this->inputBlobs.clear();
             notifyEndQueue.push(*this);
@@ -145,6 +172,12 @@ Status DLNode::fetchResults(BlobMap& outputs) {
         return StatusCode::UNKNOWN_ERROR;
     }
 
+    if (this->resultsFromCache) {
+        auto status = fetchCachedResults(outputs);
+        this->release();
+        return status;
+    }
+
     // Get infer request corresponding to this node model
     auto streamId = this->nodeStreamIdGuard->tryGetId();
     if (!streamId) {
@@ -163,6 +196,15 @@ Status DLNode::fetchResults(BlobMap& outputs) {
         return status;
     }
 
+    if (this->resultCacheMissGuard != nullptr) {
+        auto status = cacheResults(infer_request);
+        if (status.ok()) {
+            status = fetchCachedResults(outputs);
+        }
+        this->release();
+        return status;
+    }
+
     // Fill outputs map with result blobs. Fetch only those that are required in following nodes.
     for (const auto& node : this->next) {
         for (const auto& pair : node.get().getMappingByDependency(*this)) {
@@ -183,7 +225,11 @@ Status DLNode::fetchResults(BlobMap& outputs) {
                 SPDLOG_DEBUG("[Node: {}] Creating copy of blob from model: {}, inferRequestStreamId: {}, blobName: {}",
                     getName(), modelName, streamId.value(), realModelOutputName);
                 InferenceEngine::Blob::Ptr copiedBlob;
-                auto status = blobClone(copiedBlob, blob);
+                Status status;
+                {
+                    ScopedSpan span(TraceSpan::BLOB_CLONE, getName());
+                    status = blobClone(copiedBlob, blob);
+                }
                 if (!status.ok()) {
                     SPDLOG_DEBUG("Could not clone result blob; node name: {}; model name: {}; output: {}",
                         getName(),
@@ -205,6 +251,57 @@ Status DLNode::fetchResults(BlobMap& outputs) {
     return StatusCode::OK;
 }
 
+Status DLNode::cacheResults(InferenceEngine::InferRequest& infer_request) {
+    // All outputs are cached so that the entry can serve nodes of pipelines with different connections
+    cached_outputs_t results;
+    for (const auto& [name, info] : this->model->getOutputsInfo()) {
+        InferenceEngine::Blob::Ptr copiedBlob;
+        try {
+            auto status = blobClone(copiedBlob, infer_request.GetBlob(info->getName()));
+            if (!status.ok()) {
+                SPDLOG_DEBUG("Could not clone result blob; node name: {}; model name: {}; output: {}",
+                    getName(),
+                    this->modelName,
+                    info->getName());
+                return status;
+            }
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+            SPDLOG_DEBUG("[Node: {}] Error during getting blob {}; exception message: {}", getName(), status.string(), e.what());
+            return status;
+        }
+        results.emplace(info->getName(), std::move(copiedBlob));
+    }
+    this->cachedResults = results;
+    this->resultCacheMissGuard->commit(std::move(results));
+    this->resultCacheMissGuard.reset();
+    return StatusCode::OK;
+}
+
+Status DLNode::fetchCachedResults(BlobMap& outputs) {
+    for (const auto& node : this->next) {
+        for (const auto& pair : node.get().getMappingByDependency(*this)) {
+            const auto& output_name = pair.first;
+            if (outputs.count(output_name) == 1) {
+                continue;
+            }
+            std::string realModelOutputName;
+            if (!getRealOutputName(output_name, &realModelOutputName).ok()) {
+                SPDLOG_WARN("[Node: {}] Cannot find real model output name for alias{}", getName(), output_name);
+                return StatusCode::INTERNAL_ERROR;
+            }
+            auto it = this->cachedResults.find(realModelOutputName);
+            if (it == this->cachedResults.end()) {
+                SPDLOG_DEBUG("[Node: {}] Cached results of model: {} are missing output: {}", getName(), modelName, realModelOutputName);
+                return StatusCode::INTERNAL_ERROR;
+            }
+            outputs.emplace(std::make_pair(output_name, it->second));
+            SPDLOG_DEBUG("[Node: {}]: Blob with name {} has been prepared", getName(), output_name);
+        }
+    }
+    return StatusCode::OK;
+}
+
 Status DLNode::validate(const InferenceEngine::Blob::Ptr& blob, const TensorInfo& info) {
     if (info.getPrecision() != blob->getTensorDesc().getPrecision()) {
         std::stringstream ss;
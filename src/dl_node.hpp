@@ -26,6 +26,7 @@
 #include "modelinstanceunloadguard.hpp"
 #include "node.hpp"
 #include "nodestreamidguard.hpp"
+#include "resultcache.hpp"
 
 namespace ovms {
 
@@ -41,6 +42,15 @@ class DLNode : public Node {
     std::unique_ptr<NodeStreamIdGuard> nodeStreamIdGuard;
     std::unique_ptr<ModelInstanceUnloadGuard> modelUnloadGuard;
 
+    // Set when node is responsible for putting its results into model results cache
+    std::unique_ptr<ResultCacheMissGuard> resultCacheMissGuard;
+    // All model outputs keyed by real output name, filled when results are served from or put into cache
+    cached_outputs_t cachedResults;
+    bool resultsFromCache = false;
+
+    // Timestamp of the first attempt to get stream id, set only when node had to wait for it
+    uint64_t streamWaitStartNs = 0;
+
 public:
     DLNode(const std::string& nodeName, const std::string& modelName, std::optional<model_version_t> modelVersion,
         ModelManager& modelManager,
@@ -76,11 +86,19 @@ public:
 
     void release() override {
         SPDLOG_DEBUG("Releasing resources for node {}", getName());
+        this->resultCacheMissGuard.reset();
+        this->cachedResults.clear();
+        this->resultsFromCache = false;
         this->nodeStreamIdGuard.reset();
         this->model.reset();
         this->modelUnloadGuard.reset();
     }
 
+protected:
+    std::unique_ptr<Node> clone() const override {
+        return std::make_unique<DLNode>(getName(), modelName, modelVersion, modelManager, nodeOutputNameAlias);
+    }
+
 private:
     Status getRealInputName(const std::string& alias, std::string* result) const {
         if (this->model->getInputsInfo().count(alias) == 0) {
@@ -100,6 +118,8 @@ private:
     }
 
     Status requestExecuteRequiredResources();
+    Status cacheResults(InferenceEngine::InferRequest& infer_request);
+    Status fetchCachedResults(BlobMap& outputs);
     Status setInputsForInference(InferenceEngine::InferRequest& infer_request);
     Status executeInference(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue, InferenceEngine::InferRequest& infer_request);
 };
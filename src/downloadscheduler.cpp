@@ -0,0 +1,102 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "downloadscheduler.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include "config.hpp"
+
+namespace ovms {
+
+namespace {
+thread_local DownloadPriority currentPriority = DownloadPriority::NORMAL;
+}  // namespace
+
+DownloadScheduler::DownloadScheduler(uint maxConnections, uint64_t maxBytesPerSecond) :
+    maxConnections(maxConnections > 0 ? maxConnections : std::numeric_limits<uint>::max()),
+    maxBytesPerSecond(maxBytesPerSecond) {}
+
+DownloadScheduler& DownloadScheduler::instance() {
+    static DownloadScheduler scheduler(
+        Config::instance().cloudDownloadMaxConnections(),
+        uint64_t(Config::instance().cloudDownloadMaxBandwidthMb()) * 1024 * 1024);
+    return scheduler;
+}
+
+void DownloadScheduler::acquire(DownloadPriority priority) {
+    std::unique_lock lock(mtx);
+    const auto ticket = std::make_pair(-static_cast<int>(priority), nextTicket++);
+    waiting.insert(ticket);
+    connectionReleased.wait(lock, [this, &ticket]() {
+        return activeConnections < maxConnections && *waiting.begin() == ticket;
+    });
+    waiting.erase(waiting.begin());
+    activeConnections++;
+    // Next waiting download may get a connection as well
+    if (!waiting.empty() && activeConnections < maxConnections) {
+        connectionReleased.notify_all();
+    }
+}
+
+void DownloadScheduler::release() {
+    std::unique_lock lock(mtx);
+    activeConnections--;
+    if (!waiting.empty()) {
+        connectionReleased.notify_all();
+    }
+}
+
+void DownloadScheduler::throttle(size_t bytes) {
+    if (maxBytesPerSecond == 0) {
+        return;
+    }
+    clock::time_point until;
+    {
+        std::unique_lock lock(throttleMtx);
+        // Each received chunk reserves time of transfer at the limit, after transfers reserved earlier
+        throttledUntil = std::max(throttledUntil, clock::now()) +
+                         std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(double(bytes) / maxBytesPerSecond));
+        until = throttledUntil;
+    }
+    std::this_thread::sleep_until(until);
+}
+
+uint DownloadScheduler::getActiveConnections() {
+    std::unique_lock lock(mtx);
+    return activeConnections;
+}
+
+size_t DownloadScheduler::getWaitingCount() {
+    std::unique_lock lock(mtx);
+    return waiting.size();
+}
+
+DownloadPriority DownloadScheduler::getCurrentPriority() {
+    return currentPriority;
+}
+
+DownloadScheduler::PriorityScope::PriorityScope(DownloadPriority priority) :
+    previous(currentPriority) {
+    currentPriority = priority;
+}
+
+DownloadScheduler::PriorityScope::~PriorityScope() {
+    currentPriority = previous;
+}
+
+}  // namespace ovms
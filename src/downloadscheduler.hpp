@@ -0,0 +1,131 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace ovms {
+
+enum class DownloadPriority {
+    NORMAL,
+    /**
+     * @brief Downloads of models used by pipelines or serving requests
+     */
+    HIGH
+};
+
+/**
+ * @brief Process wide limits of concurrent connections and total throughput of downloads from cloud storage.
+ * Downloads of all models share them, so loading many models at once does not saturate the network and disks.
+ * Free connections are granted to waiting downloads in priority order, then in order of arrival.
+ */
+class DownloadScheduler {
+    using clock = std::chrono::steady_clock;
+
+    const uint maxConnections;
+    const uint64_t maxBytesPerSecond;
+
+    std::mutex mtx;
+    std::condition_variable connectionReleased;
+    uint activeConnections = 0;
+    uint64_t nextTicket = 0;
+    /**
+     * @brief Waiting downloads ordered by negated priority and ticket, the first one is granted the next connection
+     */
+    std::set<std::pair<int, uint64_t>> waiting;
+
+    std::mutex throttleMtx;
+    clock::time_point throttledUntil;
+
+public:
+    /**
+     * @brief Construct scheduler
+     *
+     * @param maxConnections limit of concurrent connections, 0 means unlimited
+     * @param maxBytesPerSecond limit of total throughput, 0 means unlimited
+     */
+    DownloadScheduler(uint maxConnections, uint64_t maxBytesPerSecond);
+
+    /**
+     * @brief Gets scheduler with limits set in server configuration
+     */
+    static DownloadScheduler& instance();
+
+    /**
+     * @brief Blocks until connection is available for download of given priority
+     */
+    void acquire(DownloadPriority priority);
+
+    void release();
+
+    /**
+     * @brief Blocks for as long as needed to keep total throughput within the limit after receiving given number of bytes
+     */
+    void throttle(size_t bytes);
+
+    uint getMaxConnections() const {
+        return maxConnections;
+    }
+
+    uint getActiveConnections();
+
+    size_t getWaitingCount();
+
+    /**
+     * @brief Gets priority of downloads started by current thread
+     */
+    static DownloadPriority getCurrentPriority();
+
+    /**
+     * @brief Sets priority of downloads started by current thread until the end of scope
+     */
+    class PriorityScope {
+        const DownloadPriority previous;
+
+    public:
+        explicit PriorityScope(DownloadPriority priority);
+        ~PriorityScope();
+    };
+
+    /**
+     * @brief Holds connection until the end of scope, does nothing without scheduler
+     */
+    class Connection {
+        DownloadScheduler* scheduler;
+
+    public:
+        Connection(DownloadScheduler* scheduler, DownloadPriority priority) :
+            scheduler(scheduler) {
+            if (scheduler != nullptr) {
+                scheduler->acquire(priority);
+            }
+        }
+        ~Connection() {
+            if (scheduler != nullptr) {
+                scheduler->release();
+            }
+        }
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+    };
+};
+
+}  // namespace ovms
@@ -40,7 +40,11 @@
 #include <vector>
 
 #include <assert.h>
+#include <fcntl.h>
 #include <rapidjson/document.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "../../customloaderinterface.hpp"
 
@@ -68,15 +72,16 @@ typedef std::pair<std::string, int> model_id_t;
  * usage of various APIs defined in base class, parse loader specific
  * parameters from the config file. 
  *
- * It reads the model files and returns the buffers to be loaded by the 
- * model server.  
+ * It maps the model files to memory and returns the mappings to be loaded by the 
+ * model server without copying them. Mappings are released once the model server
+ * does not need them anymore. It implements custom loader interface version 2.
  *
  * Also, based on the contents on <model>.status file, it black lists the model
  * or removes the model from blacklisting. During the periodic check on model 
  * loader will unload/reload model based on blacklist.
  */
 
-class custSampleLoader : public CustomLoaderInterface {
+class custSampleLoader : public CustomLoaderInterfaceV2 {
 private:
     std::vector<model_id_t> models_loaded;
     std::map<model_id_t, std::string> models_watched;
@@ -88,8 +93,9 @@ protected:
     int extract_input_params(const std::string& basePath, int version, const std::string& loaderOptions,
         std::string& binFile, std::string& modelFile, std::string& enableFile, int& modelType);
 
-    int load_files(std::string& binFile, std::string& modelFile, int modelType,
-        std::vector<uint8_t>& model, std::vector<uint8_t>& weghts);
+    int map_file(const std::string& fileName, std::shared_ptr<const uint8_t>& buffer, size_t& size);
+
+    int load_files(std::string& binFile, std::string& modelFile, int modelType, CustomLoaderModelBuffers& buffers);
 
     // Variables needed to manage the periodic thread.
     std::mutex cv_m;
@@ -106,8 +112,8 @@ public:
     CustomLoaderStatus loaderInit(const std::string& loader_path);
     CustomLoaderStatus loaderDeInit();
     CustomLoaderStatus unloadModel(const std::string& modelName, const int version);
-    CustomLoaderStatus loadModel(const std::string& modelName, const std::string& basePath, const int version,
-        const std::string& loaderOptions, std::vector<uint8_t>& model, std::vector<uint8_t>& weights);
+    CustomLoaderStatus loadModelBuffers(const std::string& modelName, const std::string& basePath, const int version,
+        const std::string& loaderOptions, CustomLoaderModelBuffers& buffers);
     CustomLoaderStatus getModelBlacklistStatus(const std::string& modelName, const int version);
     CustomLoaderStatus retireModel(const std::string& modelName);
 
@@ -125,6 +131,10 @@ extern "C" CustomLoaderInterface* createCustomLoader() {
     return new custSampleLoader();
 }
 
+extern "C" int getCustomLoaderInterfaceVersion() {
+    return CUSTOM_LOADER_INTERFACE_VERSION;
+}
+
 custSampleLoader::custSampleLoader() {
     std::cout << "custSampleLoader: Instance of Custom SampleLoader created" << std::endl;
 }
@@ -140,33 +150,46 @@ CustomLoaderStatus custSampleLoader::loaderInit(const std::string& loader_path)
     return CustomLoaderStatus::OK;
 }
 
-// Helper function to load the binary files
-int custSampleLoader::load_files(std::string& binFile, std::string& modelFile, int modelType,
-    std::vector<uint8_t>& model, std::vector<uint8_t>& weights) {
-
-    std::streampos size;
+// Helper function to map the file to memory. Mapping is released when the last reference to the buffer is dropped
+int custSampleLoader::map_file(const std::string& fileName, std::shared_ptr<const uint8_t>& buffer, size_t& size) {
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cout << "Unable to open file: " << fileName << std::endl;
+        return SAMPLE_LOADER_ERROR;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        std::cout << "Unable to read size of file: " << fileName << std::endl;
+        close(fd);
+        return SAMPLE_LOADER_ERROR;
+    }
+    size_t length = fileStat.st_size;
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        std::cout << "Unable to map file: " << fileName << std::endl;
+        return SAMPLE_LOADER_ERROR;
+    }
+    buffer = std::shared_ptr<const uint8_t>(static_cast<const uint8_t*>(address), [length](const uint8_t* address) {
+        munmap(const_cast<uint8_t*>(address), length);
+    });
+    size = length;
+    return SAMPLE_LOADER_OK;
+}
 
+// Helper function to load the model files
+int custSampleLoader::load_files(std::string& binFile, std::string& modelFile, int modelType, CustomLoaderModelBuffers& buffers) {
     // if the model is a onnx or blob type, the bin file will not be present.
-    // skip parsing the bin file and return empty weights
+    // skip mapping the bin file and return empty weights
     if (modelType == SAMPLE_LOADER_IR_MODEL) {
-        std::ifstream bfile(binFile, std::ios::in | std::ios::binary);
-        if (bfile.is_open()) {
-            weights.clear();
-            std::for_each(std::istreambuf_iterator<char>(bfile), std::istreambuf_iterator<char>(),
-                [&weights](const char c) { weights.push_back(c); });
-        } else {
-            std::cout << "Unable to open bin file: " << binFile << std::endl;
+        if (map_file(binFile, buffers.weights, buffers.weightsSize) != SAMPLE_LOADER_OK) {
+            std::cout << "Unable to map bin file: " << binFile << std::endl;
             return SAMPLE_LOADER_ERROR;
         }
     }
 
-    std::ifstream xfile(modelFile, std::ios::in | std::ios::binary);
-    if (xfile.is_open()) {
-        model.clear();
-        std::for_each(std::istreambuf_iterator<char>(xfile), std::istreambuf_iterator<char>(),
-            [&model](const char c) { model.push_back(c); });
-    } else {
-        std::cout << "Unable to open model file: " << modelFile << std::endl;
+    if (map_file(modelFile, buffers.model, buffers.modelSize) != SAMPLE_LOADER_OK) {
+        std::cout << "Unable to map model file: " << modelFile << std::endl;
         return SAMPLE_LOADER_ERROR;
     }
     return SAMPLE_LOADER_OK;
@@ -310,10 +333,10 @@ void custSampleLoader::watcherJoin() {
 
 /* 
  * From the custom loader options extract the model file name and other needed information and
- * load the model and optional bin file into buffers and return
+ * map the model and optional bin file to memory and return
  */
-CustomLoaderStatus custSampleLoader::loadModel(const std::string& modelName, const std::string& basePath, const int version,
-    const std::string& loaderOptions, std::vector<uint8_t>& model, std::vector<uint8_t>& weights) {
+CustomLoaderStatus custSampleLoader::loadModelBuffers(const std::string& modelName, const std::string& basePath, const int version,
+    const std::string& loaderOptions, CustomLoaderModelBuffers& buffers) {
     std::cout << "custSampleLoader: Custom loadModel loading model: " << modelName << std::endl;
 
     std::string binFile;
@@ -330,7 +353,7 @@ CustomLoaderStatus custSampleLoader::loadModel(const std::string& modelName, con
     }
 
     // load models
-    ret = load_files(binFile, modelFile, modelType, model, weights);
+    ret = load_files(binFile, modelFile, modelType, buffers);
     if (ret != SAMPLE_LOADER_OK) {
         std::cout << "custSampleLoader: Could not read model files" << std::endl;
         return CustomLoaderStatus::INTERNAL_ERROR;
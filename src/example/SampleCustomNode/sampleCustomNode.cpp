@@ -0,0 +1,102 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "../../custom_node_interface.h"
+
+// Sample custom node library adding "add_value" and then subtracting "sub_value" parameters
+// from each element of FP32 input "input_numbers". Result is returned in output "output_numbers".
+
+static const char* INPUT_NAME = "input_numbers";
+static const char* OUTPUT_NAME = "output_numbers";
+static const uint64_t ELEMENTS_COUNT = 10;
+
+static float getParam(const struct CustomNodeParam* params, int paramsCount, const std::string& key, float defaultValue) {
+    for (int i = 0; i < paramsCount; i++) {
+        if (key == params[i].key) {
+            return std::stof(params[i].value);
+        }
+    }
+    return defaultValue;
+}
+
+int initialize(void** customNodeLibraryInternalManager, const struct CustomNodeParam* params, int paramsCount) {
+    *customNodeLibraryInternalManager = nullptr;
+    return 0;
+}
+
+int deinitialize(void* customNodeLibraryInternalManager) {
+    return 0;
+}
+
+int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
+    const struct CustomNodeTensor* input = nullptr;
+    for (int i = 0; i < inputsCount; i++) {
+        if (std::strcmp(inputs[i].name, INPUT_NAME) == 0) {
+            input = &inputs[i];
+        }
+    }
+    if (input == nullptr || input->precision != FP32) {
+        return 1;
+    }
+    const float addValue = getParam(params, paramsCount, "add_value", 0.0f);
+    const float subValue = getParam(params, paramsCount, "sub_value", 0.0f);
+
+    *outputsCount = 1;
+    *outputs = (struct CustomNodeTensor*)malloc(sizeof(struct CustomNodeTensor));
+    struct CustomNodeTensor& output = (*outputs)[0];
+    output.name = OUTPUT_NAME;
+    output.dataBytes = input->dataBytes;
+    output.data = (uint8_t*)malloc(output.dataBytes);
+    output.dimsCount = input->dimsCount;
+    output.dims = (uint64_t*)malloc(output.dimsCount * sizeof(uint64_t));
+    std::memcpy(output.dims, input->dims, output.dimsCount * sizeof(uint64_t));
+    output.precision = FP32;
+
+    const float* inputData = (const float*)input->data;
+    float* outputData = (float*)output.data;
+    for (uint64_t i = 0; i < input->dataBytes / sizeof(float); i++) {
+        outputData[i] = inputData[i] + addValue - subValue;
+    }
+    return 0;
+}
+
+static int getInfo(const char* name, struct CustomNodeTensorInfo** info, int* infoCount) {
+    *infoCount = 1;
+    *info = (struct CustomNodeTensorInfo*)malloc(sizeof(struct CustomNodeTensorInfo));
+    (*info)->name = name;
+    (*info)->dimsCount = 2;
+    (*info)->dims = (uint64_t*)malloc((*info)->dimsCount * sizeof(uint64_t));
+    (*info)->dims[0] = 1;
+    (*info)->dims[1] = ELEMENTS_COUNT;
+    (*info)->precision = FP32;
+    return 0;
+}
+
+int getInputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
+    return getInfo(INPUT_NAME, info, infoCount);
+}
+
+int getOutputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
+    return getInfo(OUTPUT_NAME, info, infoCount);
+}
+
+int release(void* ptr, void* customNodeLibraryInternalManager) {
+    free(ptr);
+    return 0;
+}
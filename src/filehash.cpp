@@ -0,0 +1,108 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "filehash.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace ovms {
+
+const uint64_t FNV_PRIME = 1099511628211ULL;
+const size_t READ_CHUNK_SIZE = 1024 * 1024;
+
+void Fnv1aHash::update(const char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+}
+
+void Fnv1aHash::update(const std::string& data) {
+    const uint64_t size = data.size();
+    update(reinterpret_cast<const char*>(&size), sizeof(size));
+    update(data.data(), data.size());
+}
+
+bool Fnv1aHash::updateWithFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.good()) {
+        return false;
+    }
+    std::vector<char> buffer(READ_CHUNK_SIZE);
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        update(buffer.data(), file.gcount());
+    }
+    return file.eof();
+}
+
+std::string Fnv1aHash::toHexString() const {
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ss.str();
+}
+
+FileDigestCache& FileDigestCache::instance() {
+    static FileDigestCache cache;
+    return cache;
+}
+
+static bool statFile(const std::string& path, struct stat& fileStat) {
+    return stat(path.c_str(), &fileStat) == 0 && S_ISREG(fileStat.st_mode);
+}
+
+static bool isSameFile(const struct stat& lhs, const struct stat& rhs) {
+    return lhs.st_dev == rhs.st_dev && lhs.st_ino == rhs.st_ino && lhs.st_size == rhs.st_size &&
+           lhs.st_mtim.tv_sec == rhs.st_mtim.tv_sec && lhs.st_mtim.tv_nsec == rhs.st_mtim.tv_nsec;
+}
+
+bool FileDigestCache::getDigest(const std::string& path, uint64_t& digest) {
+    struct stat fileStat;
+    if (!statFile(path, fileStat)) {
+        return false;
+    }
+    const int64_t modificationTimeNs = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1'000'000'000 + fileStat.st_mtim.tv_nsec;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = entries.find(path);
+        if (it != entries.end() && it->second.device == fileStat.st_dev && it->second.inode == fileStat.st_ino &&
+            it->second.size == fileStat.st_size && it->second.modificationTimeNs == modificationTimeNs) {
+            digest = it->second.digest;
+            return true;
+        }
+    }
+    // File is hashed without holding the lock, so that loads of other models are not blocked
+    Fnv1aHash hash;
+    fileReads++;
+    if (!hash.updateWithFile(path)) {
+        return false;
+    }
+    digest = hash.get();
+    struct stat statAfterRead;
+    // Digest of file modified while being read is not remembered
+    if (statFile(path, statAfterRead) && isSameFile(fileStat, statAfterRead)) {
+        std::lock_guard<std::mutex> lock(mtx);
+        entries[path] = Entry{static_cast<uint64_t>(fileStat.st_dev), static_cast<uint64_t>(fileStat.st_ino),
+            static_cast<int64_t>(fileStat.st_size), modificationTimeNs, digest};
+    }
+    return true;
+}
+
+}  // namespace ovms
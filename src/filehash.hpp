@@ -0,0 +1,93 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ovms {
+
+/**
+ * @brief Incremental 64-bit FNV-1a hash used to identify content of model files in local caches.
+ * It is not a cryptographic hash.
+ */
+class Fnv1aHash {
+    uint64_t hash = 14695981039346656037ULL;
+
+public:
+    void update(const char* data, size_t size);
+
+    /**
+     * @brief Hashes string together with its length so that consecutive fields can not be confused
+     */
+    void update(const std::string& data);
+
+    /**
+     * @brief Hashes whole file content read in chunks
+     *
+     * @return false if file could not be read
+     */
+    bool updateWithFile(const std::string& path);
+
+    uint64_t get() const {
+        return hash;
+    }
+
+    /**
+     * @brief Gets hash as 16 characters hex string
+     */
+    std::string toHexString() const;
+};
+
+/**
+ * @brief Remembers content hash of model files, so that files are read only when they change.
+ * File is considered unchanged while its device, inode, size and modification time stay the same.
+ */
+class FileDigestCache {
+    struct Entry {
+        uint64_t device;
+        uint64_t inode;
+        int64_t size;
+        int64_t modificationTimeNs;
+        uint64_t digest;
+    };
+
+    std::mutex mtx;
+    std::unordered_map<std::string, Entry> entries;
+    std::atomic<uint64_t> fileReads = 0;
+
+public:
+    static FileDigestCache& instance();
+
+    /**
+     * @brief Gets FNV-1a hash of file content, reading the file only if it changed since the last call
+     *
+     * @return false if file could not be read
+     */
+    bool getDigest(const std::string& path, uint64_t& digest);
+
+    /**
+     * @brief Gets number of times file content was hashed
+     */
+    uint64_t getFileReads() const {
+        return fileReads;
+    }
+};
+
+}  // namespace ovms
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <filesystem>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -119,6 +120,18 @@ public:
      */
 
     virtual StatusCode deleteFileFolder(const std::string& path) = 0;
+
+    /**
+     * @brief Get fingerprints of directories which change whenever any file inside changes.
+     * Directories located close to each other may be listed with a single request.
+     * 
+     * @param paths 
+     * @param fingerprints filled with fingerprints of directories which could be listed
+     * @return StatusCode NOT_IMPLEMENTED if file system can not detect changes this way
+     */
+    virtual StatusCode getDirectoriesFingerprints(const std::vector<std::string>& paths, std::map<std::string, std::string>* fingerprints) {
+        return StatusCode::NOT_IMPLEMENTED;
+    }
     /**
      * @brief Create a Temp Path
      * 
@@ -141,6 +154,31 @@ public:
         return StatusCode::OK;
     }
 
+    /**
+     * @brief Groups directory prefixes for listing them together. Prefixes sharing a parent directory are listed
+     * with the parent, a prefix without siblings is listed alone.
+     * 
+     * @param prefixes directory prefixes ending with slash
+     * @return listing prefixes with prefixes covered by each of them
+     */
+    static std::map<std::string, std::vector<std::string>> groupListingPrefixes(const std::set<std::string>& prefixes) {
+        std::map<std::string, std::vector<std::string>> byParent;
+        for (const auto& prefix : prefixes) {
+            auto parentEnd = prefix.empty() ? std::string::npos : prefix.rfind('/', prefix.size() - 2);
+            byParent[parentEnd == std::string::npos ? "" : prefix.substr(0, parentEnd + 1)].push_back(prefix);
+        }
+        std::map<std::string, std::vector<std::string>> groups;
+        for (auto& [parent, children] : byParent) {
+            if (children.size() == 1) {
+                groups[children.front()].push_back(children.front());
+            } else {
+                auto& group = groups[parent];
+                group.insert(group.end(), children.begin(), children.end());
+            }
+        }
+        return groups;
+    }
+
     static bool isPathEscaped(const std::string& path) {
         return std::string::npos != path.find("../") || std::string::npos != path.find("/..");
     }
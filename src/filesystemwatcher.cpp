@@ -0,0 +1,142 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "filesystemwatcher.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <poll.h>
+#include <spdlog/spdlog.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace ovms {
+
+static const uint32_t WATCHED_EVENTS = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB |
+                                       IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+FileSystemWatcher::FileSystemWatcher() {
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        SPDLOG_WARN("Could not initialize inotify: {}; local directories will be polled for changes", std::strerror(errno));
+    }
+}
+
+FileSystemWatcher::~FileSystemWatcher() {
+    if (fd >= 0) {
+        // Closing descriptor removes all its watches
+        close(fd);
+    }
+}
+
+bool FileSystemWatcher::watchDirectory(const std::string& path, const std::string& reportedPath) {
+    if (!isEnabled()) {
+        return false;
+    }
+    if (isWatched(path)) {
+        return true;
+    }
+    int wd = inotify_add_watch(fd, path.c_str(), WATCHED_EVENTS);
+    if (wd < 0) {
+        SPDLOG_DEBUG("Could not watch directory: {}: {}", path, std::strerror(errno));
+        return false;
+    }
+    // The same directory may be watched under different paths, they share watch descriptor
+    auto it = watchedDirectories.find(wd);
+    if (it != watchedDirectories.end()) {
+        SPDLOG_DEBUG("Directory: {} is already watched as: {}", path, it->second);
+        return false;
+    }
+    SPDLOG_DEBUG("Watching directory: {} for changes", path);
+    watchedDirectories.emplace(wd, path);
+    reportedPaths.emplace(wd, reportedPath.empty() ? path : reportedPath);
+    watchDescriptors.emplace(path, wd);
+    return true;
+}
+
+void FileSystemWatcher::unwatchDirectory(const std::string& path) {
+    auto it = watchDescriptors.find(path);
+    if (it == watchDescriptors.end()) {
+        return;
+    }
+    SPDLOG_DEBUG("Stopped watching directory: {}", path);
+    inotify_rm_watch(fd, it->second);
+    watchedDirectories.erase(it->second);
+    reportedPaths.erase(it->second);
+    watchDescriptors.erase(it);
+}
+
+std::set<std::string> FileSystemWatcher::getWatchedDirectories() const {
+    std::set<std::string> directories;
+    for (const auto& [path, wd] : watchDescriptors) {
+        directories.insert(path);
+    }
+    return directories;
+}
+
+bool FileSystemWatcher::waitForChanges(std::chrono::milliseconds timeout, std::set<std::string>& changedDirectories) {
+    if (!isEnabled()) {
+        return false;
+    }
+    struct pollfd pfd = {fd, POLLIN, 0};
+    int result = poll(&pfd, 1, timeout.count());
+    if (result <= 0 || !(pfd.revents & POLLIN)) {
+        return false;
+    }
+    return readEvents(changedDirectories);
+}
+
+bool FileSystemWatcher::readEvents(std::set<std::string>& changedDirectories) {
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    bool changed = false;
+    while (true) {
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            // EAGAIN when all pending events were read
+            return changed;
+        }
+        for (char* ptr = buffer; ptr < buffer + length;) {
+            auto* event = reinterpret_cast<const struct inotify_event*>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW) {
+                SPDLOG_WARN("Filesystem events queue overflowed, rescanning all watched directories");
+                for (const auto& [wd, path] : reportedPaths) {
+                    changedDirectories.insert(path);
+                }
+                changed = true;
+                continue;
+            }
+            auto it = watchedDirectories.find(event->wd);
+            if (it == watchedDirectories.end()) {
+                continue;
+            }
+            changedDirectories.insert(reportedPaths.at(event->wd));
+            changed = true;
+            if (event->mask & (IN_IGNORED | IN_MOVE_SELF)) {
+                // Directory was deleted or moved away, path has to be watched again once it exists
+                SPDLOG_DEBUG("Directory: {} is not watched anymore", it->second);
+                if (event->mask & IN_MOVE_SELF) {
+                    inotify_rm_watch(fd, event->wd);
+                }
+                watchDescriptors.erase(it->second);
+                reportedPaths.erase(event->wd);
+                watchedDirectories.erase(it);
+            }
+        }
+    }
+}
+
+}  // namespace ovms
@@ -0,0 +1,86 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace ovms {
+
+/**
+ * @brief Watches local directories for changes of their entries using inotify.
+ * Changes of subdirectories content are not reported.
+ */
+class FileSystemWatcher {
+    int fd = -1;
+
+    /**
+     * @brief Paths under which changes of watched directories are reported, by watch descriptor
+     */
+    std::unordered_map<int, std::string> reportedPaths;
+    std::unordered_map<int, std::string> watchedDirectories;
+    std::unordered_map<std::string, int> watchDescriptors;
+
+    bool readEvents(std::set<std::string>& changedDirectories);
+
+public:
+    FileSystemWatcher();
+    ~FileSystemWatcher();
+
+    FileSystemWatcher(const FileSystemWatcher&) = delete;
+    FileSystemWatcher& operator=(const FileSystemWatcher&) = delete;
+
+    /**
+     * @brief Checks if inotify is available, otherwise nothing can be watched
+     */
+    bool isEnabled() const {
+        return fd >= 0;
+    }
+
+    /**
+     * @brief Starts watching directory, does nothing if it is already watched
+     *
+     * @param path
+     * @param reportedPath path reported when directory changes, e.g. parent directory path. Defaults to path.
+     *
+     * @return false if directory can not be watched, e.g. it does not exist
+     */
+    bool watchDirectory(const std::string& path, const std::string& reportedPath = "");
+
+    void unwatchDirectory(const std::string& path);
+
+    bool isWatched(const std::string& path) const {
+        return watchDescriptors.count(path) == 1;
+    }
+
+    std::set<std::string> getWatchedDirectories() const;
+
+    /**
+     * @brief Waits for changes in watched directories
+     *
+     * @param timeout
+     * @param changedDirectories extended with reported paths of changed directories
+     * Directories removed from the filesystem are reported as changed and are not watched anymore.
+     * When kernel events queue overflows all watched directories are reported as changed.
+     *
+     * @return true if any change was detected before timeout
+     */
+    bool waitForChanges(std::chrono::milliseconds timeout, std::set<std::string>& changedDirectories);
+};
+
+}  // namespace ovms
@@ -25,12 +25,17 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "gcsfilesystem.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "crc32c.hpp"
+#include "filehash.hpp"
 #include "logging.hpp"
 #include "stringutils.hpp"
 
@@ -41,6 +46,8 @@ namespace gcs = google::cloud::storage;
 
 const std::string GCSFileSystem::GCS_URL_PREFIX = "gs://";
 
+static const size_t DOWNLOAD_BUFFER_SIZE = 1024 * 1024;
+
 StatusCode GCSFileSystem::parsePath(const std::string& path,
     std::string* bucket, std::string* object) {
     int bucket_start = path.find(GCS_URL_PREFIX) + GCS_URL_PREFIX.size();
@@ -271,21 +278,39 @@ StatusCode GCSFileSystem::readTextFile(const std::string& path,
     return StatusCode::OK;
 }
 
-StatusCode GCSFileSystem::downloadFile(const std::string& remote_path,
-    const std::string& local_path) {
-    SPDLOG_LOGGER_TRACE(gcs_logger, "Saving file {} to {}", remote_path, local_path);
-    std::string contents;
-    auto read_status = this->readTextFile(remote_path, &contents);
-    if (read_status != StatusCode::OK) {
-        SPDLOG_LOGGER_ERROR(gcs_logger, "Failed to get object at {}", remote_path);
-        return read_status;
-    }
-    std::ofstream output_file(local_path.c_str(), std::ios::binary);
-    output_file << contents;
-    output_file.close();
+StatusCode GCSFileSystem::downloadFileRange(const std::string& remote_path, uint64_t offset, uint64_t size,
+    const range_writer_t& writer) {
+    std::string bucket, object;
+    auto status = parsePath(remote_path, &bucket, &object);
+    if (status != StatusCode::OK) {
+        return status;
+    }
+    gcs::ObjectReadStream stream = client_.ReadObject(bucket, object, gcs::ReadRange(offset, offset + size));
+    if (!stream) {
+        SPDLOG_LOGGER_ERROR(gcs_logger, "Downloading file {} range from {} of size {} has failed", remote_path, offset, size);
+        return StatusCode::GCS_FAILED_GET_OBJECT;
+    }
+    std::vector<char> buffer(std::min<uint64_t>(size, DOWNLOAD_BUFFER_SIZE));
+    while (stream.read(buffer.data(), buffer.size()) || stream.gcount() > 0) {
+        if (!writer(buffer.data(), stream.gcount())) {
+            return StatusCode::GCS_FAILED_GET_OBJECT;
+        }
+    }
+    if (!stream.status().ok()) {
+        SPDLOG_LOGGER_ERROR(gcs_logger, "Downloading file {} range from {} of size {} has failed: {}", remote_path, offset, size,
+            stream.status().message());
+        return StatusCode::GCS_FAILED_GET_OBJECT;
+    }
     return StatusCode::OK;
 }
 
+StatusCode GCSFileSystem::downloadFiles(const std::vector<RangedDownloadFile>& files) {
+    auto downloader = RangedDownloader::fromConfig();
+    return downloader.download(files, [this](const std::string& remote_path, uint64_t offset, uint64_t size, const range_writer_t& writer) {
+        return downloadFileRange(remote_path, offset, size, writer);
+    });
+}
+
 StatusCode GCSFileSystem::downloadModelVersions(const std::string& path,
     std::string* local_path,
     const std::vector<model_version_t>& versions) {
@@ -295,7 +320,9 @@ StatusCode GCSFileSystem::downloadModelVersions(const std::string& path,
         return sc;
     }
 
+    // Files of all versions are downloaded together so that they share download threads
     StatusCode result = StatusCode::OK;
+    std::vector<RangedDownloadFile> files;
     for (auto& ver : versions) {
         std::string versionpath = path;
         if (!endsWith(versionpath, "/")) {
@@ -308,17 +335,32 @@ StatusCode GCSFileSystem::downloadModelVersions(const std::string& path,
         }
         lpath.append(std::to_string(ver));
         fs::create_directory(lpath);
-        auto status = downloadFileFolder(versionpath, lpath);
+        auto status = collectFileFolder(versionpath, lpath, &files);
         if (status != StatusCode::OK) {
             result = status;
             SPDLOG_LOGGER_ERROR(gcs_logger, "Failed to download model version {}", versionpath);
         }
     }
 
+    auto status = downloadFiles(files);
+    if (status != StatusCode::OK) {
+        result = status;
+        SPDLOG_LOGGER_ERROR(gcs_logger, "Failed to download model versions from {}", path);
+    }
     return result;
 }
 
 StatusCode GCSFileSystem::downloadFileFolder(const std::string& path, const std::string& local_path) {
+    std::vector<RangedDownloadFile> files;
+    auto status = collectFileFolder(path, local_path, &files);
+    if (status != StatusCode::OK) {
+        return status;
+    }
+    return downloadFiles(files);
+}
+
+StatusCode GCSFileSystem::collectFileFolder(const std::string& path, const std::string& local_path,
+    std::vector<RangedDownloadFile>* files_to_download) {
     SPDLOG_LOGGER_TRACE(gcs_logger, "Downloading dir {} and saving to {}", path, local_path);
     bool is_dir;
     auto status = this->isDirectory(path, &is_dir);
@@ -353,7 +395,7 @@ StatusCode GCSFileSystem::downloadFileFolder(const std::string& path, const std:
             return status;
         }
         auto download_dir_status =
-            this->downloadFileFolder(remote_dir_path, local_dir_path);
+            this->collectFileFolder(remote_dir_path, local_dir_path, files_to_download);
         if (download_dir_status != StatusCode::OK) {
             SPDLOG_LOGGER_ERROR(gcs_logger, "Unable to download directory from {} to {}",
                 remote_dir_path, local_dir_path);
@@ -369,12 +411,68 @@ StatusCode GCSFileSystem::downloadFileFolder(const std::string& path, const std:
             std::string local_file_path = joinPath({local_path, f});
             SPDLOG_LOGGER_TRACE(gcs_logger, "Processing file {} from {} -> {}", f, remote_file_path,
                 local_file_path);
-            auto download_status =
-                this->downloadFile(remote_file_path, local_file_path);
-            if (download_status != StatusCode::OK) {
-                SPDLOG_LOGGER_ERROR(gcs_logger, "Unable to save file from {} to {}", remote_file_path,
-                    local_file_path);
-                return download_status;
+            std::string bucket, object;
+            status = parsePath(remote_file_path, &bucket, &object);
+            if (status != StatusCode::OK) {
+                return status;
+            }
+            google::cloud::StatusOr<gcs::ObjectMetadata> object_metadata =
+                client_.GetObjectMetadata(bucket, object);
+            if (!object_metadata) {
+                SPDLOG_LOGGER_ERROR(gcs_logger, "Unable to get metadata of {}", remote_file_path);
+                return StatusCode::GCS_METADATA_FAIL;
+            }
+            RangedDownloadFile file{remote_file_path, local_file_path, object_metadata->size(),
+                std::to_string(object_metadata->generation())};
+            // Checksum of whole object is not verified by the client for ranged reads
+            uint32_t crc32c;
+            if (Crc32c::fromBase64(object_metadata->crc32c(), crc32c)) {
+                file.crc32c = crc32c;
+            }
+            files_to_download->push_back(std::move(file));
+        }
+    }
+    return StatusCode::OK;
+}
+
+StatusCode GCSFileSystem::getDirectoriesFingerprints(const std::vector<std::string>& paths, std::map<std::string, std::string>* fingerprints) {
+    std::map<std::string, std::map<std::string, std::string>> pathsByBucket;
+    for (const auto& path : paths) {
+        std::string bucket, object;
+        if (parsePath(path, &bucket, &object) == StatusCode::OK) {
+            pathsByBucket[bucket][appendSlash(object)] = path;
+        }
+    }
+    for (const auto& [bucket, pathsByPrefix] : pathsByBucket) {
+        std::set<std::string> prefixes;
+        for (const auto& [prefix, path] : pathsByPrefix) {
+            prefixes.insert(prefix);
+        }
+        for (const auto& [listingPrefix, groupPrefixes] : groupListingPrefixes(prefixes)) {
+            std::map<std::string, Fnv1aHash> hashes;
+            for (const auto& prefix : groupPrefixes) {
+                hashes[prefix];
+            }
+            bool listed = true;
+            for (auto&& meta : client_.ListObjects(bucket, gcs::Prefix(listingPrefix))) {
+                if (!meta) {
+                    SPDLOG_LOGGER_WARN(gcs_logger, "Could not list objects in bucket {} with prefix {}", bucket, listingPrefix);
+                    listed = false;
+                    break;
+                }
+                for (auto& [prefix, hash] : hashes) {
+                    if (meta->name().rfind(prefix, 0) == 0) {
+                        hash.update(meta->name());
+                        hash.update(std::to_string(meta->generation()));
+                        hash.update(std::to_string(meta->size()));
+                    }
+                }
+            }
+            if (!listed) {
+                continue;
+            }
+            for (const auto& [prefix, hash] : hashes) {
+                (*fingerprints)[pathsByPrefix.at(prefix)] = hash.toHexString();
             }
         }
     }
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <map>
 #include <regex>
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "google/cloud/storage/client.h"
 
 #include "filesystem.hpp"
+#include "rangeddownloader.hpp"
 #include "status.hpp"
 
 namespace ovms {
@@ -131,6 +133,15 @@ public:
    */
     StatusCode deleteFileFolder(const std::string& path) override;
 
+    /**
+   * @brief Get fingerprints of directories, listing directories of the same bucket together
+   *
+   * @param paths
+   * @param fingerprints
+   * @return StatusCode
+   */
+    StatusCode getDirectoriesFingerprints(const std::vector<std::string>& paths, std::map<std::string, std::string>* fingerprints) override;
+
     static const std::string GCS_URL_PREFIX;
 
 private:
@@ -146,14 +157,35 @@ private:
         std::string* object);
 
     /**
+    * @brief Creates local mirror of remote directory tree and lists files to be downloaded into it
     *
-    * @brief
+    * @param path
+    * @param local_path
+    * @param files
+    * @return StatusCode
+    */
+    StatusCode collectFileFolder(const std::string& path, const std::string& local_path,
+        std::vector<RangedDownloadFile>* files);
+
+    /**
+    * @brief Downloads a byte range of an object with a single ranged read
     *
     * @param remote_path
-    * @param local_path
+    * @param offset
+    * @param size
+    * @param writer receives consecutive chunks of the range
+    * @return StatusCode
+    */
+    StatusCode downloadFileRange(const std::string& remote_path, uint64_t offset, uint64_t size,
+        const range_writer_t& writer);
+
+    /**
+    * @brief Downloads files in parallel ranged parts
+    *
+    * @param files
+    * @return StatusCode
     */
-    StatusCode downloadFile(const std::string& remote_path,
-        const std::string& local_path);
+    StatusCode downloadFiles(const std::vector<RangedDownloadFile>& files);
 
     /**
     * @brief
@@ -25,14 +25,13 @@
 
 #include "filesystem.hpp"
 #include "get_model_metadata_impl.hpp"
+#include "metrics.hpp"
 #include "model_service.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "prediction_service_utils.hpp"
 #include "rest_parser.hpp"
 #include "rest_utils.hpp"
-
-#define DEBUG
-#include "timer.hpp"
+#include "tracing.hpp"
 
 using tensorflow::serving::PredictRequest;
 using tensorflow::serving::PredictResponse;
@@ -44,6 +43,7 @@ const std::string HttpRestApiHandler::predictionRegexExp =
     R"((.?)\/v1\/models\/([^\/:]+)(?:(?:\/versions\/(\d+))|(?:\/labels\/(\w+)))?:(classify|regress|predict))";
 const std::string HttpRestApiHandler::modelstatusRegexExp =
     R"((.?)\/v1\/models(?:\/([^\/:]+))?(?:(?:\/versions\/(\d+))|(?:\/labels\/(\w+)))?(?:\/(metadata))?)";
+const std::string HttpRestApiHandler::metricsPath = "/metrics";
 
 Status HttpRestApiHandler::validateUrlAndMethod(
     const std::string_view http_method,
@@ -136,6 +136,10 @@ Status HttpRestApiHandler::processRequest(
         return StatusCode::PATH_INVALID;
     }
 
+    if (http_method == "GET" && request_path_str == metricsPath) {
+        return processMetricsRequest(headers, response);
+    }
+
     auto status = validateUrlAndMethod(http_method, request_path_str, &sm);
     if (!status.ok()) {
         return status;
@@ -166,6 +170,15 @@ Status HttpRestApiHandler::processRequest(
     return dispatchToProcessor(request_path, request_body, response, requestComponents);
 }
 
+Status HttpRestApiHandler::processMetricsRequest(
+    std::vector<std::pair<std::string, std::string>>* headers,
+    std::string* response) {
+    headers->clear();
+    headers->push_back({"Content-Type", "text/plain; version=0.0.4"});
+    *response = MetricsRegistry::instance().serialize();
+    return StatusCode::OK;
+}
+
 Status HttpRestApiHandler::processPredictRequest(
     const std::string& modelName,
     const std::optional<int64_t>& modelVersion,
@@ -174,9 +187,8 @@ Status HttpRestApiHandler::processPredictRequest(
     std::string* response) {
     // model_version_label currently is not in use
 
-    Timer timer;
-    timer.start("total");
-    using std::chrono::microseconds;
+    SpanTimer timer;
+    timer.start(TraceSpan::REST_REQUEST);
 
     SPDLOG_DEBUG("Processing REST request for model: {}; version: {}",
         modelName, modelVersion.value_or(0));
@@ -203,8 +215,8 @@ Status HttpRestApiHandler::processPredictRequest(
     if (!status.ok())
         return status;
 
-    timer.stop("total");
-    SPDLOG_DEBUG("Total REST request processing time: {} ms", timer.elapsed<std::chrono::microseconds>("total") / 1000);
+    timer.stop(TraceSpan::REST_REQUEST);
+    SPDLOG_DEBUG("Total REST request processing time: {} ms", timer.elapsedMicroseconds(TraceSpan::REST_REQUEST) / 1000);
     return StatusCode::OK;
 }
 
@@ -227,16 +239,16 @@ Status HttpRestApiHandler::processSingleModelRequest(const std::string& modelNam
         SPDLOG_WARN("Requested model instance - name: {}, version: {} - does not exist.", modelName, modelVersion.value_or(0));
         return status;
     }
-    Timer timer;
-    timer.start("parse");
+    SpanTimer timer;
+    timer.start(TraceSpan::REST_PARSE);
     RestParser requestParser(modelInstance->getInputsInfo());
     status = requestParser.parse(request.c_str());
     if (!status.ok()) {
         return status;
     }
     requestOrder = requestParser.getOrder();
-    timer.stop("parse");
-    SPDLOG_DEBUG("JSON request parsing time: {} ms", timer.elapsed<std::chrono::microseconds>("parse") / 1000);
+    timer.stop(TraceSpan::REST_PARSE);
+    SPDLOG_DEBUG("JSON request parsing time: {} ms", timer.elapsedMicroseconds(TraceSpan::REST_PARSE) / 1000);
 
     tensorflow::serving::PredictRequest& requestProto = requestParser.getProto();
     requestProto.mutable_model_spec()->set_name(modelName);
@@ -254,16 +266,16 @@ Status HttpRestApiHandler::processPipelineRequest(const std::string& modelName,
 
     std::unique_ptr<Pipeline> pipelinePtr;
 
-    Timer timer;
-    timer.start("parse");
+    SpanTimer timer;
+    timer.start(TraceSpan::REST_PARSE);
     RestParser requestParser;
     auto status = requestParser.parse(request.c_str());
     if (!status.ok()) {
         return status;
     }
     requestOrder = requestParser.getOrder();
-    timer.stop("parse");
-    SPDLOG_DEBUG("JSON request parsing time: {} ms", timer.elapsed<std::chrono::microseconds>("parse") / 1000);
+    timer.stop(TraceSpan::REST_PARSE);
+    SPDLOG_DEBUG("JSON request parsing time: {} ms", timer.elapsedMicroseconds(TraceSpan::REST_PARSE) / 1000);
 
     tensorflow::serving::PredictRequest& requestProto = requestParser.getProto();
     requestProto.mutable_model_spec()->set_name(modelName);
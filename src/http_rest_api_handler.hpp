@@ -44,6 +44,7 @@ public:
     static const std::string kPathRegexExp;
     static const std::string predictionRegexExp;
     static const std::string modelstatusRegexExp;
+    static const std::string metricsPath;
 
     /**
      * @brief Construct a new HttpRest Api Handler
@@ -87,6 +88,18 @@ public:
         std::vector<std::pair<std::string, std::string>>* headers,
         std::string* response);
 
+    /**
+     * @brief Process metrics request
+     *
+     * @param headers
+     * @param response filled with metrics in Prometheus text format
+     *
+     * @return StatusCode
+     */
+    Status processMetricsRequest(
+        std::vector<std::pair<std::string, std::string>>* headers,
+        std::string* response);
+
     /**
      * @brief Process predict request
      *
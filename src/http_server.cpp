@@ -18,6 +18,7 @@
 #include <memory>
 #include <regex>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -33,6 +34,7 @@
 
 #include "http_rest_api_handler.hpp"
 #include "status.hpp"
+#include "tracing.hpp"
 
 namespace ovms {
 
@@ -73,6 +75,12 @@ private:
             request_chunk = req->ReadRequestBytes(&num_bytes);
         }
 
+        const auto traceParent = req->GetRequestHeader("traceparent");
+        const auto method = req->http_method();
+        const auto path = req->uri_path();
+        RequestTraceScope traceScope({"rest ", std::string_view(method.data(), method.size()), " ", std::string_view(path.data(), path.size())},
+            std::string_view(traceParent.data(), traceParent.size()));
+
         std::vector<std::pair<std::string, std::string>> headers;
         std::string output;
         SPDLOG_DEBUG("Processing HTTP request: {} {} body: {} bytes",
@@ -0,0 +1,96 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "inmemoryfiles.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ovms {
+
+InMemoryFiles::~InMemoryFiles() {
+    for (const auto& [path, fd] : files) {
+        close(fd);
+    }
+}
+
+InMemoryFiles& InMemoryFiles::instance() {
+    static InMemoryFiles instance;
+    return instance;
+}
+
+int InMemoryFiles::create(const std::string& localPath, uint64_t size) {
+    const auto name = std::filesystem::path(localPath).filename().string();
+    int fd = memfd_create(name.c_str(), MFD_CLOEXEC);
+    if (fd < 0) {
+        SPDLOG_ERROR("Failed to create memory file for: {} {}", localPath, std::strerror(errno));
+        return -1;
+    }
+    if (fchmod(fd, 0644) != 0 || ftruncate(fd, size) != 0) {
+        SPDLOG_ERROR("Failed to allocate memory file for: {} of size: {} {}", localPath, size, std::strerror(errno));
+        close(fd);
+        return -1;
+    }
+    int writeFd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (writeFd < 0) {
+        SPDLOG_ERROR("Failed to duplicate memory file descriptor for: {} {}", localPath, std::strerror(errno));
+        close(fd);
+        return -1;
+    }
+    unlink(localPath.c_str());
+    const std::string target = "/proc/self/fd/" + std::to_string(fd);
+    if (symlink(target.c_str(), localPath.c_str()) != 0) {
+        SPDLOG_ERROR("Failed to create link to memory file: {} {}", localPath, std::strerror(errno));
+        close(writeFd);
+        close(fd);
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    auto [it, inserted] = files.emplace(localPath, fd);
+    if (!inserted) {
+        close(it->second);
+        it->second = fd;
+    }
+    return writeFd;
+}
+
+size_t InMemoryFiles::release(const std::string& directory) {
+    std::string prefix = directory;
+    if (prefix.empty() || prefix.back() != '/') {
+        prefix += '/';
+    }
+    size_t released = 0;
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto it = files.lower_bound(prefix); it != files.end() && it->first.compare(0, prefix.size(), prefix) == 0;) {
+        close(it->second);
+        it = files.erase(it);
+        released++;
+    }
+    return released;
+}
+
+size_t InMemoryFiles::getFilesCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return files.size();
+}
+
+}  // namespace ovms
@@ -0,0 +1,56 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace ovms {
+
+/**
+ * @brief Registry of anonymous memory backed files (memfd) holding downloaded model files.
+ * Each file is visible under its local path as a symbolic link to the file descriptor, so models are read
+ * with the same code as files on disk, without writing them to a disk and reading them back.
+ */
+class InMemoryFiles {
+    std::map<std::string, int> files;
+    mutable std::mutex mtx;
+
+public:
+    ~InMemoryFiles();
+
+    static InMemoryFiles& instance();
+
+    /**
+     * @brief Creates memory backed file of given size visible under local path
+     *
+     * @return descriptor for writing file content which has to be closed by the caller, -1 on failure
+     */
+    int create(const std::string& localPath, uint64_t size);
+
+    /**
+     * @brief Releases memory of files placed in given directory. Memory mapped content stays valid until unmapped.
+     *
+     * @return number of released files
+     */
+    size_t release(const std::string& directory);
+
+    size_t getFilesCount() const;
+};
+
+}  // namespace ovms
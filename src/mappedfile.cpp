@@ -0,0 +1,106 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "mappedfile.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ovms {
+
+std::mutex MappedFile::mtx;
+std::map<MappedFile::FileId, std::weak_ptr<MappedFile>> MappedFile::mappedFiles;
+
+bool MappedFile::isValidMode(const std::string& mode) {
+    return mode == MODE_OFF ||
+           mode == MODE_LAZY ||
+           mode == MODE_POPULATE ||
+           mode == MODE_WILLNEED;
+}
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& path, const std::string& mode) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        SPDLOG_DEBUG("Could not open file: {} for mapping: {}", path, std::strerror(errno));
+        return nullptr;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    FileId id{fileStat.st_dev, fileStat.st_ino, fileStat.st_size, fileStat.st_mtime};
+
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto it = mappedFiles.begin(); it != mappedFiles.end();) {
+        if (it->second.expired()) {
+            it = mappedFiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    auto it = mappedFiles.find(id);
+    if (it != mappedFiles.end()) {
+        auto existing = it->second.lock();
+        if (existing) {
+            ::close(fd);
+            SPDLOG_DEBUG("Reusing existing mapping of file: {}", path);
+            return existing;
+        }
+    }
+
+    int flags = MAP_PRIVATE;
+    if (mode == MODE_POPULATE) {
+        flags |= MAP_POPULATE;
+    }
+    size_t length = static_cast<size_t>(fileStat.st_size);
+    void* address = mmap(nullptr, length, PROT_READ, flags, fd, 0);
+    // Mapping stays valid after descriptor is closed
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        SPDLOG_WARN("Could not map file: {} to memory: {}", path, std::strerror(errno));
+        return nullptr;
+    }
+    if (mode == MODE_WILLNEED && madvise(address, length, MADV_WILLNEED) != 0) {
+        SPDLOG_DEBUG("Read ahead advice for mapped file: {} failed: {}", path, std::strerror(errno));
+    }
+    std::shared_ptr<MappedFile> mappedFile(new MappedFile(address, length));
+    mappedFiles[id] = mappedFile;
+    SPDLOG_DEBUG("Mapped file: {} of size: {} bytes to memory", path, length);
+    return mappedFile;
+}
+
+MappedFile::~MappedFile() {
+    munmap(address, length);
+}
+
+size_t MappedFile::getMappedFilesCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    size_t count = 0;
+    for (const auto& [id, mappedFile] : mappedFiles) {
+        if (!mappedFile.expired()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+}  // namespace ovms
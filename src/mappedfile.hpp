@@ -0,0 +1,94 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include <sys/types.h>
+
+namespace ovms {
+
+/**
+ * @brief Read-only memory mapping of whole file.
+ * Mappings of the same file are shared within the process, so identical weights used by
+ * several model versions or models do not occupy additional memory.
+ */
+class MappedFile {
+public:
+    static constexpr const char* MODE_OFF = "off";
+    static constexpr const char* MODE_LAZY = "lazy";
+    static constexpr const char* MODE_POPULATE = "populate";
+    static constexpr const char* MODE_WILLNEED = "willneed";
+
+    static bool isValidMode(const std::string& mode);
+
+    /**
+     * @brief Maps file or returns already existing mapping of it
+     *
+     * @param path
+     * @param mode one of lazy, populate (pages are read during mapping) or willneed (pages are read ahead asynchronously)
+     *
+     * @return mapping or nullptr if file could not be mapped
+     */
+    static std::shared_ptr<MappedFile> open(const std::string& path, const std::string& mode);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const {
+        return static_cast<const uint8_t*>(address);
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    /**
+     * @brief Gets number of files mapped at the moment
+     */
+    static size_t getMappedFilesCount();
+
+private:
+    MappedFile(void* address, size_t length) :
+        address(address),
+        length(length) {}
+
+    void* address;
+    size_t length;
+
+    struct FileId {
+        dev_t device;
+        ino_t inode;
+        off_t size;
+        time_t modificationTime;
+
+        bool operator<(const FileId& other) const {
+            return std::tie(device, inode, size, modificationTime) <
+                   std::tie(other.device, other.inode, other.size, other.modificationTime);
+        }
+    };
+
+    static std::mutex mtx;
+    static std::map<FileId, std::weak_ptr<MappedFile>> mappedFiles;
+};
+
+}  // namespace ovms
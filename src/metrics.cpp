@@ -0,0 +1,297 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace ovms {
+
+namespace {
+std::atomic<size_t> nextShardIndex{0};
+
+std::string formatValue(double value) {
+    std::ostringstream stream;
+    stream << std::setprecision(12) << value;
+    return stream.str();
+}
+
+std::string escapeLabelValue(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Joins serialized labels with additional label, e.g. le of histogram bucket
+ */
+std::string joinLabels(const std::string& labels, const std::string& extraLabel) {
+    if (labels.empty()) {
+        return "{" + extraLabel + "}";
+    }
+    return labels.substr(0, labels.size() - 1) + "," + extraLabel + "}";
+}
+}  // namespace
+
+size_t getMetricShardIndex() {
+    thread_local const size_t index = nextShardIndex++ % METRIC_SHARDS;
+    return index;
+}
+
+uint64_t MetricCounter::get() const {
+    uint64_t sum = 0;
+    for (const auto& shard : shards) {
+        sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+void MetricGauge::set(int64_t value) {
+    for (auto& shard : shards) {
+        shard.value.store(0, std::memory_order_relaxed);
+    }
+    shards[0].value.store(value, std::memory_order_relaxed);
+}
+
+int64_t MetricGauge::get() const {
+    int64_t sum = 0;
+    for (const auto& shard : shards) {
+        sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+MetricHistogram::MetricHistogram(const std::vector<uint64_t>& bounds) :
+    bounds(bounds) {
+    for (auto& shard : shards) {
+        shard.buckets = std::make_unique<std::atomic<uint64_t>[]>(bounds.size() + 1);
+        for (size_t i = 0; i <= bounds.size(); i++) {
+            shard.buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void MetricHistogram::observe(uint64_t value) {
+    const size_t bucket = std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+    auto& shard = shards[getMetricShardIndex()];
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> MetricHistogram::getBucketCounts() const {
+    std::vector<uint64_t> counts(bounds.size() + 1, 0);
+    for (const auto& shard : shards) {
+        for (size_t i = 0; i < counts.size(); i++) {
+            counts[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+    return counts;
+}
+
+uint64_t MetricHistogram::getCount() const {
+    uint64_t count = 0;
+    for (const auto& shard : shards) {
+        count += shard.count.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t MetricHistogram::getSum() const {
+    uint64_t sum = 0;
+    for (const auto& shard : shards) {
+        sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+const std::vector<uint64_t> MetricsRegistry::LATENCY_BUCKETS_MICROSECONDS = {
+    50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000};
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Family& MetricsRegistry::getFamily(const std::string& name, const std::string& help, MetricType type) {
+    auto [it, inserted] = families.try_emplace(name);
+    if (inserted) {
+        it->second.type = type;
+        it->second.help = help;
+    }
+    return it->second;
+}
+
+std::shared_ptr<MetricCounter> MetricsRegistry::getCounter(const std::string& name, const std::string& help, const metric_labels_t& labels) {
+    std::unique_lock lock(mtx);
+    auto& metric = getFamily(name, help, MetricType::COUNTER).counters[formatLabels(labels)];
+    if (metric == nullptr) {
+        metric = std::make_shared<MetricCounter>();
+    }
+    return metric;
+}
+
+std::shared_ptr<MetricGauge> MetricsRegistry::getGauge(const std::string& name, const std::string& help, const metric_labels_t& labels) {
+    std::unique_lock lock(mtx);
+    auto& metric = getFamily(name, help, MetricType::GAUGE).gauges[formatLabels(labels)];
+    if (metric == nullptr) {
+        metric = std::make_shared<MetricGauge>();
+    }
+    return metric;
+}
+
+std::shared_ptr<MetricHistogram> MetricsRegistry::getLatencyHistogram(const std::string& name, const std::string& help, const metric_labels_t& labels) {
+    std::unique_lock lock(mtx);
+    auto& family = getFamily(name, help, MetricType::HISTOGRAM);
+    family.scale = 1e-6;
+    auto& metric = family.histograms[formatLabels(labels)];
+    if (metric == nullptr) {
+        metric = std::make_shared<MetricHistogram>(LATENCY_BUCKETS_MICROSECONDS);
+    }
+    return metric;
+}
+
+void MetricsRegistry::removeSeries(const std::string& name, const metric_labels_t& labels) {
+    std::unique_lock lock(mtx);
+    auto it = families.find(name);
+    if (it == families.end()) {
+        return;
+    }
+    auto& family = it->second;
+    const std::string formattedLabels = formatLabels(labels);
+    family.counters.erase(formattedLabels);
+    family.gauges.erase(formattedLabels);
+    family.histograms.erase(formattedLabels);
+    if (family.counters.empty() && family.gauges.empty() && family.histograms.empty()) {
+        families.erase(it);
+    }
+}
+
+std::string MetricsRegistry::formatLabels(const metric_labels_t& labels) {
+    if (labels.empty()) {
+        return "";
+    }
+    std::string result = "{";
+    for (const auto& [name, value] : labels) {
+        if (result.size() > 1) {
+            result += ",";
+        }
+        result += name + "=\"" + escapeLabelValue(value) + "\"";
+    }
+    return result + "}";
+}
+
+std::string MetricsRegistry::serialize() const {
+    std::unique_lock lock(mtx);
+    std::ostringstream output;
+    for (const auto& [name, family] : families) {
+        output << "# HELP " << name << " " << family.help << "\n";
+        switch (family.type) {
+        case MetricType::COUNTER:
+            output << "# TYPE " << name << " counter\n";
+            for (const auto& [labels, counter] : family.counters) {
+                output << name << labels << " " << counter->get() << "\n";
+            }
+            break;
+        case MetricType::GAUGE:
+            output << "# TYPE " << name << " gauge\n";
+            for (const auto& [labels, gauge] : family.gauges) {
+                output << name << labels << " " << gauge->get() << "\n";
+            }
+            break;
+        case MetricType::HISTOGRAM:
+            output << "# TYPE " << name << " histogram\n";
+            for (const auto& [labels, histogram] : family.histograms) {
+                const auto& bounds = histogram->getBounds();
+                const auto counts = histogram->getBucketCounts();
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < bounds.size(); i++) {
+                    cumulative += counts[i];
+                    output << name << "_bucket" << joinLabels(labels, "le=\"" + formatValue(bounds[i] * family.scale) + "\"") << " " << cumulative << "\n";
+                }
+                cumulative += counts.back();
+                output << name << "_bucket" << joinLabels(labels, "le=\"+Inf\"") << " " << cumulative << "\n";
+                // Count is taken from buckets so that the output is consistent while observations are recorded
+                output << name << "_sum" << labels << " " << formatValue(histogram->getSum() * family.scale) << "\n";
+                output << name << "_count" << labels << " " << cumulative << "\n";
+            }
+            break;
+        }
+    }
+    return output.str();
+}
+
+static metric_labels_t withStatusLabel(const metric_labels_t& labels, const std::string& status) {
+    auto result = labels;
+    result.emplace_back("status", status);
+    return result;
+}
+
+ModelMetrics::ModelMetrics(const std::string& name, int64_t version) :
+    labels{{"name", name}, {"version", std::to_string(version)}} {
+    auto& registry = MetricsRegistry::instance();
+    const std::string requestsHelp = "Number of predict requests processed by model";
+    requestsSuccess = registry.getCounter("ovms_requests_total", requestsHelp, withStatusLabel(labels, "success"));
+    requestsFail = registry.getCounter("ovms_requests_total", requestsHelp, withStatusLabel(labels, "fail"));
+    requestLatency = registry.getLatencyHistogram("ovms_request_duration_seconds", "Time of processing predict request by model", labels);
+    inferRequestWaitLatency = registry.getLatencyHistogram("ovms_infer_request_wait_duration_seconds", "Time of waiting for free infer request", labels);
+    deserializationLatency = registry.getLatencyHistogram("ovms_deserialization_duration_seconds", "Time of deserializing request inputs", labels);
+    inferenceLatency = registry.getLatencyHistogram("ovms_inference_duration_seconds", "Time of inference", labels);
+    serializationLatency = registry.getLatencyHistogram("ovms_serialization_duration_seconds", "Time of serializing response outputs", labels);
+    inferRequestsPoolSize = registry.getGauge("ovms_infer_requests", "Number of infer requests of model", labels);
+    inferRequestsInUse = registry.getGauge("ovms_infer_requests_in_use", "Number of infer requests used by inferences in progress", labels);
+    inferRequestsWaiting = registry.getGauge("ovms_infer_requests_waiting", "Number of inferences waiting for free infer request", labels);
+    reloads = registry.getCounter("ovms_model_reloads_total", "Number of model reloads", labels);
+}
+
+void ModelMetrics::remove() {
+    auto& registry = MetricsRegistry::instance();
+    registry.removeSeries("ovms_requests_total", withStatusLabel(labels, "success"));
+    registry.removeSeries("ovms_requests_total", withStatusLabel(labels, "fail"));
+    for (const auto& name : {"ovms_request_duration_seconds", "ovms_infer_request_wait_duration_seconds", "ovms_deserialization_duration_seconds",
+             "ovms_inference_duration_seconds", "ovms_serialization_duration_seconds", "ovms_infer_requests", "ovms_infer_requests_in_use",
+             "ovms_infer_requests_waiting", "ovms_model_reloads_total"}) {
+        registry.removeSeries(name, labels);
+    }
+}
+
+PipelineMetrics::PipelineMetrics(const std::string& name) :
+    labels{{"name", name}} {
+    auto& registry = MetricsRegistry::instance();
+    const std::string requestsHelp = "Number of predict requests processed by pipeline";
+    requestsSuccess = registry.getCounter("ovms_pipeline_requests_total", requestsHelp, withStatusLabel(labels, "success"));
+    requestsFail = registry.getCounter("ovms_pipeline_requests_total", requestsHelp, withStatusLabel(labels, "fail"));
+    requestLatency = registry.getLatencyHistogram("ovms_pipeline_request_duration_seconds", "Time of pipeline execution", labels);
+}
+
+void PipelineMetrics::remove() {
+    auto& registry = MetricsRegistry::instance();
+    registry.removeSeries("ovms_pipeline_requests_total", withStatusLabel(labels, "success"));
+    registry.removeSeries("ovms_pipeline_requests_total", withStatusLabel(labels, "fail"));
+    registry.removeSeries("ovms_pipeline_request_duration_seconds", labels);
+}
+
+}  // namespace ovms
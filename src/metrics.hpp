@@ -0,0 +1,219 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ovms {
+
+/**
+ * @brief Number of copies of each metric value. Threads update their own copy, so they rarely contend on the same cache line.
+ */
+const size_t METRIC_SHARDS = 16;
+
+/**
+ * @brief Gets index of metric shard assigned to the calling thread
+ */
+size_t getMetricShardIndex();
+
+using metric_labels_t = std::vector<std::pair<std::string, std::string>>;
+
+class MetricCounter {
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Shard, METRIC_SHARDS> shards;
+
+public:
+    void increment(uint64_t value = 1) {
+        shards[getMetricShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t get() const;
+};
+
+class MetricGauge {
+    struct alignas(64) Shard {
+        std::atomic<int64_t> value{0};
+    };
+    std::array<Shard, METRIC_SHARDS> shards;
+
+public:
+    void add(int64_t value) {
+        shards[getMetricShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the value, not to be used concurrently with add
+     */
+    void set(int64_t value);
+
+    int64_t get() const;
+};
+
+/**
+ * @brief Histogram of integer observations, e.g. durations in microseconds
+ */
+class MetricHistogram {
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+    };
+
+    /**
+     * @brief Inclusive upper bounds of buckets, the last bucket without bound holds the rest
+     */
+    const std::vector<uint64_t> bounds;
+    std::array<Shard, METRIC_SHARDS> shards;
+
+public:
+    explicit MetricHistogram(const std::vector<uint64_t>& bounds);
+
+    void observe(uint64_t value);
+
+    /**
+     * @brief Observes duration in microseconds
+     */
+    template <typename Duration>
+    void observeDuration(Duration duration) {
+        observe(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    }
+
+    const std::vector<uint64_t>& getBounds() const {
+        return bounds;
+    }
+
+    /**
+     * @brief Gets counts of observations in each bucket, not cumulative, including the last unbounded one
+     */
+    std::vector<uint64_t> getBucketCounts() const;
+
+    uint64_t getCount() const;
+
+    uint64_t getSum() const;
+};
+
+/**
+ * @brief Keeps all metrics of the server and serializes them in Prometheus text format.
+ * Metrics are identified by name and labels, requesting the same metric again returns the existing one,
+ * so the values survive reloads of models and pipelines.
+ */
+class MetricsRegistry {
+    enum class MetricType {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    struct Family {
+        MetricType type;
+        std::string help;
+        /**
+         * @brief Scale of histogram observations, e.g. 1e-6 for durations in microseconds exported in seconds
+         */
+        double scale = 1;
+        std::map<std::string, std::shared_ptr<MetricCounter>> counters;
+        std::map<std::string, std::shared_ptr<MetricGauge>> gauges;
+        std::map<std::string, std::shared_ptr<MetricHistogram>> histograms;
+    };
+
+    mutable std::mutex mtx;
+    std::map<std::string, Family> families;
+
+    Family& getFamily(const std::string& name, const std::string& help, MetricType type);
+
+public:
+    static const std::vector<uint64_t> LATENCY_BUCKETS_MICROSECONDS;
+
+    static MetricsRegistry& instance();
+
+    std::shared_ptr<MetricCounter> getCounter(const std::string& name, const std::string& help, const metric_labels_t& labels);
+
+    std::shared_ptr<MetricGauge> getGauge(const std::string& name, const std::string& help, const metric_labels_t& labels);
+
+    /**
+     * @brief Gets histogram of durations in microseconds, exported in seconds
+     */
+    std::shared_ptr<MetricHistogram> getLatencyHistogram(const std::string& name, const std::string& help, const metric_labels_t& labels);
+
+    /**
+     * @brief Removes series with given labels from export, e.g. of retired model version.
+     * Metric objects held by callers stay valid, requesting the series again creates a new one.
+     */
+    void removeSeries(const std::string& name, const metric_labels_t& labels);
+
+    /**
+     * @brief Serializes all metrics in Prometheus text exposition format
+     */
+    std::string serialize() const;
+
+    static std::string formatLabels(const metric_labels_t& labels);
+};
+
+/**
+ * @brief Metrics of a single model version
+ */
+struct ModelMetrics {
+    const metric_labels_t labels;
+
+    std::shared_ptr<MetricCounter> requestsSuccess;
+    std::shared_ptr<MetricCounter> requestsFail;
+    std::shared_ptr<MetricHistogram> requestLatency;
+    std::shared_ptr<MetricHistogram> inferRequestWaitLatency;
+    std::shared_ptr<MetricHistogram> deserializationLatency;
+    std::shared_ptr<MetricHistogram> inferenceLatency;
+    std::shared_ptr<MetricHistogram> serializationLatency;
+    std::shared_ptr<MetricGauge> inferRequestsPoolSize;
+    std::shared_ptr<MetricGauge> inferRequestsInUse;
+    std::shared_ptr<MetricGauge> inferRequestsWaiting;
+    std::shared_ptr<MetricCounter> reloads;
+
+    ModelMetrics(const std::string& name, int64_t version);
+
+    /**
+     * @brief Removes series of retired model version from export
+     */
+    void remove();
+};
+
+/**
+ * @brief Metrics of a pipeline
+ */
+struct PipelineMetrics {
+    const metric_labels_t labels;
+    std::shared_ptr<MetricCounter> requestsSuccess;
+    std::shared_ptr<MetricCounter> requestsFail;
+    std::shared_ptr<MetricHistogram> requestLatency;
+
+    explicit PipelineMetrics(const std::string& name);
+
+    /**
+     * @brief Removes series of retired pipeline from export
+     */
+    void remove();
+};
+
+}  // namespace ovms
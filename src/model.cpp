@@ -15,19 +15,40 @@
 //*****************************************************************************
 #include "model.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <future>
 #include <map>
 #include <memory>
 #include <sstream>
+#include <thread>
 #include <utility>
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/util/threadpool_executor.h"
+#pragma GCC diagnostic pop
+
+#include "config.hpp"
 #include "customloaders.hpp"
+#include "inmemoryfiles.hpp"
 #include "localfilesystem.hpp"
 #include "logging.hpp"
 #include "modelmanager.hpp"
 
 namespace ovms {
 
+/**
+ * @brief Executor shared by all models so that the number of versions loaded at once is bounded regardless of how many models are loaded
+ */
+static tensorflow::serving::ThreadPoolExecutor& getModelVersionLoadExecutor() {
+    static tensorflow::serving::ThreadPoolExecutor executor(
+        tensorflow::Env::Default(),
+        "modelversionload",
+        Config::instance().modelLoadThreads() > 0 ? Config::instance().modelLoadThreads() : std::max(1u, std::thread::hardware_concurrency()));
+    return executor;
+}
+
 StatusCode downloadModels(std::shared_ptr<FileSystem>& fs, ModelConfig& config, std::shared_ptr<model_versions_t> versions) {
     if (versions->size() == 0) {
         return StatusCode::OK;
@@ -58,6 +79,7 @@ bool Model::isAnyVersionSubscribed() const {
     if (subscriptionManager.isSubscribed()) {
         return true;
     }
+    std::shared_lock lock(modelVersionsMtx);
     for (const auto& [name, instance] : modelVersions) {
         if (instance->getSubscribtionManager().isSubscribed()) {
             return true;
@@ -66,6 +88,19 @@ bool Model::isAnyVersionSubscribed() const {
     return false;
 }
 
+DownloadPriority Model::getDownloadPriority() const {
+    if (isAnyVersionSubscribed()) {
+        return DownloadPriority::HIGH;
+    }
+    std::shared_lock lock(modelVersionsMtx);
+    for (const auto& [version, instance] : modelVersions) {
+        if (!instance->canUnloadInstance()) {
+            return DownloadPriority::HIGH;
+        }
+    }
+    return DownloadPriority::NORMAL;
+}
+
 const std::map<model_version_t, const ModelInstance&> Model::getModelVersionsMapCopy() const {
     std::shared_lock lock(modelVersionsMtx);
     std::map<model_version_t, const ModelInstance&> modelInstancesMapCopy;
@@ -80,12 +115,14 @@ const std::map<model_version_t, std::shared_ptr<ModelInstance>>& Model::getModel
 }
 
 void Model::updateDefaultVersion(int ignoredVersion) {
+    // Versions may be added concurrently, selection and update of default version has to be atomic
+    std::unique_lock lock(modelVersionsMtx);
     model_version_t newDefaultVersion = 0;
     SPDLOG_INFO("Updating default version for model: {}, from: {}", getName(), defaultVersion);
     for (const auto& [version, versionInstance] : modelVersions) {
         if (version != ignoredVersion &&
             version > newDefaultVersion &&
-            ModelVersionState::AVAILABLE == versionInstance->getStatus().getState()) {
+            (ModelVersionState::AVAILABLE == versionInstance->getStatus().getState() || versionInstance->isLoadOnDemandRequired())) {
             newDefaultVersion = version;
         }
     }
@@ -132,21 +169,68 @@ Status Model::addVersion(const ModelConfig& config) {
 
 Status Model::addVersions(std::shared_ptr<model_versions_t> versionsToStart, ovms::ModelConfig& config, std::shared_ptr<FileSystem>& fs, std::shared_ptr<model_versions_t> versionsFailed) {
     Status result = StatusCode::OK;
-    downloadModels(fs, config, versionsToStart);
     versionsFailed->clear();
-    for (const auto version : *versionsToStart) {
+    const auto downloadPriority = getDownloadPriority();
+    DownloadScheduler::PriorityScope priorityScope(downloadPriority);
+    // Custom loader libraries are not required to be thread safe
+    const bool loadConcurrently = versionsToStart->size() > 1 && !config.isCustomLoaderRequiredToLoadModel();
+    // Versions from cloud storage are downloaded concurrently, each one is loaded as soon as its download finishes.
+    // Number of connections is bounded by download scheduler and number of versions in progress by version load executor.
+    const bool downloadEachVersion = loadConcurrently && dynamic_cast<LocalFileSystem*>(fs.get()) == nullptr;
+    if (!downloadEachVersion) {
+        downloadModels(fs, config, versionsToStart);
+    }
+    std::vector<ModelConfig> versionsConfigs(versionsToStart->size(), config);
+    std::vector<Status> statuses(versionsConfigs.size());
+    std::vector<std::promise<Status>> versionsLoaded(loadConcurrently ? versionsConfigs.size() : 0);
+    std::vector<std::future<Status>> versionsLoadedFutures;
+    for (auto& versionLoaded : versionsLoaded) {
+        versionsLoadedFutures.emplace_back(versionLoaded.get_future());
+    }
+    for (size_t i = 0; i < versionsConfigs.size(); i++) {
+        const auto version = (*versionsToStart)[i];
+        auto& versionConfig = versionsConfigs[i];
         SPDLOG_INFO("Will add model: {}; version: {} ...", getName(), version);
-        config.setVersion(version);
-        config.parseModelMapping();
-        auto status = addVersion(config);
+        versionConfig.setVersion(version);
+        if (!downloadEachVersion) {
+            versionConfig.parseModelMapping();
+        }
+        if (!loadConcurrently) {
+            statuses[i] = addVersion(versionConfig);
+        } else if (downloadEachVersion) {
+            getModelVersionLoadExecutor().Schedule([this, &fs, &versionsConfigs, &versionsLoaded, i, downloadPriority]() {
+                DownloadScheduler::PriorityScope priorityScope(downloadPriority);
+                auto& versionConfig = versionsConfigs[i];
+                Status status = downloadModels(fs, versionConfig, std::make_shared<model_versions_t>(1, versionConfig.getVersion()));
+                if (status.ok()) {
+                    versionConfig.parseModelMapping();
+                    status = addVersion(versionConfig);
+                }
+                versionsLoaded[i].set_value(status);
+            });
+        } else {
+            getModelVersionLoadExecutor().Schedule([this, &versionsConfigs, &versionsLoaded, i]() {
+                versionsLoaded[i].set_value(addVersion(versionsConfigs[i]));
+            });
+        }
+    }
+    for (size_t i = 0; i < versionsLoadedFutures.size(); i++) {
+        statuses[i] = versionsLoadedFutures[i].get();
+    }
+    if (!versionsConfigs.empty()) {
+        config.setVersion(versionsConfigs.back().getVersion());
+        config.setLocalPath(versionsConfigs.back().getLocalPath());
+    }
+    for (size_t i = 0; i < versionsConfigs.size(); i++) {
+        const auto& status = statuses[i];
         if (!status.ok()) {
             SPDLOG_ERROR("Error occurred while loading model: {}; version: {}; error: {}",
                 getName(),
-                version,
+                versionsConfigs[i].getVersion(),
                 status.string());
-            versionsFailed->push_back(version);
+            versionsFailed->push_back(versionsConfigs[i].getVersion());
             result = status;
-            cleanupModelTmpFiles(config);
+            cleanupModelTmpFiles(versionsConfigs[i]);
         }
     }
     return result;
@@ -196,6 +280,7 @@ void Model::retireAllVersions() {
 
 Status Model::reloadVersions(std::shared_ptr<model_versions_t> versionsToReload, ovms::ModelConfig& config, std::shared_ptr<FileSystem>& fs, std::shared_ptr<model_versions_t> versionsFailed) {
     Status result = StatusCode::OK;
+    DownloadScheduler::PriorityScope priorityScope(getDownloadPriority());
     for (const auto version : *versionsToReload) {
         SPDLOG_INFO("Will reload model: {}; version: {} ...", getName(), version);
         config.setVersion(version);
@@ -226,7 +311,10 @@ Status Model::reloadVersions(std::shared_ptr<model_versions_t> versionsToReload,
                 version,
                 status.string());
             result = status;
-            versionsFailed->push_back(version);
+            // Failed background reload keeps the previous network serving, so the version must not be retired
+            if (modelVersion->getStatus().getState() != ModelVersionState::AVAILABLE) {
+                versionsFailed->push_back(version);
+            }
             continue;
         }
         updateDefaultVersion();
@@ -241,6 +329,8 @@ Status Model::cleanupModelTmpFiles(const ModelConfig& config) {
     if (config.isCloudStored()) {
         LocalFileSystem lfs;
         lfstatus = lfs.deleteFileFolder(config.getPath());
+        // Model files downloaded to memory are released once links to them are removed
+        InMemoryFiles::instance().release(config.getPath());
         if (lfstatus != StatusCode::OK) {
             SPDLOG_ERROR("Error occurred while deleting local copy of cloud model: {} reason: {}",
                 config.getLocalPath(),
@@ -22,6 +22,7 @@
 #include <utility>
 #include <vector>
 
+#include "downloadscheduler.hpp"
 #include "filesystem.hpp"
 #include "modelchangesubscription.hpp"
 #include "modelinstance.hpp"
@@ -196,6 +197,13 @@ public:
 
     bool isAnyVersionSubscribed() const;
 
+    /**
+         * @brief Gets priority of model files downloads, models used by pipelines or serving requests are downloaded first
+         *
+         * @return priority
+         */
+    DownloadPriority getDownloadPriority() const;
+
     void setCustomLoaderName(const std::string name) {
         customLoaderName = name;
     }
@@ -62,6 +62,14 @@ bool ModelConfig::isReloadRequired(const ModelConfig& rhs) const {
         SPDLOG_DEBUG("ModelConfig {} reload required due to nireq mismatch", this->name);
         return true;
     }
+    if (this->resultCacheSize != rhs.resultCacheSize) {
+        SPDLOG_DEBUG("ModelConfig {} reload required due to result cache size mismatch", this->name);
+        return true;
+    }
+    if (this->pinned != rhs.pinned) {
+        SPDLOG_DEBUG("ModelConfig {} reload required due to pinned mismatch", this->name);
+        return true;
+    }
     if (this->pluginConfig != rhs.pluginConfig) {
         SPDLOG_DEBUG("ModelConfig {} reload required due to plugin config mismatch", this->name);
         return true;
@@ -358,6 +366,14 @@ Status ModelConfig::parseNode(const rapidjson::Value& v) {
     }
     if (v.HasMember("nireq"))
         this->setNireq(v["nireq"].GetUint64());
+    if (v.HasMember("result_cache_size_mb"))
+        this->setResultCacheSize(v["result_cache_size_mb"].GetUint64() * 1024 * 1024);
+    if (v.HasMember("warmup_iterations"))
+        this->setWarmupIterations(v["warmup_iterations"].GetUint());
+    if (v.HasMember("warmup_data"))
+        this->setWarmupData(v["warmup_data"].GetString());
+    if (v.HasMember("pinned"))
+        this->setPinned(v["pinned"].GetBool());
 
     if (v.HasMember("shape")) {
         // Legacy format as string
@@ -444,6 +460,10 @@ Status ModelConfig::parseNode(const rapidjson::Value& v) {
         SPDLOG_DEBUG("model_version_policy: {}", std::string(*getModelVersionPolicy()));
     }
     SPDLOG_DEBUG("nireq: {}", getNireq());
+    SPDLOG_DEBUG("result_cache_size_mb: {}", getResultCacheSize() / (1024 * 1024));
+    SPDLOG_DEBUG("warmup_iterations: {}", getWarmupIterations());
+    SPDLOG_DEBUG("warmup_data: {}", getWarmupData());
+    SPDLOG_DEBUG("pinned: {}", isPinned());
     SPDLOG_DEBUG("target_device: {}", getTargetDevice());
     SPDLOG_DEBUG("plugin_config:");
     for (auto& [pluginParameter, pluginValue] : getPluginConfig()) {
@@ -103,6 +103,26 @@ private:
          */
     uint64_t nireq;
 
+    /**
+         * @brief Capacity of inference results cache in bytes, 0 disables caching
+         */
+    size_t resultCacheSize = 0;
+
+    /**
+         * @brief Number of warmup inferences run on each infer request before model becomes available
+         */
+    uint32_t warmupIterations = 0;
+
+    /**
+         * @brief Warmup inputs - zeros, random or path to JSON file with predict request
+         */
+    std::string warmupData;
+
+    /**
+         * @brief Pinned model is loaded at startup and never unloaded to free memory
+         */
+    bool pinned = false;
+
     /**
          * @brief Plugin config
          */
@@ -426,6 +446,78 @@ public:
         this->nireq = nireq;
     }
 
+    /**
+         * @brief Get the inference results cache capacity in bytes
+         * 
+         * @return size_t 
+         */
+    size_t getResultCacheSize() const {
+        return this->resultCacheSize;
+    }
+
+    /**
+         * @brief Set the inference results cache capacity in bytes
+         * 
+         * @param resultCacheSize 
+         */
+    void setResultCacheSize(const size_t resultCacheSize) {
+        this->resultCacheSize = resultCacheSize;
+    }
+
+    /**
+         * @brief Get the number of warmup inferences per infer request
+         * 
+         * @return uint32_t
+         */
+    uint32_t getWarmupIterations() const {
+        return this->warmupIterations;
+    }
+
+    /**
+         * @brief Set the number of warmup inferences per infer request
+         * 
+         * @param warmupIterations 
+         */
+    void setWarmupIterations(const uint32_t warmupIterations) {
+        this->warmupIterations = warmupIterations;
+    }
+
+    /**
+         * @brief Get the warmup inputs source
+         * 
+         * @return const std::string&
+         */
+    const std::string& getWarmupData() const {
+        return this->warmupData;
+    }
+
+    /**
+         * @brief Set the warmup inputs source
+         * 
+         * @param warmupData zeros, random or path to JSON file with predict request
+         */
+    void setWarmupData(const std::string& warmupData) {
+        this->warmupData = warmupData;
+    }
+
+    /**
+         * @brief Check if model is pinned in memory
+         * 
+         * @return bool
+         */
+    bool isPinned() const {
+        return this->pinned;
+    }
+
+    /**
+         * @brief Set if model is pinned in memory
+         * 
+         * @param pinned 
+         */
+    void setPinned(const bool pinned) {
+        this->pinned = pinned;
+    }
+
     /**
          * @brief Get the plugin config
          * 
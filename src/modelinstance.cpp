@@ -16,9 +16,13 @@
 #include "modelinstance.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <utility>
@@ -27,10 +31,16 @@
 #include <spdlog/spdlog.h>
 #include <sys/types.h>
 
+#include "compilednetworkcache.hpp"
 #include "config.hpp"
+#include "coreregistry.hpp"
 #include "customloaders.hpp"
 #include "filesystem.hpp"
 #include "logging.hpp"
+#include "mappedfile.hpp"
+#include "modelmemorybudget.hpp"
+#include "modelwarmup.hpp"
+#include "onnxconversioncache.hpp"
 #include "stringutils.hpp"
 
 using namespace InferenceEngine;
@@ -53,6 +63,10 @@ void ModelInstance::subscribe(PipelineDefinition& pd) {
 void ModelInstance::unsubscribe(PipelineDefinition& pd) {
     subscriptionManager.unsubscribe(pd);
 }
+ModelInstance::~ModelInstance() {
+    ModelMemoryBudget::instance().remove(*this);
+}
+
 Status ModelInstance::loadInputTensors(const ModelConfig& config, const DynamicModelParameter& parameter) {
     if (config.isShapeAnonymousFixed() && network->getInputsInfo().size() > 1) {
         Status status = StatusCode::ANONYMOUS_FIXED_SHAPE_NOT_ALLOWED;
@@ -238,25 +252,27 @@ uint ModelInstance::getNumOfParallelInferRequests(const ModelConfig& modelConfig
 }
 
 void ModelInstance::loadOVEngine() {
-    engine = std::make_unique<InferenceEngine::Core>();
-    if (ovms::Config::instance().cpuExtensionLibraryPath() != "") {
-        SPDLOG_INFO("Loading custom CPU extension from {}", ovms::Config::instance().cpuExtensionLibraryPath());
-        try {
-            auto extension_ptr = InferenceEngine::make_so_pointer<InferenceEngine::IExtension>(ovms::Config::instance().cpuExtensionLibraryPath().c_str());
-            SPDLOG_INFO("Custom CPU extention loaded. Adding it.");
-            engine->AddExtension(extension_ptr, "CPU");
-            SPDLOG_INFO("Extention added.");
-        } catch (std::exception& ex) {
-            SPDLOG_CRITICAL("Custom CPU extention loading has failed! Reason: {}", ex.what());
-            throw;
-        } catch (...) {
-            SPDLOG_CRITICAL("Custom CPU extention loading has failed with an unknown error!");
-            throw;
-        }
-    }
+    engine = CoreRegistry::instance().getCore(ovms::Config::instance().cpuExtensionLibraryPath());
 }
 
 std::unique_ptr<InferenceEngine::CNNNetwork> ModelInstance::loadOVCNNNetworkPtr(const std::string& modelFile) {
+    const std::string mmapMode = ovms::Config::instance().weightsMmapMode();
+    if (mmapMode != MappedFile::MODE_OFF && endsWith(modelFile, OV_MODEL_FILES_EXTENSIONS[0]) &&
+        modelFiles.size() == OV_MODEL_FILES_EXTENSIONS.size()) {
+        auto mappedWeights = MappedFile::open(modelFiles[1], mmapMode);
+        std::ifstream xmlFile(modelFile);
+        if (mappedWeights && xmlFile) {
+            std::stringstream xml;
+            xml << xmlFile.rdbuf();
+            // Blob references the mapping, weights are not copied to process memory
+            auto weightsBlob = make_shared_blob<uint8_t>({Precision::U8, {mappedWeights->size()}, C},
+                const_cast<uint8_t*>(mappedWeights->data()), mappedWeights->size());
+            auto result = std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(xml.str(), weightsBlob));
+            weights = std::move(mappedWeights);
+            return result;
+        }
+        SPDLOG_DEBUG("Could not map weights of model: {} version: {}; reading them to memory", getName(), getVersion());
+    }
     return std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(modelFile));
 }
 
@@ -264,7 +280,21 @@ Status ModelInstance::loadOVCNNNetwork() {
     auto& modelFile = modelFiles[0];
     SPDLOG_DEBUG("Try reading model file: {}", modelFile);
     try {
+        auto& onnxConversionCache = OnnxConversionCache::instance();
+        std::string digest;
+        if (onnxConversionCache.isEnabled() && endsWith(modelFile, ONNX_MODEL_FILES_EXTENSIONS[0]) &&
+            OnnxConversionCache::createDigest(modelFile, digest)) {
+            network = onnxConversionCache.readNetwork(digest, *engine);
+            if (network) {
+                SPDLOG_INFO("Model: {} version: {} converted network read from ONNX conversion cache", getName(), getVersion());
+                return StatusCode::OK;
+            }
+        }
         network = loadOVCNNNetworkPtr(modelFile);
+        // Store network before any reshape so the entry does not depend on model shape parameters
+        if (!digest.empty()) {
+            onnxConversionCache.storeNetwork(digest, *network);
+        }
     } catch (std::exception& e) {
         SPDLOG_ERROR("Error: {}; occurred during loading CNNNetwork for model: {} version: {}", e.what(), getName(), getVersion());
         return StatusCode::INTERNAL_ERROR;
@@ -276,7 +306,9 @@ Status ModelInstance::loadOVCNNNetworkUsingCustomLoader() {
     SPDLOG_DEBUG("Try reading model using a custom loader");
     try {
         std::vector<uint8_t> model;
-        std::vector<uint8_t> weights;
+        // Network keeps referencing weights buffer, so it lives as long as the network
+        auto weightsBuffer = std::make_shared<std::vector<uint8_t>>();
+        auto& weights = *weightsBuffer;
 
         SPDLOG_INFO("loading CNNNetwork for model: {} basepath: {} <> {} version: {}", getName(), getPath(), this->config.getBasePath().c_str(), getVersion());
 
@@ -290,6 +322,11 @@ Status ModelInstance::loadOVCNNNetworkUsingCustomLoader() {
             throw std::invalid_argument("customloader not exisiting");
         }
 
+        auto customLoaderInterfaceV2Ptr = customloaders.findV2(loaderName);
+        if (customLoaderInterfaceV2Ptr != nullptr) {
+            return loadOVCNNNetworkUsingCustomLoaderV2(*customLoaderInterfaceV2Ptr);
+        }
+
         CustomLoaderStatus res = customLoaderInterfacePtr->loadModel(this->config.getName(),
             this->config.getBasePath(),
             getVersion(),
@@ -304,6 +341,7 @@ Status ModelInstance::loadOVCNNNetworkUsingCustomLoader() {
         if (res == CustomLoaderStatus::MODEL_TYPE_IR) {
             network = std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(strModel,
                 make_shared_blob<uint8_t>({Precision::U8, {weights.size()}, C}, weights.data())));
+            this->weights = std::move(weightsBuffer);
         } else if (res == CustomLoaderStatus::MODEL_TYPE_ONNX) {
             network = std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(strModel, InferenceEngine::Blob::CPtr()));
         } else if (res == CustomLoaderStatus::MODEL_TYPE_BLOB) {
@@ -316,6 +354,36 @@ Status ModelInstance::loadOVCNNNetworkUsingCustomLoader() {
     return StatusCode::OK;
 }
 
+Status ModelInstance::loadOVCNNNetworkUsingCustomLoaderV2(CustomLoaderInterfaceV2& customLoader) {
+    CustomLoaderModelBuffers buffers;
+    CustomLoaderStatus res = customLoader.loadModelBuffers(this->config.getName(),
+        this->config.getBasePath(),
+        getVersion(),
+        this->config.getCustomLoaderOptionsConfigStr(), buffers);
+
+    if ((res == CustomLoaderStatus::MODEL_LOAD_ERROR) || (res == CustomLoaderStatus::INTERNAL_ERROR) ||
+        (res == CustomLoaderStatus::MODEL_TYPE_BLOB) || (buffers.model == nullptr)) {
+        return StatusCode::INTERNAL_ERROR;
+    }
+
+    std::string strModel(reinterpret_cast<const char*>(buffers.model.get()), buffers.modelSize);
+    // Model description is copied, so loader can release it right away
+    buffers.model.reset();
+
+    if (res == CustomLoaderStatus::MODEL_TYPE_IR) {
+        if (buffers.weights == nullptr) {
+            return StatusCode::INTERNAL_ERROR;
+        }
+        network = std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(strModel,
+            make_shared_blob<uint8_t>({Precision::U8, {buffers.weightsSize}, C},
+                const_cast<uint8_t*>(buffers.weights.get()), buffers.weightsSize)));
+        this->weights = std::move(buffers.weights);
+    } else if (res == CustomLoaderStatus::MODEL_TYPE_ONNX) {
+        network = std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(strModel, InferenceEngine::Blob::CPtr()));
+    }
+    return StatusCode::OK;
+}
+
 void ModelInstance::loadExecutableNetworkPtr(const plugin_config_t& pluginConfig) {
     execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(engine->LoadNetwork(*network, targetDevice, pluginConfig));
 }
@@ -339,7 +407,19 @@ plugin_config_t ModelInstance::prepareDefaultPluginConfig(const ModelConfig& con
 Status ModelInstance::loadOVExecutableNetwork(const ModelConfig& config) {
     plugin_config_t pluginConfig = prepareDefaultPluginConfig(config);
     try {
-        loadExecutableNetworkPtr(pluginConfig);
+        auto& compiledNetworkCache = CompiledNetworkCache::instance();
+        std::string cacheKey;
+        // Model files are not known when custom loader is used
+        if (compiledNetworkCache.isEnabled() && !config.isCustomLoaderRequiredToLoadModel() &&
+            CompiledNetworkCache::createKey(modelFiles, targetDevice, pluginConfig, *network, cacheKey) &&
+            compiledNetworkCache.importNetwork(cacheKey, *engine, targetDevice, pluginConfig, execNetwork)) {
+            SPDLOG_INFO("Model: {} version: {} compiled network imported from cache", getName(), getVersion());
+        } else {
+            loadExecutableNetworkPtr(pluginConfig);
+            if (!cacheKey.empty()) {
+                compiledNetworkCache.exportNetwork(cacheKey, *execNetwork);
+            }
+        }
     } catch (std::exception& e) {
         Status status = StatusCode::CANNOT_LOAD_NETWORK_INTO_TARGET_DEVICE;
         SPDLOG_ERROR("{}; error: {}; model: {}; version: {}; device: {}",
@@ -366,6 +446,7 @@ Status ModelInstance::fetchModelFilepaths() {
     }
 
     SPDLOG_DEBUG("Getting model files from path: {}", path);
+    modelFiles.clear();
     if (!dirExists(path)) {
         SPDLOG_ERROR("Missing model directory {}", path);
         return StatusCode::PATH_INVALID;
@@ -405,7 +486,7 @@ Status ModelInstance::prepareInferenceRequestsQueue(const ModelConfig& config) {
     if (numberOfParallelInferRequests == 0) {
         return Status(StatusCode::INVALID_NIREQ, "Exceeded allowed nireq value");
     }
-    inferRequestsQueue = std::make_unique<OVInferRequestsQueue>(*execNetwork, numberOfParallelInferRequests);
+    inferRequestsQueue = std::make_unique<OVInferRequestsQueue>(*execNetwork, numberOfParallelInferRequests, metrics);
     SPDLOG_INFO("Loaded model {}; version: {}; batch size: {}; No of InferRequests: {}",
         getName(),
         getVersion(),
@@ -436,6 +517,7 @@ Status ModelInstance::loadModelImpl(const ModelConfig& config, const DynamicMode
         if (!this->engine)
             loadOVEngine();
         status = StatusCode::OK;
+        auto readStart = std::chrono::steady_clock::now();
         if (!this->network) {
             if (this->config.isCustomLoaderRequiredToLoadModel()) {
                 // loading the model using the custom loader
@@ -457,26 +539,139 @@ Status ModelInstance::loadModelImpl(const ModelConfig& config, const DynamicMode
             return status;
         }
         loadOutputTensors(this->config);
+        auto compileStart = std::chrono::steady_clock::now();
         status = loadOVExecutableNetwork(this->config);
         if (!status.ok()) {
             this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
             return status;
         }
+        auto compileEnd = std::chrono::steady_clock::now();
+        SPDLOG_INFO("Model: {}, version: {} network read and reshaped in {} ms, compiled in {} ms",
+            getName(), getVersion(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(compileStart - readStart).count(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(compileEnd - compileStart).count());
+        batchSize = network->getBatchSize();
         status = prepareInferenceRequestsQueue(this->config);
         if (!status.ok()) {
             this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
             return status;
         }
+        // Reshape triggered by request is not warmed up, since the request waits for it
+        if (parameter.isDefault()) {
+            auto warmupStatus = ModelWarmup::run(this->config, inputsInfo, *inferRequestsQueue);
+            if (!warmupStatus.ok()) {
+                SPDLOG_WARN("Warmup of model: {} version: {} failed with error: {}; model will be available without warmup",
+                    getName(), getVersion(), warmupStatus.string());
+            }
+        }
+        if (this->config.getResultCacheSize() > 0) {
+            SPDLOG_DEBUG("Enabling results cache of size: {} bytes for model: {} version: {}",
+                this->config.getResultCacheSize(), getName(), getVersion());
+            std::atomic_store(&resultCache, std::make_shared<ResultCache>(this->config.getResultCacheSize()));
+        } else {
+            std::atomic_store(&resultCache, std::shared_ptr<ResultCache>());
+        }
     } catch (const InferenceEngine::details::InferenceEngineException& e) {
         SPDLOG_ERROR("exception occurred while loading network: {}", e.what());
         this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
         return StatusCode::NETWORK_NOT_LOADED;
     }
+    markUsed();
     this->status.setAvailable();
     modelLoadedNotify.notify_all();
     return status;
 }
 
+void ModelInstance::updateMemoryBudget() {
+    auto& memoryBudget = ModelMemoryBudget::instance();
+    // Memory used by models loaded with custom loader can not be estimated
+    if (memoryBudget.isEnabled() && !this->config.isCustomLoaderRequiredToLoadModel()) {
+        memoryBudget.add(*this, estimateMemoryUsage(), this->config.isPinned());
+        memoryBudget.evictIfExceeded(*this);
+    }
+}
+
+size_t ModelInstance::estimateMemoryUsage() const {
+    // Compiled network size is roughly proportional to the size of model weights
+    size_t bytes = 0;
+    for (const auto& file : modelFiles) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(file, ec);
+        if (!ec) {
+            bytes += size;
+        }
+    }
+    return bytes;
+}
+
+size_t ModelInstance::estimateLoadMemoryUsage(const ModelConfig& config) {
+    // Memory used by models loaded with custom loader can not be estimated
+    if (!ModelMemoryBudget::instance().isEnabled() || config.isCustomLoaderRequiredToLoadModel()) {
+        return 0;
+    }
+    size_t bytes = 0;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(config.getPath(), ec)) {
+        if (entry.is_regular_file(ec)) {
+            auto size = entry.file_size(ec);
+            if (!ec) {
+                bytes += size;
+            }
+        }
+    }
+    return bytes;
+}
+
+void ModelInstance::markUsed() {
+    lastUsedTime.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+bool ModelInstance::isLoadOnDemandAllowed(const ModelConfig& config) {
+    return Config::instance().loadModelsOnDemand() && !config.isPinned() && !config.isCustomLoaderRequiredToLoadModel();
+}
+
+Status ModelInstance::loadOnDemand() {
+    std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
+    if (!loadOnDemandRequired) {
+        // Already loaded by another request or unloaded permanently in the meantime
+        return StatusCode::OK;
+    }
+    SPDLOG_INFO("Loading model: {} version: {} on demand", getName(), getVersion());
+    auto loadStart = std::chrono::steady_clock::now();
+    ModelLoadReservation loadReservation(ModelMemoryBudget::instance(), estimateLoadMemoryUsage(config));
+    auto status = loadModelImpl(config);
+    if (!status.ok()) {
+        SPDLOG_ERROR("Error occurred while loading model: {} version: {} on demand; error: {}", getName(), getVersion(), status.string());
+        return status;
+    }
+    loadOnDemandRequired = false;
+    updateMemoryBudget();
+    auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - loadStart).count();
+    auto& memoryBudget = ModelMemoryBudget::instance();
+    memoryBudget.recordColdLoad(loadTime);
+    SPDLOG_INFO("Model: {} version: {} loaded on demand in {} ms; loads on demand: {}; total time: {} ms",
+        getName(), getVersion(), loadTime, memoryBudget.getColdLoads(), memoryBudget.getColdLoadsTotalMilliseconds());
+    return status;
+}
+
+bool ModelInstance::unloadToFreeMemory() {
+    std::unique_lock<std::recursive_mutex> loadingLock(loadingMutex, std::try_to_lock);
+    if (!loadingLock.owns_lock() || getStatus().getState() != ModelVersionState::AVAILABLE) {
+        return false;
+    }
+    // Requests which acquire unload guard from now on see the model is not available
+    this->status.setLoading();
+    if (!canUnloadInstance()) {
+        this->status.setAvailable();
+        return false;
+    }
+    SPDLOG_INFO("Unloading model: {} version: {} to free memory", getName(), getVersion());
+    releaseResources();
+    loadOnDemandRequired = true;
+    modelLoadedNotify.notify_all();
+    return true;
+}
+
 Status ModelInstance::loadModel(const ModelConfig& config) {
     std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
     SPDLOG_INFO("Loading model: {}, version: {}, from path: {}, with target device: {} ...",
@@ -488,18 +683,108 @@ Status ModelInstance::loadModel(const ModelConfig& config) {
     }
     this->status = ModelVersionStatus(config.getName(), config.getVersion());
     this->status.setLoading();
-    return loadModelImpl(config);
+    if (isLoadOnDemandAllowed(config)) {
+        SPDLOG_INFO("Model: {} version: {} will be loaded on first request", config.getName(), config.getVersion());
+        this->path = config.getPath();
+        this->targetDevice = config.getTargetDevice();
+        this->config = config;
+        loadOnDemandRequired = true;
+        return StatusCode::OK;
+    }
+    ModelLoadReservation loadReservation(ModelMemoryBudget::instance(), estimateLoadMemoryUsage(config));
+    auto status = loadModelImpl(config);
+    if (status.ok()) {
+        updateMemoryBudget();
+    }
+    return status;
 }
 
 Status ModelInstance::reloadModel(const ModelConfig& config, const DynamicModelParameter& parameter) {
     std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
+    if (loadOnDemandRequired) {
+        SPDLOG_INFO("Model: {} version: {} is not loaded, new configuration will be used on first request", getName(), getVersion());
+        this->path = config.getPath();
+        this->targetDevice = config.getTargetDevice();
+        this->config = config;
+        return StatusCode::OK;
+    }
+    if (getStatus().getState() == ModelVersionState::END) {
+        // Series of retired version were removed from export, version added back to config starts with new ones
+        metrics = std::make_shared<ModelMetrics>(getName(), getVersion());
+    }
+    metrics->reloads->increment();
+    // Custom loaders expect the previous model to be released before loading it again
+    if (getStatus().getState() == ModelVersionState::AVAILABLE &&
+        !config.isCustomLoaderRequiredToLoadModel() && !this->config.isCustomLoaderRequiredToLoadModel()) {
+        return reloadModelInBackground(config, parameter);
+    }
     this->status.setLoading();
     while (!canUnloadInstance()) {
         SPDLOG_INFO("Waiting to reload model: {} version: {}. Blocked by: {} inferences in progress.",
             getName(), getVersion(), predictRequestsHandlesCount);
         std::this_thread::sleep_for(std::chrono::milliseconds(UNLOAD_AVAILABILITY_CHECKING_INTERVAL_MILLISECONDS));
     }
-    return loadModelImpl(config, parameter);
+    ModelLoadReservation loadReservation(ModelMemoryBudget::instance(), estimateLoadMemoryUsage(config));
+    auto status = loadModelImpl(config, parameter);
+    if (status.ok()) {
+        updateMemoryBudget();
+    }
+    return status;
+}
+
+Status ModelInstance::reloadModelInBackground(const ModelConfig& config, const DynamicModelParameter& parameter) {
+    SPDLOG_INFO("Building new network for model: {} version: {} while the current one is serving", getName(), getVersion());
+    auto buildStart = std::chrono::steady_clock::now();
+    ModelInstance shadow(getName(), getVersion());
+    shadow.engine = engine;
+    // Network is reused to avoid reading model files again on reshape. Weights stay shared with
+    // the current instance, since its compiled network keeps serving until the swap.
+    if (network) {
+        shadow.network = std::make_unique<InferenceEngine::CNNNetwork>(*network);
+    }
+    shadow.weights = weights;
+    // Current network keeps its memory until the swap, so the new one has to fit besides it
+    ModelLoadReservation loadReservation(ModelMemoryBudget::instance(), estimateLoadMemoryUsage(config));
+    auto status = shadow.loadModelImpl(config, parameter);
+    if (!status.ok()) {
+        // Network may be left reshaped, so it is read again on the next reload
+        network.reset();
+        SPDLOG_ERROR("Failed to build new network for model: {} version: {}; error: {}; current network keeps serving",
+            getName(), getVersion(), status.string());
+        return status;
+    }
+    auto swapStart = std::chrono::steady_clock::now();
+    // Requests already validated against the current network have to finish on it
+    this->status.setLoading();
+    while (!canUnloadInstance()) {
+        SPDLOG_DEBUG("Waiting to swap network of model: {} version: {}. Blocked by: {} inferences in progress.",
+            getName(), getVersion(), predictRequestsHandlesCount);
+        std::this_thread::sleep_for(std::chrono::milliseconds(UNLOAD_AVAILABILITY_CHECKING_INTERVAL_MILLISECONDS));
+    }
+    std::swap(this->config, shadow.config);
+    std::swap(path, shadow.path);
+    std::swap(targetDevice, shadow.targetDevice);
+    std::swap(modelFiles, shadow.modelFiles);
+    std::swap(network, shadow.network);
+    std::swap(weights, shadow.weights);
+    std::swap(execNetwork, shadow.execNetwork);
+    std::swap(inferRequestsQueue, shadow.inferRequestsQueue);
+    std::swap(inputsInfo, shadow.inputsInfo);
+    std::swap(outputsInfo, shadow.outputsInfo);
+    std::swap(batchSize, shadow.batchSize);
+    shadow.resultCache = std::atomic_exchange(&resultCache, shadow.resultCache);
+    markUsed();
+    this->status.setAvailable();
+    modelLoadedNotify.notify_all();
+    auto swapEnd = std::chrono::steady_clock::now();
+    SPDLOG_INFO("Model: {} version: {} new network built in {} ms and swapped in {} ms",
+        getName(), getVersion(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(swapStart - buildStart).count(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(swapEnd - swapStart).count());
+    subscriptionManager.notifySubscribers();
+    updateMemoryBudget();
+    // Previous network is released together with shadow instance
+    return StatusCode::OK;
 }
 
 Status ModelInstance::recoverFromReloadingError(const Status& status) {
@@ -536,6 +821,10 @@ Status ModelInstance::reloadModel(size_t batchSize, std::map<std::string, shape_
 
     auto status = reloadModel(config, parameter);
     if (!status.ok()) {
+        if (getStatus().getState() == ModelVersionState::AVAILABLE) {
+            // Failed build did not affect the network which is serving
+            return status;
+        }
         return this->recoverFromReloadingError(status);
     } else {
         unloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
@@ -550,10 +839,24 @@ Status ModelInstance::waitForLoaded(const uint waitForModelLoadedTimeoutMillisec
     modelInstanceUnloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
     if (getStatus().getState() == ModelVersionState::AVAILABLE) {
         SPDLOG_DEBUG("Model: {}, version: {} already loaded", getName(), getVersion());
+        markUsed();
         return StatusCode::OK;
     }
     modelInstanceUnloadGuard.reset();
 
+    if (loadOnDemandRequired) {
+        auto status = loadOnDemand();
+        if (!status.ok()) {
+            return status;
+        }
+        modelInstanceUnloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
+        if (getStatus().getState() == ModelVersionState::AVAILABLE) {
+            markUsed();
+            return StatusCode::OK;
+        }
+        modelInstanceUnloadGuard.reset();
+    }
+
     // wait several time since no guarantee that cv wakeup will be triggered before calling wait_for
     const uint waitLoadedTimestepMilliseconds = 100;
     const uint waitCheckpoints = waitForModelLoadedTimeoutMilliseconds / waitLoadedTimestepMilliseconds;
@@ -563,7 +866,13 @@ Status ModelInstance::waitForLoaded(const uint waitForModelLoadedTimeoutMillisec
     std::mutex cv_mtx;
     std::unique_lock<std::mutex> cv_lock(cv_mtx);
     while (waitCheckpointsCounter-- > 0) {
-        if (modelLoadedNotify.wait_for(cv_lock,
+        // Model could have been unloaded to free memory while waiting
+        if (loadOnDemandRequired) {
+            auto status = loadOnDemand();
+            if (!status.ok()) {
+                return status;
+            }
+        } else if (modelLoadedNotify.wait_for(cv_lock,
                 std::chrono::milliseconds(waitLoadedTimestepMilliseconds),
                 [this]() {
                     return this->getStatus().getState() > ModelVersionState::LOADING;
@@ -574,6 +883,7 @@ Status ModelInstance::waitForLoaded(const uint waitForModelLoadedTimeoutMillisec
         modelInstanceUnloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
         if (getStatus().getState() == ModelVersionState::AVAILABLE) {
             SPDLOG_INFO("Succesfully waited for model: {}, version: {}", getName(), getVersion());
+            markUsed();
             return StatusCode::OK;
         }
         modelInstanceUnloadGuard.reset();
@@ -593,6 +903,21 @@ Status ModelInstance::waitForLoaded(const uint waitForModelLoadedTimeoutMillisec
     }
 }
 
+void ModelInstance::updateInferenceLatencyEstimate(uint64_t latencyMicroseconds) {
+    // Weight of the newest measurement equals 1/INFERENCE_LATENCY_SMOOTHING_FACTOR
+    static constexpr int64_t INFERENCE_LATENCY_SMOOTHING_FACTOR = 8;
+    uint64_t current = inferenceLatencyEstimateMicroseconds.load();
+    uint64_t updated;
+    do {
+        if (current == 0) {
+            updated = latencyMicroseconds;
+        } else {
+            int64_t difference = static_cast<int64_t>(latencyMicroseconds) - static_cast<int64_t>(current);
+            updated = static_cast<uint64_t>(static_cast<int64_t>(current) + difference / INFERENCE_LATENCY_SMOOTHING_FACTOR);
+        }
+    } while (!inferenceLatencyEstimateMicroseconds.compare_exchange_weak(current, updated));
+}
+
 void ModelInstance::unloadModel(bool isPermanent) {
     std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
     if (isPermanent) {
@@ -600,21 +925,18 @@ void ModelInstance::unloadModel(bool isPermanent) {
     } else {
         this->status.setLoading();
     }
+    loadOnDemandRequired = false;
     subscriptionManager.notifySubscribers();
     while (!canUnloadInstance()) {
         SPDLOG_DEBUG("Waiting to unload model: {} version: {}. Blocked by: {} inferences in progres.",
             getName(), getVersion(), predictRequestsHandlesCount);
         std::this_thread::sleep_for(std::chrono::milliseconds(UNLOAD_AVAILABILITY_CHECKING_INTERVAL_MILLISECONDS));
     }
-    inferRequestsQueue.reset();
-    execNetwork.reset();
-    network.reset();
-    engine.reset();
-    outputsInfo.clear();
-    inputsInfo.clear();
-    modelFiles.clear();
+    releaseResources();
+    ModelMemoryBudget::instance().remove(*this);
     if (isPermanent) {
         status.setEnd();
+        metrics->remove();
     }
 
     if (this->config.isCustomLoaderRequiredToLoadModel()) {
@@ -632,6 +954,18 @@ void ModelInstance::unloadModel(bool isPermanent) {
     }
 }
 
+void ModelInstance::releaseResources() {
+    inferRequestsQueue.reset();
+    std::atomic_store(&resultCache, std::shared_ptr<ResultCache>());
+    execNetwork.reset();
+    network.reset();
+    weights.reset();
+    engine.reset();
+    outputsInfo.clear();
+    inputsInfo.clear();
+    modelFiles.clear();
+}
+
 const Status ModelInstance::validatePrecision(const ovms::TensorInfo& networkInput,
     const tensorflow::TensorProto& requestInput) {
     // Network and request must have the same precision
@@ -743,6 +1077,17 @@ const Status ModelInstance::validateTensorContentSize(const ovms::TensorInfo& ne
 const Status ModelInstance::validate(const tensorflow::serving::PredictRequest* request) {
     Status finalStatus = StatusCode::OK;
 
+    // Outputs requested in output filter must exist in network
+    for (const auto& outputName : request->output_filter()) {
+        if (getOutputsInfo().count(outputName) == 0) {
+            std::stringstream ss;
+            ss << "Requested output: " << outputName;
+            const std::string details = ss.str();
+            SPDLOG_DEBUG("[Model: {} version: {}] Missing output with specific name - {}", getName(), getVersion(), details);
+            return Status(StatusCode::INVALID_MISSING_OUTPUT, details);
+        }
+    }
+
     // Network and request must have the same amount of inputs
     if (request->inputs_size() < 0 || getInputsInfo().size() != static_cast<size_t>(request->inputs_size())) {
         std::stringstream ss;
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <map>
@@ -33,11 +34,13 @@
 
 #include "customloaderconfig.hpp"
 #include "customloaderinterface.hpp"
+#include "metrics.hpp"
 #include "modelchangesubscription.hpp"
 #include "modelconfig.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "modelversionstatus.hpp"
 #include "ovinferrequestsqueue.hpp"
+#include "resultcache.hpp"
 #include "status.hpp"
 #include "tensorinfo.hpp"
 
@@ -59,6 +62,7 @@ public:
 
     bool isBatchSizeRequested() const { return batchSize > 0; }
     bool isShapeRequested(const std::string& name) const { return shapes.count(name) && shapes.at(name).size() > 0; }
+    bool isDefault() const { return batchSize == 0 && shapes.empty(); }
 
     int getBatchSize() const { return batchSize; }
     const shape_t& getShape(const std::string& name) const { return shapes.at(name); }
@@ -76,15 +80,20 @@ class PipelineDefinition;
 class ModelInstance {
 protected:
     /**
-         * @brief Inference Engine core object
+         * @brief Inference Engine core object, shared with other model instances
          */
-    std::unique_ptr<InferenceEngine::Core> engine;
+    std::shared_ptr<InferenceEngine::Core> engine;
 
     /**
          * @brief Inference Engine CNNNetwork object
          */
     std::unique_ptr<InferenceEngine::CNNNetwork> network;
 
+    /**
+         * @brief Memory referenced by network weights blob (weights file mapping or custom loader buffer)
+         */
+    std::shared_ptr<const void> weights;
+
     /**
          * @brief Inference Engine device network
          */
@@ -198,6 +207,13 @@ protected:
          */
     Status loadOVCNNNetworkUsingCustomLoader();
 
+    /**
+         * @brief Loads OV CNNNetwork from buffers returned by the Custom Loader implementing interface version 2
+         *
+         * @return Status
+         */
+    Status loadOVCNNNetworkUsingCustomLoaderV2(CustomLoaderInterfaceV2& customLoader);
+
 private:
     /**
          * @brief Holds the information about inputs and it's parameters
@@ -226,11 +242,91 @@ private:
          */
     std::atomic<uint64_t> predictRequestsHandlesCount = 0;
 
+    /**
+         * @brief Exponentially weighted moving average of inference latency in microseconds
+         *
+         * Used to estimate critical path of pipelines using this model. Zero means no inference was measured yet.
+         */
+    std::atomic<uint64_t> inferenceLatencyEstimateMicroseconds = 0;
+
+    /**
+         * @brief Cache of inference results, created only when enabled in model config
+         *
+         * Recreated on every model load so results of previous model files or shapes are never served.
+         * Replaced while requests may be using it, so it is accessed only with atomic shared pointer operations.
+         */
+    std::shared_ptr<ResultCache> resultCache;
+
+    /**
+         * @brief Metrics of this model version exposed on the metrics endpoint
+         */
+    std::shared_ptr<ModelMetrics> metrics;
+
     /**
          * @brief Lock to disable concurrent modelinstance load/unload/reload
          */
     std::recursive_mutex loadingMutex;
 
+    /**
+         * @brief Set when model is registered but not loaded, so the first request has to load it
+         */
+    std::atomic<bool> loadOnDemandRequired = false;
+
+    /**
+         * @brief Time of the last request using the model, in steady clock ticks
+         */
+    std::atomic<uint64_t> lastUsedTime = 0;
+
+    /**
+         * @brief Loads model registered for loading on demand
+         *
+         * @return Status
+         */
+    Status loadOnDemand();
+
+    /**
+         * @brief Checks if model should be registered without loading until the first request
+         */
+    static bool isLoadOnDemandAllowed(const ModelConfig& config);
+
+    /**
+         * @brief Stores current time as the last use of the model
+         */
+    void markUsed();
+
+    /**
+         * @brief Estimates memory used by loaded model from the size of model files
+         *
+         * @return size in bytes
+         */
+    size_t estimateMemoryUsage() const;
+
+    /**
+         * @brief Estimates memory needed to load model from the size of files in its version directory
+         *
+         * @return size in bytes, 0 when memory budget is disabled
+         */
+    static size_t estimateLoadMemoryUsage(const ModelConfig& config);
+
+    /**
+         * @brief Releases network, engine and inference requests of loaded model
+         */
+    void releaseResources();
+
+    /**
+         * @brief Registers loaded model in memory budget and unloads other models if the budget is exceeded
+         */
+    void updateMemoryBudget();
+
+    /**
+         * @brief Builds new network while the current one keeps serving and swaps them once in-flight requests finish
+         *
+         * Current network keeps serving if the build fails.
+         *
+         * @return Status
+         */
+    Status reloadModelInBackground(const ModelConfig& config, const DynamicModelParameter& parameter);
+
     /**
          * @brief Internal method for loading inputs
          *
@@ -294,12 +390,13 @@ public:
     ModelInstance(const std::string& name, model_version_t version) :
         name(name),
         version(version),
+        metrics(std::make_shared<ModelMetrics>(name, version)),
         subscriptionManager(std::string("model: ") + name + std::string(" version: ") + std::to_string(version)) {}
 
     /**
          * @brief Destroy the Model Instance object
          */
-    virtual ~ModelInstance() = default;
+    virtual ~ModelInstance();
 
     /**
          * @brief Increases predict requests usage count
@@ -315,6 +412,65 @@ public:
         --predictRequestsHandlesCount;
     }
 
+    /**
+         * @brief Updates moving average of inference latency with new measurement
+         *
+         * @param latencyMicroseconds measured inference latency
+         */
+    void updateInferenceLatencyEstimate(uint64_t latencyMicroseconds);
+
+    /**
+         * @brief Gets moving average of inference latency
+         *
+         * @return latency in microseconds, 0 if no inference was measured yet
+         */
+    uint64_t getInferenceLatencyEstimate() const {
+        return inferenceLatencyEstimateMicroseconds;
+    }
+
+    /**
+         * @brief Gets the inference results cache
+         *
+         * @return cache kept alive until released by the caller or nullptr when caching is disabled
+         */
+    std::shared_ptr<ResultCache> getResultCache() const {
+        return std::atomic_load(&resultCache);
+    }
+
+    /**
+         * @brief Gets the metrics of model version
+         *
+         * @return model metrics
+         */
+    ModelMetrics& getMetrics() const {
+        return *metrics;
+    }
+
+    /**
+         * @brief Checks if model is registered but has to be loaded by the next request
+         *
+         * @return bool
+         */
+    bool isLoadOnDemandRequired() const {
+        return loadOnDemandRequired;
+    }
+
+    /**
+         * @brief Gets time of the last request using the model
+         *
+         * @return steady clock ticks
+         */
+    uint64_t getLastUsedTime() const {
+        return lastUsedTime.load(std::memory_order_relaxed);
+    }
+
+    /**
+         * @brief Unloads model to free memory if it is not in use. Model is loaded again by the next request.
+         *
+         * @return true if model was unloaded
+         */
+    bool unloadToFreeMemory();
+
     /**
          * @brief Gets the model name
          * 
@@ -366,7 +522,7 @@ public:
          * @return batch size
          */
     virtual size_t getBatchSize() const {
-        return network->getBatchSize();
+        return batchSize;
     }
 
     /**
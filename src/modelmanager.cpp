@@ -16,10 +16,13 @@
 #include "modelmanager.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <sstream>
 #include <unordered_map>
 #include <utility>
@@ -31,10 +34,17 @@
 #include <rapidjson/prettywriter.h>
 #include <sys/stat.h>
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/util/threadpool_executor.h"
+#pragma GCC diagnostic pop
+
 #include "azurefilesystem.hpp"
+#include "cloudpollscheduler.hpp"
 #include "config.hpp"
 #include "customloaders.hpp"
 #include "filesystem.hpp"
+#include "filesystemwatcher.hpp"
 #include "gcsfilesystem.hpp"
 #include "localfilesystem.hpp"
 #include "logging.hpp"
@@ -47,9 +57,26 @@ namespace ovms {
 
 static bool watcherStarted = false;
 
+// How often watcher checks exit signal while waiting for filesystem events
+static const uint WATCHER_WAIT_MILLISECONDS = 100;
+// Changes are applied after no more events arrive for this time, e.g. when all files of new version are copied
+static const uint WATCHER_DEBOUNCE_MILLISECONDS = 200;
+static const uint WATCHER_MAX_DEBOUNCE_MILLISECONDS = 10000;
+
+static bool isLocalFilesystem(const std::string& basePath) {
+    for (const auto* prefix : {&S3FileSystem::S3_URL_PREFIX, &GCSFileSystem::GCS_URL_PREFIX,
+             &AzureFileSystem::AZURE_URL_FILE_PREFIX, &AzureFileSystem::AZURE_URL_BLOB_PREFIX}) {
+        if (basePath.rfind(*prefix, 0) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status ModelManager::start() {
     auto& config = ovms::Config::instance();
     watcherIntervalSec = config.filesystemPollWaitSeconds();
+    cloudPollIntervalSec = config.cloudPollWaitSeconds() > 0 ? config.cloudPollWaitSeconds() : watcherIntervalSec;
     Status status;
     if (config.configPath() != "") {
         status = startFromFile(config.configPath());
@@ -177,7 +204,7 @@ void processNodeOutputs(const rapidjson::Value::ConstMemberIterator& nodeOutputs
     }
 }
 
-void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Value& pipelineConfig, std::set<std::string>& pipelinesInConfigFile, PipelineFactory& factory, ModelManager& manager) {
+Status processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Value& pipelineConfig, std::set<std::string>& pipelinesInConfigFile, PipelineFactory& factory, ModelManager& manager) {
     const std::string pipelineName = pipelineConfig["name"].GetString();
     SPDLOG_LOGGER_INFO(modelmanager_logger, "Reading pipeline: {} configuration", pipelineName);
     auto itr2 = pipelineConfig.FindMember("nodes");
@@ -190,14 +217,46 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
         std::string nodeName;
         nodeName = nodeConfig["name"].GetString();
 
+        const std::string nodeKindStr = nodeConfig["type"].GetString();
+        NodeKind nodeKind;
+        auto status = toNodeKind(nodeKindStr, nodeKind);
+        if (!status.ok()) {
+            SPDLOG_LOGGER_WARN(modelmanager_logger, "Parsing node kind failed: {}", nodeKindStr);
+            return status;
+        }
+
         std::string modelName;
-        modelName = nodeConfig["model_name"].GetString();
+        if (nodeConfig.HasMember("model_name")) {
+            modelName = nodeConfig["model_name"].GetString();
+        } else if (nodeKind == NodeKind::DL) {
+            SPDLOG_LOGGER_WARN(modelmanager_logger, "Pipeline: {} node: {} of type: {} is missing model_name", pipelineName, nodeName, nodeKindStr);
+            return StatusCode::PIPELINE_NODE_MISSING_MODEL_NAME;
+        }
 
-        const std::string nodeKindStr = nodeConfig["type"].GetString();
+        NodeLibrary library;
+        parameters_t parameters;
+        if (nodeKind == NodeKind::CUSTOM) {
+            if (!nodeConfig.HasMember("library_name")) {
+                SPDLOG_LOGGER_WARN(modelmanager_logger, "Pipeline: {} node: {} of type: {} is missing library_name", pipelineName, nodeName, nodeKindStr);
+                return StatusCode::PIPELINE_DEFINITION_INVALID_NODE_LIBRARY;
+            }
+            const std::string libraryName = nodeConfig["library_name"].GetString();
+            status = manager.getCustomNodeLibraryManager().getLibrary(libraryName, library);
+            if (!status.ok()) {
+                SPDLOG_LOGGER_WARN(modelmanager_logger, "Pipeline: {} node: {} refers to custom node library: {} which is not loaded", pipelineName, nodeName, libraryName);
+                return StatusCode::PIPELINE_DEFINITION_INVALID_NODE_LIBRARY;
+            }
+            if (nodeConfig.HasMember("params")) {
+                // Schema allows only string values
+                for (const auto& param : nodeConfig["params"].GetObject()) {
+                    parameters.emplace(param.name.GetString(), param.value.GetString());
+                }
+            }
+        }
         auto nodeOutputsItr = nodeConfig.FindMember("outputs");
         if (nodeOutputsItr == nodeConfig.MemberEnd() || !nodeOutputsItr->value.IsArray()) {
             SPDLOG_LOGGER_WARN(modelmanager_logger, "Pipeline: {} does not have valid outputs configuration", pipelineName);
-            return;
+            return StatusCode::JSON_INVALID;
         }
         std::unordered_map<std::string, std::string> nodeOutputNameAlias;  // key:alias, value realName
         processNodeOutputs(nodeOutputsItr, nodeName, modelName, nodeOutputNameAlias);
@@ -207,15 +266,17 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
         } else {
             modelVersion = std::nullopt;
         }
-        NodeKind nodeKind;
-        auto status = toNodeKind(nodeKindStr, nodeKind);
-        if (!status.ok()) {
-            SPDLOG_LOGGER_WARN(modelmanager_logger, "Parsing node kind failed: {}", nodeKindStr);
-            return;
+        std::optional<int32_t> demultiplyCount;
+        if (nodeConfig.HasMember("demultiply_count")) {
+            demultiplyCount = nodeConfig["demultiply_count"].GetInt();
+        }
+        std::optional<std::string> gatherFromNode;
+        if (nodeConfig.HasMember("gather_from_node")) {
+            gatherFromNode = nodeConfig["gather_from_node"].GetString();
         }
         SPDLOG_DEBUG("Creating node: {} type: {} model_name: {} modelVersion: {}",
             nodeName, nodeKindStr, modelName, modelVersion.value_or(0));
-        info.emplace_back(std::move(NodeInfo{nodeKind, nodeName, modelName, modelVersion, nodeOutputNameAlias}));
+        info.emplace_back(std::move(NodeInfo{nodeKind, nodeName, modelName, modelVersion, nodeOutputNameAlias, library, parameters, demultiplyCount, gatherFromNode}));
         auto nodeInputItr = nodeConfig.FindMember("inputs");
         processNodeInputs(nodeName, nodeInputItr, connections);
     }
@@ -227,7 +288,7 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
         SPDLOG_DEBUG("Pipeline:{} was not loaded so far. Triggering load", pipelineName);
         auto status = factory.createDefinition(pipelineName, info, connections, manager);
         pipelinesInConfigFile.insert(pipelineName);
-        return;
+        return StatusCode::OK;
     }
     SPDLOG_DEBUG("Pipeline:{} is already loaded. Triggering reload", pipelineName);
     auto status = factory.reloadDefinition(pipelineName,
@@ -235,21 +296,136 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
         std::move(connections),
         manager);
     pipelinesInConfigFile.insert(pipelineName);
+    return StatusCode::OK;
 }
 
+namespace {
+/**
+ * @brief Loads pipelines from configuration file while models are being loaded. Pipeline is validated
+ * as soon as all models used by its nodes are reloaded, the remaining ones after all models are reloaded.
+ */
+class PipelinesConfigLoader {
+    rapidjson::Document& configJson;
+    PipelineFactory& factory;
+    ModelManager& manager;
+    bool configured = false;
+    std::vector<const rapidjson::Value*> pipelineConfigs;
+    std::vector<std::set<std::string>> awaitedModels;
+    std::vector<bool> processed;
+    std::set<std::string> pipelinesInConfigFile;
+    Status firstErrorStatus = StatusCode::OK;
+    std::mutex mtx;
+    std::mutex processingMtx;
+
+    void process(const std::vector<size_t>& ready) {
+        std::lock_guard<std::mutex> lock(processingMtx);
+        for (size_t i : ready) {
+            // Pipelines with invalid configuration are skipped, the rest is still loaded
+            auto status = processPipelineConfig(configJson, *pipelineConfigs[i], pipelinesInConfigFile, factory, manager);
+            if (!status.ok() && firstErrorStatus.ok()) {
+                firstErrorStatus = status;
+            }
+        }
+    }
+
+public:
+    PipelinesConfigLoader(rapidjson::Document& configJson, PipelineFactory& factory, ModelManager& manager) :
+        configJson(configJson),
+        factory(factory),
+        manager(manager) {
+        const auto itrp = configJson.FindMember("pipeline_config_list");
+        if (itrp == configJson.MemberEnd() || !itrp->value.IsArray()) {
+            return;
+        }
+        configured = true;
+        for (const auto& pipelineConfig : itrp->value.GetArray()) {
+            std::set<std::string> models;
+            const auto nodesItr = pipelineConfig.FindMember("nodes");
+            if (nodesItr != pipelineConfig.MemberEnd() && nodesItr->value.IsArray()) {
+                for (const auto& nodeConfig : nodesItr->value.GetArray()) {
+                    const auto modelNameItr = nodeConfig.FindMember("model_name");
+                    if (modelNameItr != nodeConfig.MemberEnd() && modelNameItr->value.IsString()) {
+                        models.emplace(modelNameItr->value.GetString());
+                    }
+                }
+            }
+            // Pipelines without models are validated after models, since models take precedence in name conflicts
+            if (models.empty()) {
+                models.emplace("");
+            }
+            pipelineConfigs.push_back(&pipelineConfig);
+            awaitedModels.emplace_back(std::move(models));
+            processed.push_back(false);
+        }
+    }
+
+    /**
+     * @brief Validates pipelines which do not wait for other models anymore, called from model load threads
+     */
+    void modelReloaded(const std::string& modelName) {
+        std::vector<size_t> ready;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            for (size_t i = 0; i < pipelineConfigs.size(); i++) {
+                if (!processed[i] && awaitedModels[i].erase(modelName) > 0 && awaitedModels[i].empty()) {
+                    processed[i] = true;
+                    ready.push_back(i);
+                }
+            }
+        }
+        if (!ready.empty()) {
+            process(ready);
+        }
+    }
+
+    /**
+     * @brief Validates remaining pipelines and retires pipelines removed from configuration file
+     *
+     * @return status of the first pipeline which failed to load
+     */
+    Status finish() {
+        if (!configured) {
+            SPDLOG_LOGGER_INFO(modelmanager_logger, "Configuration file doesn't have pipelines property.");
+            factory.retireOtherThan({}, manager);
+            return StatusCode::OK;
+        }
+        std::vector<size_t> ready;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            for (size_t i = 0; i < pipelineConfigs.size(); i++) {
+                if (!processed[i]) {
+                    processed[i] = true;
+                    ready.push_back(i);
+                }
+            }
+        }
+        process(ready);
+        std::lock_guard<std::mutex> lock(processingMtx);
+        factory.retireOtherThan(std::move(pipelinesInConfigFile), manager);
+        return firstErrorStatus;
+    }
+};
+}  // namespace
+
 Status ModelManager::loadPipelinesConfig(rapidjson::Document& configJson) {
-    const auto itrp = configJson.FindMember("pipeline_config_list");
+    PipelinesConfigLoader loader(configJson, pipelineFactory, *this);
+    return loader.finish();
+}
+
+Status ModelManager::loadCustomNodeLibrariesConfig(rapidjson::Document& configJson) {
+    const auto itrp = configJson.FindMember("custom_node_library_config_list");
     if (itrp == configJson.MemberEnd() || !itrp->value.IsArray()) {
-        SPDLOG_LOGGER_INFO(modelmanager_logger, "Configuration file doesn't have pipelines property.");
-        pipelineFactory.retireOtherThan({}, *this);
         return StatusCode::OK;
     }
-    std::set<std::string> pipelinesInConfigFile;
-    for (const auto& pipelineConfig : itrp->value.GetArray()) {
-        processPipelineConfig(configJson, pipelineConfig, pipelinesInConfigFile, pipelineFactory, *this);
+    for (const auto& libraryConfig : itrp->value.GetArray()) {
+        const std::string libraryName = libraryConfig["name"].GetString();
+        const std::string basePath = libraryConfig["base_path"].GetString();
+        auto status = customNodeLibraryManager.loadLibrary(libraryName, basePath);
+        if (!status.ok()) {
+            SPDLOG_LOGGER_ERROR(modelmanager_logger, "Loading custom node library: {} failed: {}", libraryName, status.string());
+        }
     }
-    pipelineFactory.retireOtherThan(std::move(pipelinesInConfigFile), *this);
-    return ovms::StatusCode::OK;
+    return StatusCode::OK;
 }
 
 Status ModelManager::createCustomLoader(CustomLoaderConfig& loaderConfig) {
@@ -272,6 +448,13 @@ Status ModelManager::createCustomLoader(CustomLoaderConfig& loaderConfig) {
             return StatusCode::CUSTOM_LOADER_LIBRARY_LOAD_FAILED;
         }
 
+        int interfaceVersion = CustomLoaders::detectInterfaceVersion(handleCL);
+        if (interfaceVersion < 1 || interfaceVersion > CUSTOM_LOADER_INTERFACE_VERSION) {
+            SPDLOG_LOGGER_ERROR(modelmanager_logger, "Custom loader: {} implements unsupported interface version: {}", loaderName, interfaceVersion);
+            return StatusCode::CUSTOM_LOADER_LIBRARY_LOAD_FAILED;
+        }
+        SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Custom loader: {} implements interface version: {}", loaderName, interfaceVersion);
+
         std::shared_ptr<CustomLoaderInterface> customLoaderIfPtr{customObj()};
         try {
             customLoaderIfPtr->loaderInit(loaderConfig.getLoaderConfigFile());
@@ -282,7 +465,7 @@ Status ModelManager::createCustomLoader(CustomLoaderConfig& loaderConfig) {
             SPDLOG_LOGGER_ERROR(modelmanager_logger, "Cannot create or initialize the custom loader");
             return StatusCode::CUSTOM_LOADER_INIT_FAILED;
         }
-        customloaders.add(loaderName, customLoaderIfPtr, handleCL);
+        customloaders.add(loaderName, customLoaderIfPtr, handleCL, interfaceVersion);
     } else {
         // Loader is already in the existing loaders. Move it to new loaders.
         // Reload of customloader is not supported yet
@@ -321,7 +504,7 @@ Status ModelManager::loadCustomLoadersConfig(rapidjson::Document& configJson) {
     return ovms::StatusCode::OK;
 }
 
-Status ModelManager::loadModelsConfig(rapidjson::Document& configJson, std::vector<ModelConfig>& gatedModelConfigs) {
+Status ModelManager::loadModelsConfig(rapidjson::Document& configJson, std::vector<ModelConfig>& gatedModelConfigs, const std::function<void(const std::string&)>& onModelReloaded) {
     const auto itr = configJson.FindMember("model_config_list");
     if (itr == configJson.MemberEnd() || !itr->value.IsArray()) {
         SPDLOG_LOGGER_ERROR(modelmanager_logger, "Configuration file doesn't have models property.");
@@ -329,6 +512,7 @@ Status ModelManager::loadModelsConfig(rapidjson::Document& configJson, std::vect
     }
     std::set<std::string> modelsInConfigFile;
     std::unordered_map<std::string, ModelConfig> newModelConfigs;
+    std::vector<ModelConfig> modelConfigs;
     for (const auto& configs : itr->value.GetArray()) {
         ModelConfig modelConfig;
         auto status = modelConfig.parseNode(configs["config"]);
@@ -345,9 +529,17 @@ Status ModelManager::loadModelsConfig(rapidjson::Document& configJson, std::vect
             SPDLOG_LOGGER_WARN(modelmanager_logger, "Duplicated model names: {} defined in config file. Only first definition will be loaded.", modelName);
             continue;
         }
-        status = reloadModelWithVersions(modelConfig);
         modelsInConfigFile.emplace(modelName);
+        modelConfigs.emplace_back(std::move(modelConfig));
+    }
 
+    std::vector<Status> statuses;
+    reloadModelsWithVersions({modelConfigs.begin(), modelConfigs.end()}, statuses, onModelReloaded);
+
+    for (size_t i = 0; i < modelConfigs.size(); i++) {
+        auto& modelConfig = modelConfigs[i];
+        const auto modelName = modelConfig.getName();
+        const auto& status = statuses[i];
         if (!status.ok()) {
             SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Cannot reload model: {} with versions due to error: {}", modelName, status.string());
         }
@@ -369,6 +561,48 @@ Status ModelManager::loadModelsConfig(rapidjson::Document& configJson, std::vect
     return ovms::StatusCode::OK;
 }
 
+void ModelManager::reloadModelsWithVersions(const std::vector<std::reference_wrapper<ModelConfig>>& configs, std::vector<Status>& statuses, const std::function<void(const std::string&)>& onModelReloaded) {
+    statuses.assign(configs.size(), StatusCode::OK);
+    auto reloadModel = [this, &configs, &statuses, &onModelReloaded](size_t i) {
+        auto start = std::chrono::steady_clock::now();
+        statuses[i] = reloadModelWithVersions(configs[i]);
+        SPDLOG_LOGGER_INFO(modelmanager_logger, "Applying config changes to model: {} took {} ms",
+            configs[i].get().getName(), std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+        if (onModelReloaded) {
+            onModelReloaded(configs[i].get().getName());
+        }
+    };
+
+    // Models used by pipelines or serving requests are reloaded first, so that they are first to download their files
+    std::vector<size_t> order(configs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_partition(order.begin(), order.end(), [this, &configs](size_t i) {
+        auto model = findModelByName(configs[i].get().getName());
+        return model != nullptr && model->getDownloadPriority() == DownloadPriority::HIGH;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    const uint configuredThreads = ovms::Config::instance().modelLoadThreads();
+    const size_t threads = std::min<size_t>(configs.size(), configuredThreads > 0 ? configuredThreads : std::max(1u, std::thread::hardware_concurrency()));
+    if (threads > 1) {
+        // Destructor of executor waits for all scheduled reloads to finish
+        tensorflow::serving::ThreadPoolExecutor executor(tensorflow::Env::Default(), "modelload", threads);
+        for (size_t i : order) {
+            // Custom loader libraries are not required to be thread safe
+            if (!configs[i].get().isCustomLoaderRequiredToLoadModel()) {
+                executor.Schedule([&reloadModel, i]() { reloadModel(i); });
+            }
+        }
+    }
+    for (size_t i : order) {
+        if (threads <= 1 || configs[i].get().isCustomLoaderRequiredToLoadModel()) {
+            reloadModel(i);
+        }
+    }
+    SPDLOG_LOGGER_INFO(modelmanager_logger, "Applying config changes to {} models took {} ms using {} threads",
+        configs.size(), std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(), threads);
+}
+
 Status ModelManager::tryReloadGatedModelConfigs(std::vector<ModelConfig>& gatedModelConfigs) {
     for (auto& modelConfig : gatedModelConfigs) {
         SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Trying to reload model({}) configuration", modelConfig.getName());
@@ -411,14 +645,19 @@ Status ModelManager::loadConfig(const std::string& jsonFilename) {
     if (status != StatusCode::OK) {
         return status;
     }
+    // Custom node libraries are loaded first, so pipelines can be validated while models are still loading
+    loadCustomNodeLibrariesConfig(configJson);
+    PipelinesConfigLoader pipelinesLoader(configJson, pipelineFactory, *this);
     std::vector<ModelConfig> gatedModelConfigs;
-    status = loadModelsConfig(configJson, gatedModelConfigs);
+    status = loadModelsConfig(configJson, gatedModelConfigs,
+        [&pipelinesLoader](const std::string& modelName) { pipelinesLoader.modelReloaded(modelName); });
     if (status != StatusCode::OK) {
         return status;
     }
-    status = loadPipelinesConfig(configJson);
+    // Pipelines with invalid configuration are not loaded, but they do not prevent loading the other ones
+    status = pipelinesLoader.finish();
     tryReloadGatedModelConfigs(gatedModelConfigs);
-    return StatusCode::OK;
+    return status;
 }
 
 void ModelManager::retireModelsRemovedFromConfigFile(const std::set<std::string>& modelsExistingInConfigFile) {
@@ -444,18 +683,178 @@ void ModelManager::retireModelsRemovedFromConfigFile(const std::set<std::string>
 
 void ModelManager::updateConfigurationWithoutConfigFile() {
     SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Checking if something changed with model versions");
+    std::vector<std::reference_wrapper<ModelConfig>> configs;
     for (auto& [name, config] : servedModelConfigs) {
-        reloadModelWithVersions(config);
+        configs.emplace_back(config);
     }
+    std::vector<Status> statuses;
+    reloadModelsWithVersions(configs, statuses);
     pipelineFactory.revalidatePipelines(*this);
 }
 
-void ModelManager::watcher(std::future<void> exit) {
-    SPDLOG_LOGGER_INFO(modelmanager_logger, "Started config watcher thread");
+void ModelManager::updateConfigurationOfModelsInBasePaths(const std::set<std::string>& basePaths) {
+    std::vector<std::reference_wrapper<ModelConfig>> configs;
+    for (auto& [name, config] : servedModelConfigs) {
+        if (basePaths.count(config.getBasePath()) == 1) {
+            configs.emplace_back(config);
+        }
+    }
+    if (configs.empty()) {
+        return;
+    }
+    SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Checking if something changed with versions of {} models", configs.size());
+    std::vector<Status> statuses;
+    reloadModelsWithVersions(configs, statuses);
+    pipelineFactory.revalidatePipelines(*this);
+}
+
+std::set<std::string> ModelManager::pollCloudBasePaths(CloudPollScheduler& scheduler, const std::set<std::string>& cloudBasePaths) {
+    return scheduler.poll(cloudBasePaths, std::chrono::steady_clock::now(), [](const std::vector<std::string>& basePaths, CloudPollScheduler::fingerprints_t& fingerprints) {
+        // Paths of the same storage type are handled by single file system which may list them together
+        std::map<std::string, std::vector<std::string>> basePathsByStorage;
+        for (const auto& basePath : basePaths) {
+            basePathsByStorage[basePath.substr(0, basePath.find("://"))].push_back(basePath);
+        }
+        for (const auto& [storage, storageBasePaths] : basePathsByStorage) {
+            auto fs = getFilesystem(storageBasePaths.front());
+            auto status = fs->getDirectoriesFingerprints(storageBasePaths, &fingerprints);
+            if (status != StatusCode::OK && status != StatusCode::NOT_IMPLEMENTED) {
+                SPDLOG_LOGGER_WARN(modelmanager_logger, "Could not check {} storage for changes: {}", storage, Status(status).string());
+            }
+        }
+    });
+}
+
+static bool watchModelBasePath(FileSystemWatcher& fileSystemWatcher, const std::string& basePath, std::set<std::string>& watchedDirectories) {
+    if (!fileSystemWatcher.watchDirectory(basePath)) {
+        return false;
+    }
+    watchedDirectories.insert(basePath);
+    // Version directories are watched as well, so that copying model files postpones the rescan of base path
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(basePath, ec)) {
+        if (entry.is_directory(ec) && fileSystemWatcher.watchDirectory(entry.path().string(), basePath)) {
+            watchedDirectories.insert(entry.path().string());
+        }
+    }
+    return true;
+}
+
+void ModelManager::updateWatchedDirectories(FileSystemWatcher& fileSystemWatcher, const std::string& configDirectory, std::set<std::string>& localBasePaths, std::set<std::string>& polledBasePaths, std::set<std::string>& cloudBasePaths) {
+    localBasePaths.clear();
+    polledBasePaths.clear();
+    cloudBasePaths.clear();
+    for (const auto& [name, config] : servedModelConfigs) {
+        const auto& basePath = config.getBasePath();
+        if (!isLocalFilesystem(basePath)) {
+            cloudBasePaths.insert(basePath);
+        } else if (FileSystem::isPathEscaped(basePath)) {
+            polledBasePaths.insert(basePath);
+        } else {
+            localBasePaths.insert(basePath);
+        }
+    }
+    std::set<std::string> watchedDirectories;
+    if (!configDirectory.empty() && fileSystemWatcher.watchDirectory(configDirectory)) {
+        watchedDirectories.insert(configDirectory);
+    }
+    for (const auto& basePath : localBasePaths) {
+        if (!watchModelBasePath(fileSystemWatcher, basePath, watchedDirectories)) {
+            polledBasePaths.insert(basePath);
+        }
+    }
+    // Directories of models removed from config are not watched anymore
+    for (const auto& directory : fileSystemWatcher.getWatchedDirectories()) {
+        if (watchedDirectories.count(directory) == 0) {
+            fileSystemWatcher.unwatchDirectory(directory);
+        }
+    }
+}
+
+void ModelManager::updateWatchedBasePaths(FileSystemWatcher& fileSystemWatcher, const std::set<std::string>& changedDirectories, const std::set<std::string>& localBasePaths, std::set<std::string>& polledBasePaths) {
+    std::set<std::string> watchedDirectories;
+    for (const auto& basePath : changedDirectories) {
+        if (localBasePaths.count(basePath) == 0) {
+            continue;
+        }
+        // Removed base path is polled until it appears again
+        if (watchModelBasePath(fileSystemWatcher, basePath, watchedDirectories)) {
+            polledBasePaths.erase(basePath);
+        } else {
+            polledBasePaths.insert(basePath);
+        }
+    }
+}
+
+void ModelManager::watchFileSystem(FileSystemWatcher& fileSystemWatcher, std::future<void>& exit) {
+    SPDLOG_LOGGER_INFO(modelmanager_logger, "Watching config file and local model directories for changes; remote model directories are checked every {} seconds", cloudPollIntervalSec);
+    std::string configDirectory;
+    if (!configFilename.empty()) {
+        configDirectory = std::filesystem::path(configFilename).parent_path().string();
+        if (configDirectory.empty()) {
+            configDirectory = ".";
+        }
+    }
+    struct stat statTime;
+    stat(configFilename.c_str(), &statTime);
+    struct timespec lastTime = statTime.st_ctim;
+    std::set<std::string> localBasePaths, polledBasePaths, cloudBasePaths;
+    updateWatchedDirectories(fileSystemWatcher, configDirectory, localBasePaths, polledBasePaths, cloudBasePaths);
+    CloudPollScheduler cloudPollScheduler{std::chrono::seconds(cloudPollIntervalSec)};
+    auto lastPoll = std::chrono::steady_clock::now();
+    while (exit.wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout) {
+        std::set<std::string> changedDirectories;
+        if (fileSystemWatcher.waitForChanges(std::chrono::milliseconds(WATCHER_WAIT_MILLISECONDS), changedDirectories)) {
+            auto debounceStart = std::chrono::steady_clock::now();
+            do {
+                updateWatchedBasePaths(fileSystemWatcher, changedDirectories, localBasePaths, polledBasePaths);
+            } while (fileSystemWatcher.waitForChanges(std::chrono::milliseconds(WATCHER_DEBOUNCE_MILLISECONDS), changedDirectories) &&
+                     std::chrono::steady_clock::now() - debounceStart < std::chrono::milliseconds(WATCHER_MAX_DEBOUNCE_MILLISECONDS));
+        }
+        const bool pollingDue = std::chrono::steady_clock::now() - lastPoll >= std::chrono::seconds(watcherIntervalSec);
+        // Remote directories are rescanned only when their listing changed
+        auto changedCloudBasePaths = pollCloudBasePaths(cloudPollScheduler, cloudBasePaths);
+        changedDirectories.insert(changedCloudBasePaths.begin(), changedCloudBasePaths.end());
+        if (changedDirectories.empty() && !pollingDue) {
+            continue;
+        }
+        SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Watcher thread check cycle begin");
+        bool configReloaded = false;
+        if (!configFilename.empty() &&
+            (changedDirectories.count(configDirectory) == 1 || (pollingDue && !fileSystemWatcher.isWatched(configDirectory)))) {
+            stat(configFilename.c_str(), &statTime);
+            if (lastTime.tv_sec != statTime.st_ctim.tv_sec || lastTime.tv_nsec != statTime.st_ctim.tv_nsec) {
+                lastTime = statTime.st_ctim;
+                loadConfig(configFilename);
+                configReloaded = true;
+            }
+        }
+        // Loading config checks versions of all models
+        if (!configReloaded) {
+            if (pollingDue) {
+                changedDirectories.insert(polledBasePaths.begin(), polledBasePaths.end());
+            }
+            updateConfigurationOfModelsInBasePaths(changedDirectories);
+        }
+        if (pollingDue) {
+            lastPoll = std::chrono::steady_clock::now();
+        }
+        // Only config reload changes the set of watched base paths
+        if (configReloaded) {
+            updateWatchedDirectories(fileSystemWatcher, configDirectory, localBasePaths, polledBasePaths, cloudBasePaths);
+        } else {
+            updateWatchedBasePaths(fileSystemWatcher, changedDirectories, localBasePaths, polledBasePaths);
+        }
+        SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Watcher thread check cycle end");
+    }
+}
+
+void ModelManager::pollFileSystem(std::future<void>& exit) {
     int64_t lastTime;
     struct stat statTime;
     stat(configFilename.c_str(), &statTime);
     lastTime = statTime.st_ctime;
+    CloudPollScheduler cloudPollScheduler{std::chrono::seconds(cloudPollIntervalSec)};
     while (exit.wait_for(std::chrono::milliseconds(1)) == std::future_status::timeout) {
         std::this_thread::sleep_for(std::chrono::seconds(watcherIntervalSec));
         SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Watcher thread check cycle begin");
@@ -464,9 +863,25 @@ void ModelManager::watcher(std::future<void> exit) {
             lastTime = statTime.st_ctime;
             loadConfig(configFilename);
         }
-        updateConfigurationWithoutConfigFile();
+        std::set<std::string> basePaths, cloudBasePaths;
+        for (const auto& [name, config] : servedModelConfigs) {
+            (isLocalFilesystem(config.getBasePath()) ? basePaths : cloudBasePaths).insert(config.getBasePath());
+        }
+        auto changedCloudBasePaths = pollCloudBasePaths(cloudPollScheduler, cloudBasePaths);
+        basePaths.insert(changedCloudBasePaths.begin(), changedCloudBasePaths.end());
+        updateConfigurationOfModelsInBasePaths(basePaths);
         SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Watcher thread check cycle end");
     }
+}
+
+void ModelManager::watcher(std::future<void> exit) {
+    SPDLOG_LOGGER_INFO(modelmanager_logger, "Started config watcher thread");
+    FileSystemWatcher fileSystemWatcher;
+    if (fileSystemWatcher.isEnabled()) {
+        watchFileSystem(fileSystemWatcher, exit);
+    } else {
+        pollFileSystem(exit);
+    }
     SPDLOG_LOGGER_ERROR(modelmanager_logger, "Exited config watcher thread");
 }
 
@@ -554,9 +969,7 @@ std::shared_ptr<ovms::Model> ModelManager::getModelIfExistCreateElse(const std::
 
 std::shared_ptr<FileSystem> ModelManager::getFilesystem(const std::string& basePath) {
     if (basePath.rfind(S3FileSystem::S3_URL_PREFIX, 0) == 0) {
-        Aws::SDKOptions options;
-        Aws::InitAPI(options);
-        return std::make_shared<S3FileSystem>(options, basePath);
+        return std::make_shared<S3FileSystem>(S3FileSystem::initializeSdk(), basePath);
     }
     if (basePath.rfind(GCSFileSystem::GCS_URL_PREFIX, 0) == 0) {
         return std::make_shared<ovms::GCSFileSystem>();
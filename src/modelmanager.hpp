@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <functional>
 #include <future>
 #include <map>
 #include <memory>
@@ -29,12 +30,15 @@
 #include <spdlog/spdlog.h>
 
 #include "customloaders.hpp"
+#include "customnodelibrarymanager.hpp"
 #include "filesystem.hpp"
 #include "model.hpp"
 #include "pipeline.hpp"
 #include "pipeline_factory.hpp"
 
 namespace ovms {
+class CloudPollScheduler;
+class FileSystemWatcher;
 class IVersionReader;
 /**
  * @brief Model manager is managing the list of model topologies enabled for serving and their versions.
@@ -56,6 +60,11 @@ protected:
 
     PipelineFactory pipelineFactory;
 
+    /**
+     * @brief Shared libraries used by custom nodes in pipelines
+     */
+    CustomNodeLibraryManager customNodeLibraryManager;
+
 private:
     /**
      * @brief Private copying constructor
@@ -65,10 +74,20 @@ private:
     Status cleanupModelTmpFiles(ModelConfig& config);
     Status reloadModelVersions(std::shared_ptr<ovms::Model>& model, std::shared_ptr<FileSystem>& fs, ModelConfig& config, std::shared_ptr<model_versions_t>& versionsToReload, std::shared_ptr<model_versions_t> versionsFailed);
     Status addModelVersions(std::shared_ptr<ovms::Model>& model, std::shared_ptr<FileSystem>& fs, ModelConfig& config, std::shared_ptr<model_versions_t>& versionsToStart, std::shared_ptr<model_versions_t> versionsFailed);
-    Status loadModelsConfig(rapidjson::Document& configJson, std::vector<ModelConfig>& gatedModelConfigs);
+    Status loadModelsConfig(rapidjson::Document& configJson, std::vector<ModelConfig>& gatedModelConfigs, const std::function<void(const std::string&)>& onModelReloaded = {});
+
+    /**
+     * @brief Reloads models with their versions concurrently on model load thread pool
+     *
+     * @param configs models configurations
+     * @param statuses filled with reload status of each model, in the order of configs
+     * @param onModelReloaded called with model name as soon as reload of the model finishes, from model load threads
+     */
+    void reloadModelsWithVersions(const std::vector<std::reference_wrapper<ModelConfig>>& configs, std::vector<Status>& statuses, const std::function<void(const std::string&)>& onModelReloaded = {});
     Status tryReloadGatedModelConfigs(std::vector<ModelConfig>& gatedModelConfigs);
     Status loadPipelinesConfig(rapidjson::Document& configJson);
     Status loadCustomLoadersConfig(rapidjson::Document& configJson);
+    Status loadCustomNodeLibrariesConfig(rapidjson::Document& configJson);
 
     /**
      * @brief creates customloader from the loader configuration
@@ -79,6 +98,49 @@ private:
      */
     void watcher(std::future<void> exit);
 
+    /**
+     * @brief Applies changes of config file and model directories reported by inotify.
+     * Directories of models on remote filesystems are checked every cloudPollIntervalSec.
+     */
+    void watchFileSystem(FileSystemWatcher& fileSystemWatcher, std::future<void>& exit);
+
+    /**
+     * @brief Checks config file and local model directories for changes every watcherIntervalSec
+     * and directories of models on remote filesystems every cloudPollIntervalSec
+     */
+    void pollFileSystem(std::future<void>& exit);
+
+    /**
+     * @brief Watches config directory, local model directories and their version directories
+     *
+     * @param fileSystemWatcher
+     * @param configDirectory
+     * @param localBasePaths filled with local model base paths which can be watched
+     * @param polledBasePaths filled with local model base paths which could not be watched
+     * @param cloudBasePaths filled with model base paths on remote filesystems
+     */
+    void updateWatchedDirectories(FileSystemWatcher& fileSystemWatcher, const std::string& configDirectory, std::set<std::string>& localBasePaths, std::set<std::string>& polledBasePaths, std::set<std::string>& cloudBasePaths);
+
+    /**
+     * @brief Watches version directories of changed local model base paths, other base paths are not listed again
+     *
+     * @param fileSystemWatcher
+     * @param changedDirectories reported paths of changed directories
+     * @param localBasePaths local model base paths which can be watched
+     * @param polledBasePaths updated with changed base paths which could not be watched
+     */
+    void updateWatchedBasePaths(FileSystemWatcher& fileSystemWatcher, const std::set<std::string>& changedDirectories, const std::set<std::string>& localBasePaths, std::set<std::string>& polledBasePaths);
+
+    /**
+     * @brief Gets base paths on remote filesystems which have to be checked for new versions
+     */
+    std::set<std::string> pollCloudBasePaths(CloudPollScheduler& scheduler, const std::set<std::string>& cloudBasePaths);
+
+    /**
+     * @brief Checks versions of models located in given base paths
+     */
+    void updateConfigurationOfModelsInBasePaths(const std::set<std::string>& basePaths);
+
     /**
      * @brief A JSON configuration filename
      */
@@ -117,6 +179,11 @@ private:
      */
     uint watcherIntervalSec = 1;
 
+    /**
+     * Time interval between checks of model directories on remote filesystems
+     */
+    uint cloudPollIntervalSec = 1;
+
 public:
     /**
      * @brief Gets the instance of ModelManager
@@ -161,6 +228,10 @@ public:
         return pipelineFactory;
     }
 
+    const CustomNodeLibraryManager& getCustomNodeLibraryManager() const {
+        return customNodeLibraryManager;
+    }
+
     /**
      * @brief Finds model with specific name
      *
@@ -307,4 +378,13 @@ protected:
     void updateConfigurationWithoutConfigFile();
 };
 
+/**
+ * @brief Creates or reloads pipeline definition from its configuration
+ *
+ * @param pipelinesInConfigFile filled with name of the pipeline when its configuration could be parsed
+ *
+ * @return status of parsing pipeline configuration, result of pipeline validation is kept in definition status
+ */
+Status processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Value& pipelineConfig, std::set<std::string>& pipelinesInConfigFile, PipelineFactory& factory, ModelManager& manager);
+
 }  // namespace ovms
@@ -0,0 +1,165 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "modelmemorybudget.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "config.hpp"
+#include "modelinstance.hpp"
+
+namespace ovms {
+
+ModelMemoryBudget::ModelMemoryBudget(size_t budgetBytes, MetricsRegistry& registry) :
+    budgetBytes(budgetBytes) {
+    coldLoadLatency = registry.getLatencyHistogram("ovms_model_load_on_demand_duration_seconds", "Time of loading models on demand by requests", {});
+}
+
+ModelMemoryBudget& ModelMemoryBudget::instance() {
+    static ModelMemoryBudget budget(static_cast<size_t>(Config::instance().modelsMemoryBudgetMb()) * 1024 * 1024, MetricsRegistry::instance());
+    return budget;
+}
+
+void ModelMemoryBudget::add(ModelInstance& instance, size_t bytes, bool pinned) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = loadedInstances.find(&instance);
+    if (it != loadedInstances.end()) {
+        usedBytes -= it->second.bytes;
+        it->second.bytes = bytes;
+        it->second.pinned = pinned;
+    } else {
+        loadedInstances.emplace(&instance, Entry{bytes, pinned});
+    }
+    usedBytes += bytes;
+    SPDLOG_DEBUG("Model: {} version: {} uses estimated {} bytes; models memory used: {} of {} bytes",
+        instance.getName(), instance.getVersion(), bytes, usedBytes, budgetBytes);
+}
+
+void ModelMemoryBudget::remove(ModelInstance& instance) {
+    std::unique_lock<std::mutex> lock(mtx);
+    // Instance being destroyed can not be freed until eviction stops using it
+    auto it = loadedInstances.find(&instance);
+    while (it != loadedInstances.end() && it->second.evicting) {
+        evictionFinished.wait(lock);
+        it = loadedInstances.find(&instance);
+    }
+    if (it == loadedInstances.end()) {
+        return;
+    }
+    usedBytes -= it->second.bytes;
+    loadedInstances.erase(it);
+    lock.unlock();
+    loadFinished.notify_all();
+}
+
+size_t ModelMemoryBudget::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return usedBytes;
+}
+
+void ModelMemoryBudget::evictIfExceeded(ModelInstance& justLoaded) {
+    // Instances in use or being reloaded are skipped, so the next least recently used ones are tried
+    std::unordered_set<ModelInstance*> tried{&justLoaded};
+    while (true) {
+        std::vector<ModelInstance*> victims;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            // Memory of instances unloaded by concurrent evictions is already accounted as freed
+            size_t expectedBytes = usedBytes;
+            std::vector<std::pair<ModelInstance*, uint64_t>> candidates;
+            for (const auto& [instance, entry] : loadedInstances) {
+                if (entry.evicting) {
+                    expectedBytes -= entry.bytes;
+                } else if (!entry.pinned && tried.count(instance) == 0) {
+                    candidates.emplace_back(instance, instance->getLastUsedTime());
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(),
+                [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+            for (const auto& [instance, lastUsed] : candidates) {
+                if (expectedBytes <= budgetBytes) {
+                    break;
+                }
+                auto& entry = loadedInstances.at(instance);
+                entry.evicting = true;
+                expectedBytes -= entry.bytes;
+                tried.insert(instance);
+                victims.push_back(instance);
+            }
+            if (victims.empty()) {
+                if (expectedBytes > budgetBytes) {
+                    SPDLOG_WARN("Estimated memory used by loaded models: {} bytes exceeds budget: {} bytes", usedBytes, budgetBytes);
+                }
+                return;
+            }
+        }
+        std::vector<bool> unloaded;
+        unloaded.reserve(victims.size());
+        for (auto* instance : victims) {
+            unloaded.push_back(instance->unloadToFreeMemory());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            for (size_t i = 0; i < victims.size(); i++) {
+                auto it = loadedInstances.find(victims[i]);
+                if (unloaded[i]) {
+                    usedBytes -= it->second.bytes;
+                    loadedInstances.erase(it);
+                } else {
+                    it->second.evicting = false;
+                }
+            }
+        }
+        evictionFinished.notify_all();
+        loadFinished.notify_all();
+    }
+}
+
+void ModelMemoryBudget::reserveLoad(size_t bytes) {
+    if (!isEnabled() || bytes == 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mtx);
+    if (loadingBytes > 0 && usedBytes + loadingBytes + bytes > budgetBytes) {
+        SPDLOG_DEBUG("Load of estimated {} bytes waits for other loads; models memory used: {}, being loaded: {} of {} bytes",
+            bytes, usedBytes, loadingBytes, budgetBytes);
+    }
+    loadFinished.wait(lock, [this, bytes]() {
+        return loadingBytes == 0 || usedBytes + loadingBytes + bytes <= budgetBytes;
+    });
+    loadingBytes += bytes;
+}
+
+void ModelMemoryBudget::releaseLoad(size_t bytes) {
+    if (!isEnabled() || bytes == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        loadingBytes -= bytes;
+    }
+    loadFinished.notify_all();
+}
+
+void ModelMemoryBudget::recordColdLoad(uint64_t milliseconds) {
+    coldLoadLatency->observe(milliseconds * 1000);
+}
+
+}  // namespace ovms
@@ -0,0 +1,147 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "metrics.hpp"
+
+namespace ovms {
+
+class ModelInstance;
+
+/**
+ * @brief Keeps estimated memory used by loaded model instances within configured budget.
+ * When the budget is exceeded, least recently used model instances which are not pinned and not in use
+ * are unloaded. They are loaded again on demand by the next request.
+ */
+class ModelMemoryBudget {
+    struct Entry {
+        size_t bytes;
+        bool pinned;
+        /**
+         * @brief Instance is being unloaded by eviction, which runs without holding the lock
+         */
+        bool evicting = false;
+    };
+
+    const size_t budgetBytes;
+    size_t usedBytes = 0;
+    std::unordered_map<ModelInstance*, Entry> loadedInstances;
+    mutable std::mutex mtx;
+    std::condition_variable evictionFinished;
+    /**
+     * @brief Estimated memory of models being loaded at the moment
+     */
+    size_t loadingBytes = 0;
+    std::condition_variable loadFinished;
+
+    std::shared_ptr<MetricHistogram> coldLoadLatency;
+
+public:
+    /**
+     * @brief Construct budget
+     *
+     * @param budgetBytes maximal estimated memory of loaded models, 0 disables the budget
+     * @param registry metrics registry receiving durations of loads triggered by requests
+     */
+    ModelMemoryBudget(size_t budgetBytes, MetricsRegistry& registry);
+
+    /**
+     * @brief Gets the budget configured with server parameters
+     */
+    static ModelMemoryBudget& instance();
+
+    bool isEnabled() const {
+        return budgetBytes > 0;
+    }
+
+    /**
+     * @brief Registers loaded model instance or updates its memory estimate after reload
+     */
+    void add(ModelInstance& instance, size_t bytes, bool pinned);
+
+    /**
+     * @brief Unregisters model instance, waits for eviction which may be unloading the instance at the moment
+     */
+    void remove(ModelInstance& instance);
+
+    /**
+     * @brief Unloads least recently used model instances until the budget is met
+     *
+     * Victims are chosen and marked under the lock, but unloaded after releasing it,
+     * so other models can be registered and destroyed in the meantime.
+     *
+     * @param justLoaded instance which load caused the check, never unloaded
+     */
+    void evictIfExceeded(ModelInstance& justLoaded);
+
+    /**
+     * @brief Waits until memory of model which is about to be loaded fits the budget together with loaded models
+     * and other loads in progress. A load is always admitted when no other one is in progress, so models larger than
+     * the budget can still be loaded.
+     */
+    void reserveLoad(size_t bytes);
+
+    /**
+     * @brief Releases memory reserved for load, after the loaded model is registered with add()
+     */
+    void releaseLoad(size_t bytes);
+
+    /**
+     * @brief Records load of model instance triggered by a request
+     */
+    void recordColdLoad(uint64_t milliseconds);
+
+    size_t getBudgetBytes() const {
+        return budgetBytes;
+    }
+
+    size_t getUsedBytes() const;
+
+    uint64_t getColdLoads() const {
+        return coldLoadLatency->getCount();
+    }
+
+    uint64_t getColdLoadsTotalMilliseconds() const {
+        return coldLoadLatency->getSum() / 1000;
+    }
+};
+
+/**
+ * @brief Reserves memory in the budget for the time of loading a model
+ */
+class ModelLoadReservation {
+    ModelMemoryBudget& budget;
+    const size_t bytes;
+
+public:
+    ModelLoadReservation(ModelMemoryBudget& budget, size_t bytes) :
+        budget(budget),
+        bytes(bytes) {
+        budget.reserveLoad(bytes);
+    }
+    ~ModelLoadReservation() {
+        budget.releaseLoad(bytes);
+    }
+    ModelLoadReservation(const ModelLoadReservation&) = delete;
+    ModelLoadReservation& operator=(const ModelLoadReservation&) = delete;
+};
+
+}  // namespace ovms
@@ -0,0 +1,183 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "modelwarmup.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "deserialization.hpp"
+#include "ov_utils.hpp"
+#include "rest_parser.hpp"
+
+namespace ovms {
+
+const std::string ModelWarmup::ZEROS = "zeros";
+const std::string ModelWarmup::RANDOM = "random";
+
+Status ModelWarmup::run(const ModelConfig& config, const tensor_map_t& inputsInfo, OVInferRequestsQueue& inferRequestsQueue) {
+    if (config.getWarmupIterations() == 0) {
+        return StatusCode::OK;
+    }
+    auto start = std::chrono::steady_clock::now();
+    const auto& warmupData = config.getWarmupData();
+    tensorflow::serving::PredictRequest request;
+    Status status;
+    if (warmupData.empty() || warmupData == ZEROS || warmupData == RANDOM) {
+        status = prepareSyntheticInputs(config, inputsInfo, inferRequestsQueue);
+    } else {
+        status = prepareInputsFromFile(config, inputsInfo, inferRequestsQueue, request);
+    }
+    if (!status.ok()) {
+        return status;
+    }
+    const size_t inferRequestsCount = inferRequestsQueue.getInferRequestsCount();
+    try {
+        for (size_t iteration = 0; iteration < config.getWarmupIterations(); iteration++) {
+            for (size_t i = 0; i < inferRequestsCount; i++) {
+                inferRequestsQueue.getInferRequest(i).StartAsync();
+            }
+            for (size_t i = 0; i < inferRequestsCount; i++) {
+                auto sts = inferRequestsQueue.getInferRequest(i).Wait(InferenceEngine::IInferRequest::RESULT_READY);
+                if (sts != InferenceEngine::StatusCode::OK) {
+                    SPDLOG_WARN("Warmup inference of model: {} version: {} failed with code: {}", config.getName(), config.getVersion(), sts);
+                    return StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+                }
+            }
+        }
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        SPDLOG_WARN("Warmup inference of model: {} version: {} failed; error: {}", config.getName(), config.getVersion(), e.what());
+        return StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+    }
+    SPDLOG_INFO("Warmup of model: {} version: {} with {} inferences on each of {} infer requests took {} ms",
+        config.getName(), config.getVersion(), config.getWarmupIterations(), inferRequestsCount,
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+    return StatusCode::OK;
+}
+
+Status ModelWarmup::prepareSyntheticInputs(const ModelConfig& config, const tensor_map_t& inputsInfo, OVInferRequestsQueue& inferRequestsQueue) {
+    const bool random = config.getWarmupData() == RANDOM;
+    for (const auto& [name, info] : inputsInfo) {
+        InferenceEngine::Blob::Ptr blob;
+        auto status = createSharedBlob(blob, info->getTensorDesc());
+        if (!status.ok()) {
+            SPDLOG_WARN("Could not create warmup input: {} for model: {} version: {}", name, config.getName(), config.getVersion());
+            return status;
+        }
+        if (random) {
+            fillWithRandomValues(blob);
+        } else {
+            std::memset(blob->buffer(), 0, blob->byteSize());
+        }
+        // Inputs are only read by inference, so all infer requests share the same blob
+        try {
+            for (size_t i = 0; i < inferRequestsQueue.getInferRequestsCount(); i++) {
+                inferRequestsQueue.getInferRequest(i).SetBlob(info->getName(), blob);
+            }
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            SPDLOG_WARN("Could not set warmup input: {} for model: {} version: {}; error: {}", name, config.getName(), config.getVersion(), e.what());
+            return StatusCode::OV_INTERNAL_DESERIALIZATION_ERROR;
+        }
+    }
+    return StatusCode::OK;
+}
+
+Status ModelWarmup::prepareInputsFromFile(const ModelConfig& config, const tensor_map_t& inputsInfo, OVInferRequestsQueue& inferRequestsQueue,
+    tensorflow::serving::PredictRequest& request) {
+    std::ifstream file(config.getWarmupData());
+    if (!file.good()) {
+        SPDLOG_WARN("Could not read warmup data file: {} for model: {} version: {}", config.getWarmupData(), config.getName(), config.getVersion());
+        return StatusCode::FILE_INVALID;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    RestParser parser(inputsInfo);
+    auto status = parser.parse(content.str().c_str());
+    if (!status.ok()) {
+        SPDLOG_WARN("Could not parse warmup data file: {} for model: {} version: {}; error: {}",
+            config.getWarmupData(), config.getName(), config.getVersion(), status.string());
+        return status;
+    }
+    request = std::move(parser.getProto());
+    for (const auto& [name, info] : inputsInfo) {
+        auto it = request.inputs().find(name);
+        if (it == request.inputs().end()) {
+            SPDLOG_WARN("Warmup data file: {} is missing input: {}", config.getWarmupData(), name);
+            return StatusCode::INVALID_MISSING_INPUT;
+        }
+        const auto& tensorShape = it->second.tensor_shape();
+        const auto& shape = info->getShape();
+        bool shapeMatches = static_cast<size_t>(tensorShape.dim_size()) == shape.size();
+        for (int i = 0; shapeMatches && i < tensorShape.dim_size(); i++) {
+            shapeMatches = static_cast<size_t>(tensorShape.dim(i).size()) == shape[i];
+        }
+        if (!shapeMatches) {
+            SPDLOG_WARN("Warmup data file: {} input: {} shape: {} does not match model shape: {}",
+                config.getWarmupData(), name, TensorInfo::tensorShapeToString(tensorShape), TensorInfo::shapeToString(shape));
+            return StatusCode::INVALID_SHAPE;
+        }
+    }
+    for (size_t i = 0; i < inferRequestsQueue.getInferRequestsCount(); i++) {
+        status = deserializePredictRequest<ConcreteTensorProtoDeserializator>(request, inputsInfo, inferRequestsQueue.getInferRequest(i));
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return StatusCode::OK;
+}
+
+void ModelWarmup::fillWithRandomValues(InferenceEngine::Blob::Ptr& blob) {
+    // Values are kept small and non negative, so they are valid for most models and never overflow
+    std::mt19937 generator(std::random_device{}());
+    const size_t size = blob->size();
+    switch (blob->getTensorDesc().getPrecision()) {
+    case InferenceEngine::Precision::FP32: {
+        std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+        auto data = blob->buffer().as<float*>();
+        for (size_t i = 0; i < size; i++) {
+            data[i] = distribution(generator);
+        }
+        break;
+    }
+    case InferenceEngine::Precision::FP16: {
+        // Bit patterns below 0x3C00 are half precision values from [0, 1)
+        std::uniform_int_distribution<int16_t> distribution(0, 0x3BFF);
+        auto data = blob->buffer().as<int16_t*>();
+        for (size_t i = 0; i < size; i++) {
+            data[i] = distribution(generator);
+        }
+        break;
+    }
+    default: {
+        std::uniform_int_distribution<int> distribution(0, 127);
+        auto data = blob->buffer().as<uint8_t*>();
+        const size_t elementSize = blob->element_size();
+        std::memset(data, 0, blob->byteSize());
+        // Only the lowest byte of each element is set, which is correct for little endian integers of any size
+        for (size_t i = 0; i < size; i++) {
+            data[i * elementSize] = static_cast<uint8_t>(distribution(generator));
+        }
+    }
+    }
+}
+
+}  // namespace ovms
@@ -0,0 +1,68 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <string>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#pragma GCC diagnostic pop
+
+#include "modelconfig.hpp"
+#include "ovinferrequestsqueue.hpp"
+#include "status.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Runs synthetic inferences on all infer requests of a model version before it becomes available,
+ * so that one-time costs like kernels compilation, memory allocation and page faults on weights are not paid by the first requests.
+ */
+class ModelWarmup {
+public:
+    static const std::string ZEROS;
+    static const std::string RANDOM;
+
+    /**
+     * @brief Runs warmup configured in model config
+     *
+     * Each infer request runs warmup_iterations inferences, all infer requests run in parallel.
+     * Inputs are filled with zeros, random values or taken from JSON file in TensorFlow Serving REST API predict request format,
+     * depending on warmup_data.
+     *
+     * @param config model configuration
+     * @param inputsInfo inputs of loaded network
+     * @param inferRequestsQueue infer requests of loaded network
+     *
+     * @return Status
+     */
+    static Status run(const ModelConfig& config, const tensor_map_t& inputsInfo, OVInferRequestsQueue& inferRequestsQueue);
+
+private:
+    static Status prepareSyntheticInputs(const ModelConfig& config, const tensor_map_t& inputsInfo, OVInferRequestsQueue& inferRequestsQueue);
+    /**
+     * @brief Sets inputs read from warmup data file on all infer requests
+     *
+     * Input blobs point into the tensors of the request without copying, so the request has to outlive all warmup inferences.
+     */
+    static Status prepareInputsFromFile(const ModelConfig& config, const tensor_map_t& inputsInfo, OVInferRequestsQueue& inferRequestsQueue,
+        tensorflow::serving::PredictRequest& request);
+    static void fillWithRandomValues(InferenceEngine::Blob::Ptr& blob);
+};
+
+}  // namespace ovms
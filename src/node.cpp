@@ -17,9 +17,11 @@
 
 #include <algorithm>
 #include <sstream>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
+#include "ov_utils.hpp"
 #include "status.hpp"
 
 namespace ovms {
@@ -56,11 +58,49 @@ Status Node::setInputs(const Node& dependency, BlobMap& inputs) {
             dependency.getName(),
             current_node_input_name,
             dependency_output_name);
-        this->inputBlobs[current_node_input_name] = it->second;
+        if (dependency.getDemultiplexIndex() && !this->demultiplexIndex) {
+            // Dependency is a part of demultiplexed branch while this node is not - gather results
+            this->shardedInputBlobs[current_node_input_name].emplace(dependency.getDemultiplexIndex().value(), it->second);
+        } else {
+            this->inputBlobs[current_node_input_name] = it->second;
+        }
     }
 
     finishedDependenciesCount++;
+    if (isReady() && this->shardedInputBlobs.size() > 0) {
+        return gatherShardedInputs();
+    }
+    return StatusCode::OK;
+}
+
+Status Node::gatherShardedInputs() {
+    for (auto& [inputName, shardsByIndex] : this->shardedInputBlobs) {
+        std::vector<InferenceEngine::Blob::Ptr> shards;
+        shards.reserve(shardsByIndex.size());
+        for (auto& [index, blob] : shardsByIndex) {
+            shards.emplace_back(blob);
+        }
+        InferenceEngine::Blob::Ptr gatheredBlob;
+        auto status = concatenateBlobs(shards, gatheredBlob);
+        if (!status.ok()) {
+            SPDLOG_WARN("Node::gatherShardedInputs: (Node name {}) failed to gather {} results for input name: {}",
+                getName(), shards.size(), inputName);
+            return status;
+        }
+        SPDLOG_DEBUG("Node::gatherShardedInputs: (Node name {}) gathered {} results for input name: {}", getName(), shards.size(), inputName);
+        this->inputBlobs[inputName] = gatheredBlob;
+    }
+    this->shardedInputBlobs.clear();
     return StatusCode::OK;
 }
 
+std::unique_ptr<Node> Node::cloneForDemultiplexing(size_t index) const {
+    auto node = this->clone();
+    node->inputBlobs = this->inputBlobs;
+    node->finishedDependenciesCount = this->finishedDependenciesCount;
+    node->demultiplexIndex = index;
+    node->criticalPathCost = this->criticalPathCost;
+    return node;
+}
+
 }  // namespace ovms
@@ -15,6 +15,10 @@
 //*****************************************************************************
 #pragma once
 
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -46,6 +50,19 @@ protected:
     // Input/Output name mapping and list of required inputs from previous nodes
     std::unordered_map<std::string, InputPairs> blobNamesMapping;
 
+    // Demultiplexing - set for node which splits its outputs along 0th dimension, -1 means count known only at runtime
+    std::optional<int32_t> demultiplyCount;
+    // Name of demultiplexer node which results are gathered by this node
+    std::optional<std::string> gatherFrom;
+    // Index of sub-execution if node is part of demultiplexed branch
+    std::optional<size_t> demultiplexIndex;
+
+    // Blobs received from demultiplexed dependencies keyed by input name and sub-execution index
+    std::unordered_map<std::string, std::map<size_t, InferenceEngine::Blob::Ptr>> shardedInputBlobs;
+
+    // Estimated execution time of the longest path from this node to response node, used to prioritize ready nodes
+    uint64_t criticalPathCost = 0;
+
 public:
     Node(const std::string& nodeName) :
         nodeName(nodeName) {
@@ -60,6 +77,12 @@ public:
 
     Status setInputs(const Node& dependency, BlobMap& inputs);
 
+    /**
+     * @brief Creates node of the same kind and configuration, used to run demultiplexed branches in parallel.
+     * Inputs already received from dependencies are copied to the created node.
+     */
+    std::unique_ptr<Node> cloneForDemultiplexing(size_t index) const;
+
     virtual void addDependency(Node& node, const InputPairs& blobNamesMapping) {
         this->previous.emplace_back(node);
         this->blobNamesMapping[node.getName()] = blobNamesMapping;
@@ -76,10 +99,33 @@ public:
     const std::vector<std::reference_wrapper<Node>>& getNextNodes() {
         return next;
     }
+    const std::vector<std::reference_wrapper<Node>>& getPreviousNodes() {
+        return previous;
+    }
+
+    void setDemultiplyCount(std::optional<int32_t> demultiplyCount) { this->demultiplyCount = demultiplyCount; }
+    const std::optional<int32_t>& getDemultiplyCount() const { return demultiplyCount; }
+    void setGatherFrom(std::optional<std::string> gatherFrom) { this->gatherFrom = gatherFrom; }
+    const std::optional<std::string>& getGatherFrom() const { return gatherFrom; }
+    void setDemultiplexIndex(size_t index) { this->demultiplexIndex = index; }
+    const std::optional<size_t>& getDemultiplexIndex() const { return demultiplexIndex; }
+    void setCriticalPathCost(uint64_t cost) { this->criticalPathCost = cost; }
+    uint64_t getCriticalPathCost() const { return criticalPathCost; }
     virtual void release() {}
     virtual bool tryDisarmStreamIdGuard(const uint microseconds = 1) { return true; }
 
     static void printNodeConnections(const std::string& nodeName, const std::string& sourceNode, const InputPairs& pairs);
+
+protected:
+    /**
+     * @brief Creates node with the same configuration without any execution state
+     */
+    virtual std::unique_ptr<Node> clone() const {
+        throw std::logic_error("This node cannot be demultiplexed");
+    }
+
+private:
+    Status gatherShardedInputs();
 };
 
 }  // namespace ovms
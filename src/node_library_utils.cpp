@@ -0,0 +1,116 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "node_library_utils.hpp"
+
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+CustomNodeTensorPrecision toCustomNodeTensorPrecision(InferenceEngine::Precision precision) {
+    switch (precision) {
+    case InferenceEngine::Precision::FP32:
+        return CustomNodeTensorPrecision::FP32;
+    case InferenceEngine::Precision::FP16:
+        return CustomNodeTensorPrecision::FP16;
+    case InferenceEngine::Precision::U8:
+        return CustomNodeTensorPrecision::U8;
+    case InferenceEngine::Precision::I8:
+        return CustomNodeTensorPrecision::I8;
+    case InferenceEngine::Precision::I16:
+        return CustomNodeTensorPrecision::I16;
+    case InferenceEngine::Precision::U16:
+        return CustomNodeTensorPrecision::U16;
+    case InferenceEngine::Precision::I32:
+        return CustomNodeTensorPrecision::I32;
+    default:
+        return CustomNodeTensorPrecision::UNSPECIFIED;
+    }
+}
+
+InferenceEngine::Precision toInferenceEnginePrecision(CustomNodeTensorPrecision precision) {
+    switch (precision) {
+    case CustomNodeTensorPrecision::FP32:
+        return InferenceEngine::Precision::FP32;
+    case CustomNodeTensorPrecision::FP16:
+        return InferenceEngine::Precision::FP16;
+    case CustomNodeTensorPrecision::U8:
+        return InferenceEngine::Precision::U8;
+    case CustomNodeTensorPrecision::I8:
+        return InferenceEngine::Precision::I8;
+    case CustomNodeTensorPrecision::I16:
+        return InferenceEngine::Precision::I16;
+    case CustomNodeTensorPrecision::U16:
+        return InferenceEngine::Precision::U16;
+    case CustomNodeTensorPrecision::I32:
+        return InferenceEngine::Precision::I32;
+    default:
+        return InferenceEngine::Precision::UNSPECIFIED;
+    }
+}
+
+std::unique_ptr<struct CustomNodeParam[]> createCustomNodeParamArray(const parameters_t& parameters) {
+    if (parameters.size() == 0) {
+        return nullptr;
+    }
+    auto libraryParameters = std::make_unique<struct CustomNodeParam[]>(parameters.size());
+    int i = 0;
+    for (const auto& [key, value] : parameters) {
+        libraryParameters[i].key = key.c_str();
+        libraryParameters[i].value = value.c_str();
+        i++;
+    }
+    return libraryParameters;
+}
+
+Status createTensorInfoMap(struct CustomNodeTensorInfo* info, int infoCount, tensor_map_t& map, release_fn freeCallback, void* customNodeLibraryInternalManager) {
+    if (info == nullptr) {
+        return StatusCode::NODE_LIBRARY_METADATA_FAILED;
+    }
+    Status status = StatusCode::OK;
+    for (int i = 0; i < infoCount; i++) {
+        shape_t shape;
+        if (info[i].dims != nullptr) {
+            shape.assign(info[i].dims, info[i].dims + info[i].dimsCount);
+            freeCallback(info[i].dims, customNodeLibraryInternalManager);
+        }
+        if (info[i].name == nullptr) {
+            SPDLOG_ERROR("Custom node library returned tensor info without name");
+            status = StatusCode::NODE_LIBRARY_METADATA_FAILED;
+            continue;
+        }
+        const std::string name(info[i].name);
+        auto precision = toInferenceEnginePrecision(info[i].precision);
+        map.emplace(name, std::make_shared<TensorInfo>(name, precision, shape));
+    }
+    freeCallback(info, customNodeLibraryInternalManager);
+    return status;
+}
+
+Status getCustomNodeLibraryMetadata(metadata_fn fn, release_fn freeCallback, const parameters_t& parameters, void* customNodeLibraryInternalManager, tensor_map_t& map) {
+    struct CustomNodeTensorInfo* info = nullptr;
+    int infoCount = 0;
+    auto libraryParameters = createCustomNodeParamArray(parameters);
+    int result = fn(&info, &infoCount, libraryParameters.get(), parameters.size(), customNodeLibraryInternalManager);
+    if (result != 0) {
+        SPDLOG_ERROR("Custom node library metadata call failed with error: {}", result);
+        return StatusCode::NODE_LIBRARY_METADATA_FAILED;
+    }
+    return createTensorInfoMap(info, infoCount, map, freeCallback, customNodeLibraryInternalManager);
+}
+
+}  // namespace ovms
@@ -0,0 +1,44 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+
+#include <inference_engine.hpp>
+
+#include "custom_node_interface.h"
+#include "node_library.hpp"
+#include "status.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+CustomNodeTensorPrecision toCustomNodeTensorPrecision(InferenceEngine::Precision precision);
+InferenceEngine::Precision toInferenceEnginePrecision(CustomNodeTensorPrecision precision);
+
+std::unique_ptr<struct CustomNodeParam[]> createCustomNodeParamArray(const parameters_t& parameters);
+
+/**
+ * @brief Converts tensor infos allocated by custom node library to tensor map. Library memory is released afterwards.
+ */
+Status createTensorInfoMap(struct CustomNodeTensorInfo* info, int infoCount, tensor_map_t& map, release_fn freeCallback, void* customNodeLibraryInternalManager);
+
+/**
+ * @brief Queries custom node library for its inputs or outputs metadata
+ */
+Status getCustomNodeLibraryMetadata(metadata_fn fn, release_fn freeCallback, const parameters_t& parameters, void* customNodeLibraryInternalManager, tensor_map_t& map);
+
+}  // namespace ovms
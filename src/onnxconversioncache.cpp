@@ -0,0 +1,182 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "onnxconversioncache.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include "config.hpp"
+#include "filehash.hpp"
+
+namespace ovms {
+
+const std::string IR_XML_EXTENSION = ".xml";
+const std::string IR_BIN_EXTENSION = ".bin";
+
+OnnxConversionCache::OnnxConversionCache(const std::string& directory, size_t capacityBytes) :
+    directory(directory),
+    capacityBytes(capacityBytes) {
+    if (!isEnabled()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        SPDLOG_ERROR("Could not create ONNX conversion cache directory: {}; error: {}", directory, ec.message());
+    }
+}
+
+OnnxConversionCache& OnnxConversionCache::instance() {
+    static OnnxConversionCache cache(
+        Config::instance().onnxConversionCacheDir(),
+        static_cast<size_t>(Config::instance().onnxConversionCacheSizeMb()) * 1024 * 1024);
+    return cache;
+}
+
+std::string OnnxConversionCache::getEntryPath(const std::string& digest, const std::string& extension) const {
+    return (std::filesystem::path(directory) / (digest + extension)).string();
+}
+
+bool OnnxConversionCache::createDigest(const std::string& onnxFile, std::string& digest) {
+    Fnv1aHash hash;
+    // Conversion result may differ between OpenVINO releases
+    const auto version = InferenceEngine::GetInferenceEngineVersion();
+    hash.update(version->buildNumber != nullptr ? version->buildNumber : "");
+    if (!hash.updateWithFile(onnxFile)) {
+        SPDLOG_WARN("Could not read ONNX file: {} to create conversion cache digest", onnxFile);
+        return false;
+    }
+    digest = hash.toHexString();
+    return true;
+}
+
+std::unique_ptr<InferenceEngine::CNNNetwork> OnnxConversionCache::readNetwork(const std::string& digest, InferenceEngine::Core& engine) {
+    const auto xmlPath = getEntryPath(digest, IR_XML_EXTENSION);
+    const auto binPath = getEntryPath(digest, IR_BIN_EXTENSION);
+    std::error_code ec;
+    // xml is renamed last when storing, so its presence means the entry is complete
+    if (!std::filesystem::exists(xmlPath, ec) || !std::filesystem::exists(binPath, ec)) {
+        misses++;
+        SPDLOG_INFO("ONNX conversion cache miss for digest: {}; hits: {}; misses: {}", digest, hits.load(), misses.load());
+        return nullptr;
+    }
+    std::unique_ptr<InferenceEngine::CNNNetwork> network;
+    try {
+        network = std::make_unique<InferenceEngine::CNNNetwork>(engine.ReadNetwork(xmlPath, binPath));
+    } catch (const std::exception& e) {
+        misses++;
+        SPDLOG_WARN("Could not read converted network from: {}; error: {}; entry will be removed", xmlPath, e.what());
+        std::filesystem::remove(xmlPath, ec);
+        std::filesystem::remove(binPath, ec);
+        return nullptr;
+    }
+    // Mark entry as recently used
+    std::filesystem::last_write_time(xmlPath, std::filesystem::file_time_type::clock::now(), ec);
+    hits++;
+    SPDLOG_INFO("ONNX conversion cache hit for digest: {}; hits: {}; misses: {}", digest, hits.load(), misses.load());
+    return network;
+}
+
+void OnnxConversionCache::storeNetwork(const std::string& digest, const InferenceEngine::CNNNetwork& network) {
+    const auto xmlPath = getEntryPath(digest, IR_XML_EXTENSION);
+    const auto binPath = getEntryPath(digest, IR_BIN_EXTENSION);
+    std::stringstream tmpSuffix;
+    tmpSuffix << ".tmp." << getpid() << "." << std::hash<std::thread::id>{}(std::this_thread::get_id());
+    const auto tmpXmlPath = xmlPath + tmpSuffix.str();
+    const auto tmpBinPath = binPath + tmpSuffix.str();
+    std::error_code ec;
+    try {
+        network.serialize(tmpXmlPath, tmpBinPath);
+    } catch (const std::exception& e) {
+        SPDLOG_WARN("Could not serialize converted network to: {}; error: {}", tmpXmlPath, e.what());
+        std::filesystem::remove(tmpXmlPath, ec);
+        std::filesystem::remove(tmpBinPath, ec);
+        return;
+    }
+    // Weights go first, so the entry is complete as soon as xml appears
+    std::filesystem::rename(tmpBinPath, binPath, ec);
+    if (!ec) {
+        std::filesystem::rename(tmpXmlPath, xmlPath, ec);
+    }
+    if (ec) {
+        SPDLOG_WARN("Could not store ONNX conversion cache entry: {}; error: {}", xmlPath, ec.message());
+        std::filesystem::remove(tmpXmlPath, ec);
+        std::filesystem::remove(tmpBinPath, ec);
+        return;
+    }
+    stores++;
+    SPDLOG_INFO("Stored converted ONNX network in cache: {}", xmlPath);
+    evict();
+}
+
+void OnnxConversionCache::evict() {
+    if (capacityBytes == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(evictionMtx);
+    struct Entry {
+        std::filesystem::file_time_type lastUsed = std::filesystem::file_time_type::min();
+        uintmax_t size = 0;
+    };
+    // xml and bin files of the same network make up one entry, used time is kept on xml
+    std::unordered_map<std::string, Entry> entries;
+    uintmax_t totalSize = 0;
+    std::error_code ec;
+    for (const auto& file : std::filesystem::directory_iterator(directory, ec)) {
+        const auto extension = file.path().extension();
+        if (!file.is_regular_file(ec) || (extension != IR_XML_EXTENSION && extension != IR_BIN_EXTENSION)) {
+            continue;
+        }
+        auto size = file.file_size(ec);
+        if (ec) {
+            continue;
+        }
+        auto& entry = entries[file.path().stem().string()];
+        entry.size += size;
+        totalSize += size;
+        if (extension == IR_XML_EXTENSION) {
+            entry.lastUsed = file.last_write_time(ec);
+        }
+    }
+    if (totalSize <= capacityBytes) {
+        return;
+    }
+    std::vector<std::pair<std::string, Entry>> sortedEntries(entries.begin(), entries.end());
+    std::sort(sortedEntries.begin(), sortedEntries.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.second.lastUsed < rhs.second.lastUsed; });
+    for (const auto& [digest, entry] : sortedEntries) {
+        if (totalSize <= capacityBytes) {
+            break;
+        }
+        SPDLOG_INFO("Evicting ONNX conversion cache entry: {}", digest);
+        // xml is removed first, so the entry is seen as missing while its weights are being removed
+        std::filesystem::remove(getEntryPath(digest, IR_XML_EXTENSION), ec);
+        std::filesystem::remove(getEntryPath(digest, IR_BIN_EXTENSION), ec);
+        totalSize -= entry.size;
+    }
+}
+
+}  // namespace ovms
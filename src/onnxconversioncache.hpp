@@ -0,0 +1,98 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <inference_engine.hpp>
+
+namespace ovms {
+
+/**
+ * @brief On-disk cache of ONNX models converted to IR. Converted network is stored as xml/bin pair named after
+ * digest of the ONNX file, so subsequent loads of the same model read IR instead of converting ONNX again.
+ */
+class OnnxConversionCache {
+    const std::string directory;
+    const size_t capacityBytes;
+
+    std::atomic<uint64_t> hits = 0;
+    std::atomic<uint64_t> misses = 0;
+    std::atomic<uint64_t> stores = 0;
+
+    /**
+     * @brief Serializes eviction within the process. Other processes sharing the directory only ever see complete entries.
+     */
+    std::mutex evictionMtx;
+
+    std::string getEntryPath(const std::string& digest, const std::string& extension) const;
+    void evict();
+
+public:
+    /**
+     * @brief Construct cache in given directory
+     *
+     * @param directory cache location, empty disables the cache
+     * @param capacityBytes maximal size of all converted networks, 0 means no limit
+     */
+    OnnxConversionCache(const std::string& directory, size_t capacityBytes);
+
+    /**
+     * @brief Gets the cache configured with server parameters
+     */
+    static OnnxConversionCache& instance();
+
+    bool isEnabled() const {
+        return !directory.empty();
+    }
+
+    /**
+     * @brief Creates digest identifying conversion result of ONNX file. Depends on file content and OpenVINO version.
+     *
+     * @return false if file could not be read
+     */
+    static bool createDigest(const std::string& onnxFile, std::string& digest);
+
+    /**
+     * @brief Reads network converted earlier from ONNX file with given digest
+     *
+     * @return network on hit, nullptr when there is no valid entry
+     */
+    std::unique_ptr<InferenceEngine::CNNNetwork> readNetwork(const std::string& digest, InferenceEngine::Core& engine);
+
+    /**
+     * @brief Stores network converted from ONNX file with given digest. The entry becomes visible only when completely written.
+     * Least recently used entries are removed afterwards when the cache exceeds its capacity.
+     */
+    void storeNetwork(const std::string& digest, const InferenceEngine::CNNNetwork& network);
+
+    uint64_t getHits() const {
+        return hits;
+    }
+
+    uint64_t getMisses() const {
+        return misses;
+    }
+
+    uint64_t getStores() const {
+        return stores;
+    }
+};
+
+}  // namespace ovms
@@ -13,49 +13,62 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
-
 #include "ov_utils.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
-namespace ovms {
+#include "tensorinfo.hpp"
 
-Status blobClone(InferenceEngine::Blob::Ptr& destinationBlob, const InferenceEngine::Blob::Ptr sourceBlob) {
-    auto& description = sourceBlob->getTensorDesc();
+namespace ovms {
 
+Status createSharedBlob(InferenceEngine::Blob::Ptr& destinationBlob, InferenceEngine::TensorDesc tensorDesc) {
     try {
-        switch (description.getPrecision()) {
+        switch (tensorDesc.getPrecision()) {
         case InferenceEngine::Precision::FP32:
-            destinationBlob = InferenceEngine::make_shared_blob<float>(description);
+            destinationBlob = InferenceEngine::make_shared_blob<float>(tensorDesc);
             break;
         case InferenceEngine::Precision::U8:
-            destinationBlob = InferenceEngine::make_shared_blob<uint8_t>(description);
+            destinationBlob = InferenceEngine::make_shared_blob<uint8_t>(tensorDesc);
             break;
         case InferenceEngine::Precision::I8:
-            destinationBlob = InferenceEngine::make_shared_blob<int8_t>(description);
+            destinationBlob = InferenceEngine::make_shared_blob<int8_t>(tensorDesc);
             break;
+        case InferenceEngine::Precision::FP16:
         case InferenceEngine::Precision::I16:
-            destinationBlob = InferenceEngine::make_shared_blob<int16_t>(description);
+            destinationBlob = InferenceEngine::make_shared_blob<int16_t>(tensorDesc);
+            break;
+        case InferenceEngine::Precision::U16:
+            destinationBlob = InferenceEngine::make_shared_blob<uint16_t>(tensorDesc);
             break;
         case InferenceEngine::Precision::I32:
-            destinationBlob = InferenceEngine::make_shared_blob<int32_t>(description);
+            destinationBlob = InferenceEngine::make_shared_blob<int32_t>(tensorDesc);
             break;
         default: {
-            SPDLOG_ERROR("Blob clone failed, unsupported precision");
+            SPDLOG_ERROR("Blob creation failed, unsupported precision");
             return StatusCode::INVALID_PRECISION;
         }
         }
+        destinationBlob->allocate();
     } catch (const InferenceEngine::details::InferenceEngineException& e) {
-        SPDLOG_DEBUG("Blob clone failed; exception message: {}", e.what());
+        SPDLOG_DEBUG("Blob creation failed; exception message: {}", e.what());
         return StatusCode::OV_CLONE_BLOB_ERROR;
     } catch (std::logic_error& e) {
-        SPDLOG_DEBUG("Blob clone failed; exception message: {}", e.what());
+        SPDLOG_DEBUG("Blob creation failed; exception message: {}", e.what());
         return StatusCode::OV_CLONE_BLOB_ERROR;
     }
+    return StatusCode::OK;
+}
 
-    destinationBlob->allocate();
+Status blobClone(InferenceEngine::Blob::Ptr& destinationBlob, const InferenceEngine::Blob::Ptr sourceBlob) {
+    auto status = createSharedBlob(destinationBlob, sourceBlob->getTensorDesc());
+    if (!status.ok()) {
+        return status;
+    }
     if (destinationBlob->byteSize() != sourceBlob->byteSize()) {
         destinationBlob = nullptr;
         return StatusCode::OV_CLONE_BLOB_ERROR;
@@ -64,4 +77,80 @@ Status blobClone(InferenceEngine::Blob::Ptr& destinationBlob, const InferenceEng
     return StatusCode::OK;
 }
 
+Status splitBlob(const InferenceEngine::Blob::Ptr& sourceBlob, std::vector<InferenceEngine::Blob::Ptr>& shards) {
+    const auto& description = sourceBlob->getTensorDesc();
+    const auto& dims = description.getDims();
+    if (dims.size() == 0) {
+        SPDLOG_DEBUG("Blob split failed; cannot split scalar blob");
+        return StatusCode::INVALID_SHAPE;
+    }
+    const size_t shardsCount = dims[0];
+    shards.clear();
+    if (shardsCount == 0) {
+        return StatusCode::OK;
+    }
+    InferenceEngine::SizeVector shardDims = dims;
+    shardDims[0] = 1;
+    const InferenceEngine::TensorDesc shardDescription(description.getPrecision(), shardDims, description.getLayout());
+    const size_t shardByteSize = sourceBlob->byteSize() / shardsCount;
+    const char* source = (const char*)sourceBlob->buffer();
+    shards.reserve(shardsCount);
+    for (size_t i = 0; i < shardsCount; i++) {
+        InferenceEngine::Blob::Ptr shard;
+        auto status = createSharedBlob(shard, shardDescription);
+        if (!status.ok()) {
+            shards.clear();
+            return status;
+        }
+        if (shard->byteSize() != shardByteSize) {
+            shards.clear();
+            return StatusCode::OV_CLONE_BLOB_ERROR;
+        }
+        std::memcpy((void*)shard->buffer(), source + i * shardByteSize, shardByteSize);
+        shards.emplace_back(std::move(shard));
+    }
+    return StatusCode::OK;
+}
+
+Status concatenateBlobs(const std::vector<InferenceEngine::Blob::Ptr>& shards, InferenceEngine::Blob::Ptr& destinationBlob) {
+    if (shards.size() == 0) {
+        return StatusCode::PIPELINE_INCONSISTENT_SHARD_DIMENSIONS;
+    }
+    const auto& firstDescription = shards[0]->getTensorDesc();
+    const auto& firstDims = firstDescription.getDims();
+    if (firstDims.size() == 0) {
+        return StatusCode::PIPELINE_INCONSISTENT_SHARD_DIMENSIONS;
+    }
+    size_t batchSize = 0;
+    for (const auto& shard : shards) {
+        const auto& description = shard->getTensorDesc();
+        const auto& dims = description.getDims();
+        if (description.getPrecision() != firstDescription.getPrecision() ||
+            dims.size() != firstDims.size() ||
+            !std::equal(dims.begin() + 1, dims.end(), firstDims.begin() + 1)) {
+            SPDLOG_DEBUG("Blob concatenation failed; shard shape: {} does not match first shard shape: {}",
+                TensorInfo::shapeToString(dims), TensorInfo::shapeToString(firstDims));
+            return StatusCode::PIPELINE_INCONSISTENT_SHARD_DIMENSIONS;
+        }
+        batchSize += dims[0];
+    }
+    InferenceEngine::SizeVector dims = firstDims;
+    dims[0] = batchSize;
+    auto status = createSharedBlob(destinationBlob, InferenceEngine::TensorDesc(firstDescription.getPrecision(), dims, firstDescription.getLayout()));
+    if (!status.ok()) {
+        return status;
+    }
+    char* destination = (char*)destinationBlob->buffer();
+    size_t offset = 0;
+    for (const auto& shard : shards) {
+        if (offset + shard->byteSize() > destinationBlob->byteSize()) {
+            destinationBlob = nullptr;
+            return StatusCode::PIPELINE_INCONSISTENT_SHARD_DIMENSIONS;
+        }
+        std::memcpy(destination + offset, (void*)shard->buffer(), shard->byteSize());
+        offset += shard->byteSize();
+    }
+    return StatusCode::OK;
+}
+
 }  // namespace ovms
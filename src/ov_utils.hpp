@@ -15,12 +15,26 @@
 //*****************************************************************************
 #pragma once
 
+#include <vector>
+
 #include <inference_engine.hpp>
 
 #include "status.hpp"
 
 namespace ovms {
 
+Status createSharedBlob(InferenceEngine::Blob::Ptr& destinationBlob, InferenceEngine::TensorDesc tensorDesc);
+
 Status blobClone(InferenceEngine::Blob::Ptr& destinationBlob, const InferenceEngine::Blob::Ptr sourceBlob);
 
+/**
+ * @brief Splits blob along 0th dimension into blobs with 0th dimension equal to 1
+ */
+Status splitBlob(const InferenceEngine::Blob::Ptr& sourceBlob, std::vector<InferenceEngine::Blob::Ptr>& shards);
+
+/**
+ * @brief Concatenates blobs along 0th dimension. All remaining dimensions and precision must match.
+ */
+Status concatenateBlobs(const std::vector<InferenceEngine::Blob::Ptr>& shards, InferenceEngine::Blob::Ptr& destinationBlob);
+
 }  // namespace ovms
@@ -27,11 +27,17 @@ std::future<int> OVInferRequestsQueue::getIdleStream() {
     if (streams[front_idx] < 0) {  // we need to wait for any idle stream to be returned
         std::unique_lock<std::mutex> queueLock(queue_mutex);
         promises.push(std::move(idleStreamPromise));
+        if (metrics) {
+            metrics->inferRequestsWaiting->add(1);
+        }
     } else {  // we can give idle stream right away
         value = streams[front_idx];
         streams[front_idx] = -1;  // negative value indicate consumed vector index
         front_idx = (front_idx + 1) % streams.size();
         lk.unlock();
+        if (metrics) {
+            metrics->inferRequestsInUse->add(1);
+        }
         idleStreamPromise.set_value(value);
     }
     return std::move(idleStreamFuture);
@@ -43,9 +49,16 @@ void OVInferRequestsQueue::returnStream(int streamID) {
         std::promise<int> promise = std::move(promises.front());
         promises.pop();
         lk.unlock();
+        // Stream is passed directly to the waiting request, so it stays in use
+        if (metrics) {
+            metrics->inferRequestsWaiting->add(-1);
+        }
         promise.set_value(streamID);
         return;
     }
+    if (metrics) {
+        metrics->inferRequestsInUse->add(-1);
+    }
     std::uint32_t old_back = back_idx.load();
     while (!back_idx.compare_exchange_weak(
         old_back,
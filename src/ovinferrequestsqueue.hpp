@@ -18,6 +18,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -26,6 +27,8 @@
 #include <inference_engine.hpp>
 #include <spdlog/spdlog.h>
 
+#include "metrics.hpp"
+
 namespace ovms {
 /**
 * @brief Class representing circular buffer for managing IE streams
@@ -44,15 +47,23 @@ public:
 
     /**
     * @brief Constructor with initialization
+    *
+    * @param network
+    * @param streamsLength
+    * @param metrics model metrics updated with numbers of used and awaited infer requests, nullptr disables them
     */
-    OVInferRequestsQueue(InferenceEngine::ExecutableNetwork& network, int streamsLength) :
+    OVInferRequestsQueue(InferenceEngine::ExecutableNetwork& network, int streamsLength, std::shared_ptr<ModelMetrics> metrics = nullptr) :
         streams(streamsLength),
         front_idx{0},
-        back_idx{0} {
+        back_idx{0},
+        metrics(std::move(metrics)) {
         for (int i = 0; i < streamsLength; ++i) {
             streams[i] = i;
             inferRequests.push_back(network.CreateInferRequest());
         }
+        if (this->metrics) {
+            this->metrics->inferRequestsPoolSize->set(streamsLength);
+        }
     }
 
     /**
@@ -62,6 +73,13 @@ public:
         return inferRequests[streamID];
     }
 
+    /**
+     * @brief Get number of InferRequests
+     */
+    size_t getInferRequestsCount() const {
+        return inferRequests.size();
+    }
+
 protected:
     /**
     * @brief Vector representing circular buffer for infer queue
@@ -88,5 +106,7 @@ protected:
      */
     std::vector<InferenceEngine::InferRequest> inferRequests;
     std::queue<std::promise<int>> promises;
+
+    std::shared_ptr<ModelMetrics> metrics;
 };
 }  // namespace ovms
@@ -16,12 +16,21 @@
 #include "pipeline.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
 #include <map>
+#include <optional>
+#include <queue>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "logging.hpp"
+#include "ov_utils.hpp"
 #include "threadsafequeue.hpp"
+#include "tracing.hpp"
 
 namespace ovms {
 
@@ -37,12 +46,104 @@ void printNodeConnections(const std::string& nodeName, const std::string& source
     SPDLOG_LOGGER_DEBUG(dag_executor_logger, ss.str());
 }
 
-std::map<const std::string, bool> Pipeline::prepareStatusMap() const {
-    std::map<const std::string, bool> nameFlagMap;
+std::map<const Node*, bool> Pipeline::prepareStatusMap() const {
+    std::map<const Node*, bool> nodeFlagMap;
     for (const auto& node : nodes) {
-        nameFlagMap.emplace(std::make_pair(node->getName(), false));
+        nodeFlagMap.emplace(std::make_pair(node.get(), false));
     }
-    return std::move(nameFlagMap);
+    return std::move(nodeFlagMap);
+}
+
+Status Pipeline::demultiplex(Node& demultiplexer, const BlobMap& outputs, std::vector<BlobMap>& shardedOutputs,
+    std::map<const Node*, bool>& startedExecute, std::map<const Node*, bool>& finishedExecute) {
+    std::optional<size_t> count;
+    for (const auto& [outputName, blob] : outputs) {
+        std::vector<InferenceEngine::Blob::Ptr> shards;
+        auto status = splitBlob(blob, shards);
+        if (!status.ok()) {
+            SPDLOG_LOGGER_ERROR(dag_executor_logger, "Pipeline: {} failed to demultiplex node: {} output: {}", getName(), demultiplexer.getName(), outputName);
+            return status;
+        }
+        if (!count) {
+            count = shards.size();
+            shardedOutputs.resize(shards.size());
+        } else if (count.value() != shards.size()) {
+            SPDLOG_LOGGER_ERROR(dag_executor_logger, "Pipeline: {} node: {} outputs have different 0th dimension size; output: {} has: {}, expected: {}",
+                getName(), demultiplexer.getName(), outputName, shards.size(), count.value());
+            return StatusCode::PIPELINE_DEMULTIPLY_COUNT_DOES_NOT_MATCH_BLOB_BATCH_SIZE;
+        }
+        for (size_t i = 0; i < shards.size(); i++) {
+            shardedOutputs[i].emplace(outputName, shards[i]);
+        }
+    }
+    if (!count || count.value() == 0) {
+        SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Pipeline: {} node: {} returned no results to demultiplex", getName(), demultiplexer.getName());
+        return StatusCode::PIPELINE_DEMULTIPLEXER_NO_RESULTS;
+    }
+    const int32_t demultiplyCount = demultiplexer.getDemultiplyCount().value();
+    if (demultiplyCount > 0 && static_cast<size_t>(demultiplyCount) != count.value()) {
+        SPDLOG_LOGGER_ERROR(dag_executor_logger, "Pipeline: {} node: {} demultiply_count: {} does not match 0th dimension of outputs: {}",
+            getName(), demultiplexer.getName(), demultiplyCount, count.value());
+        return StatusCode::PIPELINE_DEMULTIPLY_COUNT_DOES_NOT_MATCH_BLOB_BATCH_SIZE;
+    }
+    SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Pipeline: {} node: {} outputs demultiplexed into {} parts", getName(), demultiplexer.getName(), count.value());
+
+    // Collect nodes between demultiplexer and gathering node (or response node)
+    std::vector<Node*> region;
+    std::set<const Node*> visited;
+    std::queue<Node*> toVisit;
+    for (auto& node : demultiplexer.getNextNodes()) {
+        toVisit.push(&node.get());
+    }
+    while (!toVisit.empty()) {
+        Node* node = toVisit.front();
+        toVisit.pop();
+        if (node == &exit || node->getGatherFrom() == demultiplexer.getName() || !visited.insert(node).second) {
+            continue;
+        }
+        region.push_back(node);
+        for (auto& next : node->getNextNodes()) {
+            toVisit.push(&next.get());
+        }
+    }
+    for (auto* node : region) {
+        node->setDemultiplexIndex(0);
+    }
+
+    for (size_t index = 1; index < count.value(); index++) {
+        std::map<const Node*, Node*> clones;
+        for (auto* node : region) {
+            auto clone = node->cloneForDemultiplexing(index);
+            clones.emplace(node, clone.get());
+            startedExecute.emplace(clone.get(), false);
+            finishedExecute.emplace(clone.get(), false);
+            push(std::move(clone));
+        }
+        for (auto* node : region) {
+            Node& clone = *clones.at(node);
+            for (auto& dependency : node->getPreviousNodes()) {
+                auto it = clones.find(&dependency.get());
+                Node& from = it != clones.end() ? *it->second : dependency.get();
+                connect(from, clone, node->getMappingByDependency(dependency.get()));
+            }
+            for (auto& dependant : node->getNextNodes()) {
+                if (clones.count(&dependant.get()) == 0) {
+                    connect(clone, dependant.get(), dependant.get().getMappingByDependency(*node));
+                }
+            }
+        }
+    }
+    return StatusCode::OK;
+}
+
+static bool hasLongerCriticalPath(const std::reference_wrapper<Node>& lhs, const std::reference_wrapper<Node>& rhs) {
+    return lhs.get().getCriticalPathCost() > rhs.get().getCriticalPathCost();
+}
+
+static void deferNodeExecution(std::vector<std::reference_wrapper<Node>>& deferredNodes, Node& node) {
+    // Keep deferred nodes ordered so the ones on the longest remaining path are retried first
+    auto position = std::upper_bound(deferredNodes.begin(), deferredNodes.end(), std::ref(node), hasLongerCriticalPath);
+    deferredNodes.insert(position, node);
 }
 
 void setFailIfNotFailEarlier(ovms::Status& earlierStatusCode, ovms::Status& newFailStatus) {
@@ -68,19 +169,39 @@ void setFailIfNotFailEarlier(ovms::Status& earlierStatusCode, ovms::Status& newF
     }
 
 Status Pipeline::execute() {
+    if (!metrics) {
+        return executeNodes();
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    auto status = executeNodes();
+    metrics->requestLatency->observeDuration(std::chrono::high_resolution_clock::now() - start);
+    if (status.ok()) {
+        metrics->requestsSuccess->increment();
+    } else {
+        metrics->requestsFail->increment();
+    }
+    return status;
+}
+
+static Status executeNode(Node& node, ThreadSafeQueue<std::reference_wrapper<Node>>& finishedNodeQueue) {
+    ScopedSpan span(TraceSpan::NODE_EXECUTE, node.getName());
+    return node.execute(finishedNodeQueue);
+}
+
+Status Pipeline::executeNodes() {
     SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Started execution of pipeline: {}", getName());
     ThreadSafeQueue<std::reference_wrapper<Node>> finishedNodeQueue;
     ovms::Status firstErrorStatus{ovms::StatusCode::OK};
     auto startedExecute{prepareStatusMap()};
     auto finishedExecute{prepareStatusMap()};
-    startedExecute.at(entry.getName()) = true;
-    ovms::Status status = entry.execute(finishedNodeQueue);  // first node will triger first message
+    startedExecute.at(&entry) = true;
+    ovms::Status status = executeNode(entry, finishedNodeQueue);  // first node will triger first message
     if (!status.ok()) {
         SPDLOG_LOGGER_WARN(dag_executor_logger, "Executing pipeline: {} node: {} failed with: {}",
             getName(), entry.getName(), status.string());
         return status;
     }
-    std::vector<std::reference_wrapper<Node>> nodesWaitingForIdleInferenceStreamId;  // consider replacing with std::vector
+    std::vector<std::reference_wrapper<Node>> nodesWaitingForIdleInferenceStreamId;  // ordered by critical path cost, longest first
     // even though we can remove with random sequence it is probable that we will remove those in sequence
     const uint WAIT_FOR_FINISHED_NODE_TIMEOUT_MICROSECONDS = 5000;
     const uint WAIT_FOR_DEFERRED_NODE_DISARM_TIMEOUT_MICROSECONDS = 500;
@@ -88,48 +209,66 @@ Status Pipeline::execute() {
     // has necessary resources already
     while (true) {
         spdlog::trace("Pipeline: {} waiting for message that node finished.", getName());
-        auto optionallyFinishedNode = finishedNodeQueue.tryPull(WAIT_FOR_FINISHED_NODE_TIMEOUT_MICROSECONDS);
+        std::optional<std::reference_wrapper<Node>> optionallyFinishedNode;
+        {
+            ScopedSpan span(TraceSpan::PIPELINE_WAIT);
+            optionallyFinishedNode = finishedNodeQueue.tryPull(WAIT_FOR_FINISHED_NODE_TIMEOUT_MICROSECONDS);
+        }
         if (optionallyFinishedNode) {
             Node& finishedNode = optionallyFinishedNode.value().get();
             SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Pipeline: {} got message that node: {} finished.", getName(), finishedNode.getName());
-            finishedExecute.at(finishedNode.getName()) = true;
+            finishedExecute.at(&finishedNode) = true;
             if (!firstErrorStatus.ok()) {
                 finishedNode.release();
             }
             IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
             BlobMap finishedNodeOutputBlobMap;
             SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Fetching results of pipeline: {} node: {}", getName(), finishedNode.getName());
-            status = finishedNode.fetchResults(finishedNodeOutputBlobMap);
+            {
+                ScopedSpan span(TraceSpan::NODE_FETCH_RESULTS, finishedNode.getName());
+                status = finishedNode.fetchResults(finishedNodeOutputBlobMap);
+            }
             CHECK_AND_LOG_ERROR(finishedNode)
             IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
             if (std::all_of(finishedExecute.begin(), finishedExecute.end(), [](auto pair) { return pair.second; })) {
                 break;
             }
+            std::vector<BlobMap> shardedOutputBlobMaps;
+            if (finishedNode.getDemultiplyCount()) {
+                status = demultiplex(finishedNode, finishedNodeOutputBlobMap, shardedOutputBlobMaps, startedExecute, finishedExecute);
+                CHECK_AND_LOG_ERROR(finishedNode)
+                IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
+            }
             auto& nextNodesFromFinished = finishedNode.getNextNodes();
             for (auto& nextNode : nextNodesFromFinished) {
                 SPDLOG_LOGGER_DEBUG(dag_executor_logger, "setting pipeline: {} node: {} outputs as inputs for node: {}",
                     getName(), finishedNode.getName(), nextNode.get().getName());
-                status = nextNode.get().setInputs(finishedNode, finishedNodeOutputBlobMap);
+                const auto& demultiplexIndex = nextNode.get().getDemultiplexIndex();
+                BlobMap& inputs = (shardedOutputBlobMaps.size() > 0 && demultiplexIndex) ? shardedOutputBlobMaps[demultiplexIndex.value()] : finishedNodeOutputBlobMap;
+                status = nextNode.get().setInputs(finishedNode, inputs);
                 CHECK_AND_LOG_ERROR(nextNode.get())
                 if (!firstErrorStatus.ok()) {
                     break;
                 }
             }
             finishedNodeOutputBlobMap.clear();
-            for (auto& nextNode : nextNodesFromFinished) {
-                if (nextNode.get().isReady()) {
-                    SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Started execution of pipeline: {} node: {}", getName(), nextNode.get().getName());
-                    startedExecute.at(nextNode.get().getName()) = true;
-                    status = nextNode.get().execute(finishedNodeQueue);
-                    if (status == StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET) {
-                        SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Node: {} not ready for execution yet", nextNode.get().getName());
-                        nodesWaitingForIdleInferenceStreamId.push_back(nextNode.get());
-                        status = StatusCode::OK;
-                    }
-                    CHECK_AND_LOG_ERROR(nextNode.get())
-                    if (!firstErrorStatus.ok()) {
-                        break;
-                    }
+            shardedOutputBlobMaps.clear();
+            std::vector<std::reference_wrapper<Node>> readyNodes;
+            std::copy_if(nextNodesFromFinished.begin(), nextNodesFromFinished.end(), std::back_inserter(readyNodes),
+                [](const auto& node) { return node.get().isReady(); });
+            std::stable_sort(readyNodes.begin(), readyNodes.end(), hasLongerCriticalPath);
+            for (auto& nextNode : readyNodes) {
+                SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Started execution of pipeline: {} node: {}", getName(), nextNode.get().getName());
+                startedExecute.at(&nextNode.get()) = true;
+                status = executeNode(nextNode.get(), finishedNodeQueue);
+                if (status == StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET) {
+                    SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Node: {} not ready for execution yet", nextNode.get().getName());
+                    deferNodeExecution(nodesWaitingForIdleInferenceStreamId, nextNode.get());
+                    status = StatusCode::OK;
+                }
+                CHECK_AND_LOG_ERROR(nextNode.get())
+                if (!firstErrorStatus.ok()) {
+                    break;
                 }
             }
         } else {
@@ -143,7 +282,7 @@ Status Pipeline::execute() {
                         auto& node = (*it).get();
                         if (node.tryDisarmStreamIdGuard(WAIT_FOR_DEFERRED_NODE_DISARM_TIMEOUT_MICROSECONDS)) {
                             SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Stream id guard disarm of node {} has succeeded", node.getName());
-                            finishedExecute.at(node.getName()) = true;
+                            finishedExecute.at(&node) = true;
                             it = nodesWaitingForIdleInferenceStreamId.erase(it);
                         } else {
                             SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Cannot disarm stream id guard of node {} yet, will try again later", node.getName());
@@ -166,7 +305,7 @@ Status Pipeline::execute() {
             for (auto it = nodesWaitingForIdleInferenceStreamId.begin(); it != nodesWaitingForIdleInferenceStreamId.end();) {
                 auto& node = (*it).get();
                 SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Trying to trigger node: {} execution", node.getName());
-                status = node.execute(finishedNodeQueue);
+                status = executeNode(node, finishedNodeQueue);
                 if (status.ok()) {
                     SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Node: {} ready yet:", node.getName());
                     it = nodesWaitingForIdleInferenceStreamId.erase(it);
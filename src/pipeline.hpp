@@ -24,6 +24,7 @@
 #include "dl_node.hpp"
 #include "entry_node.hpp"
 #include "exit_node.hpp"
+#include "metrics.hpp"
 #include "status.hpp"
 
 namespace ovms {
@@ -35,12 +36,14 @@ class Pipeline {
     const std::string name;
     EntryNode& entry;
     ExitNode& exit;
+    std::shared_ptr<PipelineMetrics> metrics;
 
 public:
-    Pipeline(EntryNode& entry, ExitNode& exit, const std::string& name = "default_name") :
+    Pipeline(EntryNode& entry, ExitNode& exit, const std::string& name = "default_name", std::shared_ptr<PipelineMetrics> metrics = nullptr) :
         name(name),
         entry(entry),
-        exit(exit) {}
+        exit(exit),
+        metrics(std::move(metrics)) {}
 
     void push(std::unique_ptr<Node> node) {
         nodes.emplace_back(std::move(node));
@@ -62,7 +65,16 @@ public:
     }
 
 private:
-    std::map<const std::string, bool> prepareStatusMap() const;
+    std::map<const Node*, bool> prepareStatusMap() const;
+
+    Status executeNodes();
+
+    /**
+     * @brief Splits demultiplexer outputs along 0th dimension and creates copies of nodes located
+     * between demultiplexer and gathering node, so each slice is processed by its own set of nodes.
+     */
+    Status demultiplex(Node& demultiplexer, const BlobMap& outputs, std::vector<BlobMap>& shardedOutputs,
+        std::map<const Node*, bool>& startedExecute, std::map<const Node*, bool>& finishedExecute);
 };
 
 }  // namespace ovms
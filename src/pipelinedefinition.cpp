@@ -16,10 +16,13 @@
 #include "pipelinedefinition.hpp"
 
 #include <chrono>
+#include <queue>
 #include <set>
 #include <thread>
 
+#include "custom_node.hpp"
 #include "logging.hpp"
+#include "node_library_utils.hpp"
 #include "pipelinedefinitionunloadguard.hpp"
 #include "prediction_service_utils.hpp"
 
@@ -30,6 +33,10 @@ Status toNodeKind(const std::string& str, NodeKind& nodeKind) {
         nodeKind = NodeKind::DL;
         return StatusCode::OK;
     }
+    if (str == CUSTOM_NODE_CONFIG_TYPE) {
+        nodeKind = NodeKind::CUSTOM;
+        return StatusCode::OK;
+    }
     SPDLOG_LOGGER_ERROR(modelmanager_logger, "Unsupported node type: {}", str);
     return StatusCode::PIPELINE_NODE_WRONG_KIND_CONFIGURATION;
 }
@@ -43,7 +50,12 @@ Status PipelineDefinition::validate(ModelManager& manager) {
         return StatusCode::PIPELINE_NAME_OCCUPIED;
     }
 
-    Status validationResult = validateNodes(manager);
+    Status validationResult = initializeNodeResources();
+    if (!validationResult.ok()) {
+        return validationResult;
+    }
+
+    validationResult = validateNodes(manager);
     if (!validationResult.ok()) {
         return validationResult;
     }
@@ -52,21 +64,33 @@ Status PipelineDefinition::validate(ModelManager& manager) {
     if (!validationResult.ok()) {
         return validationResult;
     }
+
+    validationResult = validateDemultiplexerGatherNodesOrder();
+    if (!validationResult.ok()) {
+        return validationResult;
+    }
     notifier.passed = true;
     SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Finished validation of pipeline: {}", getName());
     return validationResult;
 }
 
 Status PipelineDefinition::reload(ModelManager& manager, const std::vector<NodeInfo>&& nodeInfos, const pipeline_connections_t&& connections) {
+    const bool wasRetired = this->status.getStateCode() == PipelineDefinitionStateCode::RETIRED;
     // block creating new unloadGuards
     this->status.handle(ReloadEvent());
     resetSubscriptions(manager);
     while (requestsHandlesCounter > 0) {
         std::this_thread::sleep_for(std::chrono::microseconds(1));
     }
+    if (wasRetired) {
+        // Series of retired pipeline were removed from export, pipeline added back to config starts with new ones
+        metrics = std::make_shared<PipelineMetrics>(getName());
+    }
 
+    this->nodeResources.clear();
     this->nodeInfos = std::move(nodeInfos);
     this->connections = std::move(connections);
+    resetNodeCosts();
     makeSubscriptions(manager);
 
     return validate(manager);
@@ -78,8 +102,32 @@ void PipelineDefinition::retire(ModelManager& manager) {
     while (requestsHandlesCounter > 0) {
         std::this_thread::sleep_for(std::chrono::microseconds(1));
     }
+    this->nodeResources.clear();
     this->nodeInfos.clear();
     this->connections.clear();
+    resetNodeCosts();
+    metrics->remove();
+}
+
+Status PipelineDefinition::initializeNodeResources() {
+    for (const auto& nodeInfo : nodeInfos) {
+        if (nodeInfo.kind != NodeKind::CUSTOM || nodeResources.count(nodeInfo.nodeName) > 0) {
+            continue;
+        }
+        if (!nodeInfo.library.isValid()) {
+            SPDLOG_LOGGER_ERROR(modelmanager_logger, "Pipeline: {} node: {} refers to invalid custom node library", getName(), nodeInfo.nodeName);
+            return StatusCode::PIPELINE_DEFINITION_INVALID_NODE_LIBRARY;
+        }
+        void* customNodeLibraryInternalManager = nullptr;
+        auto params = createCustomNodeParamArray(nodeInfo.parameters);
+        int result = nodeInfo.library.initialize(&customNodeLibraryInternalManager, params.get(), nodeInfo.parameters.size());
+        if (result != 0) {
+            SPDLOG_LOGGER_ERROR(modelmanager_logger, "Initialization of custom node library for pipeline: {} node: {} failed with error: {}", getName(), nodeInfo.nodeName, result);
+            return StatusCode::NODE_LIBRARY_INITIALIZE_FAILED;
+        }
+        nodeResources.emplace(nodeInfo.nodeName, std::make_shared<CNLIMWrapper>(customNodeLibraryInternalManager, nodeInfo.library.deinitialize));
+    }
+    return StatusCode::OK;
 }
 
 Status PipelineDefinition::waitForLoaded(std::unique_ptr<PipelineDefinitionUnloadGuard>& unloadGuard, const uint waitForLoadedTimeoutMicroseconds) {
@@ -128,6 +176,107 @@ Status PipelineDefinition::waitForLoaded(std::unique_ptr<PipelineDefinitionUnloa
     return StatusCode::OK;
 }
 
+Status PipelineDefinition::collectRequiredNodes(const tensorflow::serving::PredictRequest* request, std::set<std::string>& requiredNodes) const {
+    if (request->output_filter_size() == 0) {
+        for (const auto& info : nodeInfos) {
+            requiredNodes.insert(info.nodeName);
+        }
+        return StatusCode::OK;
+    }
+    std::queue<std::string> toVisit;
+    for (const auto& info : nodeInfos) {
+        if (info.kind == NodeKind::ENTRY || info.kind == NodeKind::EXIT) {
+            requiredNodes.insert(info.nodeName);
+        }
+    }
+    auto exitConnections = connections.find(EXIT_NODE_NAME);
+    for (const auto& outputName : request->output_filter()) {
+        bool found = false;
+        if (exitConnections != connections.end()) {
+            for (const auto& [dependencyName, mapping] : exitConnections->second) {
+                if (std::any_of(mapping.begin(), mapping.end(), [&outputName](const auto& pair) { return pair.second == outputName; })) {
+                    toVisit.push(dependencyName);
+                    found = true;
+                }
+            }
+        }
+        if (!found) {
+            std::stringstream ss;
+            ss << "Requested output: " << outputName;
+            const std::string details = ss.str();
+            SPDLOG_LOGGER_DEBUG(dag_executor_logger, "[Pipeline: {}] Missing output with specific name - {}", getName(), details);
+            return Status(StatusCode::INVALID_MISSING_OUTPUT, details);
+        }
+    }
+    // Only nodes from which requested outputs can be reached are executed
+    while (!toVisit.empty()) {
+        const std::string nodeName = toVisit.front();
+        toVisit.pop();
+        if (!requiredNodes.insert(nodeName).second) {
+            continue;
+        }
+        auto it = connections.find(nodeName);
+        if (it == connections.end()) {
+            continue;
+        }
+        for (const auto& [dependencyName, mapping] : it->second) {
+            toVisit.push(dependencyName);
+        }
+    }
+    return StatusCode::OK;
+}
+
+static uint64_t estimateNodeCost(const NodeInfo& info, ModelManager& manager) {
+    // Each node costs at least 1 so that with no measurements longer chains of nodes are still preferred
+    uint64_t cost = 1;
+    if (info.kind == NodeKind::DL) {
+        auto instance = manager.findModelInstance(info.modelName, info.modelVersion.value_or(0));
+        if (instance) {
+            cost = std::max<uint64_t>(cost, instance->getInferenceLatencyEstimate());
+        }
+    }
+    return cost;
+}
+
+std::shared_ptr<const std::unordered_map<std::string, uint64_t>> PipelineDefinition::getNodeCosts(ModelManager& manager) {
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(nodeCostsMtx);
+        if (nodeCosts && now < nodeCostsExpiration) {
+            return nodeCosts;
+        }
+        // Concurrent requests keep using previous costs while they are refreshed
+        nodeCostsExpiration = now + NODE_COSTS_REFRESH_INTERVAL;
+    }
+    auto costs = std::make_shared<std::unordered_map<std::string, uint64_t>>();
+    for (const auto& info : nodeInfos) {
+        costs->emplace(info.nodeName, estimateNodeCost(info, manager));
+    }
+    std::lock_guard<std::mutex> lock(nodeCostsMtx);
+    nodeCosts = costs;
+    return costs;
+}
+
+void PipelineDefinition::resetNodeCosts() {
+    std::lock_guard<std::mutex> lock(nodeCostsMtx);
+    nodeCosts.reset();
+}
+
+static uint64_t estimateCriticalPathCost(Node& node, const std::unordered_map<const Node*, uint64_t>& nodeCosts, std::unordered_map<const Node*, uint64_t>& criticalPathCosts) {
+    auto it = criticalPathCosts.find(&node);
+    if (it != criticalPathCosts.end()) {
+        return it->second;
+    }
+    uint64_t longestRemainingPath = 0;
+    for (auto& next : node.getNextNodes()) {
+        longestRemainingPath = std::max(longestRemainingPath, estimateCriticalPathCost(next.get(), nodeCosts, criticalPathCosts));
+    }
+    uint64_t cost = nodeCosts.at(&node) + longestRemainingPath;
+    node.setCriticalPathCost(cost);
+    criticalPathCosts.emplace(&node, cost);
+    return cost;
+}
+
 Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
     const tensorflow::serving::PredictRequest* request,
     tensorflow::serving::PredictResponse* response,
@@ -138,10 +287,22 @@ Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
         return status;
     }
 
+    std::set<std::string> requiredNodes;
+    status = collectRequiredNodes(request, requiredNodes);
+    if (!status.ok()) {
+        return status;
+    }
+
     std::unordered_map<std::string, std::unique_ptr<Node>> nodes;
+    const auto estimatedCosts = getNodeCosts(manager);
+    std::unordered_map<const Node*, uint64_t> costs;
     EntryNode* entry = nullptr;
     ExitNode* exit = nullptr;
     for (const auto& info : nodeInfos) {
+        if (requiredNodes.count(info.nodeName) == 0) {
+            SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Creating pipeline: {}. Skipping node: {} not required by output filter", getName(), info.nodeName);
+            continue;
+        }
         SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Creating pipeline: {}. Adding nodeName: {}, modelName: {}",
             getName(), info.nodeName, info.modelName);
         switch (info.kind) {
@@ -158,6 +319,13 @@ Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
                                                            manager,
                                                            info.outputNameAliases))));
             break;
+        case NodeKind::CUSTOM:
+            nodes.insert(std::make_pair(info.nodeName, std::move(std::make_unique<CustomNode>(info.nodeName,
+                                                           info.library,
+                                                           info.parameters,
+                                                           info.outputNameAliases,
+                                                           nodeResources.at(info.nodeName)))));
+            break;
         case NodeKind::EXIT: {
             auto node = std::make_unique<ExitNode>(response);
             exit = node.get();
@@ -167,16 +335,39 @@ Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
         default:
             throw std::invalid_argument("unknown node kind");
         }
+        auto& node = nodes.at(info.nodeName);
+        node->setDemultiplyCount(info.demultiplyCount);
+        node->setGatherFrom(info.gatherFromNode);
+        costs.emplace(node.get(), estimatedCosts->at(info.nodeName));
     }
     for (const auto& kv : connections) {
+        if (nodes.count(kv.first) == 0) {
+            continue;
+        }
         const auto& dependantNode = nodes.at(kv.first);
         for (const auto& pair : kv.second) {
+            if (nodes.count(pair.first) == 0) {
+                continue;
+            }
             const auto& dependencyNode = nodes.at(pair.first);
+            InputPairs mapping = pair.second;
+            if (dependantNode.get() == exit && request->output_filter_size() > 0) {
+                const auto& outputFilter = request->output_filter();
+                mapping.erase(std::remove_if(mapping.begin(), mapping.end(), [&outputFilter](const auto& outputPair) {
+                    return std::find(outputFilter.begin(), outputFilter.end(), outputPair.second) == outputFilter.end();
+                }),
+                    mapping.end());
+                if (mapping.empty()) {
+                    continue;
+                }
+            }
             SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Connecting pipeline: {}, from: {}, to: {}", getName(), dependencyNode->getName(), dependantNode->getName());
-            Pipeline::connect(*dependencyNode, *dependantNode, pair.second);
+            Pipeline::connect(*dependencyNode, *dependantNode, mapping);
         }
     }
-    pipeline = std::make_unique<Pipeline>(*entry, *exit, pipelineName);
+    std::unordered_map<const Node*, uint64_t> criticalPathCosts;
+    estimateCriticalPathCost(*entry, costs, criticalPathCosts);
+    pipeline = std::make_unique<Pipeline>(*entry, *exit, pipelineName, metrics);
     for (auto& kv : nodes) {
         pipeline->push(std::move(kv.second));
     }
@@ -240,10 +431,14 @@ class NodeValidator {
     const NodeInfo& dependantNodeInfo;
     const pipeline_connections_t& connections;
     const std::vector<NodeInfo>& nodeInfos;
+    const std::unordered_map<std::string, std::shared_ptr<CNLIMWrapper>>& nodeResources;
 
     std::unique_ptr<ModelInstanceUnloadGuard> dependantModelUnloadGuard;
     std::shared_ptr<ModelInstance> dependantModelInstance;
-    std::set<std::string> remainingUnconnectedDependantModelInputs;
+    std::set<std::string> remainingUnconnectedDependantInputs;
+
+    // Inputs metadata of validated node - taken from underlying model or custom node library
+    tensor_map_t dependantInputsInfo;
 
 public:
     NodeValidator(
@@ -251,12 +446,14 @@ public:
         ModelManager& manager,
         const NodeInfo& dependantNodeInfo,
         const pipeline_connections_t& connections,
-        const std::vector<NodeInfo>& nodeInfos) :
+        const std::vector<NodeInfo>& nodeInfos,
+        const std::unordered_map<std::string, std::shared_ptr<CNLIMWrapper>>& nodeResources) :
         pipelineName(pipelineName),
         manager(manager),
         dependantNodeInfo(dependantNodeInfo),
         connections(connections),
-        nodeInfos(nodeInfos) {
+        nodeInfos(nodeInfos),
+        nodeResources(nodeResources) {
         SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Validation of pipeline: {}; node name: {}; node kind: {}",
             pipelineName,
             dependantNodeInfo.nodeName,
@@ -277,9 +474,34 @@ public:
                 dependantNodeInfo.modelVersion.value_or(0));
             return StatusCode::PIPELINE_NODE_REFERING_TO_MISSING_MODEL;
         }
+        dependantInputsInfo = dependantModelInstance->getInputsInfo();
         return StatusCode::OK;
     }
 
+    Status fetchCustomNodeLibraryMetadata(const NodeInfo& nodeInfo, bool inputs, tensor_map_t& metadata) {
+        if (!nodeInfo.library.isValid()) {
+            SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node: {} refers to invalid custom node library",
+                pipelineName,
+                nodeInfo.nodeName);
+            return StatusCode::PIPELINE_DEFINITION_INVALID_NODE_LIBRARY;
+        }
+        auto it = nodeResources.find(nodeInfo.nodeName);
+        void* customNodeLibraryInternalManager = it != nodeResources.end() ? it->second->ptr : nullptr;
+        auto status = getCustomNodeLibraryMetadata(
+            inputs ? nodeInfo.library.getInputsInfo : nodeInfo.library.getOutputsInfo,
+            nodeInfo.library.release,
+            nodeInfo.parameters,
+            customNodeLibraryInternalManager,
+            metadata);
+        if (!status.ok()) {
+            SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node: {} custom node library failed to return {} metadata",
+                pipelineName,
+                nodeInfo.nodeName,
+                inputs ? "inputs" : "outputs");
+        }
+        return status;
+    }
+
     Status getDependencyNodeInfo(const std::string& dependencyNodeName, std::vector<NodeInfo>::const_iterator& dependencyNodeInfo) {
         // Find dependency node info object.
         dependencyNodeInfo = std::find_if(
@@ -315,7 +537,7 @@ public:
         return StatusCode::OK;
     }
 
-    Status checkConnectionMappedToExistingDataSource(const NodeInfo& dependencyNodeInfo, std::shared_ptr<ModelInstance>& dependencyModelInstance, const std::string& dataSource) {
+    Status checkConnectionMappedToExistingDataSource(const NodeInfo& dependencyNodeInfo, const tensor_map_t& dependencyOutputsInfo, const std::string& dataSource) {
         // Check whether dependency node is configured to have required output.
         if (dependencyNodeInfo.outputNameAliases.count(dataSource) == 0) {
             SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Missing dependency node:{} data item:{} for dependant node:{}",
@@ -326,11 +548,11 @@ public:
             return StatusCode::PIPELINE_NODE_REFERING_TO_MISSING_DATA_SOURCE;
         }
 
-        // If dependency node is of type DL model, make sure there is underlying model output present.
-        if (dependencyNodeInfo.kind == NodeKind::DL) {
-            // Check whether underlying model contains required output.
+        // If dependency node is of type DL model or custom, make sure there is underlying model/library output present.
+        if (dependencyNodeInfo.kind == NodeKind::DL || dependencyNodeInfo.kind == NodeKind::CUSTOM) {
+            // Check whether underlying model/library contains required output.
             const auto& modelOutputName = dependencyNodeInfo.outputNameAliases.at(dataSource);
-            if (dependencyModelInstance->getOutputsInfo().count(modelOutputName) == 0) {
+            if (dependencyOutputsInfo.count(modelOutputName) == 0) {
                 SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Missing model (name:{}, version:{}) output:{} of dependency node:{}",
                     pipelineName,
                     dependencyNodeInfo.modelName,
@@ -344,12 +566,27 @@ public:
         return StatusCode::OK;
     }
 
-    Status checkConnectionMetadataCorrectness(const NodeInfo& dependencyNodeInfo, std::shared_ptr<ModelInstance>& dependencyModelInstance, const std::string& modelInputName, const std::string& modelOutputName) {
-        // If validated connection pair connects two DL model nodes,
+    static bool isShapeSpecified(const shape_t& shape) {
+        // Custom node libraries may leave shape empty or report 0 for dimensions known only at runtime
+        return shape.size() > 0 && std::find(shape.begin(), shape.end(), 0) == shape.end();
+    }
+
+    Status checkConnectionMetadataCorrectness(const NodeInfo& dependencyNodeInfo, const tensor_map_t& dependencyOutputsInfo, const std::string& modelInputName, const std::string& modelOutputName) {
+        // If validated connection pair connects two DL model or custom nodes,
         // check if both input/output exist and its metadata (shape, precision) matches.
-        const auto& tensorInput = dependantModelInstance->getInputsInfo().at(modelInputName);
-        const auto& tensorOutput = dependencyModelInstance->getOutputsInfo().at(modelOutputName);
-        if (tensorInput->getShape() != tensorOutput->getShape()) {
+        const auto& tensorInput = dependantInputsInfo.at(modelInputName);
+        const auto& tensorOutput = dependencyOutputsInfo.at(modelOutputName);
+        shape_t dependencyOutputShape = tensorOutput->getShape();
+        if (dependencyNodeInfo.demultiplyCount && dependencyOutputShape.size() > 0) {
+            // Dependant receives single slice of demultiplexed output
+            dependencyOutputShape[0] = 1;
+        }
+        if (dependantNodeInfo.gatherFromNode && dependencyOutputShape.size() > 0 && tensorInput->getShape().size() > 0) {
+            // Number of gathered slices is known only at runtime
+            dependencyOutputShape[0] = tensorInput->getShape()[0];
+        }
+        if (isShapeSpecified(tensorInput->getShape()) && isShapeSpecified(dependencyOutputShape) &&
+            tensorInput->getShape() != dependencyOutputShape) {
             SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Shape mismatch between: dependant node:{}; model:{}; version:{}; input:{}; shape:{} vs dependency node:{}; model:{}; version:{}; output:{}; shape:{}",
                 pipelineName,
                 dependantNodeInfo.nodeName,
@@ -361,10 +598,12 @@ public:
                 dependencyNodeInfo.modelName,
                 dependencyNodeInfo.modelVersion.value_or(0),
                 modelOutputName,
-                TensorInfo::shapeToString(tensorOutput->getShape()));
+                TensorInfo::shapeToString(dependencyOutputShape));
             return StatusCode::INVALID_SHAPE;
         }
-        if (tensorInput->getPrecision() != tensorOutput->getPrecision()) {
+        if (tensorInput->getPrecision() != InferenceEngine::Precision::UNSPECIFIED &&
+            tensorOutput->getPrecision() != InferenceEngine::Precision::UNSPECIFIED &&
+            tensorInput->getPrecision() != tensorOutput->getPrecision()) {
             SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Precision mismatch between: dependant node:{}; model:{}; version:{}; input:{}; precision:{} vs dependency node:{}; model:{}; version:{}; output:{}; precision:{}",
                 pipelineName,
                 dependantNodeInfo.nodeName,
@@ -382,23 +621,23 @@ public:
         return StatusCode::OK;
     }
 
-    void prepareRemainingUnconnectedDependantModelInputsSet() {
-        // Save set of inputs which are required by underlying model of currently validated node.
+    void prepareRemainingUnconnectedDependantInputsSet() {
+        // Save set of inputs which are required by underlying model/library of currently validated node.
         // This is later used to make sure we feed each input exactly one data source.
         std::transform(
-            dependantModelInstance->getInputsInfo().begin(),
-            dependantModelInstance->getInputsInfo().end(),
+            dependantInputsInfo.begin(),
+            dependantInputsInfo.end(),
             std::inserter(
-                remainingUnconnectedDependantModelInputs,
-                remainingUnconnectedDependantModelInputs.end()),
+                remainingUnconnectedDependantInputs,
+                remainingUnconnectedDependantInputs.end()),
             [](auto pair) { return pair.first; });
     }
 
     Status ensureAllModelInputsOfValidatedNodeHaveDataSource() {
         // Make sure all model inputs of validated node is fed with some data source.
-        if (remainingUnconnectedDependantModelInputs.size() > 0) {
+        if (remainingUnconnectedDependantInputs.size() > 0) {
             std::stringstream ss;
-            for (const auto& input : remainingUnconnectedDependantModelInputs) {
+            for (const auto& input : remainingUnconnectedDependantInputs) {
                 ss << input << ", ";
             }
             SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node:{} model:{} version:{} has inputs:({}) not connected to any source",
@@ -412,12 +651,12 @@ public:
         return StatusCode::OK;
     }
 
-    Status markModelInputAsConnected(const std::string& name) {
-        // If currently validated node is of type DL model, mark its input as connected
+    Status markInputAsConnected(const std::string& name) {
+        // If currently validated node is of type DL model or custom, mark its input as connected
         // by erasing from previously gathered input set.
         // If such input cannot be found in the map, it means we refer
         // to non existing model input or we already connected it to some other data source which is invalid.
-        if (dependantModelInstance->getInputsInfo().count(name) == 0) {
+        if (dependantInputsInfo.count(name) == 0) {
             SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node:{} model:{} version:{} has no input with name:{}",
                 pipelineName,
                 dependantNodeInfo.nodeName,
@@ -426,7 +665,7 @@ public:
                 name);
             return StatusCode::PIPELINE_CONNECTION_TO_MISSING_MODEL_INPUT;
         }
-        if (remainingUnconnectedDependantModelInputs.erase(name) == 0) {
+        if (remainingUnconnectedDependantInputs.erase(name) == 0) {
             SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node:{} model:{} version:{} input name:{} is connected to more than one data source",
                 pipelineName,
                 dependantNodeInfo.nodeName,
@@ -439,10 +678,11 @@ public:
     }
 
     Status validateConnection(const NodeInfo& dependencyNodeInfo, const InputPairs& mapping) {
-        // At this point dependency node can only be either DL model node or entry node.
+        // At this point dependency node can only be either DL model node, custom node or entry node.
         // Take care when adding new node types.
         std::unique_ptr<ModelInstanceUnloadGuard> dependencyModelUnloadGuard;
         std::shared_ptr<ModelInstance> dependencyModelInstance;
+        tensor_map_t dependencyOutputsInfo;
         if (dependencyNodeInfo.kind == NodeKind::DL) {
             if (!getModelInstance(
                     manager,
@@ -457,23 +697,31 @@ public:
                     dependencyNodeInfo.modelVersion.value_or(0));
                 return StatusCode::PIPELINE_NODE_REFERING_TO_MISSING_MODEL;
             }
+            dependencyOutputsInfo = dependencyModelInstance->getOutputsInfo();
+        } else if (dependencyNodeInfo.kind == NodeKind::CUSTOM) {
+            auto result = fetchCustomNodeLibraryMetadata(dependencyNodeInfo, false, dependencyOutputsInfo);
+            if (!result.ok()) {
+                return result;
+            }
         }
 
+        const bool isDependantWithMetadata = dependantNodeInfo.kind == NodeKind::DL || dependantNodeInfo.kind == NodeKind::CUSTOM;
+        const bool isDependencyWithMetadata = dependencyNodeInfo.kind == NodeKind::DL || dependencyNodeInfo.kind == NodeKind::CUSTOM;
         for (const auto& [alias, realName] : mapping) {
-            if (dependantNodeInfo.kind == NodeKind::DL) {
-                auto result = markModelInputAsConnected(realName);
+            if (isDependantWithMetadata) {
+                auto result = markInputAsConnected(realName);
                 if (!result.ok()) {
                     return result;
                 }
             }
 
-            auto result = checkConnectionMappedToExistingDataSource(dependencyNodeInfo, dependencyModelInstance, alias);
+            auto result = checkConnectionMappedToExistingDataSource(dependencyNodeInfo, dependencyOutputsInfo, alias);
             if (!result.ok()) {
                 return result;
             }
 
-            if (dependantNodeInfo.kind == NodeKind::DL && dependencyNodeInfo.kind == NodeKind::DL) {
-                result = checkConnectionMetadataCorrectness(dependencyNodeInfo, dependencyModelInstance, realName, dependencyNodeInfo.outputNameAliases.at(alias));
+            if (isDependantWithMetadata && isDependencyWithMetadata) {
+                result = checkConnectionMetadataCorrectness(dependencyNodeInfo, dependencyOutputsInfo, realName, dependencyNodeInfo.outputNameAliases.at(alias));
                 if (!result.ok()) {
                     return result;
                 }
@@ -495,7 +743,14 @@ public:
                 return result;
             }
 
-            prepareRemainingUnconnectedDependantModelInputsSet();
+            prepareRemainingUnconnectedDependantInputsSet();
+        } else if (dependantNodeInfo.kind == NodeKind::CUSTOM) {
+            auto result = fetchCustomNodeLibraryMetadata(dependantNodeInfo, true, dependantInputsInfo);
+            if (!result.ok()) {
+                return result;
+            }
+
+            prepareRemainingUnconnectedDependantInputsSet();
         }
 
         if (connections.count(dependantNodeInfo.nodeName) > 0) {
@@ -522,7 +777,7 @@ public:
 };
 
 Status PipelineDefinition::validateNode(ModelManager& manager, const NodeInfo& dependantNodeInfo) {
-    NodeValidator validator(this->pipelineName, manager, dependantNodeInfo, connections, nodeInfos);
+    NodeValidator validator(this->pipelineName, manager, dependantNodeInfo, connections, nodeInfos, nodeResources);
     return validator.validate();
 }
 
@@ -593,6 +848,99 @@ Status PipelineDefinition::validateForCycles() {
     return StatusCode::OK;
 }
 
+Status PipelineDefinition::validateDemultiplexerGatherNodesOrder() {
+    this->demultiplexedNodes.clear();
+    std::unordered_map<std::string, const NodeInfo*> infos;
+    for (const auto& info : nodeInfos) {
+        infos.emplace(info.nodeName, &info);
+    }
+    std::unordered_map<std::string, std::vector<std::string>> dependants;
+    for (const auto& [dependantName, dependencies] : connections) {
+        for (const auto& [dependencyName, mapping] : dependencies) {
+            dependants[dependencyName].push_back(dependantName);
+        }
+    }
+
+    for (const auto& info : nodeInfos) {
+        if (info.demultiplyCount && (info.demultiplyCount.value() == 0 || info.demultiplyCount.value() < -1)) {
+            SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node: {} has invalid demultiply_count: {}",
+                getName(), info.nodeName, info.demultiplyCount.value());
+            return StatusCode::PIPELINE_INVALID_DEMULTIPLY_COUNT;
+        }
+        if (info.gatherFromNode) {
+            auto it = infos.find(info.gatherFromNode.value());
+            if (it == infos.end() || !it->second->demultiplyCount) {
+                SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node: {} gathers from node: {} which is not a demultiplexer",
+                    getName(), info.nodeName, info.gatherFromNode.value());
+                return StatusCode::PIPELINE_NODE_GATHER_FROM_NOT_DEMULTIPLEXER;
+            }
+        }
+    }
+
+    for (const auto& info : nodeInfos) {
+        if (!info.demultiplyCount) {
+            continue;
+        }
+        const std::string& demultiplexerName = info.nodeName;
+        std::queue<std::string> toVisit;
+        for (const auto& dependantName : dependants[demultiplexerName]) {
+            if (infos.at(dependantName)->gatherFromNode == demultiplexerName) {
+                SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node: {} gathers results of demultiplexer: {} it is directly connected to",
+                    getName(), dependantName, demultiplexerName);
+                return StatusCode::PIPELINE_WRONG_DEMULTIPLEXER_GATHER_NODES_ORDER;
+            }
+            toVisit.push(dependantName);
+        }
+        while (!toVisit.empty()) {
+            const NodeInfo& current = *infos.at(toVisit.front());
+            toVisit.pop();
+            if (current.kind == NodeKind::EXIT || current.gatherFromNode == demultiplexerName) {
+                continue;
+            }
+            auto it = this->demultiplexedNodes.find(current.nodeName);
+            if (it != this->demultiplexedNodes.end()) {
+                if (it->second == demultiplexerName) {
+                    continue;
+                }
+                SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node: {} is demultiplexed by both: {} and: {}",
+                    getName(), current.nodeName, it->second, demultiplexerName);
+                return StatusCode::PIPELINE_NESTED_DEMULTIPLEXING_UNSUPPORTED;
+            }
+            if (current.demultiplyCount) {
+                SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Demultiplexer: {} is placed after demultiplexer: {}",
+                    getName(), current.nodeName, demultiplexerName);
+                return StatusCode::PIPELINE_NESTED_DEMULTIPLEXING_UNSUPPORTED;
+            }
+            if (current.gatherFromNode) {
+                SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node: {} gathers from: {} while placed after demultiplexer: {}",
+                    getName(), current.nodeName, current.gatherFromNode.value(), demultiplexerName);
+                return StatusCode::PIPELINE_WRONG_DEMULTIPLEXER_GATHER_NODES_ORDER;
+            }
+            this->demultiplexedNodes.emplace(current.nodeName, demultiplexerName);
+            for (const auto& dependantName : dependants[current.nodeName]) {
+                toVisit.push(dependantName);
+            }
+        }
+    }
+
+    for (const auto& info : nodeInfos) {
+        if (!info.gatherFromNode) {
+            continue;
+        }
+        const auto& dependencies = connections[info.nodeName];
+        bool gathersFromDemultiplexedNode = std::any_of(dependencies.begin(), dependencies.end(), [this, &info](const auto& pair) {
+            auto it = this->demultiplexedNodes.find(pair.first);
+            return it != this->demultiplexedNodes.end() && it->second == info.gatherFromNode.value();
+        });
+        if (!gathersFromDemultiplexedNode) {
+            SPDLOG_LOGGER_ERROR(modelmanager_logger, "Validation of pipeline({}) definition failed. Node: {} is not connected to any node demultiplexed by: {}",
+                getName(), info.nodeName, info.gatherFromNode.value());
+            return StatusCode::PIPELINE_WRONG_DEMULTIPLEXER_GATHER_NODES_ORDER;
+        }
+    }
+    return StatusCode::OK;
+}
+
 Status PipelineDefinition::validateNodes(ModelManager& manager) {
     SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Validation of pipeline definition: {} nodes started.", getName());
 
@@ -645,6 +993,22 @@ Status PipelineDefinition::validateNodes(ModelManager& manager) {
     return StatusCode::OK;
 }
 
+Status PipelineDefinition::getCustomNodeMetadata(const NodeInfo& customNodeInfo, bool inputs, tensor_map_t& info) const {
+    auto it = nodeResources.find(customNodeInfo.nodeName);
+    void* customNodeLibraryInternalManager = it != nodeResources.end() ? it->second->ptr : nullptr;
+    auto status = getCustomNodeLibraryMetadata(
+        inputs ? customNodeInfo.library.getInputsInfo : customNodeInfo.library.getOutputsInfo,
+        customNodeInfo.library.release,
+        customNodeInfo.parameters,
+        customNodeLibraryInternalManager,
+        info);
+    if (!status.ok()) {
+        SPDLOG_DEBUG("Custom node: {} metadata was unavailable during pipeline: {} {} info fetching",
+            customNodeInfo.nodeName, this->getName(), inputs ? "inputs" : "outputs");
+    }
+    return status;
+}
+
 Status PipelineDefinition::getInputsInfo(tensor_map_t& inputsInfo, const ModelManager& manager) const {
     // Assumptions: this can only be called on available pipeline definition.
     // Add check if available when pipeline status will be implemented.
@@ -687,6 +1051,18 @@ Status PipelineDefinition::getInputsInfo(tensor_map_t& inputsInfo, const ModelMa
                 }
                 break;
             }
+            case NodeKind::CUSTOM: {
+                tensor_map_t info;
+                auto status = getCustomNodeMetadata(*dependantNodeInfo, true, info);
+                if (!status.ok()) {
+                    return status;
+                }
+
+                for (const auto& [alias, realName] : specificDependencyMapping) {
+                    inputsInfo[alias] = info.at(realName);
+                }
+                break;
+            }
             default: {
                 // Pipeline validation does not allow connections into entry node.
                 SPDLOG_ERROR("Unexpected dependant node kind (name: {})", this->getName());
@@ -698,6 +1074,16 @@ Status PipelineDefinition::getInputsInfo(tensor_map_t& inputsInfo, const ModelMa
     return StatusCode::OK;
 }
 
+std::shared_ptr<TensorInfo> PipelineDefinition::getGatheredTensorInfo(const std::string& nodeName, const std::shared_ptr<TensorInfo>& info) const {
+    if (this->demultiplexedNodes.count(nodeName) == 0 || info->getShape().size() == 0) {
+        return info;
+    }
+    // Results of demultiplexed nodes are gathered along 0th dimension which size is known only at runtime
+    shape_t shape = info->getShape();
+    shape[0] = 0;
+    return std::make_shared<TensorInfo>(info->getName(), info->getMappedName(), info->getPrecision(), shape, info->getLayout());
+}
+
 Status PipelineDefinition::getOutputsInfo(tensor_map_t& outputsInfo, const ModelManager& manager) const {
     // Assumptions: this can only be called on available pipeline definition.
     // Add check if available when pipeline status will be implemented.
@@ -738,7 +1124,20 @@ Status PipelineDefinition::getOutputsInfo(tensor_map_t& outputsInfo, const Model
 
                 for (const auto& [alias, realName] : specificDependencyMapping) {
                     const auto& finalName = dependencyNodeInfo->outputNameAliases.count(alias) > 0 ? dependencyNodeInfo->outputNameAliases.at(alias) : alias;
-                    outputsInfo[realName] = instance->getOutputsInfo().at(finalName);
+                    outputsInfo[realName] = getGatheredTensorInfo(dependencyNodeName, instance->getOutputsInfo().at(finalName));
+                }
+                break;
+            }
+            case NodeKind::CUSTOM: {
+                tensor_map_t info;
+                auto status = getCustomNodeMetadata(*dependencyNodeInfo, false, info);
+                if (!status.ok()) {
+                    return status;
+                }
+
+                for (const auto& [alias, realName] : specificDependencyMapping) {
+                    const auto& finalName = dependencyNodeInfo->outputNameAliases.count(alias) > 0 ? dependencyNodeInfo->outputNameAliases.at(alias) : alias;
+                    outputsInfo[realName] = getGatheredTensorInfo(dependencyNodeName, info.at(finalName));
                 }
                 break;
             }
@@ -16,8 +16,11 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <shared_mutex>
 #include <string>
@@ -30,8 +33,10 @@
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 #pragma GCC diagnostic pop
 
+#include "metrics.hpp"
 #include "model_version_policy.hpp"
 #include "node.hpp"
+#include "node_library.hpp"
 #include "pipeline.hpp"
 #include "pipelinedefinitionstatus.hpp"
 #include "pipelinedefinitionunloadguard.hpp"
@@ -46,10 +51,12 @@ using pipeline_connections_t = std::unordered_map<std::string, std::unordered_ma
 enum class NodeKind {
     ENTRY,
     DL,
+    CUSTOM,
     EXIT
 };
 
 const std::string DL_NODE_CONFIG_TYPE = "DL model";
+const std::string CUSTOM_NODE_CONFIG_TYPE = "custom";
 
 Status toNodeKind(const std::string& str, NodeKind& nodeKind);
 
@@ -59,17 +66,29 @@ struct NodeInfo {
     std::string modelName;
     std::optional<model_version_t> modelVersion;
     std::unordered_map<std::string, std::string> outputNameAliases;
+    NodeLibrary library;
+    parameters_t parameters;
+    std::optional<int32_t> demultiplyCount;
+    std::optional<std::string> gatherFromNode;
 
     NodeInfo(NodeKind kind,
         const std::string& nodeName,
         const std::string& modelName = "",
         std::optional<model_version_t> modelVersion = std::nullopt,
-        std::unordered_map<std::string, std::string> outputNameAliases = {}) :
+        std::unordered_map<std::string, std::string> outputNameAliases = {},
+        const NodeLibrary& library = {},
+        const parameters_t& parameters = {},
+        std::optional<int32_t> demultiplyCount = std::nullopt,
+        std::optional<std::string> gatherFromNode = std::nullopt) :
         kind(kind),
         nodeName(nodeName),
         modelName(modelName),
         modelVersion(modelVersion),
-        outputNameAliases(outputNameAliases) {}
+        outputNameAliases(outputNameAliases),
+        library(library),
+        parameters(parameters),
+        demultiplyCount(demultiplyCount),
+        gatherFromNode(gatherFromNode) {}
 };
 
 class PipelineDefinition {
@@ -96,9 +115,15 @@ class PipelineDefinition {
     std::vector<NodeInfo> nodeInfos;
     pipeline_connections_t connections;
 
+    // Shared by all pipelines created from this definition
+    std::shared_ptr<PipelineMetrics> metrics;
+
     std::atomic<uint64_t> requestsHandlesCounter = 0;
     std::shared_mutex loadMtx;
 
+    // Models used by pipeline may be loaded concurrently and notify about changes from different threads
+    std::mutex notifyMtx;
+
     std::condition_variable loadedNotify;
 
     // Pipelines are not versioned and any available definition has constant version equal 1.
@@ -110,7 +135,30 @@ protected:
 private:
     std::set<std::pair<const std::string, model_version_t>> subscriptions;
 
+    // Custom node library internal state per node name, created with library initialize call
+    std::unordered_map<std::string, std::shared_ptr<CNLIMWrapper>> nodeResources;
+
+    // Nodes executed once per demultiplexed slice, mapped to name of demultiplexer node
+    std::unordered_map<std::string, std::string> demultiplexedNodes;
+
+    // Estimated costs of nodes per node name, refreshed with latency measured for models at most once per interval
+    std::shared_ptr<const std::unordered_map<std::string, uint64_t>> nodeCosts;
+    std::chrono::steady_clock::time_point nodeCostsExpiration;
+    std::mutex nodeCostsMtx;
+    static constexpr std::chrono::seconds NODE_COSTS_REFRESH_INTERVAL{1};
+
+    std::shared_ptr<const std::unordered_map<std::string, uint64_t>> getNodeCosts(ModelManager& manager);
+    void resetNodeCosts();
+
     Status validateNode(ModelManager& manager, const NodeInfo& node);
+    Status initializeNodeResources();
+    Status getCustomNodeMetadata(const NodeInfo& customNodeInfo, bool inputs, tensor_map_t& info) const;
+
+    /**
+     * @brief Collects names of nodes needed to produce outputs requested in output filter. All nodes are required when filter is empty.
+     */
+    Status collectRequiredNodes(const tensorflow::serving::PredictRequest* request, std::set<std::string>& requiredNodes) const;
+    std::shared_ptr<TensorInfo> getGatheredTensorInfo(const std::string& nodeName, const std::shared_ptr<TensorInfo>& info) const;
 
 public:
     static constexpr uint64_t WAIT_FOR_LOADED_DEFAULT_TIMEOUT_MICROSECONDS = 10000;
@@ -120,6 +168,7 @@ public:
         pipelineName(pipelineName),
         nodeInfos(nodeInfos),
         connections(connections),
+        metrics(std::make_shared<PipelineMetrics>(pipelineName)),
         status(this->pipelineName) {}
 
     Status create(std::unique_ptr<Pipeline>& pipeline,
@@ -131,11 +180,13 @@ public:
     Status validate(ModelManager& manager);
     Status validateNodes(ModelManager& manager);
     Status validateForCycles();
+    Status validateDemultiplexerGatherNodesOrder();
     const std::string& getName() const { return pipelineName; }
     const PipelineDefinitionStateCode getStateCode() const { return status.getStateCode(); }
     const model_version_t getVersion() const { return VERSION; }
 
     void notifyUsedModelChanged(const std::string& ownerDetails) {
+        std::lock_guard<std::mutex> lock(notifyMtx);
         this->status.handle(UsedModelChangedEvent(ownerDetails));
     }
 
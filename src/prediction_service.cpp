@@ -18,6 +18,7 @@
 #include <condition_variable>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <inference_engine.hpp>
@@ -34,9 +35,7 @@
 #include "ovinferrequestsqueue.hpp"
 #include "prediction_service_utils.hpp"
 #include "status.hpp"
-
-#define DEBUG
-#include "timer.hpp"
+#include "tracing.hpp"
 
 using grpc::ServerContext;
 
@@ -64,13 +63,28 @@ Status getPipeline(const PredictRequest* request,
     return getPipeline(manager, pipelinePtr, request, response);
 }
 
+/**
+ * @brief Gets W3C traceparent from request metadata, empty if not present
+ */
+static std::string_view getTraceParent(const ServerContext* context) {
+    if (context == nullptr) {
+        return {};
+    }
+    const auto& metadata = context->client_metadata();
+    auto it = metadata.find("traceparent");
+    if (it == metadata.end()) {
+        return {};
+    }
+    return std::string_view(it->second.data(), it->second.length());
+}
+
 grpc::Status ovms::PredictionServiceImpl::Predict(
     ServerContext* context,
     const PredictRequest* request,
     PredictResponse* response) {
-    Timer timer;
-    timer.start("total");
-    using std::chrono::microseconds;
+    RequestTraceScope traceScope({"grpc predict ", request->model_spec().name()}, getTraceParent(context));
+    SpanTimer timer;
+    timer.start(TraceSpan::GRPC_REQUEST);
     SPDLOG_DEBUG("Processing gRPC request for model: {}; version: {}",
         request->model_spec().name(),
         request->model_spec().version().value());
@@ -100,8 +114,8 @@ grpc::Status ovms::PredictionServiceImpl::Predict(
         return status.grpc();
     }
 
-    timer.stop("total");
-    SPDLOG_DEBUG("Total gRPC request processing time: {} ms", timer.elapsed<microseconds>("total") / 1000);
+    timer.stop(TraceSpan::GRPC_REQUEST);
+    SPDLOG_DEBUG("Total gRPC request processing time: {} ms", timer.elapsedMicroseconds(TraceSpan::GRPC_REQUEST) / 1000);
     return grpc::Status::OK;
 }
 
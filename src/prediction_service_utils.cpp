@@ -16,16 +16,19 @@
 #include "prediction_service_utils.hpp"
 
 #include <map>
+#include <utility>
 
 #include "deserialization.hpp"
 #include "executinstreamidguard.hpp"
+#include "metrics.hpp"
 #include "modelinstance.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "modelmanager.hpp"
+#include "ov_utils.hpp"
+#include "resultcache.hpp"
 #include "serialization.hpp"
+#include "tracing.hpp"
 
-#define DEBUG
-#include "timer.hpp"
 
 using tensorflow::serving::PredictRequest;
 using tensorflow::serving::PredictResponse;
@@ -62,6 +65,7 @@ Status getModelInstance(ovms::ModelManager& manager,
     std::shared_ptr<ovms::ModelInstance>& modelInstance,
     std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) {
     SPDLOG_DEBUG("Requesting model: {}; version: {}.", modelName, modelVersionId);
+    ScopedSpan span(TraceSpan::MODEL_LOOKUP, modelName);
 
     auto model = manager.findModelByName(modelName);
     if (model == nullptr) {
@@ -88,6 +92,7 @@ Status getPipeline(ovms::ModelManager& manager,
     tensorflow::serving::PredictResponse* response) {
 
     SPDLOG_DEBUG("Requesting pipeline: {};", request->model_spec().name());
+    ScopedSpan span(TraceSpan::PIPELINE_CREATE, request->model_spec().name());
     auto status = manager.createPipeline(pipelinePtr, request->model_spec().name(), request, response);
     return status;
 }
@@ -109,54 +114,114 @@ Status performInference(ovms::OVInferRequestsQueue& inferRequestsQueue, const in
     return StatusCode::OK;
 }
 
-Status inference(
+/**
+ * @brief Records duration of finished span in model metrics
+ */
+static void observeSpan(MetricHistogram& histogram, const SpanTimer& timer, TraceSpan span) {
+    histogram.observe(timer.elapsedMicroseconds(span));
+}
+
+static Status processInference(
     ModelInstance& modelVersion,
     const PredictRequest* requestProto,
     PredictResponse* responseProto,
     std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr) {
-    Timer timer;
-    using std::chrono::microseconds;
+    SpanTimer timer;
+    ModelMetrics& metrics = modelVersion.getMetrics();
 
     auto status = modelVersion.validate(requestProto);
     status = reloadModelIfRequired(status, modelVersion, requestProto, modelUnloadGuardPtr);
     if (!status.ok())
         return status;
 
-    timer.start("get infer request");
+    std::unique_ptr<ResultCacheMissGuard> resultCacheMissGuard;
+    auto resultCache = modelVersion.getResultCache();
+    if (resultCache != nullptr) {
+        timer.start(TraceSpan::CACHE_LOOKUP);
+        cached_outputs_t cachedResults;
+        bool found = resultCache->lookup(ResultCache::createKey(*requestProto, modelVersion.getVersion()), cachedResults, resultCacheMissGuard);
+        timer.stop(TraceSpan::CACHE_LOOKUP);
+        SPDLOG_DEBUG("Results cache lookup duration in model {}, version {}: {:.3f} ms; found: {}",
+            requestProto->model_spec().name(), modelVersion.getVersion(), timer.elapsedMicroseconds(TraceSpan::CACHE_LOOKUP) / 1000, found);
+        if (found) {
+            return serializePredictResponse(cachedResults, modelVersion.getOutputsInfo(), responseProto, requestProto->output_filter());
+        }
+    }
+
+    timer.start(TraceSpan::INFER_REQUEST_WAIT);
     ovms::OVInferRequestsQueue& inferRequestsQueue = modelVersion.getInferRequestsQueue();
     ExecutingStreamIdGuard executingStreamIdGuard(inferRequestsQueue);
     int executingInferId = executingStreamIdGuard.getId();
     InferenceEngine::InferRequest& inferRequest = inferRequestsQueue.getInferRequest(executingInferId);
-    timer.stop("get infer request");
+    timer.stop(TraceSpan::INFER_REQUEST_WAIT);
     SPDLOG_DEBUG("Getting infer req duration in model {}, version {}, nireq {}: {:.3f} ms",
-        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("get infer request") / 1000);
+        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsedMicroseconds(TraceSpan::INFER_REQUEST_WAIT) / 1000);
+    observeSpan(*metrics.inferRequestWaitLatency, timer, TraceSpan::INFER_REQUEST_WAIT);
 
-    timer.start("deserialize");
+    timer.start(TraceSpan::DESERIALIZE);
     status = deserializePredictRequest<ConcreteTensorProtoDeserializator>(*requestProto, modelVersion.getInputsInfo(), inferRequest);
-    timer.stop("deserialize");
+    timer.stop(TraceSpan::DESERIALIZE);
     if (!status.ok())
         return status;
     SPDLOG_DEBUG("Deserialization duration in model {}, version {}, nireq {}: {:.3f} ms",
-        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("deserialize") / 1000);
-    timer.start("prediction");
+        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsedMicroseconds(TraceSpan::DESERIALIZE) / 1000);
+    observeSpan(*metrics.deserializationLatency, timer, TraceSpan::DESERIALIZE);
+    timer.start(TraceSpan::INFERENCE);
     status = performInference(inferRequestsQueue, executingInferId, inferRequest);
-    timer.stop("prediction");
+    timer.stop(TraceSpan::INFERENCE);
     if (!status.ok())
         return status;
     SPDLOG_DEBUG("Prediction duration in model {}, version {}, nireq {}: {:.3f} ms",
-        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("prediction") / 1000);
+        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsedMicroseconds(TraceSpan::INFERENCE) / 1000);
+    observeSpan(*metrics.inferenceLatency, timer, TraceSpan::INFERENCE);
+
+    if (resultCacheMissGuard != nullptr) {
+        // All outputs are cached regardless of output filter, copies are required since infer request is reused
+        cached_outputs_t results;
+        for (const auto& [name, info] : modelVersion.getOutputsInfo()) {
+            InferenceEngine::Blob::Ptr copiedBlob;
+            try {
+                status = blobClone(copiedBlob, inferRequest.GetBlob(info->getName()));
+            } catch (const InferenceEngine::details::InferenceEngineException& e) {
+                status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+                SPDLOG_ERROR("{}: {}", status.string(), e.what());
+            }
+            if (!status.ok())
+                return status;
+            results.emplace(info->getName(), std::move(copiedBlob));
+        }
+        resultCacheMissGuard->commit(std::move(results));
+    }
 
-    timer.start("serialize");
-    status = serializePredictResponse(inferRequest, modelVersion.getOutputsInfo(), responseProto);
-    timer.stop("serialize");
+    timer.start(TraceSpan::SERIALIZE);
+    status = serializePredictResponse(inferRequest, modelVersion.getOutputsInfo(), responseProto, requestProto->output_filter());
+    timer.stop(TraceSpan::SERIALIZE);
     if (!status.ok())
         return status;
     SPDLOG_DEBUG("Serialization duration in model {}, version {}, nireq {}: {:.3f} ms",
-        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("serialize") / 1000);
+        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsedMicroseconds(TraceSpan::SERIALIZE) / 1000);
+    observeSpan(*metrics.serializationLatency, timer, TraceSpan::SERIALIZE);
 
     return StatusCode::OK;
 }
 
+Status inference(
+    ModelInstance& modelVersion,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr) {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto status = processInference(modelVersion, requestProto, responseProto, modelUnloadGuardPtr);
+    ModelMetrics& metrics = modelVersion.getMetrics();
+    metrics.requestLatency->observeDuration(std::chrono::high_resolution_clock::now() - start);
+    if (status.ok()) {
+        metrics.requestsSuccess->increment();
+    } else {
+        metrics.requestsFail->increment();
+    }
+    return status;
+}
+
 Status reloadModelIfRequired(
     Status validationStatus,
     ModelInstance& modelInstance,
@@ -0,0 +1,324 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "rangeddownloader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include <fcntl.h>
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include "cloudfilecache.hpp"
+#include "config.hpp"
+#include "crc32c.hpp"
+#include "downloadscheduler.hpp"
+#include "inmemoryfiles.hpp"
+
+namespace ovms {
+
+namespace {
+
+struct Part {
+    size_t fileIndex;
+    uint64_t offset;
+    uint64_t size;
+};
+
+class LocalFiles {
+    std::vector<int> descriptors;
+
+public:
+    ~LocalFiles() {
+        for (int fd : descriptors) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    bool open(const std::vector<RangedDownloadFile>& files, bool inMemory) {
+        for (const auto& file : files) {
+            if (inMemory) {
+                int fd = InMemoryFiles::instance().create(file.localPath, file.size);
+                descriptors.push_back(fd);
+                if (fd < 0) {
+                    return false;
+                }
+                continue;
+            }
+            // Existing file may be hard linked to cache entry, which must not be overwritten
+            unlink(file.localPath.c_str());
+            int fd = ::open(file.localPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            descriptors.push_back(fd);
+            if (fd < 0) {
+                SPDLOG_ERROR("Failed to create local file: {} {}", file.localPath, std::strerror(errno));
+                return false;
+            }
+            // Allocate whole file upfront so that parts written out of order do not fragment it
+            if (file.size > 0 && posix_fallocate(fd, 0, file.size) != 0 && ftruncate(fd, file.size) != 0) {
+                SPDLOG_ERROR("Failed to allocate local file: {} of size: {} {}", file.localPath, file.size, std::strerror(errno));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int get(size_t index) const {
+        return descriptors[index];
+    }
+};
+
+StatusCode readChecksumsManifest(const std::string& path, std::map<std::string, uint32_t>& checksums) {
+    std::ifstream ifs(path);
+    if (!ifs.good()) {
+        SPDLOG_ERROR("Failed to open checksums manifest: {}", path);
+        return StatusCode::FILE_INVALID;
+    }
+    rapidjson::Document manifest;
+    rapidjson::IStreamWrapper isw(ifs);
+    if (manifest.ParseStream(isw).HasParseError() || !manifest.IsObject() ||
+        !manifest.HasMember("crc32c") || !manifest["crc32c"].IsObject()) {
+        SPDLOG_ERROR("Checksums manifest: {} is not valid", path);
+        return StatusCode::JSON_INVALID;
+    }
+    for (const auto& entry : manifest["crc32c"].GetObject()) {
+        uint32_t checksum;
+        if (!entry.value.IsString() || !Crc32c::fromHexString(entry.value.GetString(), checksum)) {
+            SPDLOG_ERROR("Checksums manifest: {} has invalid checksum of file: {}", path, entry.name.GetString());
+            return StatusCode::JSON_INVALID;
+        }
+        checksums[entry.name.GetString()] = checksum;
+    }
+    return StatusCode::OK;
+}
+
+StatusCode verifyChecksums(const std::vector<RangedDownloadFile>& files, const std::vector<Part>& parts, const std::vector<uint32_t>& partsChecksums) {
+    std::vector<uint32_t> checksums(files.size(), Crc32c().get());
+    for (size_t i = 0; i < parts.size(); i++) {
+        auto& checksum = checksums[parts[i].fileIndex];
+        checksum = Crc32c::combine(checksum, partsChecksums[i], parts[i].size);
+    }
+    size_t verified = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (!files[i].crc32c) {
+            continue;
+        }
+        if (*files[i].crc32c != checksums[i]) {
+            SPDLOG_ERROR("Checksum: {} of downloaded file: {} does not match expected checksum: {}",
+                Crc32c(checksums[i]).toHexString(), files[i].remotePath, Crc32c(*files[i].crc32c).toHexString());
+            return StatusCode::FILE_CHECKSUM_MISMATCH;
+        }
+        verified++;
+    }
+    SPDLOG_DEBUG("Verified checksums of {} of {} downloaded files", verified, files.size());
+    return StatusCode::OK;
+}
+
+}  // namespace
+
+const std::string RangedDownloader::CHECKSUMS_MANIFEST = "checksums.json";
+
+RangedDownloader RangedDownloader::fromConfig() {
+    auto& config = Config::instance();
+    auto& cache = CloudFileCache::instance();
+    return RangedDownloader(uint64_t(config.cloudDownloadPartSizeMb()) * 1024 * 1024, config.cloudDownloadThreads(),
+        cache.isEnabled() ? &cache : nullptr, config.cloudModelsInMemory(), &DownloadScheduler::instance());
+}
+
+StatusCode RangedDownloader::download(const std::vector<RangedDownloadFile>& files, const range_reader_t& readRange) const {
+    std::vector<RangedDownloadFile> manifests;
+    std::vector<RangedDownloadFile> modelFiles;
+    for (const auto& file : files) {
+        (std::filesystem::path(file.localPath).filename() == CHECKSUMS_MANIFEST ? manifests : modelFiles).push_back(file);
+    }
+    if (manifests.empty()) {
+        return downloadFiles(files, readRange);
+    }
+    auto status = downloadFiles(manifests, readRange);
+    if (status != StatusCode::OK) {
+        return status;
+    }
+    for (const auto& manifest : manifests) {
+        std::map<std::string, uint32_t> checksums;
+        status = readChecksumsManifest(manifest.localPath, checksums);
+        if (status != StatusCode::OK) {
+            return status;
+        }
+        const auto directory = std::filesystem::path(manifest.localPath).parent_path();
+        for (auto& file : modelFiles) {
+            auto it = checksums.find(std::filesystem::path(file.localPath).lexically_relative(directory).string());
+            if (it == checksums.end()) {
+                continue;
+            }
+            if (file.crc32c && *file.crc32c != it->second) {
+                SPDLOG_ERROR("Checksum of file: {} in manifest: {} differs from checksum reported by storage", file.remotePath, manifest.remotePath);
+                return StatusCode::FILE_CHECKSUM_MISMATCH;
+            }
+            file.crc32c = it->second;
+        }
+    }
+    return downloadFiles(modelFiles, readRange);
+}
+
+StatusCode RangedDownloader::downloadFiles(const std::vector<RangedDownloadFile>& files, const range_reader_t& readRange) const {
+    if (cache == nullptr) {
+        return downloadParts(files, readRange);
+    }
+    std::vector<RangedDownloadFile> missingFiles;
+    std::vector<std::string> keys;
+    for (const auto& file : files) {
+        std::string key;
+        if (!file.version.empty()) {
+            key = CloudFileCache::createKey(file.remotePath, file.version, file.size);
+            if (cache->restore(key, file.localPath)) {
+                continue;
+            }
+        }
+        missingFiles.push_back(file);
+        keys.push_back(std::move(key));
+    }
+    if (missingFiles.size() < files.size()) {
+        SPDLOG_INFO("Reused {} of {} files from cloud files cache; hits: {}; misses: {}",
+            files.size() - missingFiles.size(), files.size(), cache->getHits(), cache->getMisses());
+    }
+    auto status = downloadParts(missingFiles, readRange);
+    if (status != StatusCode::OK) {
+        return status;
+    }
+    for (size_t i = 0; i < missingFiles.size(); i++) {
+        if (!keys[i].empty()) {
+            cache->store(keys[i], missingFiles[i].localPath);
+        }
+    }
+    return StatusCode::OK;
+}
+
+StatusCode RangedDownloader::downloadParts(const std::vector<RangedDownloadFile>& files, const range_reader_t& readRange) const {
+    LocalFiles localFiles;
+    if (!localFiles.open(files, inMemory)) {
+        return StatusCode::FILESYSTEM_ERROR;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t totalBytes = 0;
+    std::vector<Part> parts;
+    for (size_t i = 0; i < files.size(); i++) {
+        totalBytes += files[i].size;
+        for (uint64_t offset = 0; offset < files[i].size; offset += partSize) {
+            parts.push_back({i, offset, std::min(partSize, files[i].size - offset)});
+        }
+    }
+
+    std::vector<uint32_t> partsChecksums(parts.size());
+    std::atomic<size_t> nextPart{0};
+    std::atomic<bool> failed{false};
+    StatusCode result = StatusCode::OK;
+    auto fail = [&](StatusCode status) {
+        // Only the first failure is reported, result is read after all workers finish
+        if (!failed.exchange(true)) {
+            result = status;
+        }
+    };
+
+    const auto priority = DownloadScheduler::getCurrentPriority();
+    auto worker = [&]() {
+        for (size_t i = nextPart++; i < parts.size() && !failed; i = nextPart++) {
+            DownloadScheduler::Connection connection(scheduler, priority);
+            if (failed) {
+                break;
+            }
+            const auto& part = parts[i];
+            const auto& file = files[part.fileIndex];
+            const int fd = localFiles.get(part.fileIndex);
+            uint64_t written = 0;
+            bool writeFailed = false;
+            Crc32c checksum;
+            auto writer = [&](const char* data, size_t size) {
+                if (failed) {
+                    return false;
+                }
+                if (written + size > part.size) {
+                    SPDLOG_ERROR("Received more data than requested at offset: {} of file: {}", part.offset, file.remotePath);
+                    writeFailed = true;
+                    return false;
+                }
+                if (scheduler != nullptr) {
+                    scheduler->throttle(size);
+                }
+                checksum.update(data, size);
+                while (size > 0) {
+                    ssize_t count = pwrite(fd, data, size, part.offset + written);
+                    if (count < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        SPDLOG_ERROR("Failed to write local file: {} {}", file.localPath, std::strerror(errno));
+                        writeFailed = true;
+                        return false;
+                    }
+                    data += count;
+                    size -= count;
+                    written += count;
+                }
+                return true;
+            };
+            auto status = readRange(file.remotePath, part.offset, part.size, writer);
+            if (writeFailed) {
+                fail(StatusCode::FILESYSTEM_ERROR);
+            } else if (status != StatusCode::OK) {
+                fail(status);
+            } else if (written != part.size && !failed) {
+                SPDLOG_ERROR("Downloaded {} bytes instead of {} at offset: {} of file: {}", written, part.size, part.offset, file.remotePath);
+                fail(StatusCode::FILESYSTEM_ERROR);
+            } else {
+                partsChecksums[i] = checksum.get();
+            }
+        }
+    };
+
+    const size_t threadsCount = std::min<size_t>(threads, parts.size());
+    SPDLOG_DEBUG("Downloading {} files in {} parts using {} threads", files.size(), parts.size(), threadsCount);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadsCount; i++) {
+        workers.emplace_back(worker);
+    }
+    // Calling thread downloads as well
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    if (result == StatusCode::OK) {
+        result = verifyChecksums(files, parts, partsChecksums);
+    }
+    if (result == StatusCode::OK && totalBytes > 0) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        SPDLOG_INFO("Downloaded {} files of {} bytes in {:.3f} s ({:.1f} MB/s) using {} threads",
+            files.size(), totalBytes, seconds, totalBytes / (1024.0 * 1024.0) / std::max(seconds, 1e-6), threadsCount);
+    }
+    return result;
+}
+
+}  // namespace ovms
@@ -0,0 +1,129 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "status.hpp"
+
+namespace ovms {
+
+class CloudFileCache;
+class DownloadScheduler;
+
+/**
+ * @brief Remote file to be downloaded to local path
+ */
+struct RangedDownloadFile {
+    std::string remotePath;
+    std::string localPath;
+    uint64_t size;
+    /**
+     * @brief ETag or generation identifying content of remote file, empty if unknown
+     */
+    std::string version;
+    /**
+     * @brief Expected CRC-32C of file content, verified once the file is downloaded
+     */
+    std::optional<uint32_t> crc32c;
+};
+
+/**
+ * @brief Consumes consecutive pieces of downloaded range, returns false to abort the download
+ */
+using range_writer_t = std::function<bool(const char* data, size_t size)>;
+
+/**
+ * @brief Reads given range of remote file and passes it to writer. Has to be thread safe.
+ */
+using range_reader_t = std::function<StatusCode(const std::string& remotePath, uint64_t offset, uint64_t size, const range_writer_t& writer)>;
+
+/**
+ * @brief Downloads files split into parts of fixed size. Parts of all files are downloaded concurrently
+ * and written directly at their offsets into files preallocated to their final size.
+ * Each part is downloaded over a connection granted by the scheduler, with priority of the thread starting the download.
+ * Checksums of parts are computed while they are written and combined into checksums of whole files,
+ * so verifying the files does not require reading them again.
+ */
+class RangedDownloader {
+    const uint64_t partSize;
+    const uint threads;
+    CloudFileCache* cache;
+    const bool inMemory;
+    DownloadScheduler* scheduler;
+
+    StatusCode downloadFiles(const std::vector<RangedDownloadFile>& files, const range_reader_t& readRange) const;
+    StatusCode downloadParts(const std::vector<RangedDownloadFile>& files, const range_reader_t& readRange) const;
+
+public:
+    /**
+     * @brief Name of optional file with expected checksums of other files in its directory, in format:
+     * {"crc32c": {"relative/path": "8 hex digits"}}
+     */
+    static const std::string CHECKSUMS_MANIFEST;
+
+    /**
+     * @brief Construct downloader
+     *
+     * @param partSize
+     * @param threads
+     * @param cache reused files cache, nullptr disables caching
+     * @param inMemory whether files are downloaded to memory files linked under local paths instead of files on disk
+     * @param scheduler process wide connections and throughput limits, nullptr disables them
+     */
+    RangedDownloader(uint64_t partSize, uint threads, CloudFileCache* cache = nullptr, bool inMemory = false, DownloadScheduler* scheduler = nullptr) :
+        partSize(partSize > 0 ? partSize : 1),
+        threads(threads > 0 ? threads : 1),
+        cache(cache),
+        inMemory(inMemory),
+        scheduler(scheduler) {}
+
+    /**
+     * @brief Creates downloader with part size, concurrency, cache, download target and scheduler set in server configuration
+     */
+    static RangedDownloader fromConfig();
+
+    uint64_t getPartSize() const {
+        return partSize;
+    }
+
+    uint getThreads() const {
+        return threads;
+    }
+
+    bool isInMemory() const {
+        return inMemory;
+    }
+
+    /**
+     * @brief Downloads files, stops on the first failure. Files with known version are restored from cache
+     * when available and stored in it once downloaded. Checksums manifests are downloaded first and checksums
+     * listed in them are verified together with checksums of files reported by the storage.
+     *
+     * @param files
+     * @param readRange
+     *
+     * @return status of the first failed part, FILESYSTEM_ERROR if local file could not be written or remote part was incomplete,
+     * FILE_CHECKSUM_MISMATCH if file content does not match its expected checksum
+     */
+    StatusCode download(const std::vector<RangedDownloadFile>& files, const range_reader_t& readRange) const;
+};
+
+}  // namespace ovms
@@ -22,8 +22,7 @@
 #include "tensorflow_serving/util/json_tensor.h"
 #pragma GCC diagnostic pop
 
-#define DEBUG
-#include "timer.hpp"
+#include "tracing.hpp"
 
 using tensorflow::DataType;
 using tensorflow::DataTypeSize;
@@ -40,10 +39,9 @@ Status makeJsonFromPredictResponse(
         return StatusCode::REST_PREDICT_UNKNOWN_ORDER;
     }
 
-    Timer timer;
-    using std::chrono::microseconds;
+    SpanTimer timer;
 
-    timer.start("convert");
+    timer.start(TraceSpan::REST_CONVERT);
 
     for (auto& kv : *response_proto.mutable_outputs()) {
         auto& tensor = kv.second;
@@ -108,17 +106,17 @@ Status makeJsonFromPredictResponse(
         }
     }
 
-    timer.stop("convert");
-    timer.start("MakeJsonFromTensors");
+    timer.stop(TraceSpan::REST_CONVERT);
+    timer.start(TraceSpan::REST_MAKE_JSON);
 
     const auto& tf_status = MakeJsonFromTensors(
         response_proto.outputs(),
         order == Order::ROW ? JsonPredictRequestFormat::kRow : JsonPredictRequestFormat::kColumnar,
         response_json);
 
-    timer.stop("MakeJsonFromTensors");
-    SPDLOG_DEBUG("tensor_content to *_val container conversion: {:.3f} ms", timer.elapsed<microseconds>("convert") / 1000);
-    SPDLOG_DEBUG("MakeJsonFromTensors call: {:.3f} ms", timer.elapsed<microseconds>("MakeJsonFromTensors") / 1000);
+    timer.stop(TraceSpan::REST_MAKE_JSON);
+    SPDLOG_DEBUG("tensor_content to *_val container conversion: {:.3f} ms", timer.elapsedMicroseconds(TraceSpan::REST_CONVERT) / 1000);
+    SPDLOG_DEBUG("MakeJsonFromTensors call: {:.3f} ms", timer.elapsedMicroseconds(TraceSpan::REST_MAKE_JSON) / 1000);
 
     if (!tf_status.ok()) {
         SPDLOG_ERROR("Creating json from tensors failed: {}", tf_status.error_message());
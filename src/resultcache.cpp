@@ -0,0 +1,165 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "resultcache.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "crc32c.hpp"
+
+namespace ovms {
+
+size_t ResultCacheKeyHash::operator()(std::string_view key) const {
+    Crc32c crc;
+    crc.update(key.data(), key.size());
+    return crc.get();
+}
+
+std::string ResultCache::createKey(const tensorflow::serving::PredictRequest& request, model_version_t version) {
+    std::vector<std::pair<const std::string*, const tensorflow::TensorProto*>> inputs;
+    inputs.reserve(request.inputs().size());
+    for (const auto& [name, proto] : request.inputs()) {
+        inputs.emplace_back(&name, &proto);
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const auto& lhs, const auto& rhs) { return *lhs.first < *rhs.first; });
+
+    std::string key = "proto:" + std::to_string(version);
+    for (const auto& [name, proto] : inputs) {
+        key += '\0';
+        key += *name;
+        key += '\0';
+        key += std::to_string(proto->dtype());
+        for (const auto& dim : proto->tensor_shape().dim()) {
+            key += ',';
+            key += std::to_string(dim.size());
+        }
+        key += '\0';
+        if (!proto->tensor_content().empty()) {
+            key += proto->tensor_content();
+        } else {
+            // Values passed in typed fields instead of tensor content are small
+            key += proto->SerializeAsString();
+        }
+    }
+    return key;
+}
+
+std::string ResultCache::createKey(const cached_outputs_t& inputs, model_version_t version) {
+    std::vector<std::pair<const std::string*, const InferenceEngine::Blob::Ptr*>> sorted;
+    sorted.reserve(inputs.size());
+    for (const auto& [name, blob] : inputs) {
+        sorted.emplace_back(&name, &blob);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return *lhs.first < *rhs.first; });
+
+    std::string key = "blob:" + std::to_string(version);
+    for (const auto& [name, blobPtr] : sorted) {
+        const auto& blob = *blobPtr;
+        const auto& desc = blob->getTensorDesc();
+        key += '\0';
+        key += *name;
+        key += '\0';
+        key += desc.getPrecision().name();
+        for (const auto& dim : desc.getDims()) {
+            key += ',';
+            key += std::to_string(dim);
+        }
+        key += '\0';
+        key.append((const char*)blob->buffer(), blob->byteSize());
+    }
+    return key;
+}
+
+bool ResultCache::lookup(const std::string& key, cached_outputs_t& outputs, std::unique_ptr<ResultCacheMissGuard>& missGuard, bool waitForPending) {
+    std::shared_ptr<const cached_outputs_t> found;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            auto it = index.find(key);
+            if (it != index.end()) {
+                entries.splice(entries.begin(), entries, it->second);
+                found = it->second->outputs;
+                break;
+            }
+            if (pending.count(key) == 0) {
+                pending.insert(key);
+                missGuard = std::make_unique<ResultCacheMissGuard>(shared_from_this(), key);
+                return false;
+            }
+            if (!waitForPending) {
+                return false;
+            }
+            pendingFinished.wait(lock);
+        }
+    }
+    outputs = *found;
+    return true;
+}
+
+void ResultCache::insert(const std::string& key, cached_outputs_t&& outputs) {
+    size_t bytes = key.size();
+    for (const auto& [name, blob] : outputs) {
+        bytes += name.size() + blob->byteSize();
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    pending.erase(key);
+    pendingFinished.notify_all();
+    if (bytes > capacityBytes) {
+        SPDLOG_DEBUG("Result of size: {} bytes does not fit into cache of capacity: {} bytes", bytes, capacityBytes);
+        return;
+    }
+    if (index.count(key) == 1) {
+        return;
+    }
+    while (usedBytes + bytes > capacityBytes && !entries.empty()) {
+        auto& lru = entries.back();
+        usedBytes -= lru.bytes;
+        index.erase(lru.key);
+        entries.pop_back();
+    }
+    entries.push_front(Entry{key, std::make_shared<const cached_outputs_t>(std::move(outputs)), bytes});
+    index.emplace(entries.front().key, entries.begin());
+    usedBytes += bytes;
+}
+
+void ResultCache::abandon(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mtx);
+    pending.erase(key);
+    pendingFinished.notify_all();
+}
+
+void ResultCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    index.clear();
+    entries.clear();
+    usedBytes = 0;
+}
+
+size_t ResultCache::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return usedBytes;
+}
+
+size_t ResultCache::getEntriesCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return entries.size();
+}
+
+}  // namespace ovms
@@ -0,0 +1,157 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <inference_engine.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#pragma GCC diagnostic pop
+
+#include "model_version_policy.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Model outputs keyed by network output name
+ */
+using cached_outputs_t = std::unordered_map<std::string, InferenceEngine::Blob::Ptr>;
+
+class ResultCacheMissGuard;
+
+/**
+ * @brief Hashes keys with CRC-32C computed with SSE 4.2 instructions. Used only to pick buckets, keys are always compared in full.
+ */
+struct ResultCacheKeyHash {
+    size_t operator()(std::string_view key) const;
+};
+
+/**
+ * @brief Bounded LRU cache of model outputs keyed by the exact content of inputs.
+ * Keys contain the whole content of inputs so a hash collision can never return results of different request.
+ * Concurrent lookups of the same key are coalesced - only the first one computes the results,
+ * while the rest wait for them.
+ */
+class ResultCache : public std::enable_shared_from_this<ResultCache> {
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const cached_outputs_t> outputs;
+        size_t bytes;
+    };
+
+    const size_t capacityBytes;
+    size_t usedBytes = 0;
+
+    /**
+     * @brief Entries ordered from most to least recently used
+     */
+    std::list<Entry> entries;
+
+    /**
+     * @brief Views on keys owned by entries list
+     */
+    std::unordered_map<std::string_view, std::list<Entry>::iterator, ResultCacheKeyHash> index;
+
+    /**
+     * @brief Keys which results are being computed at the moment
+     */
+    std::unordered_set<std::string, ResultCacheKeyHash> pending;
+
+    mutable std::mutex mtx;
+    std::condition_variable pendingFinished;
+
+    friend class ResultCacheMissGuard;
+
+    void insert(const std::string& key, cached_outputs_t&& outputs);
+    void abandon(const std::string& key);
+
+public:
+    explicit ResultCache(size_t capacityBytes) :
+        capacityBytes(capacityBytes) {}
+
+    /**
+     * @brief Creates key from predict request inputs. Inputs order in request does not matter.
+     */
+    static std::string createKey(const tensorflow::serving::PredictRequest& request, model_version_t version);
+
+    /**
+     * @brief Creates key from inputs blobs
+     */
+    static std::string createKey(const cached_outputs_t& inputs, model_version_t version);
+
+    /**
+     * @brief Looks up results for given key
+     *
+     * Cache has to be owned by shared pointer, which is kept by miss guard.
+     *
+     * @param key
+     * @param outputs filled with cached results on hit
+     * @param missGuard set on miss when caller becomes responsible for computing the results
+     * @param waitForPending whether to wait when the same key is being computed by another caller
+     *
+     * @return true on hit
+     */
+    bool lookup(const std::string& key, cached_outputs_t& outputs, std::unique_ptr<ResultCacheMissGuard>& missGuard, bool waitForPending = true);
+
+    void clear();
+
+    size_t getCapacityBytes() const {
+        return capacityBytes;
+    }
+
+    size_t getUsedBytes() const;
+
+    size_t getEntriesCount() const;
+};
+
+/**
+ * @brief Holds the responsibility for computing results after cache miss.
+ * If results are not committed, pending key is released so waiting callers can compute them on their own.
+ */
+class ResultCacheMissGuard {
+    const std::shared_ptr<ResultCache> cache;
+    const std::string key;
+    bool committed = false;
+
+public:
+    ResultCacheMissGuard(std::shared_ptr<ResultCache> cache, const std::string& key) :
+        cache(std::move(cache)),
+        key(key) {}
+
+    ~ResultCacheMissGuard() {
+        if (!committed) {
+            cache->abandon(key);
+        }
+    }
+
+    void commit(cached_outputs_t&& outputs) {
+        cache->insert(key, std::move(outputs));
+        committed = true;
+    }
+};
+
+}  // namespace ovms
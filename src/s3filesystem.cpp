@@ -25,10 +25,15 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "s3filesystem.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <aws/core/Aws.h>
@@ -39,7 +44,9 @@
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 
+#include "filehash.hpp"
 #include "logging.hpp"
+#include "rangeddownloader.hpp"
 #include "stringutils.hpp"
 
 namespace ovms {
@@ -49,6 +56,8 @@ namespace fs = std::filesystem;
 
 const std::string S3FileSystem::S3_URL_PREFIX = "s3://";
 
+static const size_t DOWNLOAD_BUFFER_SIZE = 1024 * 1024;
+
 StatusCode S3FileSystem::parsePath(const std::string& path, std::string* bucket, std::string* object) {
     std::smatch sm;
 
@@ -161,8 +170,26 @@ S3FileSystem::S3FileSystem(const Aws::SDKOptions& options, const std::string& s3
     }
 }
 
-S3FileSystem::~S3FileSystem() {
-    Aws::ShutdownAPI(options_);
+namespace {
+std::mutex sdkMtx;
+std::unique_ptr<Aws::SDKOptions> sdkOptions;
+}  // namespace
+
+const Aws::SDKOptions& S3FileSystem::initializeSdk() {
+    std::lock_guard<std::mutex> lock(sdkMtx);
+    if (!sdkOptions) {
+        sdkOptions = std::make_unique<Aws::SDKOptions>();
+        Aws::InitAPI(*sdkOptions);
+    }
+    return *sdkOptions;
+}
+
+void S3FileSystem::shutdownSdk() {
+    std::lock_guard<std::mutex> lock(sdkMtx);
+    if (sdkOptions) {
+        Aws::ShutdownAPI(*sdkOptions);
+        sdkOptions.reset();
+    }
 }
 
 StatusCode S3FileSystem::fileExists(const std::string& path, bool* exists) {
@@ -447,60 +474,130 @@ StatusCode S3FileSystem::downloadFileFolder(const std::string& path, const std::
             }
         }
 
+        std::vector<std::pair<std::string, std::string>> filesToDownload;
         for (auto iter = files.begin(); iter != files.end(); ++iter) {
             if (std::any_of(acceptedFiles.begin(), acceptedFiles.end(), [&iter](const std::string& x) {
                     return iter->size() > 0 && endsWith(*iter, x);
                 })) {
-                std::string bucket, object;
-                status = parsePath(*iter, &bucket, &object);
-                if (status != StatusCode::OK) {
-                    return status;
-                }
-
-                // Send a request for the objects metadata
-                s3::Model::GetObjectRequest object_request;
-                object_request.SetBucket(bucket.c_str());
-                object_request.SetKey(object.c_str());
-
-                auto get_object_outcome = client_.GetObject(object_request);
-                if (get_object_outcome.IsSuccess()) {
-                    auto& retrieved_file =
-                        get_object_outcome.GetResultWithOwnership().GetBody();
-                    std::string s3_removed_path = (*iter).substr(effective_path.size());
-                    std::string local_file_path = joinPath({local_path, s3_removed_path});
-                    std::ofstream output_file(local_file_path.c_str(), std::ios::binary);
-                    output_file << retrieved_file.rdbuf();
-                    output_file.close();
-                } else {
-                    SPDLOG_LOGGER_ERROR(s3_logger, "Failed to get object at {}", *iter);
-                    return StatusCode::S3_FAILED_GET_OBJECT;
-                }
+                std::string s3_removed_path = (*iter).substr(effective_path.size());
+                filesToDownload.emplace_back(*iter, joinPath({local_path, s3_removed_path}));
             }
         }
+        return downloadFiles(filesToDownload);
     } else {
+        return downloadFiles({{effective_path, local_path}});
+    }
+}
+
+StatusCode S3FileSystem::downloadFiles(const std::vector<std::pair<std::string, std::string>>& files) {
+    std::vector<RangedDownloadFile> rangedFiles;
+    for (const auto& [s3_path, local_file_path] : files) {
         std::string bucket, object;
-        auto s = parsePath(effective_path, &bucket, &object);
-        if (s != StatusCode::OK) {
-            return s;
+        auto status = parsePath(s3_path, &bucket, &object);
+        if (status != StatusCode::OK) {
+            return status;
         }
 
         // Send a request for the objects metadata
-        s3::Model::GetObjectRequest object_request;
-        object_request.SetBucket(bucket.c_str());
-        object_request.SetKey(object.c_str());
-
-        auto get_object_outcome = client_.GetObject(object_request);
-        if (get_object_outcome.IsSuccess()) {
-            auto& retrieved_file = get_object_outcome.GetResultWithOwnership().GetBody();
-            std::ofstream output_file(local_path.c_str(), std::ios::binary);
-            output_file << retrieved_file.rdbuf();
-            output_file.close();
-        } else {
-            SPDLOG_LOGGER_ERROR(s3_logger, "Failed to get object at {}", effective_path);
+        s3::Model::HeadObjectRequest head_request;
+        head_request.SetBucket(bucket.c_str());
+        head_request.SetKey(object.c_str());
+
+        auto head_object_outcome = client_.HeadObject(head_request);
+        if (!head_object_outcome.IsSuccess()) {
+            SPDLOG_LOGGER_ERROR(s3_logger, "Failed to get object metadata at {}", s3_path);
             return StatusCode::S3_FAILED_GET_OBJECT;
         }
+        const auto& metadata = head_object_outcome.GetResult();
+        rangedFiles.push_back({s3_path, local_file_path, static_cast<uint64_t>(metadata.GetContentLength()), metadata.GetETag().c_str()});
+    }
+
+    auto downloader = RangedDownloader::fromConfig();
+    return downloader.download(rangedFiles, [this](const std::string& s3_path, uint64_t offset, uint64_t size, const range_writer_t& writer) {
+        return downloadObjectRange(s3_path, offset, size, writer);
+    });
+}
+
+StatusCode S3FileSystem::downloadObjectRange(const std::string& path, uint64_t offset, uint64_t size, const range_writer_t& writer) {
+    std::string bucket, object;
+    auto status = parsePath(path, &bucket, &object);
+    if (status != StatusCode::OK) {
+        return status;
     }
 
+    s3::Model::GetObjectRequest object_request;
+    object_request.SetBucket(bucket.c_str());
+    object_request.SetKey(object.c_str());
+    object_request.SetRange(("bytes=" + std::to_string(offset) + "-" + std::to_string(offset + size - 1)).c_str());
+
+    auto get_object_outcome = client_.GetObject(object_request);
+    if (!get_object_outcome.IsSuccess()) {
+        SPDLOG_LOGGER_ERROR(s3_logger, "Failed to get object at {} range from {} of size {}", path, offset, size);
+        return StatusCode::S3_FAILED_GET_OBJECT;
+    }
+    auto& retrieved_file = get_object_outcome.GetResultWithOwnership().GetBody();
+    std::vector<char> buffer(std::min<uint64_t>(size, DOWNLOAD_BUFFER_SIZE));
+    while (retrieved_file.read(buffer.data(), buffer.size()) || retrieved_file.gcount() > 0) {
+        if (!writer(buffer.data(), retrieved_file.gcount())) {
+            return StatusCode::S3_FAILED_GET_OBJECT;
+        }
+    }
+    return StatusCode::OK;
+}
+
+StatusCode S3FileSystem::getDirectoriesFingerprints(const std::vector<std::string>& paths, std::map<std::string, std::string>* fingerprints) {
+    std::map<std::string, std::map<std::string, std::string>> pathsByBucket;
+    for (const auto& path : paths) {
+        std::string bucket, object;
+        if (parsePath(path, &bucket, &object) == StatusCode::OK) {
+            pathsByBucket[bucket][appendSlash(object)] = path;
+        }
+    }
+    for (const auto& [bucket, pathsByPrefix] : pathsByBucket) {
+        std::set<std::string> prefixes;
+        for (const auto& [prefix, path] : pathsByPrefix) {
+            prefixes.insert(prefix);
+        }
+        for (const auto& [listingPrefix, groupPrefixes] : groupListingPrefixes(prefixes)) {
+            std::map<std::string, Fnv1aHash> hashes;
+            for (const auto& prefix : groupPrefixes) {
+                hashes[prefix];
+            }
+            s3::Model::ListObjectsRequest objects_request;
+            objects_request.SetBucket(bucket.c_str());
+            objects_request.SetPrefix(listingPrefix.c_str());
+            bool listed = true;
+            while (true) {
+                auto list_objects_outcome = client_.ListObjects(objects_request);
+                if (!list_objects_outcome.IsSuccess()) {
+                    SPDLOG_LOGGER_WARN(s3_logger, "Could not list objects in bucket {} with prefix {}", bucket, listingPrefix);
+                    listed = false;
+                    break;
+                }
+                const auto& result = list_objects_outcome.GetResult();
+                for (const auto& s3_object : result.GetContents()) {
+                    std::string key(s3_object.GetKey().c_str());
+                    for (auto& [prefix, hash] : hashes) {
+                        if (key.rfind(prefix, 0) == 0) {
+                            hash.update(key);
+                            hash.update(s3_object.GetETag().c_str());
+                            hash.update(std::to_string(s3_object.GetSize()));
+                        }
+                    }
+                }
+                if (!result.GetIsTruncated() || result.GetContents().empty()) {
+                    break;
+                }
+                objects_request.SetMarker(result.GetContents().back().GetKey());
+            }
+            if (!listed) {
+                continue;
+            }
+            for (const auto& [prefix, hash] : hashes) {
+                (*fingerprints)[pathsByPrefix.at(prefix)] = hash.toHexString();
+            }
+        }
+    }
     return StatusCode::OK;
 }
 
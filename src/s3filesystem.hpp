@@ -15,14 +15,17 @@
 //*****************************************************************************
 #pragma once
 
+#include <map>
 #include <regex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <aws/core/Aws.h>
 #include <aws/s3/S3Client.h>
 
 #include "filesystem.hpp"
+#include "rangeddownloader.hpp"
 #include "status.hpp"
 
 namespace ovms {
@@ -38,10 +41,17 @@ public:
     S3FileSystem(const Aws::SDKOptions& options, const std::string& s3_path);
 
     /**
-     * @brief Destroy the S3FileSystem object
+     * @brief Initializes AWS SDK on first call and keeps it initialized until shutdownSdk is called.
+     * InitAPI and ShutdownAPI are not thread safe, so they are not called per filesystem instance.
      * 
+     * @return options the SDK was initialized with
      */
-    ~S3FileSystem();
+    static const Aws::SDKOptions& initializeSdk();
+
+    /**
+     * @brief Shuts down AWS SDK if it was initialized. Called at server teardown, when no S3 filesystem is in use anymore.
+     */
+    static void shutdownSdk();
 
     /**
      * @brief Check if given path or file exists
@@ -124,6 +134,15 @@ public:
      */
     StatusCode deleteFileFolder(const std::string& path) override;
 
+    /**
+     * @brief Get fingerprints of directories, listing directories of the same bucket together
+     * 
+     * @param paths 
+     * @param fingerprints 
+     * @return StatusCode 
+     */
+    StatusCode getDirectoriesFingerprints(const std::vector<std::string>& paths, std::map<std::string, std::string>* fingerprints) override;
+
     static const std::string S3_URL_PREFIX;
 
 private:
@@ -137,6 +156,25 @@ private:
      */
     StatusCode parsePath(const std::string& path, std::string* bucket, std::string* object);
 
+    /**
+     * @brief Download objects in parallel ranged parts
+     * 
+     * @param files pairs of remote object path and local file path
+     * @return StatusCode 
+     */
+    StatusCode downloadFiles(const std::vector<std::pair<std::string, std::string>>& files);
+
+    /**
+     * @brief Download a byte range of an object with a single ranged GET
+     * 
+     * @param path 
+     * @param offset 
+     * @param size 
+     * @param writer receives consecutive chunks of the range
+     * @return StatusCode 
+     */
+    StatusCode downloadObjectRange(const std::string& path, uint64_t offset, uint64_t size, const range_writer_t& writer);
+
     /**
      * @brief 
      * 
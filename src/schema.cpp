@@ -77,6 +77,21 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 						"nireq": {
 							"type": "integer"
 						},
+						"result_cache_size_mb": {
+							"type": "integer",
+							"minimum": 0
+						},
+						"warmup_iterations": {
+							"type": "integer",
+							"minimum": 0,
+							"maximum": 1000
+						},
+						"warmup_data": {
+							"type": "string"
+						},
+						"pinned": {
+							"type": "boolean"
+						},
 						"target_device": {
 							"type": "string"
 						},
@@ -133,9 +148,22 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 			},
 			"additionalProperties": false
 		},
+		"custom_node_library_config": {
+			"type": "object",
+			"required": ["name", "base_path"],
+			"properties": {
+				"name": {
+					"type": "string"
+				},
+				"base_path": {
+					"type": "string"
+				}
+			},
+			"additionalProperties": false
+		},
 		"node_config": {
 			"type": "object",
-			"required": ["name", "model_name", "inputs", "outputs"],
+			"required": ["name", "type", "inputs", "outputs"],
 			"properties": {
 				"name": {
 					"type": "string"
@@ -143,14 +171,30 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 				"model_name": {
 					"type": "string"
 				},
+				"library_name": {
+					"type": "string"
+				},
 				"type": {
 					"type": "string",
-					"enum": ["DL model", "Demultiplexer", "Batch dispatcher"]
+					"enum": ["DL model", "custom", "Demultiplexer", "Batch dispatcher"]
+				},
+				"params": {
+					"type": "object",
+					"additionalProperties": {
+						"type": "string"
+					}
 				},
 				"version": {
 					"type": "integer",
 					"minimum": 1
 				},
+				"demultiply_count": {
+					"type": "integer",
+					"minimum": -1
+				},
+				"gather_from_node": {
+					"type": "string"
+				},
 				"inputs": {
 					"type": "array",
 					"items": {
@@ -210,6 +254,12 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 				"$ref": "#/definitions/model_config"
 			}
 		},
+		"custom_node_library_config_list": {
+			"type": "array",
+			"items": {
+				"$ref": "#/definitions/custom_node_library_config"
+			}
+		},
 		"pipeline_config_list": {
 			"type": "array",
 			"items": {
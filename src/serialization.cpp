@@ -15,6 +15,8 @@
 //*****************************************************************************
 #include "serialization.hpp"
 
+#include <algorithm>
+
 namespace ovms {
 
 Status serializeBlobToTensorProto(
@@ -73,10 +75,15 @@ Status serializeBlobToTensorProto(
 Status serializePredictResponse(
     InferenceEngine::InferRequest& inferRequest,
     const tensor_map_t& outputMap,
-    tensorflow::serving::PredictResponse* response) {
+    tensorflow::serving::PredictResponse* response,
+    const google::protobuf::RepeatedPtrField<std::string>& outputFilter) {
 
     for (const auto& pair : outputMap) {
         auto networkOutput = pair.second;
+        if (outputFilter.size() > 0 &&
+            std::find(outputFilter.begin(), outputFilter.end(), networkOutput->getMappedName()) == outputFilter.end()) {
+            continue;
+        }
         InferenceEngine::Blob::Ptr blob;
         try {
             blob = inferRequest.GetBlob(networkOutput->getName());
@@ -95,4 +102,32 @@ Status serializePredictResponse(
     return StatusCode::OK;
 }
 
+Status serializePredictResponse(
+    const std::unordered_map<std::string, InferenceEngine::Blob::Ptr>& outputBlobs,
+    const tensor_map_t& outputMap,
+    tensorflow::serving::PredictResponse* response,
+    const google::protobuf::RepeatedPtrField<std::string>& outputFilter) {
+
+    for (const auto& pair : outputMap) {
+        auto networkOutput = pair.second;
+        if (outputFilter.size() > 0 &&
+            std::find(outputFilter.begin(), outputFilter.end(), networkOutput->getMappedName()) == outputFilter.end()) {
+            continue;
+        }
+        auto it = outputBlobs.find(networkOutput->getName());
+        if (it == outputBlobs.end()) {
+            Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+            SPDLOG_ERROR("{}: missing output: {}", status.string(), networkOutput->getName());
+            return status;
+        }
+        auto& tensorProto = (*response->mutable_outputs())[networkOutput->getMappedName()];
+        auto status = serializeBlobToTensorProto(tensorProto, networkOutput, it->second);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    return StatusCode::OK;
+}
+
 }  // namespace ovms
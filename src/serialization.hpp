@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include <inference_engine.hpp>
 #include <spdlog/spdlog.h>
@@ -37,9 +38,22 @@ Status serializeBlobToTensorProto(
     const std::shared_ptr<TensorInfo>& networkOutput,
     InferenceEngine::Blob::Ptr blob);
 
+/**
+ * @brief Serializes network outputs to predict response. When output filter is not empty, only outputs listed in it are serialized.
+ */
 Status serializePredictResponse(
     InferenceEngine::InferRequest& inferRequest,
     const tensor_map_t& outputMap,
-    tensorflow::serving::PredictResponse* response);
+    tensorflow::serving::PredictResponse* response,
+    const google::protobuf::RepeatedPtrField<std::string>& outputFilter = {});
+
+/**
+ * @brief Serializes already fetched network outputs, keyed by network output name, to predict response.
+ */
+Status serializePredictResponse(
+    const std::unordered_map<std::string, InferenceEngine::Blob::Ptr>& outputBlobs,
+    const tensor_map_t& outputMap,
+    tensorflow::serving::PredictResponse* response,
+    const google::protobuf::RepeatedPtrField<std::string>& outputFilter = {});
 
 }  // namespace ovms
@@ -14,7 +14,9 @@
 // limitations under the License.
 //*****************************************************************************
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -35,7 +37,9 @@
 #include "model_service.hpp"
 #include "modelmanager.hpp"
 #include "prediction_service.hpp"
+#include "s3filesystem.hpp"
 #include "stringutils.hpp"
+#include "tracing.hpp"
 
 using grpc::Server;
 using grpc::ServerBuilder;
@@ -245,6 +249,16 @@ int server_main(int argc, char** argv) {
     try {
         auto& config = ovms::Config::instance().parse(argc, argv);
         configure_logger(config.logLevel(), config.logPath());
+        SpanExporter::instance().setSamplingRate(config.traceSamplingRate());
+        if (!config.requestTracePath().empty()) {
+            auto output = std::make_unique<std::ofstream>(config.requestTracePath(), std::ios::trunc);
+            if (output->is_open()) {
+                SpanExporter::instance().enableRequestTracing(std::move(output), config.requestTraceSamplingRate());
+            } else {
+                SPDLOG_ERROR("Cannot open request trace file: {}; request tracing is disabled", config.requestTracePath());
+            }
+        }
+        SpanExporter::instance().start();
 
         PredictionServiceImpl predict_service;
         ModelServiceImpl model_service;
@@ -268,6 +282,8 @@ int server_main(int argc, char** argv) {
         }
 
         ModelManager::getInstance().join();
+        S3FileSystem::shutdownSdk();
+        SpanExporter::instance().join();
     } catch (std::exception& e) {
         SPDLOG_ERROR("Exception catch: {} - will now terminate.", e.what());
         return EXIT_FAILURE;
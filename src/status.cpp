@@ -23,6 +23,7 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
 
     {StatusCode::PATH_INVALID, "The provided base path is invalid or doesn't exists"},
     {StatusCode::FILE_INVALID, "File not found or cannot open"},
+    {StatusCode::FILE_CHECKSUM_MISMATCH, "Downloaded file content does not match its checksum"},
     {StatusCode::NO_MODEL_VERSION_AVAILABLE, "Not a single model version directory has valid numeric name"},
     {StatusCode::NETWORK_NOT_LOADED, "Error while loading a network"},
     {StatusCode::JSON_INVALID, "The file is not valid json"},
@@ -51,6 +52,7 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     // Predict request validation
     {StatusCode::INVALID_NO_OF_INPUTS, "Invalid number of inputs"},
     {StatusCode::INVALID_MISSING_INPUT, "Missing input with specific name"},
+    {StatusCode::INVALID_MISSING_OUTPUT, "Missing output with specific name"},
     {StatusCode::INVALID_NO_OF_SHAPE_DIMENSIONS, "Invalid number of shape dimensions"},
     {StatusCode::INVALID_BATCH_SIZE, "Invalid input batch size"},
     {StatusCode::INVALID_SHAPE, "Invalid input shape"},
@@ -107,11 +109,32 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     {StatusCode::PIPELINE_NODE_REFERING_TO_MISSING_MODEL, "Pipeline definition has reference to missing model"},
     {StatusCode::PIPELINE_NODE_REFERING_TO_MISSING_DATA_SOURCE, "Pipeline definition has reference to missing data source"},
     {StatusCode::PIPELINE_NODE_REFERING_TO_MISSING_MODEL_OUTPUT, "Pipeline definition has reference to missing model output"},
+    {StatusCode::PIPELINE_NODE_MISSING_MODEL_NAME, "Pipeline definition has DL model node without model name"},
     {StatusCode::PIPELINE_CONNECTION_TO_MISSING_MODEL_INPUT, "Pipeline definition has connection to non existing model input"},
     {StatusCode::PIPELINE_NOT_ALL_INPUTS_CONNECTED, "Pipeline definition does not have connections for all inputs of underlying models"},
     {StatusCode::PIPELINE_MODEL_INPUT_CONNECTED_TO_MULTIPLE_DATA_SOURCES, "Pipeline definition has multiple connections to the same input of underlying model"},
     {StatusCode::PIPELINE_EXIT_USED_AS_NODE_DEPENDENCY, "Pipeline definition has response node used as dependency node"},
     {StatusCode::PIPELINE_NAME_OCCUPIED, "Pipeline has the same name as model"},
+    {StatusCode::PIPELINE_DEFINITION_INVALID_NODE_LIBRARY, "Pipeline refers to incorrect library"},
+    {StatusCode::PIPELINE_INVALID_DEMULTIPLY_COUNT, "Demultiply count must be positive or -1 for dynamic demultiplexing"},
+    {StatusCode::PIPELINE_NODE_GATHER_FROM_NOT_DEMULTIPLEXER, "Gathering node refers to node which is not a demultiplexer"},
+    {StatusCode::PIPELINE_WRONG_DEMULTIPLEXER_GATHER_NODES_ORDER, "Demultiplexer and gather nodes are not in correct order"},
+    {StatusCode::PIPELINE_NESTED_DEMULTIPLEXING_UNSUPPORTED, "Nested or overlapping demultiplexing is not supported"},
+    {StatusCode::PIPELINE_DEMULTIPLY_COUNT_DOES_NOT_MATCH_BLOB_BATCH_SIZE, "Demultiplexer output 0th dimension does not match demultiply count"},
+    {StatusCode::PIPELINE_DEMULTIPLEXER_NO_RESULTS, "Demultiplexer node returned no results"},
+    {StatusCode::PIPELINE_INCONSISTENT_SHARD_DIMENSIONS, "Gathered blobs have inconsistent shapes or precisions"},
+
+    // Custom node library
+    {StatusCode::NODE_LIBRARY_ALREADY_LOADED, "Custom node library is already loaded from different path"},
+    {StatusCode::NODE_LIBRARY_LOAD_FAILED_OPEN, "Custom node library failed to open"},
+    {StatusCode::NODE_LIBRARY_LOAD_FAILED_SYM, "Custom node library failed to load symbol"},
+    {StatusCode::NODE_LIBRARY_MISSING, "Custom node library is not loaded"},
+    {StatusCode::NODE_LIBRARY_INITIALIZE_FAILED, "Custom node library initialization failed"},
+    {StatusCode::NODE_LIBRARY_METADATA_FAILED, "Custom node library failed to return inputs or outputs metadata"},
+    {StatusCode::NODE_LIBRARY_EXECUTION_FAILED, "Custom node library execution failed"},
+    {StatusCode::NODE_LIBRARY_OUTPUTS_CORRUPTED, "Custom node library returned corrupted outputs"},
+    {StatusCode::NODE_LIBRARY_INVALID_PRECISION, "Custom node library returned output with unsupported precision"},
+    {StatusCode::NODE_LIBRARY_MISSING_OUTPUT, "Custom node library did not return required output"},
 
     // Storage errors
     // S3
@@ -162,6 +185,7 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
 
     {StatusCode::PATH_INVALID, grpc::StatusCode::INTERNAL},
     {StatusCode::FILE_INVALID, grpc::StatusCode::INTERNAL},
+    {StatusCode::FILE_CHECKSUM_MISMATCH, grpc::StatusCode::INTERNAL},
     {StatusCode::NO_MODEL_VERSION_AVAILABLE, grpc::StatusCode::INTERNAL},
     {StatusCode::NETWORK_NOT_LOADED, grpc::StatusCode::INTERNAL},
     {StatusCode::JSON_INVALID, grpc::StatusCode::INTERNAL},
@@ -185,6 +209,7 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
     // Predict request validation
     {StatusCode::INVALID_NO_OF_INPUTS, grpc::StatusCode::INVALID_ARGUMENT},
     {StatusCode::INVALID_MISSING_INPUT, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::INVALID_MISSING_OUTPUT, grpc::StatusCode::INVALID_ARGUMENT},
     {StatusCode::INVALID_NO_OF_SHAPE_DIMENSIONS, grpc::StatusCode::INVALID_ARGUMENT},
     {StatusCode::INVALID_BATCH_SIZE, grpc::StatusCode::INVALID_ARGUMENT},
     {StatusCode::INVALID_SHAPE, grpc::StatusCode::INVALID_ARGUMENT},
@@ -207,6 +232,17 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
     {StatusCode::OV_UNSUPPORTED_SERIALIZATION_PRECISION, grpc::StatusCode::INTERNAL},
     {StatusCode::OV_INTERNAL_SERIALIZATION_ERROR, grpc::StatusCode::INTERNAL},
 
+    // Custom node execution
+    {StatusCode::NODE_LIBRARY_EXECUTION_FAILED, grpc::StatusCode::FAILED_PRECONDITION},
+    {StatusCode::NODE_LIBRARY_OUTPUTS_CORRUPTED, grpc::StatusCode::INTERNAL},
+    {StatusCode::NODE_LIBRARY_INVALID_PRECISION, grpc::StatusCode::INTERNAL},
+    {StatusCode::NODE_LIBRARY_MISSING_OUTPUT, grpc::StatusCode::INTERNAL},
+
+    // Pipeline demultiplexing
+    {StatusCode::PIPELINE_DEMULTIPLY_COUNT_DOES_NOT_MATCH_BLOB_BATCH_SIZE, grpc::StatusCode::FAILED_PRECONDITION},
+    {StatusCode::PIPELINE_DEMULTIPLEXER_NO_RESULTS, grpc::StatusCode::FAILED_PRECONDITION},
+    {StatusCode::PIPELINE_INCONSISTENT_SHARD_DIMENSIONS, grpc::StatusCode::INTERNAL},
+
     // GetModelStatus
     {StatusCode::INTERNAL_ERROR, grpc::StatusCode::INTERNAL},
 };
@@ -237,6 +273,7 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
 
     {StatusCode::PATH_INVALID, net_http::HTTPStatusCode::ERROR},
     {StatusCode::FILE_INVALID, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::FILE_CHECKSUM_MISMATCH, net_http::HTTPStatusCode::ERROR},
     {StatusCode::NO_MODEL_VERSION_AVAILABLE, net_http::HTTPStatusCode::ERROR},
     {StatusCode::NETWORK_NOT_LOADED, net_http::HTTPStatusCode::ERROR},
     {StatusCode::JSON_INVALID, net_http::HTTPStatusCode::ERROR},
@@ -260,6 +297,7 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
     // Predict request validation
     {StatusCode::INVALID_NO_OF_INPUTS, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::INVALID_MISSING_INPUT, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::INVALID_MISSING_OUTPUT, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::INVALID_NO_OF_SHAPE_DIMENSIONS, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::INVALID_BATCH_SIZE, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::INVALID_SHAPE, net_http::HTTPStatusCode::BAD_REQUEST},
@@ -282,6 +320,17 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
     {StatusCode::OV_UNSUPPORTED_SERIALIZATION_PRECISION, net_http::HTTPStatusCode::ERROR},
     {StatusCode::OV_INTERNAL_SERIALIZATION_ERROR, net_http::HTTPStatusCode::ERROR},
 
+    // Custom node execution
+    {StatusCode::NODE_LIBRARY_EXECUTION_FAILED, net_http::HTTPStatusCode::PRECOND_FAILED},
+    {StatusCode::NODE_LIBRARY_OUTPUTS_CORRUPTED, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::NODE_LIBRARY_INVALID_PRECISION, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::NODE_LIBRARY_MISSING_OUTPUT, net_http::HTTPStatusCode::ERROR},
+
+    // Pipeline demultiplexing
+    {StatusCode::PIPELINE_DEMULTIPLY_COUNT_DOES_NOT_MATCH_BLOB_BATCH_SIZE, net_http::HTTPStatusCode::PRECOND_FAILED},
+    {StatusCode::PIPELINE_DEMULTIPLEXER_NO_RESULTS, net_http::HTTPStatusCode::PRECOND_FAILED},
+    {StatusCode::PIPELINE_INCONSISTENT_SHARD_DIMENSIONS, net_http::HTTPStatusCode::ERROR},
+
     // GetModelStatus
     {StatusCode::INTERNAL_ERROR, net_http::HTTPStatusCode::ERROR},
 };
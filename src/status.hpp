@@ -33,9 +33,10 @@ namespace net_http = tensorflow::serving::net_http;
 enum class StatusCode {
     OK, /*!< Success */
 
-    PATH_INVALID,     /*!< The provided path is invalid or doesn't exists */
-    FILE_INVALID,     /*!< File not found or cannot open */
-    FILESYSTEM_ERROR, /*!< Underlaying filesystem error */
+    PATH_INVALID,           /*!< The provided path is invalid or doesn't exists */
+    FILE_INVALID,           /*!< File not found or cannot open */
+    FILESYSTEM_ERROR,       /*!< Underlaying filesystem error */
+    FILE_CHECKSUM_MISMATCH, /*!< Downloaded file content does not match its checksum */
     NETWORK_NOT_LOADED,
     JSON_INVALID,             /*!< The file/content is not valid json */
     JSON_SERIALIZATION_ERROR, /*!< Data serialization to json format failed */
@@ -173,11 +174,32 @@ enum class StatusCode {
     PIPELINE_NODE_REFERING_TO_MISSING_MODEL,
     PIPELINE_NODE_REFERING_TO_MISSING_DATA_SOURCE,
     PIPELINE_NODE_REFERING_TO_MISSING_MODEL_OUTPUT,
+    PIPELINE_NODE_MISSING_MODEL_NAME,
     PIPELINE_CONNECTION_TO_MISSING_MODEL_INPUT,
     PIPELINE_NOT_ALL_INPUTS_CONNECTED,
     PIPELINE_MODEL_INPUT_CONNECTED_TO_MULTIPLE_DATA_SOURCES,
     PIPELINE_EXIT_USED_AS_NODE_DEPENDENCY,
     PIPELINE_NAME_OCCUPIED,
+    PIPELINE_DEFINITION_INVALID_NODE_LIBRARY,
+    PIPELINE_INVALID_DEMULTIPLY_COUNT,
+    PIPELINE_NODE_GATHER_FROM_NOT_DEMULTIPLEXER,
+    PIPELINE_WRONG_DEMULTIPLEXER_GATHER_NODES_ORDER,
+    PIPELINE_NESTED_DEMULTIPLEXING_UNSUPPORTED,
+    PIPELINE_DEMULTIPLY_COUNT_DOES_NOT_MATCH_BLOB_BATCH_SIZE,
+    PIPELINE_DEMULTIPLEXER_NO_RESULTS,
+    PIPELINE_INCONSISTENT_SHARD_DIMENSIONS,
+
+    // Custom node library
+    NODE_LIBRARY_ALREADY_LOADED,
+    NODE_LIBRARY_LOAD_FAILED_OPEN,
+    NODE_LIBRARY_LOAD_FAILED_SYM,
+    NODE_LIBRARY_MISSING,
+    NODE_LIBRARY_INITIALIZE_FAILED,
+    NODE_LIBRARY_METADATA_FAILED,
+    NODE_LIBRARY_EXECUTION_FAILED,
+    NODE_LIBRARY_OUTPUTS_CORRUPTED,
+    NODE_LIBRARY_INVALID_PRECISION,
+    NODE_LIBRARY_MISSING_OUTPUT,
 
     // Custom Loader
     CUSTOM_LOADER_LIBRARY_INVALID,
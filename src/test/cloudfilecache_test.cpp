@@ -0,0 +1,96 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../cloudfilecache.hpp"
+#include "test_utils.hpp"
+
+using ovms::CloudFileCache;
+
+class CloudFileCacheTest : public TestWithTempDir {
+protected:
+    void SetUp() override {
+        TestWithTempDir::SetUp();
+        cacheDirectory = directoryPath + "/cache";
+        std::filesystem::create_directories(directoryPath + "/models");
+    }
+
+    std::string createFile(const std::string& name, const std::string& content) {
+        const std::string path = directoryPath + "/models/" + name;
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+
+    static std::string readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    std::string cacheDirectory;
+};
+
+TEST_F(CloudFileCacheTest, DisabledWithoutDirectory) {
+    CloudFileCache cache("", 0);
+    EXPECT_FALSE(cache.isEnabled());
+}
+
+TEST_F(CloudFileCacheTest, KeyDependsOnPathVersionAndSize) {
+    const auto key = CloudFileCache::createKey("s3://bucket/model/1/model.bin", "etag", 100);
+    EXPECT_EQ(key, CloudFileCache::createKey("s3://bucket/model/1/model.bin", "etag", 100));
+    EXPECT_NE(key, CloudFileCache::createKey("s3://bucket/model/2/model.bin", "etag", 100));
+    EXPECT_NE(key, CloudFileCache::createKey("s3://bucket/model/1/model.bin", "etag2", 100));
+    EXPECT_NE(key, CloudFileCache::createKey("s3://bucket/model/1/model.bin", "etag", 101));
+}
+
+TEST_F(CloudFileCacheTest, StoredFileIsRestored) {
+    CloudFileCache cache(cacheDirectory, 0);
+    ASSERT_TRUE(cache.isEnabled());
+    const auto key = CloudFileCache::createKey("gs://bucket/1/model.bin", "1", 7);
+    const std::string restoredPath = directoryPath + "/models/restored.bin";
+
+    EXPECT_FALSE(cache.restore(key, restoredPath));
+    EXPECT_EQ(cache.getMisses(), 1);
+
+    const auto downloadedPath = createFile("model.bin", "weights");
+    cache.store(key, downloadedPath);
+    EXPECT_EQ(cache.getStores(), 1);
+    // Removing downloaded model does not remove cached file
+    std::filesystem::remove(downloadedPath);
+
+    ASSERT_TRUE(cache.restore(key, restoredPath));
+    EXPECT_EQ(cache.getHits(), 1);
+    EXPECT_EQ(readFile(restoredPath), "weights");
+}
+
+TEST_F(CloudFileCacheTest, LeastRecentlyUsedEntriesAreEvicted) {
+    CloudFileCache cache(cacheDirectory, 10);
+    const auto firstKey = CloudFileCache::createKey("first", "1", 6);
+    const auto secondKey = CloudFileCache::createKey("second", "1", 6);
+    const auto firstPath = createFile("first", "first_");
+    std::filesystem::last_write_time(firstPath, std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+    cache.store(firstKey, firstPath);
+    cache.store(secondKey, createFile("second", "second"));
+
+    EXPECT_FALSE(cache.restore(firstKey, directoryPath + "/models/restored_first"));
+    EXPECT_TRUE(cache.restore(secondKey, directoryPath + "/models/restored_second"));
+    EXPECT_TRUE(std::filesystem::exists(directoryPath + "/models/first")) << "Evicting cache entry must not remove downloaded file";
+}
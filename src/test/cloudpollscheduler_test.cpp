@@ -0,0 +1,117 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../cloudpollscheduler.hpp"
+#include "../filesystem.hpp"
+
+using ovms::CloudPollScheduler;
+
+class CloudPollSchedulerTest : public ::testing::Test {
+protected:
+    CloudPollScheduler scheduler{std::chrono::seconds(1)};
+    CloudPollScheduler::clock::time_point now = CloudPollScheduler::clock::now();
+    CloudPollScheduler::fingerprints_t contents;
+    std::vector<std::vector<std::string>> listings;
+
+    std::set<std::string> poll(const std::set<std::string>& basePaths) {
+        return scheduler.poll(basePaths, now, [this](const std::vector<std::string>& paths, CloudPollScheduler::fingerprints_t& fingerprints) {
+            listings.push_back(paths);
+            for (const auto& path : paths) {
+                if (contents.count(path)) {
+                    fingerprints[path] = contents[path];
+                }
+            }
+        });
+    }
+};
+
+TEST_F(CloudPollSchedulerTest, FirstPollReportsAllPaths) {
+    contents = {{"s3://bucket/a", "1"}, {"s3://bucket/b", "2"}};
+    EXPECT_EQ(poll({"s3://bucket/a", "s3://bucket/b"}), std::set<std::string>({"s3://bucket/a", "s3://bucket/b"}));
+    ASSERT_EQ(listings.size(), 1);
+    EXPECT_EQ(listings[0].size(), 2);
+}
+
+TEST_F(CloudPollSchedulerTest, UnchangedPathIsPolledLessOften) {
+    contents = {{"s3://bucket/a", "1"}};
+    poll({"s3://bucket/a"});
+
+    EXPECT_TRUE(poll({"s3://bucket/a"}).empty());
+    EXPECT_EQ(listings.size(), 1);
+
+    now += std::chrono::seconds(1);
+    EXPECT_TRUE(poll({"s3://bucket/a"}).empty());
+    EXPECT_EQ(listings.size(), 2);
+    EXPECT_EQ(scheduler.getInterval("s3://bucket/a"), std::chrono::seconds(2));
+
+    now += std::chrono::seconds(1);
+    EXPECT_TRUE(poll({"s3://bucket/a"}).empty());
+    EXPECT_EQ(listings.size(), 2);
+
+    for (int i = 0; i < 10; i++) {
+        now += scheduler.getInterval("s3://bucket/a");
+        poll({"s3://bucket/a"});
+    }
+    EXPECT_EQ(scheduler.getInterval("s3://bucket/a"), std::chrono::seconds(CloudPollScheduler::DEFAULT_MAX_BACKOFF_MULTIPLIER));
+}
+
+TEST_F(CloudPollSchedulerTest, ChangedPathIsReportedAndIntervalReset) {
+    contents = {{"s3://bucket/a", "1"}};
+    poll({"s3://bucket/a"});
+    now += std::chrono::seconds(1);
+    poll({"s3://bucket/a"});
+    ASSERT_EQ(scheduler.getInterval("s3://bucket/a"), std::chrono::seconds(2));
+
+    contents["s3://bucket/a"] = "2";
+    now += std::chrono::seconds(2);
+    EXPECT_EQ(poll({"s3://bucket/a"}), std::set<std::string>({"s3://bucket/a"}));
+    EXPECT_EQ(scheduler.getInterval("s3://bucket/a"), std::chrono::seconds(1));
+}
+
+TEST_F(CloudPollSchedulerTest, PathWithoutFingerprintIsAlwaysReported) {
+    poll({"az://share/a"});
+    now += std::chrono::seconds(1);
+    EXPECT_EQ(poll({"az://share/a"}), std::set<std::string>({"az://share/a"}));
+    EXPECT_EQ(scheduler.getInterval("az://share/a"), std::chrono::seconds(1));
+}
+
+TEST_F(CloudPollSchedulerTest, NewPathIsPolledImmediately) {
+    contents = {{"s3://bucket/a", "1"}, {"s3://bucket/b", "2"}};
+    poll({"s3://bucket/a"});
+    EXPECT_EQ(poll({"s3://bucket/a", "s3://bucket/b"}), std::set<std::string>({"s3://bucket/b"}));
+    ASSERT_EQ(listings.size(), 2);
+    EXPECT_EQ(listings[1], std::vector<std::string>({"s3://bucket/b"}));
+}
+
+TEST_F(CloudPollSchedulerTest, RemovedPathIsForgotten) {
+    contents = {{"s3://bucket/a", "1"}};
+    poll({"s3://bucket/a"});
+    poll({});
+    EXPECT_EQ(poll({"s3://bucket/a"}), std::set<std::string>({"s3://bucket/a"}));
+}
+
+TEST(FileSystemListingPrefixes, SiblingsAreListedWithParent) {
+    auto groups = ovms::FileSystem::groupListingPrefixes({"models/a", "models/b", "other/c"});
+    ASSERT_EQ(groups.size(), 2);
+    EXPECT_EQ(groups["models/"], std::vector<std::string>({"models/a", "models/b"}));
+    EXPECT_EQ(groups["other/c"], std::vector<std::string>({"other/c"}));
+}
@@ -0,0 +1,130 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <inference_engine.hpp>
+
+#include "../compilednetworkcache.hpp"
+#include "../filehash.hpp"
+#include "../metrics.hpp"
+#include "test_utils.hpp"
+
+using ovms::CompiledNetworkCache;
+
+class CompiledNetworkCacheTest : public TestWithTempDir {
+protected:
+    void SetUp() override {
+        TestWithTempDir::SetUp();
+        modelFiles = {dummy_model_location + "/1/dummy.xml", dummy_model_location + "/1/dummy.bin"};
+        network = engine.ReadNetwork(modelFiles[0]);
+    }
+
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network;
+    std::vector<std::string> modelFiles;
+};
+
+TEST_F(CompiledNetworkCacheTest, DisabledWithoutDirectory) {
+    ovms::MetricsRegistry registry;
+    CompiledNetworkCache cache("", 0, registry);
+    EXPECT_FALSE(cache.isEnabled());
+}
+
+TEST_F(CompiledNetworkCacheTest, KeyIsStableForSameParameters) {
+    std::string first, second;
+    ASSERT_TRUE(CompiledNetworkCache::createKey(modelFiles, "CPU", {}, network, first));
+    ASSERT_TRUE(CompiledNetworkCache::createKey(modelFiles, "CPU", {}, network, second));
+    EXPECT_FALSE(first.empty());
+    EXPECT_EQ(first, second);
+}
+
+TEST_F(CompiledNetworkCacheTest, KeyDependsOnDevicePluginConfigAndShape) {
+    std::string key, otherKey;
+    ASSERT_TRUE(CompiledNetworkCache::createKey(modelFiles, "CPU", {}, network, key));
+    ASSERT_TRUE(CompiledNetworkCache::createKey(modelFiles, "GPU", {}, network, otherKey));
+    EXPECT_NE(key, otherKey);
+    ASSERT_TRUE(CompiledNetworkCache::createKey(modelFiles, "CPU", {{"CPU_THROUGHPUT_STREAMS", "2"}}, network, otherKey));
+    EXPECT_NE(key, otherKey);
+    network.setBatchSize(2);
+    ASSERT_TRUE(CompiledNetworkCache::createKey(modelFiles, "CPU", {}, network, otherKey));
+    EXPECT_NE(key, otherKey);
+}
+
+TEST_F(CompiledNetworkCacheTest, KeyDependsOnModelFilesContent) {
+    const std::string copiedXml = directoryPath + "/dummy.xml";
+    const std::string copiedBin = directoryPath + "/dummy.bin";
+    std::filesystem::copy_file(modelFiles[0], copiedXml);
+    std::filesystem::copy_file(modelFiles[1], copiedBin);
+    std::string key, otherKey;
+    ASSERT_TRUE(CompiledNetworkCache::createKey(modelFiles, "CPU", {}, network, key));
+    ASSERT_TRUE(CompiledNetworkCache::createKey({copiedXml, copiedBin}, "CPU", {}, network, otherKey));
+    EXPECT_EQ(key, otherKey) << "Key should not depend on model location";
+
+    std::ofstream(copiedBin, std::ios::binary | std::ios::app) << "modified";
+    ASSERT_TRUE(CompiledNetworkCache::createKey({copiedXml, copiedBin}, "CPU", {}, network, otherKey));
+    EXPECT_NE(key, otherKey);
+}
+
+TEST_F(CompiledNetworkCacheTest, KeyCreationReadsOnlyChangedModelFiles) {
+    const std::string copiedXml = directoryPath + "/dummy.xml";
+    const std::string copiedBin = directoryPath + "/dummy.bin";
+    std::filesystem::copy_file(modelFiles[0], copiedXml);
+    std::filesystem::copy_file(modelFiles[1], copiedBin);
+    auto& digests = ovms::FileDigestCache::instance();
+    std::string key;
+    ASSERT_TRUE(CompiledNetworkCache::createKey({copiedXml, copiedBin}, "CPU", {}, network, key));
+    auto fileReads = digests.getFileReads();
+    ASSERT_TRUE(CompiledNetworkCache::createKey({copiedXml, copiedBin}, "CPU", {}, network, key));
+    EXPECT_EQ(digests.getFileReads(), fileReads);
+
+    std::ofstream(copiedBin, std::ios::binary | std::ios::app) << "modified";
+    ASSERT_TRUE(CompiledNetworkCache::createKey({copiedXml, copiedBin}, "CPU", {}, network, key));
+    EXPECT_EQ(digests.getFileReads(), fileReads + 1);
+}
+
+TEST_F(CompiledNetworkCacheTest, KeyCreationFailsForMissingModelFile) {
+    std::string key;
+    EXPECT_FALSE(CompiledNetworkCache::createKey({directoryPath + "/missing.bin"}, "CPU", {}, network, key));
+}
+
+TEST_F(CompiledNetworkCacheTest, MissingEntryIsMiss) {
+    ovms::MetricsRegistry registry;
+    CompiledNetworkCache cache(directoryPath, 0, registry);
+    std::shared_ptr<InferenceEngine::ExecutableNetwork> execNetwork;
+    EXPECT_FALSE(cache.importNetwork("0123456789abcdef", engine, "CPU", {}, execNetwork));
+    EXPECT_EQ(execNetwork, nullptr);
+    EXPECT_EQ(cache.getMisses(), 1);
+    EXPECT_EQ(cache.getHits(), 0);
+    auto misses = registry.getCounter("ovms_compiled_network_cache_requests_total", "", {{"result", "miss"}});
+    EXPECT_EQ(misses->get(), 1);
+}
+
+TEST_F(CompiledNetworkCacheTest, CorruptedEntryIsRemoved) {
+    ovms::MetricsRegistry registry;
+    CompiledNetworkCache cache(directoryPath, 0, registry);
+    const std::string entryPath = directoryPath + "/0123456789abcdef" + CompiledNetworkCache::ENTRY_EXTENSION;
+    std::ofstream(entryPath, std::ios::binary) << "not a compiled network";
+    std::shared_ptr<InferenceEngine::ExecutableNetwork> execNetwork;
+    EXPECT_FALSE(cache.importNetwork("0123456789abcdef", engine, "CPU", {}, execNetwork));
+    EXPECT_EQ(cache.getMisses(), 1);
+    EXPECT_FALSE(std::filesystem::exists(entryPath));
+}
@@ -0,0 +1,52 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../coreregistry.hpp"
+
+using ovms::CoreRegistry;
+
+TEST(CoreRegistry, SameCoreIsReturnedForSameExtension) {
+    CoreRegistry registry;
+    auto core = registry.getCore("");
+    ASSERT_NE(core, nullptr);
+    EXPECT_EQ(core, registry.getCore(""));
+    EXPECT_EQ(registry.getCoresCount(), 1);
+}
+
+TEST(CoreRegistry, CoreIsCreatedOnceForConcurrentRequests) {
+    CoreRegistry registry;
+    std::vector<std::future<std::shared_ptr<InferenceEngine::Core>>> cores;
+    for (int i = 0; i < 8; i++) {
+        cores.emplace_back(std::async(std::launch::async, [&registry]() { return registry.getCore(""); }));
+    }
+    auto first = cores[0].get();
+    for (size_t i = 1; i < cores.size(); i++) {
+        EXPECT_EQ(first, cores[i].get());
+    }
+    EXPECT_EQ(registry.getCoresCount(), 1);
+}
+
+TEST(CoreRegistry, InvalidExtensionThrows) {
+    CoreRegistry registry;
+    EXPECT_ANY_THROW(registry.getCore("/nonexisting/libextension.so"));
+    EXPECT_EQ(registry.getCoresCount(), 0);
+}
@@ -0,0 +1,79 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../crc32c.hpp"
+
+using ovms::Crc32c;
+
+namespace {
+uint32_t computeCrc32c(const std::string& data) {
+    Crc32c checksum;
+    checksum.update(data.data(), data.size());
+    return checksum.get();
+}
+}  // namespace
+
+TEST(Crc32c, MatchesKnownValues) {
+    EXPECT_EQ(computeCrc32c(""), 0);
+    EXPECT_EQ(computeCrc32c("123456789"), 0xE3069283);
+    EXPECT_EQ(computeCrc32c(std::string(32, '\0')), 0x8A9136AA);
+}
+
+TEST(Crc32c, IncrementalUpdatesMatchSingleUpdate) {
+    std::string data(1001, '\0');
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<char>(i * 7 + 3);
+    }
+    Crc32c checksum;
+    for (size_t offset = 0; offset < data.size(); offset += 13) {
+        checksum.update(data.data() + offset, std::min<size_t>(13, data.size() - offset));
+    }
+    EXPECT_EQ(checksum.get(), computeCrc32c(data));
+}
+
+TEST(Crc32c, CombinesChecksumsOfConsecutiveParts) {
+    std::string data(100003, '\0');
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<char>(i * 31 + 5);
+    }
+    for (size_t split : {size_t(0), size_t(1), size_t(4096), size_t(99999), data.size()}) {
+        auto first = computeCrc32c(data.substr(0, split));
+        auto second = computeCrc32c(data.substr(split));
+        EXPECT_EQ(Crc32c::combine(first, second, data.size() - split), computeCrc32c(data)) << split;
+    }
+}
+
+TEST(Crc32c, ParsesHexString) {
+    uint32_t crc = 0;
+    ASSERT_TRUE(Crc32c::fromHexString("E3069283", crc));
+    EXPECT_EQ(crc, 0xE3069283);
+    EXPECT_EQ(Crc32c(crc).toHexString(), "e3069283");
+    EXPECT_FALSE(Crc32c::fromHexString("e306928", crc));
+    EXPECT_FALSE(Crc32c::fromHexString("e306928g", crc));
+}
+
+TEST(Crc32c, ParsesBase64OfBigEndianBytes) {
+    uint32_t crc = 0;
+    ASSERT_TRUE(Crc32c::fromBase64("4waSgw==", crc));
+    EXPECT_EQ(crc, 0xE3069283);
+    EXPECT_FALSE(Crc32c::fromBase64("", crc));
+    EXPECT_FALSE(Crc32c::fromBase64("4waSgw", crc));
+    EXPECT_FALSE(Crc32c::fromBase64("4wa*gw==", crc));
+}
@@ -18,13 +18,18 @@
 #include <filesystem>
 #include <fstream>
 #include <future>
+#include <iterator>
+#include <memory>
 #include <thread>
+#include <vector>
 
+#include <dlfcn.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <inference_engine.hpp>
 #include <stdlib.h>
 
+#include "../customloaders.hpp"
 #include "../executinstreamidguard.hpp"
 #include "../get_model_metadata_impl.hpp"
 #include "../localfilesystem.hpp"
@@ -1010,4 +1015,106 @@ TEST_F(TestCustomLoader, CustomLoaderMultipleLoaderWithSameLoaderName) {
     performPredict("dummy", 1, request);
 }
 
+namespace {
+/**
+ * @brief Loader implementing only interface version 1, which returns model and weights copied into vectors
+ */
+class CustomLoaderV1 : public CustomLoaderInterface {
+    static bool readFile(const std::string& path, std::vector<uint8_t>& content) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.good()) {
+            return false;
+        }
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+public:
+    CustomLoaderStatus loaderInit(const std::string& loaderConfigFile) override {
+        return CustomLoaderStatus::OK;
+    }
+    CustomLoaderStatus loadModel(const std::string& modelName, const std::string& basePath, const int version,
+        const std::string& loaderOptions, std::vector<uint8_t>& model, std::vector<uint8_t>& weights) override {
+        const std::string versionPath = basePath + "/" + std::to_string(version) + "/";
+        if (!readFile(versionPath + "dummy.xml", model) || !readFile(versionPath + "dummy.bin", weights)) {
+            return CustomLoaderStatus::MODEL_LOAD_ERROR;
+        }
+        return CustomLoaderStatus::MODEL_TYPE_IR;
+    }
+    CustomLoaderStatus unloadModel(const std::string& modelName, const int version) override {
+        return CustomLoaderStatus::OK;
+    }
+    CustomLoaderStatus retireModel(const std::string& modelName) override {
+        return CustomLoaderStatus::OK;
+    }
+    CustomLoaderStatus loaderDeInit() override {
+        return CustomLoaderStatus::OK;
+    }
+};
+}  // namespace
+
+TEST_F(TestCustomLoader, CustomLoaderVersion1Prediction) {
+    const char* custom_loader_v1_config_model = R"({
+      "model_config_list":[
+        {
+          "config":{
+            "name":"dummy",
+            "base_path": "/tmp/test_cl_models/model1",
+            "nireq": 1,
+            "custom_loader_options": {"loader_name":  "loader-v1"}
+          }
+        }
+      ]
+    })";
+    // Loaders without custom_loader_config_list in config file are kept
+    auto& customloaders = CustomLoaders::instance();
+    ASSERT_EQ(customloaders.add("loader-v1", std::make_shared<CustomLoaderV1>(), nullptr), ovms::StatusCode::OK);
+    customloaders.finalize();
+    ASSERT_NE(customloaders.find("loader-v1"), nullptr);
+    ASSERT_EQ(customloaders.findV2("loader-v1"), nullptr);
+
+    // Copy dummy model to temporary destination
+    std::filesystem::copy("/ovms/src/test/dummy", cl_model_1_path, std::filesystem::copy_options::recursive);
+
+    // Replace model path in the config string
+    std::string configStr = custom_loader_v1_config_model;
+    configStr.replace(configStr.find("/tmp/test_cl_models"), std::string("/tmp/test_cl_models").size(), cl_models_path);
+
+    // Create config file
+    std::string fileToReload = cl_models_path + "/cl_config.json";
+    createConfigFileWithContent(configStr, fileToReload);
+
+    ASSERT_EQ(manager.startFromFile(fileToReload), ovms::StatusCode::OK);
+    tensorflow::serving::PredictRequest request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME,
+            std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 10}, tensorflow::DataType::DT_FLOAT}}});
+    performPredict("dummy", 1, request);
+}
+
+TEST(CustomLoaderInterfaceVersion, SampleLoaderImplementsVersion2) {
+    void* library = dlopen("/ovms/bazel-bin/src/libsampleloader.so", RTLD_LAZY | RTLD_LOCAL);
+    ASSERT_NE(library, nullptr) << dlerror();
+    EXPECT_EQ(CustomLoaders::detectInterfaceVersion(library), CUSTOM_LOADER_INTERFACE_VERSION);
+    dlclose(library);
+}
+
+TEST(CustomLoaderInterfaceVersion, LibraryWithoutVersionIsVersion1) {
+    void* library = dlopen(nullptr, RTLD_LAZY);
+    ASSERT_NE(library, nullptr);
+    EXPECT_EQ(CustomLoaders::detectInterfaceVersion(library), 1);
+    dlclose(library);
+}
+
+TEST(CustomLoaderModelBuffers, AllocatedWeightsAreOwnedByBuffers) {
+    CustomLoaderModelBuffers buffers;
+    uint8_t* weights = buffers.allocateWeights(16);
+    ASSERT_NE(weights, nullptr);
+    std::memset(weights, 7, 16);
+    EXPECT_EQ(buffers.weights.get(), weights);
+    EXPECT_EQ(buffers.weightsSize, 16);
+    std::shared_ptr<const void> networkReference = buffers.weights;
+    buffers.weights.reset();
+    EXPECT_EQ(static_cast<const uint8_t*>(networkReference.get())[15], 7);
+}
+
 #pragma GCC diagnostic pop
@@ -0,0 +1,430 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../custom_node.hpp"
+#include "../customnodelibrarymanager.hpp"
+#include "../entry_node.hpp"
+#include "../exit_node.hpp"
+#include "../modelmanager.hpp"
+#include "../node_library_utils.hpp"
+#include "../pipeline.hpp"
+#include "../pipeline_factory.hpp"
+#include "../schema.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+using namespace tensorflow;
+using namespace tensorflow::serving;
+
+static const std::string SAMPLE_CUSTOM_NODE_LIBRARY_PATH = "/ovms/bazel-bin/src/libsamplecustomnode.so";
+static const std::string SAMPLE_CUSTOM_NODE_INPUT_NAME = "input_numbers";
+static const std::string SAMPLE_CUSTOM_NODE_OUTPUT_NAME = "output_numbers";
+
+class CustomNodeLibraryManagerTest : public ::testing::Test {};
+
+TEST_F(CustomNodeLibraryManagerTest, LoadSampleLibrary) {
+    CustomNodeLibraryManager manager;
+    ASSERT_EQ(manager.loadLibrary("sample", SAMPLE_CUSTOM_NODE_LIBRARY_PATH), StatusCode::OK);
+    NodeLibrary library;
+    ASSERT_EQ(manager.getLibrary("sample", library), StatusCode::OK);
+    EXPECT_TRUE(library.isValid());
+}
+
+TEST_F(CustomNodeLibraryManagerTest, LoadSameLibraryTwice) {
+    CustomNodeLibraryManager manager;
+    ASSERT_EQ(manager.loadLibrary("sample", SAMPLE_CUSTOM_NODE_LIBRARY_PATH), StatusCode::OK);
+    EXPECT_EQ(manager.loadLibrary("sample", SAMPLE_CUSTOM_NODE_LIBRARY_PATH), StatusCode::OK);
+    EXPECT_EQ(manager.loadLibrary("sample", "/ovms/bazel-bin/src/libsampleloader.so"), StatusCode::NODE_LIBRARY_ALREADY_LOADED);
+}
+
+TEST_F(CustomNodeLibraryManagerTest, LoadNonExistingLibrary) {
+    CustomNodeLibraryManager manager;
+    EXPECT_EQ(manager.loadLibrary("sample", "/tmp/non_existing_library.so"), StatusCode::NODE_LIBRARY_LOAD_FAILED_OPEN);
+    NodeLibrary library;
+    EXPECT_EQ(manager.getLibrary("sample", library), StatusCode::NODE_LIBRARY_MISSING);
+    EXPECT_FALSE(library.isValid());
+}
+
+TEST_F(CustomNodeLibraryManagerTest, LoadLibraryWithMissingSymbols) {
+    CustomNodeLibraryManager manager;
+    EXPECT_EQ(manager.loadLibrary("loader", "/ovms/bazel-bin/src/libsampleloader.so"), StatusCode::NODE_LIBRARY_LOAD_FAILED_SYM);
+}
+
+TEST_F(CustomNodeLibraryManagerTest, LoadLibraryWithEscapedPath) {
+    CustomNodeLibraryManager manager;
+    EXPECT_EQ(manager.loadLibrary("sample", "/ovms/bazel-bin/src/../src/libsamplecustomnode.so"), StatusCode::PATH_INVALID);
+}
+
+TEST(NodeLibraryUtils, PrecisionConversion) {
+    const std::vector<InferenceEngine::Precision> precisions{
+        InferenceEngine::Precision::FP32,
+        InferenceEngine::Precision::FP16,
+        InferenceEngine::Precision::U8,
+        InferenceEngine::Precision::I8,
+        InferenceEngine::Precision::I16,
+        InferenceEngine::Precision::U16,
+        InferenceEngine::Precision::I32};
+    for (const auto& precision : precisions) {
+        EXPECT_EQ(toInferenceEnginePrecision(toCustomNodeTensorPrecision(precision)), precision);
+    }
+    EXPECT_EQ(toCustomNodeTensorPrecision(InferenceEngine::Precision::I64), CustomNodeTensorPrecision::UNSPECIFIED);
+}
+
+TEST(NodeLibraryUtils, CreateCustomNodeParamArray) {
+    EXPECT_EQ(createCustomNodeParamArray({}), nullptr);
+    parameters_t parameters{{"add_value", "2.5"}};
+    auto params = createCustomNodeParamArray(parameters);
+    ASSERT_NE(params, nullptr);
+    EXPECT_EQ(std::string(params[0].key), "add_value");
+    EXPECT_EQ(std::string(params[0].value), "2.5");
+}
+
+class CustomNodeFlowTest : public TestWithTempDir {
+protected:
+    void SetUp() override {
+        TestWithTempDir::SetUp();
+        prepareRequest(requestData, 1);
+    }
+
+    void prepareRequest(const std::vector<float>& data, size_t batchSize) {
+        tensorflow::TensorProto& proto = (*request.mutable_inputs())[pipelineInputName];
+        proto.Clear();
+        proto.set_dtype(tensorflow::DataType::DT_FLOAT);
+        proto.mutable_tensor_content()->assign((char*)data.data(), data.size() * sizeof(float));
+        proto.mutable_tensor_shape()->add_dim()->set_size(batchSize);
+        proto.mutable_tensor_shape()->add_dim()->set_size(DUMMY_MODEL_INPUT_SIZE);
+    }
+
+    void checkResponse(float expectedDifference) {
+        checkResponse(requestData, 1, expectedDifference);
+    }
+
+    void checkResponse(const std::vector<float>& data, size_t batchSize, float expectedDifference) {
+        ASSERT_EQ(response.outputs().count(pipelineOutputName), 1);
+        const auto& proto = response.outputs().at(pipelineOutputName);
+        ASSERT_EQ(proto.tensor_shape().dim_size(), 2);
+        EXPECT_EQ(proto.tensor_shape().dim(0).size(), batchSize);
+        ASSERT_EQ(proto.tensor_content().size(), data.size() * sizeof(float));
+        const float* actual = (const float*)proto.tensor_content().data();
+        for (size_t i = 0; i < data.size(); i++) {
+            EXPECT_FLOAT_EQ(actual[i], data[i] + expectedDifference) << "at place: " << i;
+        }
+    }
+
+    PredictRequest request;
+    PredictResponse response;
+
+    const std::string pipelineInputName = "pipeline_input";
+    const std::string pipelineOutputName = "pipeline_output";
+    const std::vector<float> requestData{-5.0, 3.0, 0.0, -12.0, 9.0, -100.0, 102.0, 92.0, -1.0, 12.0};
+};
+
+TEST_F(CustomNodeFlowTest, CustomNodeThenDummyModel) {
+    // request   custom_node   dummy_node   response
+    //  O----------->O------------>O---------->O
+    ConstructorEnabledModelManager manager;
+    ModelConfig config = DUMMY_MODEL_CONFIG;
+    manager.reloadModelWithVersions(config);
+
+    CustomNodeLibraryManager libraryManager;
+    ASSERT_EQ(libraryManager.loadLibrary("sample", SAMPLE_CUSTOM_NODE_LIBRARY_PATH), StatusCode::OK);
+    NodeLibrary library;
+    ASSERT_EQ(libraryManager.getLibrary("sample", library), StatusCode::OK);
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, ENTRY_NODE_NAME, "", std::nullopt, {{pipelineInputName, pipelineInputName}}},
+        {NodeKind::CUSTOM, "custom_node", "", std::nullopt, {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, SAMPLE_CUSTOM_NODE_OUTPUT_NAME}}, library, {{"add_value", "3.5"}, {"sub_value", "1.0"}}},
+        {NodeKind::DL, "dummy_node", "dummy", std::nullopt, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_OUTPUT_NAME}}},
+        {NodeKind::EXIT, EXIT_NODE_NAME},
+    };
+
+    pipeline_connections_t connections;
+    connections["custom_node"] = {
+        {ENTRY_NODE_NAME, {{pipelineInputName, SAMPLE_CUSTOM_NODE_INPUT_NAME}}}};
+    connections["dummy_node"] = {
+        {"custom_node", {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}}}};
+    connections[EXIT_NODE_NAME] = {
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, pipelineOutputName}}}};
+
+    PipelineFactory factory;
+    ASSERT_EQ(factory.createDefinition("custom_pipeline", info, connections, manager), StatusCode::OK);
+
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(factory.create(pipeline, "custom_pipeline", &request, &response, manager), StatusCode::OK);
+    ASSERT_EQ(pipeline->execute(), StatusCode::OK);
+    // custom node adds 3.5 and subtracts 1.0, dummy model adds 1.0
+    checkResponse(3.5f);
+}
+
+TEST_F(CustomNodeFlowTest, CustomNodeWithInvalidLibraryFailsValidation) {
+    ConstructorEnabledModelManager manager;
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, ENTRY_NODE_NAME, "", std::nullopt, {{pipelineInputName, pipelineInputName}}},
+        {NodeKind::CUSTOM, "custom_node", "", std::nullopt, {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, SAMPLE_CUSTOM_NODE_OUTPUT_NAME}}, NodeLibrary{}},
+        {NodeKind::EXIT, EXIT_NODE_NAME},
+    };
+
+    pipeline_connections_t connections;
+    connections["custom_node"] = {
+        {ENTRY_NODE_NAME, {{pipelineInputName, SAMPLE_CUSTOM_NODE_INPUT_NAME}}}};
+    connections[EXIT_NODE_NAME] = {
+        {"custom_node", {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, pipelineOutputName}}}};
+
+    PipelineFactory factory;
+    EXPECT_EQ(factory.createDefinition("custom_pipeline", info, connections, manager), StatusCode::PIPELINE_DEFINITION_INVALID_NODE_LIBRARY);
+}
+
+TEST_F(CustomNodeFlowTest, CustomNodeMissingLibraryOutputFailsValidation) {
+    ConstructorEnabledModelManager manager;
+    CustomNodeLibraryManager libraryManager;
+    ASSERT_EQ(libraryManager.loadLibrary("sample", SAMPLE_CUSTOM_NODE_LIBRARY_PATH), StatusCode::OK);
+    NodeLibrary library;
+    ASSERT_EQ(libraryManager.getLibrary("sample", library), StatusCode::OK);
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, ENTRY_NODE_NAME, "", std::nullopt, {{pipelineInputName, pipelineInputName}}},
+        {NodeKind::CUSTOM, "custom_node", "", std::nullopt, {{"non_existing_output", "non_existing_output"}}, library},
+        {NodeKind::EXIT, EXIT_NODE_NAME},
+    };
+
+    pipeline_connections_t connections;
+    connections["custom_node"] = {
+        {ENTRY_NODE_NAME, {{pipelineInputName, SAMPLE_CUSTOM_NODE_INPUT_NAME}}}};
+    connections[EXIT_NODE_NAME] = {
+        {"custom_node", {{"non_existing_output", pipelineOutputName}}}};
+
+    PipelineFactory factory;
+    EXPECT_EQ(factory.createDefinition("custom_pipeline", info, connections, manager), StatusCode::PIPELINE_NODE_REFERING_TO_MISSING_DATA_SOURCE);
+}
+
+static const char* pipelineCustomNodeConfig = R"(
+{
+    "model_config_list": [],
+    "custom_node_library_config_list": [
+        {
+            "name": "sample",
+            "base_path": "/ovms/bazel-bin/src/libsamplecustomnode.so"
+        }
+    ],
+    "pipeline_config_list": [
+        {
+            "name": "custom_pipeline",
+            "inputs": ["pipeline_input"],
+            "nodes": [
+                {
+                    "name": "custom_node",
+                    "library_name": "sample",
+                    "type": "custom",
+                    "params": {
+                        "add_value": "2.0",
+                        "sub_value": "0.5"
+                    },
+                    "inputs": [
+                        {"input_numbers": {"node_name": "request",
+                                           "data_item": "pipeline_input"}}
+                    ],
+                    "outputs": [
+                        {"data_item": "output_numbers",
+                         "alias": "custom_output"}
+                    ]
+                }
+            ],
+            "outputs": [
+                {"pipeline_output": {"node_name": "custom_node",
+                                     "data_item": "custom_output"}
+                }
+            ]
+        }
+    ]
+})";
+
+TEST_F(CustomNodeFlowTest, CustomNodeFromConfigFile) {
+    std::string fileToReload = directoryPath + "/ovms_config_file.json";
+    createConfigFileWithContent(pipelineCustomNodeConfig, fileToReload);
+    ConstructorEnabledModelManager manager;
+    ASSERT_EQ(manager.loadConfig(fileToReload), StatusCode::OK);
+
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(manager.createPipeline(pipeline, "custom_pipeline", &request, &response), StatusCode::OK);
+    ASSERT_EQ(pipeline->execute(), StatusCode::OK);
+    checkResponse(1.5f);
+}
+
+TEST_F(CustomNodeFlowTest, CustomNodeFromConfigFileWithNonStringParameter) {
+    std::string config = pipelineCustomNodeConfig;
+    const std::string stringParameter = "\"add_value\": \"2.0\"";
+    config.replace(config.find(stringParameter), stringParameter.size(), "\"add_value\": 2.0");
+    std::string fileToReload = directoryPath + "/ovms_config_file.json";
+    createConfigFileWithContent(config, fileToReload);
+    ConstructorEnabledModelManager manager;
+    ASSERT_EQ(manager.loadConfig(fileToReload), StatusCode::JSON_INVALID);
+
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(manager.createPipeline(pipeline, "custom_pipeline", &request, &response), StatusCode::PIPELINE_DEFINITION_NAME_MISSING);
+}
+
+class DemultiplexerFlowTest : public CustomNodeFlowTest {
+protected:
+    void SetUp() override {
+        CustomNodeFlowTest::SetUp();
+        prepareRequest(batchedRequestData, batchSize);
+        ModelConfig config = DUMMY_MODEL_CONFIG;
+        manager.reloadModelWithVersions(config);
+        ASSERT_EQ(libraryManager.loadLibrary("sample", SAMPLE_CUSTOM_NODE_LIBRARY_PATH), StatusCode::OK);
+        ASSERT_EQ(libraryManager.getLibrary("sample", library), StatusCode::OK);
+    }
+
+    // request   demultiplexer   dummy_node   (gather_node)   response
+    //  O------------->O------------>O------------->O------------>O
+    void prepareDefinition(std::optional<int32_t> demultiplyCount, bool withGatherNode) {
+        info = {
+            {NodeKind::ENTRY, ENTRY_NODE_NAME, "", std::nullopt, {{pipelineInputName, pipelineInputName}}},
+            {NodeKind::CUSTOM, "demultiplexer", "", std::nullopt, {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, SAMPLE_CUSTOM_NODE_OUTPUT_NAME}}, library, {{"add_value", "2.0"}}, demultiplyCount},
+            {NodeKind::DL, "dummy_node", "dummy", std::nullopt, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_OUTPUT_NAME}}},
+            {NodeKind::EXIT, EXIT_NODE_NAME},
+        };
+        connections.clear();
+        connections["demultiplexer"] = {
+            {ENTRY_NODE_NAME, {{pipelineInputName, SAMPLE_CUSTOM_NODE_INPUT_NAME}}}};
+        connections["dummy_node"] = {
+            {"demultiplexer", {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}}}};
+        if (withGatherNode) {
+            info.emplace_back(NodeKind::CUSTOM, "gather_node", "", std::nullopt, std::unordered_map<std::string, std::string>{{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, SAMPLE_CUSTOM_NODE_OUTPUT_NAME}},
+                library, parameters_t{{"sub_value", "0.5"}}, std::nullopt, std::string("demultiplexer"));
+            connections["gather_node"] = {
+                {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, SAMPLE_CUSTOM_NODE_INPUT_NAME}}}};
+            connections[EXIT_NODE_NAME] = {
+                {"gather_node", {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, pipelineOutputName}}}};
+        } else {
+            connections[EXIT_NODE_NAME] = {
+                {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, pipelineOutputName}}}};
+        }
+    }
+
+    ConstructorEnabledModelManager manager;
+    CustomNodeLibraryManager libraryManager;
+    NodeLibrary library;
+    std::vector<NodeInfo> info;
+    pipeline_connections_t connections;
+    PipelineFactory factory;
+
+    static constexpr size_t batchSize = 3;
+    const std::vector<float> batchedRequestData{
+        -5.0, 3.0, 0.0, -12.0, 9.0, -100.0, 102.0, 92.0, -1.0, 12.0,
+        1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0,
+        -1.0, -2.0, -3.0, -4.0, -5.0, -6.0, -7.0, -8.0, -9.0, -10.0};
+};
+
+TEST_F(DemultiplexerFlowTest, DynamicDemultiplexerGatheredByResponse) {
+    prepareDefinition(-1, false);
+    ASSERT_EQ(factory.createDefinition("demultiplexed_pipeline", info, connections, manager), StatusCode::OK);
+
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(factory.create(pipeline, "demultiplexed_pipeline", &request, &response, manager), StatusCode::OK);
+    ASSERT_EQ(pipeline->execute(), StatusCode::OK);
+    // demultiplexer adds 2.0, each dummy model execution adds 1.0
+    checkResponse(batchedRequestData, batchSize, 3.0f);
+}
+
+TEST_F(DemultiplexerFlowTest, FixedDemultiplexerGatheredByNode) {
+    prepareDefinition(batchSize, true);
+    ASSERT_EQ(factory.createDefinition("demultiplexed_pipeline", info, connections, manager), StatusCode::OK);
+
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(factory.create(pipeline, "demultiplexed_pipeline", &request, &response, manager), StatusCode::OK);
+    ASSERT_EQ(pipeline->execute(), StatusCode::OK);
+    // gather node subtracts 0.5 from gathered results
+    checkResponse(batchedRequestData, batchSize, 2.5f);
+}
+
+TEST_F(DemultiplexerFlowTest, DemultiplyCountNotMatchingBatchSize) {
+    prepareDefinition(batchSize + 1, false);
+    ASSERT_EQ(factory.createDefinition("demultiplexed_pipeline", info, connections, manager), StatusCode::OK);
+
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(factory.create(pipeline, "demultiplexed_pipeline", &request, &response, manager), StatusCode::OK);
+    EXPECT_EQ(pipeline->execute(), StatusCode::PIPELINE_DEMULTIPLY_COUNT_DOES_NOT_MATCH_BLOB_BATCH_SIZE);
+}
+
+TEST_F(DemultiplexerFlowTest, InvalidDemultiplyCount) {
+    prepareDefinition(0, false);
+    EXPECT_EQ(factory.createDefinition("demultiplexed_pipeline", info, connections, manager), StatusCode::PIPELINE_INVALID_DEMULTIPLY_COUNT);
+}
+
+TEST_F(DemultiplexerFlowTest, GatherFromNodeWhichIsNotDemultiplexer) {
+    prepareDefinition(std::nullopt, true);
+    EXPECT_EQ(factory.createDefinition("demultiplexed_pipeline", info, connections, manager), StatusCode::PIPELINE_NODE_GATHER_FROM_NOT_DEMULTIPLEXER);
+}
+
+TEST_F(DemultiplexerFlowTest, GatherNodeDirectlyAfterDemultiplexer) {
+    prepareDefinition(-1, true);
+    connections["gather_node"] = {
+        {"demultiplexer", {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, SAMPLE_CUSTOM_NODE_INPUT_NAME}}}};
+    connections[EXIT_NODE_NAME] = {
+        {"gather_node", {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, pipelineOutputName}}},
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, "dummy_output"}}}};
+    EXPECT_EQ(factory.createDefinition("demultiplexed_pipeline", info, connections, manager), StatusCode::PIPELINE_WRONG_DEMULTIPLEXER_GATHER_NODES_ORDER);
+}
+
+TEST_F(DemultiplexerFlowTest, NestedDemultiplexer) {
+    prepareDefinition(-1, false);
+    info.emplace_back(NodeKind::CUSTOM, "nested_demultiplexer", "", std::nullopt, std::unordered_map<std::string, std::string>{{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, SAMPLE_CUSTOM_NODE_OUTPUT_NAME}},
+        library, parameters_t{}, -1);
+    connections["nested_demultiplexer"] = {
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, SAMPLE_CUSTOM_NODE_INPUT_NAME}}}};
+    connections[EXIT_NODE_NAME] = {
+        {"nested_demultiplexer", {{SAMPLE_CUSTOM_NODE_OUTPUT_NAME, pipelineOutputName}}}};
+    EXPECT_EQ(factory.createDefinition("demultiplexed_pipeline", info, connections, manager), StatusCode::PIPELINE_NESTED_DEMULTIPLEXING_UNSUPPORTED);
+}
+
+TEST_F(DemultiplexerFlowTest, GatheredOutputsReportDynamicBatch) {
+    prepareDefinition(-1, false);
+    ASSERT_EQ(factory.createDefinition("demultiplexed_pipeline", info, connections, manager), StatusCode::OK);
+    auto definition = factory.findDefinitionByName("demultiplexed_pipeline");
+    ASSERT_NE(definition, nullptr);
+    tensor_map_t outputs;
+    ASSERT_EQ(definition->getOutputsInfo(outputs, manager), StatusCode::OK);
+    ASSERT_EQ(outputs.count(pipelineOutputName), 1);
+    EXPECT_EQ(outputs.at(pipelineOutputName)->getShape(), shape_t({0, DUMMY_MODEL_OUTPUT_SIZE}));
+}
+
+TEST(SchemaTest, PipelineConfigWithCustomNodeMatchingSchema) {
+    rapidjson::Document configParsed;
+    configParsed.Parse(pipelineCustomNodeConfig);
+    auto result = ovms::validateJsonAgainstSchema(configParsed, ovms::MODELS_CONFIG_SCHEMA);
+    EXPECT_EQ(result, ovms::StatusCode::OK);
+}
+
+TEST(SchemaTest, CustomNodeLibraryConfigMissingBasePath) {
+    const char* config = R"(
+    {
+        "model_config_list": [],
+        "custom_node_library_config_list": [
+            {"name": "sample"}
+        ]
+    })";
+    rapidjson::Document configParsed;
+    configParsed.Parse(config);
+    auto result = ovms::validateJsonAgainstSchema(configParsed, ovms::MODELS_CONFIG_SCHEMA);
+    EXPECT_EQ(result, ovms::StatusCode::JSON_INVALID);
+}
@@ -0,0 +1,104 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../downloadscheduler.hpp"
+
+using ovms::DownloadPriority;
+using ovms::DownloadScheduler;
+
+namespace {
+void waitForWaitingCount(DownloadScheduler& scheduler, size_t count) {
+    while (scheduler.getWaitingCount() != count) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+}  // namespace
+
+TEST(DownloadScheduler, LimitsConcurrentConnections) {
+    DownloadScheduler scheduler(2, 0);
+    scheduler.acquire(DownloadPriority::NORMAL);
+    scheduler.acquire(DownloadPriority::NORMAL);
+    EXPECT_EQ(scheduler.getActiveConnections(), 2);
+
+    std::thread waiter([&scheduler]() {
+        DownloadScheduler::Connection connection(&scheduler, DownloadPriority::NORMAL);
+    });
+    waitForWaitingCount(scheduler, 1);
+    EXPECT_EQ(scheduler.getActiveConnections(), 2);
+
+    scheduler.release();
+    waiter.join();
+    EXPECT_EQ(scheduler.getWaitingCount(), 0);
+    EXPECT_EQ(scheduler.getActiveConnections(), 1);
+    scheduler.release();
+}
+
+TEST(DownloadScheduler, HighPriorityIsGrantedFirst) {
+    DownloadScheduler scheduler(1, 0);
+    scheduler.acquire(DownloadPriority::NORMAL);
+
+    std::mutex mtx;
+    std::vector<DownloadPriority> granted;
+    auto download = [&](DownloadPriority priority) {
+        DownloadScheduler::Connection connection(&scheduler, priority);
+        std::unique_lock lock(mtx);
+        granted.push_back(priority);
+    };
+    std::thread normal(download, DownloadPriority::NORMAL);
+    waitForWaitingCount(scheduler, 1);
+    std::thread high(download, DownloadPriority::HIGH);
+    waitForWaitingCount(scheduler, 2);
+
+    scheduler.release();
+    normal.join();
+    high.join();
+    EXPECT_EQ(granted, std::vector<DownloadPriority>({DownloadPriority::HIGH, DownloadPriority::NORMAL}));
+}
+
+TEST(DownloadScheduler, ZeroConnectionsMeansUnlimited) {
+    DownloadScheduler scheduler(0, 0);
+    for (int i = 0; i < 100; i++) {
+        scheduler.acquire(DownloadPriority::NORMAL);
+    }
+    EXPECT_EQ(scheduler.getActiveConnections(), 100);
+}
+
+TEST(DownloadScheduler, ThrottleKeepsThroughputWithinLimit) {
+    DownloadScheduler scheduler(0, 10 * 1024 * 1024);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; i++) {
+        scheduler.throttle(1024 * 1024);
+    }
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(290));
+}
+
+TEST(DownloadScheduler, PriorityScopeIsRestored) {
+    EXPECT_EQ(DownloadScheduler::getCurrentPriority(), DownloadPriority::NORMAL);
+    {
+        DownloadScheduler::PriorityScope scope(DownloadPriority::HIGH);
+        EXPECT_EQ(DownloadScheduler::getCurrentPriority(), DownloadPriority::HIGH);
+        std::thread([]() {
+            EXPECT_EQ(DownloadScheduler::getCurrentPriority(), DownloadPriority::NORMAL);
+        }).join();
+    }
+    EXPECT_EQ(DownloadScheduler::getCurrentPriority(), DownloadPriority::NORMAL);
+}
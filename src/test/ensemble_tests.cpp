@@ -13,7 +13,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <sstream>
+#include <thread>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -21,7 +25,6 @@
 #include "../modelconfig.hpp"
 #include "../pipeline.hpp"
 #include "../pipeline_factory.hpp"
-#define DEBUG
 #include <cstdio>
 
 #include <stdlib.h>
@@ -31,7 +34,7 @@
 #include "../modelinstance.hpp"
 #include "../prediction_service_utils.hpp"
 #include "../status.hpp"
-#include "../timer.hpp"
+#include "../tracing.hpp"
 #include "test_utils.hpp"
 
 using namespace ovms;
@@ -206,8 +209,10 @@ TEST_F(EnsembleFlowTest, DummyModelDirectAndPipelineInference) {
 TEST_F(EnsembleFlowTest, SeriesOfDummyModels) {
     // Most basic configuration, just process single dummy model request
 
-    Timer timer;
-    timer.start("prepare pipeline");
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::steady_clock;
+    auto prepareStart = steady_clock::now();
 
     const int N = 100;
     // input      dummy x N      output
@@ -238,18 +243,16 @@ TEST_F(EnsembleFlowTest, SeriesOfDummyModels) {
         pipeline.push(std::move(dummy_node));
     }
 
-    timer.stop("prepare pipeline");
-    timer.start("pipeline::execute");
+    auto executeStart = steady_clock::now();
     pipeline.execute();
-    timer.stop("pipeline::execute");
 
-    timer.start("compare results");
+    auto compareStart = steady_clock::now();
     checkDummyResponse(N);
-    timer.stop("compare results");
+    auto compareEnd = steady_clock::now();
 
-    std::cout << "prepare pipeline: " << timer.elapsed<std::chrono::microseconds>("prepare pipeline") / 1000 << "ms\n";
-    std::cout << "pipeline::execute: " << timer.elapsed<std::chrono::microseconds>("pipeline::execute") / 1000 << "ms\n";
-    std::cout << "compare results: " << timer.elapsed<std::chrono::microseconds>("compare results") / 1000 << "ms\n";
+    std::cout << "prepare pipeline: " << duration_cast<microseconds>(executeStart - prepareStart).count() / 1000.0 << "ms\n";
+    std::cout << "pipeline::execute: " << duration_cast<microseconds>(compareStart - executeStart).count() / 1000.0 << "ms\n";
+    std::cout << "compare results: " << duration_cast<microseconds>(compareEnd - compareStart).count() / 1000.0 << "ms\n";
 }
 
 TEST_F(EnsembleFlowTest, ExecutePipelineWithDynamicBatchSize) {
@@ -1512,6 +1515,118 @@ TEST_F(EnsembleFlowTest, PipelineFactoryCreationWithInputOutputsMappings) {
     managerWithDummyModel.join();
 }
 
+static const char* pipelineOneDummyAndUnusedModelConfig = R"(
+{
+    "model_config_list": [
+        {
+            "config": {
+                "name": "dummy",
+                "base_path": "/ovms/src/test/dummy",
+                "target_device": "CPU",
+                "model_version_policy": {"all": {}},
+                "nireq": 1
+            }
+        },
+        {
+            "config": {
+                "name": "unused",
+                "base_path": "/ovms/src/test/dummy",
+                "target_device": "CPU",
+                "model_version_policy": {"specific": {"versions": [1]}},
+                "nireq": 1
+            }
+        }
+    ],
+    "pipeline_config_list": [
+        {
+            "name": "pipeline1Dummy",
+            "inputs": ["custom_dummy_input"],
+            "nodes": [
+                {
+                    "name": "dummyNode",
+                    "model_name": "dummy",
+                    "type": "DL model",
+                    "inputs": [
+                        {"b": {"node_name": "request",
+                               "data_item": "custom_dummy_input"}}
+                    ],
+                    "outputs": [
+                        {"data_item": "a",
+                         "alias": "new_dummy_output"}
+                    ]
+                }
+            ],
+            "outputs": [
+                {"custom_dummy_output": {"node_name": "dummyNode",
+                                         "data_item": "new_dummy_output"}
+                }
+            ]
+        }
+    ]
+})";
+
+namespace {
+class ModelInstanceWaitingForPipeline : public ModelInstance {
+    const ModelManager& manager;
+
+public:
+    bool pipelineExistedDuringLoad = false;
+
+    ModelInstanceWaitingForPipeline(const std::string& name, model_version_t version, const ModelManager& manager) :
+        ModelInstance(name, version),
+        manager(manager) {}
+
+    ovms::Status loadModel(const ModelConfig& config) override {
+        for (int i = 0; i < 500 && !manager.pipelineDefinitionExists("pipeline1Dummy"); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        pipelineExistedDuringLoad = manager.pipelineDefinitionExists("pipeline1Dummy");
+        return ModelInstance::loadModel(config);
+    }
+};
+
+class ModelWaitingForPipeline : public Model {
+    const ModelManager& manager;
+
+public:
+    std::shared_ptr<ModelInstanceWaitingForPipeline> instance;
+
+    ModelWaitingForPipeline(const std::string& name, const ModelManager& manager) :
+        Model(name),
+        manager(manager) {}
+
+    std::shared_ptr<ModelInstance> modelInstanceFactory(const std::string& modelName, const model_version_t modelVersion) override {
+        instance = std::make_shared<ModelInstanceWaitingForPipeline>(modelName, modelVersion, manager);
+        return instance;
+    }
+};
+
+class ModelManagerWithModelWaitingForPipeline : public ConstructorEnabledModelManager {
+public:
+    std::shared_ptr<ModelWaitingForPipeline> unusedModel;
+
+    std::shared_ptr<Model> modelFactory(const std::string& name) override {
+        if (name != "unused") {
+            return ConstructorEnabledModelManager::modelFactory(name);
+        }
+        unusedModel = std::make_shared<ModelWaitingForPipeline>(name, *this);
+        return unusedModel;
+    }
+};
+}  // namespace
+
+TEST_F(EnsembleFlowTest, PipelineIsLoadedBeforeModelsItDoesNotUse) {
+    std::string fileToReload = directoryPath + "/ovms_config_file.json";
+    createConfigFileWithContent(pipelineOneDummyAndUnusedModelConfig, fileToReload);
+    ModelManagerWithModelWaitingForPipeline manager;
+    ASSERT_EQ(manager.loadConfig(fileToReload), StatusCode::OK);
+    ASSERT_NE(manager.unusedModel, nullptr);
+    ASSERT_NE(manager.unusedModel->instance, nullptr);
+    EXPECT_TRUE(manager.unusedModel->instance->pipelineExistedDuringLoad);
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(manager.createPipeline(pipeline, "pipeline1Dummy", &request, &response), StatusCode::OK);
+}
+
 static const char* pipelineOneDummyConfig2ParallelDummy = R"(
 {
     "model_config_list": [
@@ -2845,3 +2960,121 @@ TEST_F(EnsembleFlowTest, PipelineRetiredAddModelWithSameName) {
     auto instance = manager.findModelInstance(PIPELINE_1_DUMMY_NAME);
     ASSERT_EQ(instance, nullptr);
 }
+
+TEST_F(EnsembleFlowTest, BranchesOfDifferentLengthStartLongerBranchFirst) {
+    // Nodes on longer branch are started first when more nodes become ready at once,
+    // node costs are based on measured model latency
+    // input   dummy_a   dummy_b   output
+    //  O------->O-------->O-------->O
+    //  |                            |
+    //  |------->O------------------>|
+    //         dummy_c
+    ConstructorEnabledModelManager manager;
+    manager.reloadModelWithVersions(config);
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, ENTRY_NODE_NAME, "", std::nullopt, {{customPipelineInputName, customPipelineInputName}}},
+        {NodeKind::DL, "dummy_a", dummyModelName, requestedModelVersion, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_OUTPUT_NAME}}},
+        {NodeKind::DL, "dummy_b", dummyModelName, requestedModelVersion, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_OUTPUT_NAME}}},
+        {NodeKind::DL, "dummy_c", dummyModelName, requestedModelVersion, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_OUTPUT_NAME}}},
+        {NodeKind::EXIT, EXIT_NODE_NAME},
+    };
+
+    pipeline_connections_t connections;
+    connections["dummy_a"] = {
+        {ENTRY_NODE_NAME, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["dummy_b"] = {
+        {"dummy_a", {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["dummy_c"] = {
+        {ENTRY_NODE_NAME, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections[EXIT_NODE_NAME] = {
+        {"dummy_b", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}},
+        {"dummy_c", {{DUMMY_MODEL_OUTPUT_NAME, "short_branch_output"}}}};
+
+    PipelineFactory factory;
+    ASSERT_EQ(factory.createDefinition("branched_pipeline", info, connections, manager), StatusCode::OK);
+
+    auto instance = manager.findModelInstance(dummyModelName);
+    ASSERT_NE(instance, nullptr);
+    EXPECT_EQ(instance->getInferenceLatencyEstimate(), 0);
+
+    for (int i = 0; i < 2; i++) {
+        response.Clear();
+        std::unique_ptr<Pipeline> pipeline;
+        ASSERT_EQ(factory.create(pipeline, "branched_pipeline", &request, &response, manager), StatusCode::OK);
+        // Order of started nodes is taken from node execution spans collected by request trace
+        RequestTrace trace("branched_pipeline", "0af7651916cd43dd8448eb211c80319c", "00f067aa0ba902b7", "");
+        currentRequestTrace = &trace;
+        auto status = pipeline->execute();
+        currentRequestTrace = nullptr;
+        ASSERT_EQ(status, StatusCode::OK);
+        checkDummyResponse(2);
+        ASSERT_EQ(response.outputs().count("short_branch_output"), 1);
+
+        if (!TRACING_ENABLED) {
+            continue;
+        }
+        std::vector<std::string> startedNodes;
+        for (const auto& span : trace.getSpans()) {
+            if (span.span == TraceSpan::NODE_EXECUTE && std::find(startedNodes.begin(), startedNodes.end(), span.detail) == startedNodes.end()) {
+                startedNodes.push_back(span.detail);
+            }
+        }
+        auto longBranchStart = std::find(startedNodes.begin(), startedNodes.end(), "dummy_a");
+        auto shortBranchStart = std::find(startedNodes.begin(), startedNodes.end(), "dummy_c");
+        ASSERT_NE(longBranchStart, startedNodes.end());
+        ASSERT_NE(shortBranchStart, startedNodes.end());
+        EXPECT_LT(longBranchStart, shortBranchStart);
+    }
+    EXPECT_GT(instance->getInferenceLatencyEstimate(), 0);
+}
+
+TEST_F(EnsembleFlowTest, OutputFilterPrunesNodesNotLeadingToRequestedOutputs) {
+    // Only dummy_c is executed when only short branch output is requested
+    // input   dummy_a   dummy_b   output
+    //  O------->O-------->O-------->O
+    //  |                            |
+    //  |------->O------------------>|
+    //         dummy_c
+    ConstructorEnabledModelManager manager;
+    manager.reloadModelWithVersions(config);
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, ENTRY_NODE_NAME, "", std::nullopt, {{customPipelineInputName, customPipelineInputName}}},
+        {NodeKind::DL, "dummy_a", dummyModelName, requestedModelVersion, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_OUTPUT_NAME}}},
+        {NodeKind::DL, "dummy_b", dummyModelName, requestedModelVersion, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_OUTPUT_NAME}}},
+        {NodeKind::DL, "dummy_c", dummyModelName, requestedModelVersion, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_OUTPUT_NAME}}},
+        {NodeKind::EXIT, EXIT_NODE_NAME},
+    };
+
+    pipeline_connections_t connections;
+    connections["dummy_a"] = {
+        {ENTRY_NODE_NAME, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["dummy_b"] = {
+        {"dummy_a", {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["dummy_c"] = {
+        {ENTRY_NODE_NAME, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections[EXIT_NODE_NAME] = {
+        {"dummy_b", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}},
+        {"dummy_c", {{DUMMY_MODEL_OUTPUT_NAME, "short_branch_output"}}}};
+
+    PipelineFactory factory;
+    ASSERT_EQ(factory.createDefinition("branched_pipeline", info, connections, manager), StatusCode::OK);
+
+    request.add_output_filter("short_branch_output");
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(factory.create(pipeline, "branched_pipeline", &request, &response, manager), StatusCode::OK);
+    ASSERT_EQ(pipeline->execute(), StatusCode::OK);
+    ASSERT_EQ(response.outputs_size(), 1);
+    ASSERT_EQ(response.outputs().count("short_branch_output"), 1);
+    const auto& proto = response.outputs().at("short_branch_output");
+    ASSERT_EQ(proto.tensor_content().size(), requestData.size() * sizeof(float));
+    const float* actual = (const float*)proto.tensor_content().data();
+    for (size_t i = 0; i < requestData.size(); i++) {
+        EXPECT_FLOAT_EQ(actual[i], requestData[i] + 1) << "at place: " << i;
+    }
+
+    request.clear_output_filter();
+    request.add_output_filter("non_existing_output");
+    EXPECT_EQ(factory.create(pipeline, "branched_pipeline", &request, &response, manager), StatusCode::INVALID_MISSING_OUTPUT);
+}
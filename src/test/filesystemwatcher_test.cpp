@@ -0,0 +1,95 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../filesystemwatcher.hpp"
+#include "test_utils.hpp"
+
+using ovms::FileSystemWatcher;
+using testing::ElementsAre;
+
+class FileSystemWatcherTest : public TestWithTempDir {
+protected:
+    void SetUp() override {
+        TestWithTempDir::SetUp();
+        if (!watcher.isEnabled()) {
+            GTEST_SKIP() << "inotify is not available";
+        }
+    }
+
+    FileSystemWatcher watcher;
+    const std::chrono::milliseconds timeout{1000};
+};
+
+TEST_F(FileSystemWatcherTest, NoChangesUntilTimeout) {
+    ASSERT_TRUE(watcher.watchDirectory(directoryPath));
+    std::set<std::string> changed;
+    EXPECT_FALSE(watcher.waitForChanges(std::chrono::milliseconds(10), changed));
+    EXPECT_TRUE(changed.empty());
+}
+
+TEST_F(FileSystemWatcherTest, ReportsCreatedVersionDirectory) {
+    ASSERT_TRUE(watcher.watchDirectory(directoryPath));
+    EXPECT_TRUE(watcher.isWatched(directoryPath));
+    std::filesystem::create_directories(directoryPath + "/1");
+    std::set<std::string> changed;
+    EXPECT_TRUE(watcher.waitForChanges(timeout, changed));
+    EXPECT_THAT(changed, ElementsAre(directoryPath));
+}
+
+TEST_F(FileSystemWatcherTest, ReportsChangesOfSubdirectoryAsParent) {
+    const std::string versionPath = directoryPath + "/1";
+    std::filesystem::create_directories(versionPath);
+    ASSERT_TRUE(watcher.watchDirectory(versionPath, directoryPath));
+    std::ofstream(versionPath + "/model.xml") << "model";
+    std::set<std::string> changed;
+    EXPECT_TRUE(watcher.waitForChanges(timeout, changed));
+    EXPECT_THAT(changed, ElementsAre(directoryPath));
+}
+
+TEST_F(FileSystemWatcherTest, RemovedDirectoryIsReportedAndNotWatchedAnymore) {
+    const std::string modelPath = directoryPath + "/model";
+    std::filesystem::create_directories(modelPath);
+    ASSERT_TRUE(watcher.watchDirectory(modelPath));
+    std::filesystem::remove_all(modelPath);
+    std::set<std::string> changed;
+    while (watcher.waitForChanges(timeout, changed) && watcher.isWatched(modelPath)) {
+    }
+    EXPECT_THAT(changed, ElementsAre(modelPath));
+    EXPECT_FALSE(watcher.isWatched(modelPath));
+}
+
+TEST_F(FileSystemWatcherTest, UnwatchedDirectoryIsNotReported) {
+    ASSERT_TRUE(watcher.watchDirectory(directoryPath));
+    watcher.unwatchDirectory(directoryPath);
+    EXPECT_FALSE(watcher.isWatched(directoryPath));
+    std::filesystem::create_directories(directoryPath + "/1");
+    std::set<std::string> changed;
+    EXPECT_FALSE(watcher.waitForChanges(std::chrono::milliseconds(100), changed));
+    EXPECT_TRUE(changed.empty());
+}
+
+TEST_F(FileSystemWatcherTest, MissingDirectoryCanNotBeWatched) {
+    EXPECT_FALSE(watcher.watchDirectory(directoryPath + "/missing"));
+    EXPECT_TRUE(watcher.getWatchedDirectories().empty());
+}
@@ -0,0 +1,84 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../inmemoryfiles.hpp"
+#include "test_utils.hpp"
+
+using ovms::InMemoryFiles;
+
+class InMemoryFilesTest : public TestWithTempDir {
+protected:
+    void TearDown() override {
+        InMemoryFiles::instance().release(directoryPath);
+        TestWithTempDir::TearDown();
+    }
+
+    static std::string readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+};
+
+TEST_F(InMemoryFilesTest, ContentIsReadableThroughLocalPath) {
+    const std::string path = directoryPath + "/model.xml";
+    const std::string content = "<net></net>";
+    int fd = InMemoryFiles::instance().create(path, content.size());
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(pwrite(fd, content.data(), content.size(), 0), static_cast<ssize_t>(content.size()));
+    close(fd);
+
+    EXPECT_TRUE(std::filesystem::is_symlink(path));
+    EXPECT_EQ(std::filesystem::file_size(path), content.size());
+    EXPECT_EQ(readFile(path), content);
+}
+
+TEST_F(InMemoryFilesTest, ReleaseClosesFilesInDirectory) {
+    std::filesystem::create_directories(directoryPath + "/1");
+    std::filesystem::create_directories(directoryPath + "/10");
+    const auto initialCount = InMemoryFiles::instance().getFilesCount();
+    close(InMemoryFiles::instance().create(directoryPath + "/1/model.xml", 1));
+    close(InMemoryFiles::instance().create(directoryPath + "/1/model.bin", 1));
+    close(InMemoryFiles::instance().create(directoryPath + "/10/model.bin", 1));
+    EXPECT_EQ(InMemoryFiles::instance().getFilesCount(), initialCount + 3);
+
+    EXPECT_EQ(InMemoryFiles::instance().release(directoryPath + "/1"), 2);
+    EXPECT_EQ(InMemoryFiles::instance().getFilesCount(), initialCount + 1);
+    EXPECT_FALSE(std::filesystem::exists(directoryPath + "/1/model.bin")) << "Link should point to closed descriptor";
+    EXPECT_EQ(readFile(directoryPath + "/10/model.bin").size(), 1);
+}
+
+TEST_F(InMemoryFilesTest, MappedContentOutlivesRelease) {
+    const std::string path = directoryPath + "/model.bin";
+    const std::string content = "weights";
+    int fd = InMemoryFiles::instance().create(path, content.size());
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(pwrite(fd, content.data(), content.size(), 0), static_cast<ssize_t>(content.size()));
+    void* mapping = mmap(nullptr, content.size(), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    ASSERT_NE(mapping, MAP_FAILED);
+
+    InMemoryFiles::instance().release(directoryPath);
+    EXPECT_EQ(std::string(static_cast<const char*>(mapping), content.size()), content);
+    munmap(mapping, content.size());
+}
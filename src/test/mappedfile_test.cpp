@@ -0,0 +1,86 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../mappedfile.hpp"
+#include "test_utils.hpp"
+
+using ovms::MappedFile;
+
+class MappedFileTest : public TestWithTempDir {
+protected:
+    void SetUp() override {
+        TestWithTempDir::SetUp();
+        weightsFile = directoryPath + "/model.bin";
+        std::ofstream(weightsFile, std::ios::binary) << content;
+    }
+
+    const std::string content = "model weights content";
+    std::string weightsFile;
+};
+
+TEST_F(MappedFileTest, ValidModes) {
+    EXPECT_TRUE(MappedFile::isValidMode("off"));
+    EXPECT_TRUE(MappedFile::isValidMode("lazy"));
+    EXPECT_TRUE(MappedFile::isValidMode("populate"));
+    EXPECT_TRUE(MappedFile::isValidMode("willneed"));
+    EXPECT_FALSE(MappedFile::isValidMode("LAZY"));
+    EXPECT_FALSE(MappedFile::isValidMode(""));
+}
+
+TEST_F(MappedFileTest, MapsFileContent) {
+    for (auto mode : {MappedFile::MODE_LAZY, MappedFile::MODE_POPULATE, MappedFile::MODE_WILLNEED}) {
+        auto mappedFile = MappedFile::open(weightsFile, mode);
+        ASSERT_NE(mappedFile, nullptr) << mode;
+        ASSERT_EQ(mappedFile->size(), content.size());
+        EXPECT_EQ(std::memcmp(mappedFile->data(), content.data(), content.size()), 0);
+    }
+}
+
+TEST_F(MappedFileTest, MappingOfTheSameFileIsShared) {
+    auto mappedFile = MappedFile::open(weightsFile, MappedFile::MODE_LAZY);
+    auto otherMappedFile = MappedFile::open(weightsFile, MappedFile::MODE_LAZY);
+    ASSERT_NE(mappedFile, nullptr);
+    EXPECT_EQ(mappedFile, otherMappedFile);
+    EXPECT_EQ(MappedFile::getMappedFilesCount(), 1);
+
+    mappedFile.reset();
+    otherMappedFile.reset();
+    EXPECT_EQ(MappedFile::getMappedFilesCount(), 0);
+}
+
+TEST_F(MappedFileTest, ModifiedFileIsMappedAgain) {
+    auto mappedFile = MappedFile::open(weightsFile, MappedFile::MODE_LAZY);
+    ASSERT_NE(mappedFile, nullptr);
+    std::ofstream(weightsFile, std::ios::binary | std::ios::app) << "modified";
+    auto otherMappedFile = MappedFile::open(weightsFile, MappedFile::MODE_LAZY);
+    ASSERT_NE(otherMappedFile, nullptr);
+    EXPECT_NE(mappedFile, otherMappedFile);
+    EXPECT_EQ(otherMappedFile->size(), content.size() + std::strlen("modified"));
+}
+
+TEST_F(MappedFileTest, MissingOrEmptyFileIsNotMapped) {
+    EXPECT_EQ(MappedFile::open(directoryPath + "/missing.bin", MappedFile::MODE_LAZY), nullptr);
+    const std::string emptyFile = directoryPath + "/empty.bin";
+    std::ofstream(emptyFile, std::ios::binary);
+    EXPECT_EQ(MappedFile::open(emptyFile, MappedFile::MODE_LAZY), nullptr);
+}
@@ -0,0 +1,144 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../metrics.hpp"
+
+using ovms::MetricCounter;
+using ovms::MetricGauge;
+using ovms::MetricHistogram;
+using ovms::MetricsRegistry;
+using ovms::ModelMetrics;
+using ovms::PipelineMetrics;
+
+TEST(Metrics, CounterSumsIncrementsFromAllThreads) {
+    MetricCounter counter;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([&counter]() {
+            for (int j = 0; j < 1000; j++) {
+                counter.increment();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.get(), 8000);
+}
+
+TEST(Metrics, GaugeSumsChangesFromAllThreads) {
+    MetricGauge gauge;
+    gauge.set(5);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&gauge]() {
+            for (int j = 0; j < 100; j++) {
+                gauge.add(2);
+                gauge.add(-1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(gauge.get(), 405);
+    gauge.set(3);
+    EXPECT_EQ(gauge.get(), 3);
+}
+
+TEST(Metrics, HistogramCountsObservationsInBuckets) {
+    MetricHistogram histogram({10, 100});
+    histogram.observe(1);
+    histogram.observe(10);
+    histogram.observe(11);
+    histogram.observe(1000);
+    histogram.observeDuration(std::chrono::milliseconds(1));
+    EXPECT_EQ(histogram.getBucketCounts(), (std::vector<uint64_t>{2, 1, 2}));
+    EXPECT_EQ(histogram.getCount(), 5);
+    EXPECT_EQ(histogram.getSum(), 2022);
+}
+
+TEST(Metrics, RegistryReturnsExistingMetricForSameLabels) {
+    MetricsRegistry registry;
+    auto first = registry.getCounter("ovms_test_total", "Test counter", {{"name", "dummy"}});
+    auto second = registry.getCounter("ovms_test_total", "Test counter", {{"name", "dummy"}});
+    auto other = registry.getCounter("ovms_test_total", "Test counter", {{"name", "other"}});
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, other);
+}
+
+TEST(Metrics, RemovedSeriesIsNotSerialized) {
+    MetricsRegistry registry;
+    auto removed = registry.getCounter("ovms_test_total", "Test counter", {{"name", "removed"}});
+    registry.getCounter("ovms_test_total", "Test counter", {{"name", "kept"}})->increment();
+    registry.getGauge("ovms_test_gauge", "Test gauge", {{"name", "removed"}});
+    registry.removeSeries("ovms_test_total", {{"name", "removed"}});
+    registry.removeSeries("ovms_test_gauge", {{"name", "removed"}});
+
+    const std::string serialized = registry.serialize();
+    EXPECT_EQ(serialized.find("name=\"removed\""), std::string::npos);
+    EXPECT_EQ(serialized.find("ovms_test_gauge"), std::string::npos);
+    EXPECT_NE(serialized.find("ovms_test_total{name=\"kept\"} 1\n"), std::string::npos);
+    EXPECT_NE(registry.getCounter("ovms_test_total", "Test counter", {{"name", "removed"}}), removed);
+}
+
+TEST(Metrics, RetiredModelAndPipelineSeriesAreRemoved) {
+    ModelMetrics modelMetrics("retired_model", 1);
+    PipelineMetrics pipelineMetrics("retired_pipeline");
+    modelMetrics.requestsSuccess->increment();
+    pipelineMetrics.requestsSuccess->increment();
+    std::string serialized = MetricsRegistry::instance().serialize();
+    ASSERT_NE(serialized.find("name=\"retired_model\""), std::string::npos);
+    ASSERT_NE(serialized.find("name=\"retired_pipeline\""), std::string::npos);
+
+    modelMetrics.remove();
+    pipelineMetrics.remove();
+    serialized = MetricsRegistry::instance().serialize();
+    EXPECT_EQ(serialized.find("name=\"retired_model\""), std::string::npos);
+    EXPECT_EQ(serialized.find("name=\"retired_pipeline\""), std::string::npos);
+}
+
+TEST(Metrics, FormatLabelsEscapesValues) {
+    EXPECT_EQ(MetricsRegistry::formatLabels({}), "");
+    EXPECT_EQ(MetricsRegistry::formatLabels({{"name", "a\"b\\c\nd"}, {"version", "1"}}),
+        "{name=\"a\\\"b\\\\c\\nd\",version=\"1\"}");
+}
+
+TEST(Metrics, SerializeInPrometheusTextFormat) {
+    MetricsRegistry registry;
+    registry.getCounter("ovms_test_total", "Test counter", {{"name", "dummy"}})->increment(3);
+    registry.getGauge("ovms_test_gauge", "Test gauge", {})->set(-2);
+    auto histogram = registry.getLatencyHistogram("ovms_test_duration_seconds", "Test histogram", {{"name", "dummy"}});
+    histogram->observe(75);
+    histogram->observe(20000000);
+
+    const std::string serialized = registry.serialize();
+    EXPECT_NE(serialized.find("# HELP ovms_test_total Test counter\n# TYPE ovms_test_total counter\novms_test_total{name=\"dummy\"} 3\n"), std::string::npos);
+    EXPECT_NE(serialized.find("# TYPE ovms_test_gauge gauge\novms_test_gauge -2\n"), std::string::npos);
+    EXPECT_NE(serialized.find("# TYPE ovms_test_duration_seconds histogram\n"), std::string::npos);
+    EXPECT_NE(serialized.find("ovms_test_duration_seconds_bucket{name=\"dummy\",le=\"5e-05\"} 0\n"), std::string::npos);
+    EXPECT_NE(serialized.find("ovms_test_duration_seconds_bucket{name=\"dummy\",le=\"0.0001\"} 1\n"), std::string::npos);
+    EXPECT_NE(serialized.find("ovms_test_duration_seconds_bucket{name=\"dummy\",le=\"10\"} 1\n"), std::string::npos);
+    EXPECT_NE(serialized.find("ovms_test_duration_seconds_bucket{name=\"dummy\",le=\"+Inf\"} 2\n"), std::string::npos);
+    EXPECT_NE(serialized.find("ovms_test_duration_seconds_sum{name=\"dummy\"} 20.000075\n"), std::string::npos);
+    EXPECT_NE(serialized.find("ovms_test_duration_seconds_count{name=\"dummy\"} 2\n"), std::string::npos);
+}
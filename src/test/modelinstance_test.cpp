@@ -23,6 +23,7 @@
 
 #include "../get_model_metadata_impl.hpp"
 #include "../modelinstance.hpp"
+#include "../prediction_service_utils.hpp"
 #include "test_utils.hpp"
 
 using testing::Return;
@@ -333,6 +334,58 @@ TEST_F(TestReloadModel, SuccessfulReloadFromAlreadyLoadedWithNewShape) {
     EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
 }
 
+TEST_F(TestReloadModel, ReloadFromAlreadyLoadedWithNewBatchSizeSwapsNetwork) {
+    ovms::ModelInstance modelInstance("UNUSED_NAME", UNUSED_MODEL_VERSION);
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setBatchSize(1);
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    ASSERT_EQ(modelInstance.getBatchSize(), 1);
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    EXPECT_EQ(modelInstance.reloadModel(3, {}, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+    EXPECT_EQ(modelInstance.getBatchSize(), 3);
+    EXPECT_EQ(modelInstance.getInputsInfo().at(DUMMY_MODEL_INPUT_NAME)->getShape(), (ovms::shape_t{3, 10}));
+}
+
+TEST_F(TestReloadModel, FailedReloadFromAlreadyLoadedKeepsServingPreviousNetwork) {
+    ovms::ModelInstance modelInstance("UNUSED_NAME", UNUSED_MODEL_VERSION);
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setBatchSize(1);
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    config.setBatchSize(2);
+    config.setNireq(100000 + 1);
+    EXPECT_EQ(modelInstance.reloadModel(config), ovms::StatusCode::INVALID_NIREQ);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+    EXPECT_EQ(modelInstance.getBatchSize(), 1);
+    EXPECT_EQ(modelInstance.getModelConfig().getNireq(), DUMMY_MODEL_CONFIG.getNireq());
+}
+
+TEST_F(TestReloadModel, FailedReloadFromAlreadyLoadedKeepsPreviousNetworkInferring) {
+    ovms::ModelInstance modelInstance("UNUSED_NAME", UNUSED_MODEL_VERSION);
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setBatchSize(1);
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    config.setBatchSize(2);
+    config.setNireq(100000 + 1);
+    ASSERT_EQ(modelInstance.reloadModel(config), ovms::StatusCode::INVALID_NIREQ);
+
+    std::vector<float> requestData{1., 2., 3., 4., 5., 6., 7., 8., 9., 10.};
+    tensorflow::serving::PredictRequest request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME,
+            std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 10}, tensorflow::DataType::DT_FLOAT}}});
+    auto& input = (*request.mutable_inputs())[DUMMY_MODEL_INPUT_NAME];
+    input.mutable_tensor_content()->assign(reinterpret_cast<const char*>(requestData.data()), requestData.size() * sizeof(float));
+    tensorflow::serving::PredictResponse response;
+    auto unloadGuard = std::make_unique<ovms::ModelInstanceUnloadGuard>(modelInstance);
+    ASSERT_EQ(ovms::inference(modelInstance, &request, &response, unloadGuard), ovms::StatusCode::OK);
+    checkDummyResponse(DUMMY_MODEL_OUTPUT_NAME, requestData, request, response, 1);
+
+    // Next reload reads the network again
+    config.setNireq(DUMMY_MODEL_CONFIG.getNireq());
+    EXPECT_EQ(modelInstance.reloadModel(config), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.getBatchSize(), 2);
+}
+
 TEST_F(TestReloadModel, SuccessfulReloadFromAlreadyUnloadedWithNewBatchSize) {
     ovms::ModelInstance modelInstance("UNUSED_NAME", UNUSED_MODEL_VERSION);
     ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
@@ -390,3 +443,23 @@ TEST(CpuThroughputStreamsNotSpecified, NotSetForNonCpuDevices) {
     pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config);
     EXPECT_EQ(pluginConfig.count("CPU_THROUGHPUT_STREAMS"), 0);
 }
+
+TEST(ModelInstanceLatencyEstimate, FirstMeasurementIsTakenAsIs) {
+    ovms::ModelInstance instance("UNUSED_NAME", UNUSED_MODEL_VERSION);
+    EXPECT_EQ(instance.getInferenceLatencyEstimate(), 0);
+    instance.updateInferenceLatencyEstimate(800);
+    EXPECT_EQ(instance.getInferenceLatencyEstimate(), 800);
+}
+
+TEST(ModelInstanceLatencyEstimate, MovingAverageFollowsMeasurements) {
+    ovms::ModelInstance instance("UNUSED_NAME", UNUSED_MODEL_VERSION);
+    instance.updateInferenceLatencyEstimate(800);
+    instance.updateInferenceLatencyEstimate(1600);
+    EXPECT_EQ(instance.getInferenceLatencyEstimate(), 900);
+    instance.updateInferenceLatencyEstimate(100);
+    EXPECT_EQ(instance.getInferenceLatencyEstimate(), 800);
+    for (int i = 0; i < 100; i++) {
+        instance.updateInferenceLatencyEstimate(100);
+    }
+    EXPECT_LT(instance.getInferenceLatencyEstimate(), 110);
+}
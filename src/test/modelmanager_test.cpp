@@ -13,12 +13,20 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <rapidjson/document.h>
 
+#include "../config.hpp"
 #include "../localfilesystem.hpp"
 #include "../logging.hpp"
 #include "../model.hpp"
@@ -242,6 +250,56 @@ TEST(ModelManager, parseConfigWhenOnlyPipelineDefinitionProvided) {
     modelMock.reset();
 }
 
+TEST(ModelManager, PipelineConfigWithDLNodeWithoutModelNameIsRejected) {
+    const char* pipelineConfigWithoutModelName = R"({
+        "name": "pipeline",
+        "inputs": ["in"],
+        "outputs": [{"out": {"node_name": "alpha", "data_item": "prob"}}],
+        "nodes": [
+            {
+                "name": "alpha",
+                "type": "DL model",
+                "inputs": [{"a": {"node_name": "request", "data_item": "in"}}],
+                "outputs": [{"data_item": "prob", "alias": "prob"}]
+            }
+        ]
+    })";
+    rapidjson::Document configJson;
+    ASSERT_FALSE(configJson.Parse(pipelineConfigWithoutModelName).HasParseError());
+    ConstructorEnabledModelManager manager;
+    ovms::PipelineFactory factory;
+    std::set<std::string> pipelinesInConfigFile;
+    auto status = ovms::processPipelineConfig(configJson, configJson, pipelinesInConfigFile, factory, manager);
+    EXPECT_EQ(status, ovms::StatusCode::PIPELINE_NODE_MISSING_MODEL_NAME) << status.string();
+    EXPECT_TRUE(pipelinesInConfigFile.empty());
+    EXPECT_FALSE(factory.definitionExists("pipeline"));
+}
+
+TEST(ModelManager, PipelineConfigWithCustomNodeUsingMissingLibraryIsRejected) {
+    const char* pipelineConfigWithMissingLibrary = R"({
+        "name": "pipeline",
+        "inputs": ["in"],
+        "outputs": [{"out": {"node_name": "alpha", "data_item": "prob"}}],
+        "nodes": [
+            {
+                "name": "alpha",
+                "type": "custom",
+                "library_name": "missing_library",
+                "inputs": [{"a": {"node_name": "request", "data_item": "in"}}],
+                "outputs": [{"data_item": "prob", "alias": "prob"}]
+            }
+        ]
+    })";
+    rapidjson::Document configJson;
+    ASSERT_FALSE(configJson.Parse(pipelineConfigWithMissingLibrary).HasParseError());
+    ConstructorEnabledModelManager manager;
+    ovms::PipelineFactory factory;
+    std::set<std::string> pipelinesInConfigFile;
+    auto status = ovms::processPipelineConfig(configJson, configJson, pipelinesInConfigFile, factory, manager);
+    EXPECT_EQ(status, ovms::StatusCode::PIPELINE_DEFINITION_INVALID_NODE_LIBRARY) << status.string();
+    EXPECT_TRUE(pipelinesInConfigFile.empty());
+}
+
 TEST(ModelManager, ReadsVersionsFromDisk) {
     const std::string path = "/tmp/test_model/";
 
@@ -436,6 +494,40 @@ TEST(ModelManager, HandlingInvalidLastVersion) {
     ASSERT_EQ(modelInstance2->getStatus().getState(), ovms::ModelVersionState::AVAILABLE);
 }
 
+TEST(ModelManager, FailedReloadOfAvailableVersionKeepsItServing) {
+    DummyModelDirectoryStructure modelDirectory("FailedReloadOfAvailableVersionKeepsItServing");
+    DummyModelDirectoryStructure brokenModelDirectory("FailedReloadOfAvailableVersionKeepsItServingBroken");
+    bool validVersion = true;
+    modelDirectory.addVersion(1, validVersion);
+    brokenModelDirectory.addVersion(1, !validVersion);
+    ovms::ModelConfig config;
+    config.setBasePath("/tmp/" + modelDirectory.name);
+    config.setName(modelDirectory.name);
+    config.setNireq(1);
+    ConstructorEnabledModelManager manager;
+    ASSERT_EQ(manager.reloadModelWithVersions(config), ovms::StatusCode::OK);
+    std::shared_ptr<ovms::ModelInstance> modelInstance;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
+    ASSERT_EQ(ovms::getModelInstance(manager, modelDirectory.name, 1, modelInstance, modelInstanceUnloadGuard), ovms::StatusCode::OK);
+    modelInstanceUnloadGuard.reset();
+
+    // version 1 replaced with broken files
+    // expected version 1 still available with previous files
+    config.setBasePath("/tmp/" + brokenModelDirectory.name);
+    manager.reloadModelWithVersions(config);
+    ASSERT_EQ(modelInstance->getStatus().getState(), ovms::ModelVersionState::AVAILABLE);
+    EXPECT_EQ(modelInstance->getModelConfig().getBasePath(), "/tmp/" + modelDirectory.name);
+    std::shared_ptr<ovms::ModelInstance> modelInstanceAfterReload;
+    ASSERT_EQ(ovms::getModelInstance(manager, modelDirectory.name, 1, modelInstanceAfterReload, modelInstanceUnloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstanceAfterReload, modelInstance);
+
+    tensorflow::serving::PredictRequest request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME,
+            std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 10}, tensorflow::DataType::DT_FLOAT}}});
+    tensorflow::serving::PredictResponse response;
+    ASSERT_EQ(ovms::inference(*modelInstance, &request, &response, modelInstanceUnloadGuard), ovms::StatusCode::OK);
+}
+
 TEST(ModelManager, ConfigReloadingWithTwoModelsWithTheSameName) {
     const char* configWithTwoSameNames = R"({
    "model_config_list": [
@@ -526,6 +618,88 @@ TEST(ModelManager, ConfigReloadingShouldRetireModelInstancesOfModelRemovedFromJs
     manager.join();
 }
 
+TEST(ModelManager, ConfigLoadingShouldLoadAllModelsAndVersionsConcurrently) {
+    const char* configWithFourModels = R"({
+   "model_config_list": [
+    {"config": {"name": "first", "base_path": "/tmp/models/dummy1", "model_version_policy": {"all": {}}}},
+    {"config": {"name": "second", "base_path": "/tmp/models/dummy1", "model_version_policy": {"all": {}}}},
+    {"config": {"name": "third", "base_path": "/tmp/models/dummy1", "model_version_policy": {"all": {}}}},
+    {"config": {"name": "fourth", "base_path": "/tmp/models/dummy1", "model_version_policy": {"all": {}}}}]})";
+    std::filesystem::create_directories(model_1_path);
+    std::string fileToReload = "/tmp/ovms_config_file_four_models.json";
+    createConfigFileWithContent(configWithFourModels, fileToReload);
+    MockModelManagerWithModelInstancesJustChangingStates manager;
+    manager.registerVersionToLoad(1);
+    manager.registerVersionToLoad(2);
+    manager.registerVersionToLoad(3);
+    ASSERT_EQ(manager.startFromFile(fileToReload), ovms::StatusCode::OK);
+    auto models = manager.getModels();
+    ASSERT_EQ(models.size(), 4);
+    for (auto& [name, model] : models) {
+        ASSERT_EQ(model->getModelVersions().size(), 3) << name;
+        for (auto& [version, instance] : model->getModelVersions()) {
+            EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, instance->getStatus().getState()) << name << " " << version;
+        }
+        auto defaultInstance = model->getDefaultModelInstance();
+        ASSERT_NE(defaultInstance, nullptr) << name;
+        EXPECT_EQ(defaultInstance->getVersion(), 3) << name;
+    }
+}
+
+namespace {
+class FileSystemWaitingForConcurrentDownloads : public ovms::FileSystem {
+    std::mutex mtx;
+    std::condition_variable downloadStarted;
+    size_t inProgress = 0;
+    const size_t expectedConcurrentDownloads;
+
+public:
+    size_t maxConcurrentDownloads = 0;
+
+    FileSystemWaitingForConcurrentDownloads(size_t expectedConcurrentDownloads) :
+        expectedConcurrentDownloads(expectedConcurrentDownloads) {}
+
+    ovms::StatusCode fileExists(const std::string& path, bool* exists) override { return ovms::StatusCode::OK; }
+    ovms::StatusCode isDirectory(const std::string& path, bool* is_dir) override { return ovms::StatusCode::OK; }
+    ovms::StatusCode getDirectoryContents(const std::string& path, ovms::files_list_t* contents) override { return ovms::StatusCode::OK; }
+    ovms::StatusCode getDirectorySubdirs(const std::string& path, ovms::files_list_t* subdirs) override { return ovms::StatusCode::OK; }
+    ovms::StatusCode getDirectoryFiles(const std::string& path, ovms::files_list_t* files) override { return ovms::StatusCode::OK; }
+    ovms::StatusCode readTextFile(const std::string& path, std::string* contents) override { return ovms::StatusCode::OK; }
+    ovms::StatusCode downloadFileFolder(const std::string& path, const std::string& local_path) override { return ovms::StatusCode::OK; }
+    ovms::StatusCode deleteFileFolder(const std::string& path) override { return ovms::StatusCode::OK; }
+
+    ovms::StatusCode downloadModelVersions(const std::string& path, std::string* local_path, const std::vector<ovms::model_version_t>& versions) override {
+        std::unique_lock<std::mutex> lock(mtx);
+        inProgress++;
+        maxConcurrentDownloads = std::max(maxConcurrentDownloads, inProgress);
+        downloadStarted.notify_all();
+        // Downloads which are not started concurrently never reach the expected number and fail the test after timeout
+        downloadStarted.wait_for(lock, std::chrono::seconds(5), [this]() { return maxConcurrentDownloads >= expectedConcurrentDownloads; });
+        inProgress--;
+        *local_path = "/tmp/downloaded";
+        return ovms::StatusCode::OK;
+    }
+};
+}  // namespace
+
+TEST(ModelManager, VersionsFromCloudStorageAreDownloadedConcurrently) {
+    const size_t versionsCount = 3;
+    const auto configuredThreads = ovms::Config::instance().modelLoadThreads();
+    const size_t executorThreads = configuredThreads > 0 ? configuredThreads : std::max(1u, std::thread::hardware_concurrency());
+    const size_t expectedConcurrentDownloads = std::min(versionsCount, executorThreads);
+    auto fileSystem = std::make_shared<FileSystemWaitingForConcurrentDownloads>(expectedConcurrentDownloads);
+    std::shared_ptr<ovms::FileSystem> fs = fileSystem;
+    MockModel model;
+    EXPECT_CALL(model, addVersion(::testing::_)).Times(versionsCount).WillRepeatedly(::testing::Return(ovms::StatusCode::OK));
+    ovms::ModelConfig config;
+    config.setBasePath("s3://bucket/model");
+    auto versionsToStart = std::make_shared<ovms::model_versions_t>(ovms::model_versions_t{1, 2, 3});
+    auto versionsFailed = std::make_shared<ovms::model_versions_t>();
+    EXPECT_EQ(model.addVersions(versionsToStart, config, fs, versionsFailed), ovms::StatusCode::OK);
+    EXPECT_TRUE(versionsFailed->empty());
+    EXPECT_EQ(fileSystem->maxConcurrentDownloads, expectedConcurrentDownloads);
+}
+
 class MockModelInstanceInStateWithConfig : public ovms::ModelInstance {
     static const ovms::model_version_t UNUSED_VERSION = 987789;
 
@@ -0,0 +1,207 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../metrics.hpp"
+#include "../modelinstance.hpp"
+#include "../modelmemorybudget.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+class ModelMemoryBudgetTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (auto& instance : instances) {
+            instance = std::make_unique<ModelInstance>("UNUSED_NAME", UNUSED_MODEL_VERSION);
+            ASSERT_EQ(instance->loadModel(DUMMY_MODEL_CONFIG), StatusCode::OK);
+        }
+    }
+
+    std::unique_ptr<ModelInstance> instances[3];
+};
+
+TEST_F(ModelMemoryBudgetTest, UnloadedModelIsLoadedOnDemand) {
+    auto& instance = *instances[0];
+    ASSERT_TRUE(instance.unloadToFreeMemory());
+    EXPECT_TRUE(instance.isLoadOnDemandRequired());
+    EXPECT_EQ(instance.getStatus().getState(), ModelVersionState::LOADING);
+
+    std::unique_ptr<ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(instance.waitForLoaded(0, unloadGuard), StatusCode::OK);
+    EXPECT_NE(unloadGuard, nullptr);
+    EXPECT_FALSE(instance.isLoadOnDemandRequired());
+    EXPECT_EQ(instance.getStatus().getState(), ModelVersionState::AVAILABLE);
+}
+
+TEST_F(ModelMemoryBudgetTest, ModelInUseIsNotUnloaded) {
+    auto& instance = *instances[0];
+    std::unique_ptr<ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(instance.waitForLoaded(0, unloadGuard), StatusCode::OK);
+    EXPECT_FALSE(instance.unloadToFreeMemory());
+    EXPECT_EQ(instance.getStatus().getState(), ModelVersionState::AVAILABLE);
+    unloadGuard.reset();
+    EXPECT_TRUE(instance.unloadToFreeMemory());
+}
+
+TEST_F(ModelMemoryBudgetTest, PermanentlyUnloadedModelIsNotLoadedOnDemand) {
+    auto& instance = *instances[0];
+    ASSERT_TRUE(instance.unloadToFreeMemory());
+    instance.unloadModel();
+    EXPECT_FALSE(instance.isLoadOnDemandRequired());
+    std::unique_ptr<ModelInstanceUnloadGuard> unloadGuard;
+    EXPECT_EQ(instance.waitForLoaded(0, unloadGuard), StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE);
+}
+
+TEST_F(ModelMemoryBudgetTest, LeastRecentlyUsedModelIsUnloadedWhenBudgetExceeded) {
+    MetricsRegistry registry;
+    ModelMemoryBudget budget(250, registry);
+    budget.add(*instances[0], 100, false);
+    budget.add(*instances[1], 100, false);
+    std::unique_ptr<ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(instances[0]->waitForLoaded(0, unloadGuard), StatusCode::OK);
+    unloadGuard.reset();
+
+    budget.add(*instances[2], 100, false);
+    budget.evictIfExceeded(*instances[2]);
+    EXPECT_EQ(budget.getUsedBytes(), 200);
+    EXPECT_FALSE(instances[0]->isLoadOnDemandRequired());
+    EXPECT_TRUE(instances[1]->isLoadOnDemandRequired());
+    EXPECT_FALSE(instances[2]->isLoadOnDemandRequired());
+}
+
+TEST_F(ModelMemoryBudgetTest, PinnedAndJustLoadedModelsAreNotUnloaded) {
+    MetricsRegistry registry;
+    ModelMemoryBudget budget(150, registry);
+    budget.add(*instances[0], 100, true);
+    budget.add(*instances[1], 100, false);
+    budget.evictIfExceeded(*instances[1]);
+    EXPECT_EQ(budget.getUsedBytes(), 200);
+    EXPECT_FALSE(instances[0]->isLoadOnDemandRequired());
+    EXPECT_FALSE(instances[1]->isLoadOnDemandRequired());
+}
+
+TEST_F(ModelMemoryBudgetTest, ReloadUpdatesUsedMemory) {
+    MetricsRegistry registry;
+    ModelMemoryBudget budget(1000, registry);
+    budget.add(*instances[0], 100, false);
+    budget.add(*instances[0], 300, false);
+    EXPECT_EQ(budget.getUsedBytes(), 300);
+    budget.remove(*instances[0]);
+    EXPECT_EQ(budget.getUsedBytes(), 0);
+}
+
+namespace {
+class ModelInstanceRetiredDuringUnload : public ModelInstance {
+    ModelMemoryBudget& budget;
+    mutable std::thread retiring;
+
+public:
+    mutable std::atomic<bool> removed{false};
+    mutable bool removedDuringUnload = false;
+    mutable size_t usedBytesDuringUnload = 0;
+
+    ModelInstanceRetiredDuringUnload(ModelMemoryBudget& budget) :
+        ModelInstance("UNUSED_NAME", UNUSED_MODEL_VERSION),
+        budget(budget) {}
+
+    ~ModelInstanceRetiredDuringUnload() {
+        waitForRetired();
+    }
+
+    void waitForRetired() {
+        if (retiring.joinable()) {
+            retiring.join();
+        }
+    }
+
+    // Retiring the model is triggered while eviction is unloading it
+    bool canUnloadInstance() const override {
+        if (!retiring.joinable()) {
+            std::promise<void> removeStarted;
+            auto removeStartedFuture = removeStarted.get_future();
+            retiring = std::thread([this, removeStarted = std::move(removeStarted)]() mutable {
+                removeStarted.set_value();
+                budget.remove(const_cast<ModelInstanceRetiredDuringUnload&>(*this));
+                removed = true;
+            });
+            removeStartedFuture.wait();
+            removedDuringUnload = removed;
+            // Budget is not locked while the instance is being unloaded
+            usedBytesDuringUnload = budget.getUsedBytes();
+        }
+        return ModelInstance::canUnloadInstance();
+    }
+};
+}  // namespace
+
+TEST_F(ModelMemoryBudgetTest, ModelRetiredDuringEvictionWaitsForUnload) {
+    MetricsRegistry registry;
+    ModelMemoryBudget budget(150, registry);
+    ModelInstanceRetiredDuringUnload retired(budget);
+    ASSERT_EQ(retired.loadModel(DUMMY_MODEL_CONFIG), StatusCode::OK);
+    budget.add(retired, 100, false);
+    budget.add(*instances[0], 100, false);
+    budget.evictIfExceeded(*instances[0]);
+    EXPECT_FALSE(retired.removedDuringUnload);
+    EXPECT_EQ(retired.usedBytesDuringUnload, 200);
+    EXPECT_TRUE(retired.isLoadOnDemandRequired());
+    retired.waitForRetired();
+    EXPECT_TRUE(retired.removed);
+    EXPECT_EQ(budget.getUsedBytes(), 100);
+}
+
+TEST_F(ModelMemoryBudgetTest, ColdLoadsAreExportedAsMetrics) {
+    MetricsRegistry registry;
+    ModelMemoryBudget budget(150, registry);
+    budget.recordColdLoad(20);
+    budget.recordColdLoad(30);
+    EXPECT_EQ(budget.getColdLoads(), 2);
+    EXPECT_EQ(budget.getColdLoadsTotalMilliseconds(), 50);
+    auto histogram = registry.getLatencyHistogram("ovms_model_load_on_demand_duration_seconds", "", {});
+    EXPECT_EQ(histogram->getCount(), 2);
+    EXPECT_EQ(histogram->getSum(), 50'000);
+}
+
+TEST_F(ModelMemoryBudgetTest, LoadWaitsUntilItFitsBudgetWithOtherLoads) {
+    MetricsRegistry registry;
+    ModelMemoryBudget budget(250, registry);
+    budget.add(*instances[0], 100, false);
+    auto firstLoad = std::make_unique<ModelLoadReservation>(budget, 100);
+    auto secondLoad = std::async(std::launch::async, [&budget]() {
+        ModelLoadReservation reservation(budget, 100);
+    });
+    // Second load would exceed the budget, so it has to wait for the first one to finish
+    EXPECT_EQ(secondLoad.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+    budget.remove(*instances[0]);
+    firstLoad.reset();
+    secondLoad.get();
+}
+
+TEST_F(ModelMemoryBudgetTest, SingleLoadLargerThanBudgetIsAdmitted) {
+    MetricsRegistry registry;
+    ModelMemoryBudget budget(150, registry);
+    budget.add(*instances[0], 100, true);
+    ModelLoadReservation reservation(budget, 300);
+    SUCCEED();
+}
@@ -0,0 +1,80 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <fstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../modelinstance.hpp"
+#include "../modelwarmup.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+class ModelWarmupTest : public TestWithTempDir {
+protected:
+    void SetUp() override {
+        TestWithTempDir::SetUp();
+        config = DUMMY_MODEL_CONFIG;
+        ASSERT_EQ(instance.loadModel(config), StatusCode::OK);
+        config.setWarmupIterations(2);
+    }
+
+    void writeWarmupFile(const std::string& content) {
+        warmupFile = directoryPath + "/warmup.json";
+        std::ofstream(warmupFile) << content;
+        config.setWarmupData(warmupFile);
+    }
+
+    ModelConfig config;
+    ModelInstance instance{"UNUSED_NAME", UNUSED_MODEL_VERSION};
+    std::string warmupFile;
+};
+
+TEST_F(ModelWarmupTest, ModelIsAvailableAfterWarmup) {
+    ModelInstance warmedUpInstance("UNUSED_NAME", UNUSED_MODEL_VERSION);
+    ASSERT_EQ(warmedUpInstance.loadModel(config), StatusCode::OK);
+    EXPECT_EQ(warmedUpInstance.getStatus().getState(), ModelVersionState::AVAILABLE);
+}
+
+TEST_F(ModelWarmupTest, DisabledWithZeroIterations) {
+    config.setWarmupIterations(0);
+    config.setWarmupData(directoryPath + "/missing.json");
+    EXPECT_EQ(ModelWarmup::run(config, instance.getInputsInfo(), instance.getInferRequestsQueue()), StatusCode::OK);
+}
+
+TEST_F(ModelWarmupTest, SyntheticInputs) {
+    config.setWarmupData(ModelWarmup::ZEROS);
+    EXPECT_EQ(ModelWarmup::run(config, instance.getInputsInfo(), instance.getInferRequestsQueue()), StatusCode::OK);
+    config.setWarmupData(ModelWarmup::RANDOM);
+    EXPECT_EQ(ModelWarmup::run(config, instance.getInputsInfo(), instance.getInferRequestsQueue()), StatusCode::OK);
+}
+
+TEST_F(ModelWarmupTest, InputsFromFile) {
+    writeWarmupFile(R"({"instances": [[1, 2, 3, 4, 5, 6, 7, 8, 9, 10]]})");
+    EXPECT_EQ(ModelWarmup::run(config, instance.getInputsInfo(), instance.getInferRequestsQueue()), StatusCode::OK);
+}
+
+TEST_F(ModelWarmupTest, InputsFromFileWithWrongShape) {
+    writeWarmupFile(R"({"instances": [[1, 2, 3]]})");
+    EXPECT_EQ(ModelWarmup::run(config, instance.getInputsInfo(), instance.getInferRequestsQueue()), StatusCode::INVALID_SHAPE);
+}
+
+TEST_F(ModelWarmupTest, MissingFile) {
+    config.setWarmupData(directoryPath + "/missing.json");
+    EXPECT_EQ(ModelWarmup::run(config, instance.getInputsInfo(), instance.getInferRequestsQueue()), StatusCode::FILE_INVALID);
+}
@@ -0,0 +1,117 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <inference_engine.hpp>
+
+#include "../onnxconversioncache.hpp"
+#include "test_utils.hpp"
+
+using ovms::OnnxConversionCache;
+
+class OnnxConversionCacheTest : public TestWithTempDir {
+protected:
+    void SetUp() override {
+        TestWithTempDir::SetUp();
+        modelFile = directoryPath + "/model.onnx";
+        std::ofstream(modelFile, std::ios::binary) << "onnx model content";
+    }
+
+    InferenceEngine::Core engine;
+    std::string modelFile;
+};
+
+TEST_F(OnnxConversionCacheTest, DisabledWithoutDirectory) {
+    OnnxConversionCache cache("", 0);
+    EXPECT_FALSE(cache.isEnabled());
+}
+
+TEST_F(OnnxConversionCacheTest, DigestDependsOnlyOnFileContent) {
+    const std::string copiedFile = directoryPath + "/copied.onnx";
+    std::filesystem::copy_file(modelFile, copiedFile);
+    std::string digest, otherDigest;
+    ASSERT_TRUE(OnnxConversionCache::createDigest(modelFile, digest));
+    ASSERT_TRUE(OnnxConversionCache::createDigest(copiedFile, otherDigest));
+    EXPECT_FALSE(digest.empty());
+    EXPECT_EQ(digest, otherDigest);
+
+    std::ofstream(copiedFile, std::ios::binary | std::ios::app) << "modified";
+    ASSERT_TRUE(OnnxConversionCache::createDigest(copiedFile, otherDigest));
+    EXPECT_NE(digest, otherDigest);
+}
+
+TEST_F(OnnxConversionCacheTest, DigestCreationFailsForMissingFile) {
+    std::string digest;
+    EXPECT_FALSE(OnnxConversionCache::createDigest(directoryPath + "/missing.onnx", digest));
+}
+
+TEST_F(OnnxConversionCacheTest, MissingEntryIsMiss) {
+    OnnxConversionCache cache(directoryPath + "/cache", 0);
+    EXPECT_EQ(cache.readNetwork("0123456789abcdef", engine), nullptr);
+    EXPECT_EQ(cache.getMisses(), 1);
+    EXPECT_EQ(cache.getHits(), 0);
+}
+
+TEST_F(OnnxConversionCacheTest, StoredNetworkIsReadBack) {
+    OnnxConversionCache cache(directoryPath + "/cache", 0);
+    auto network = engine.ReadNetwork(dummy_model_location + "/1/dummy.xml");
+    cache.storeNetwork("0123456789abcdef", network);
+    EXPECT_EQ(cache.getStores(), 1);
+    EXPECT_TRUE(std::filesystem::exists(directoryPath + "/cache/0123456789abcdef.xml"));
+    EXPECT_TRUE(std::filesystem::exists(directoryPath + "/cache/0123456789abcdef.bin"));
+
+    auto cachedNetwork = cache.readNetwork("0123456789abcdef", engine);
+    ASSERT_NE(cachedNetwork, nullptr);
+    EXPECT_EQ(cache.getHits(), 1);
+    EXPECT_EQ(cachedNetwork->getInputsInfo().size(), network.getInputsInfo().size());
+    EXPECT_EQ(cachedNetwork->getOutputsInfo().size(), network.getOutputsInfo().size());
+}
+
+TEST_F(OnnxConversionCacheTest, CorruptedEntryIsRemoved) {
+    OnnxConversionCache cache(directoryPath + "/cache", 0);
+    std::ofstream(directoryPath + "/cache/0123456789abcdef.xml") << "not an IR";
+    std::ofstream(directoryPath + "/cache/0123456789abcdef.bin") << "not an IR";
+    EXPECT_EQ(cache.readNetwork("0123456789abcdef", engine), nullptr);
+    EXPECT_EQ(cache.getMisses(), 1);
+    EXPECT_FALSE(std::filesystem::exists(directoryPath + "/cache/0123456789abcdef.xml"));
+}
+
+TEST_F(OnnxConversionCacheTest, LeastRecentlyUsedEntryIsEvictedWhenCapacityExceeded) {
+    const std::string cacheDir = directoryPath + "/cache";
+    auto network = engine.ReadNetwork(dummy_model_location + "/1/dummy.xml");
+    OnnxConversionCache unlimitedCache(cacheDir, 0);
+    unlimitedCache.storeNetwork("0000000000000001", network);
+    const auto entrySize = std::filesystem::file_size(cacheDir + "/0000000000000001.xml") +
+                           std::filesystem::file_size(cacheDir + "/0000000000000001.bin");
+    unlimitedCache.storeNetwork("0000000000000002", network);
+    // First entry is used again, so the second one becomes the least recently used
+    std::filesystem::last_write_time(cacheDir + "/0000000000000002.xml", std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+    ASSERT_NE(unlimitedCache.readNetwork("0000000000000001", engine), nullptr);
+
+    OnnxConversionCache cache(cacheDir, 2 * entrySize);
+    cache.storeNetwork("0000000000000003", network);
+    EXPECT_TRUE(std::filesystem::exists(cacheDir + "/0000000000000001.xml"));
+    EXPECT_FALSE(std::filesystem::exists(cacheDir + "/0000000000000002.xml"));
+    EXPECT_FALSE(std::filesystem::exists(cacheDir + "/0000000000000002.bin"));
+    EXPECT_TRUE(std::filesystem::exists(cacheDir + "/0000000000000003.xml"));
+    EXPECT_TRUE(std::filesystem::exists(cacheDir + "/0000000000000003.bin"));
+}
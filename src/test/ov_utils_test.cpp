@@ -63,3 +63,43 @@ TEST(OVUtils, CopyBlob) {
     // Expect memory addresses to differ since cloning should allocate new memory space for the cloned blob
     EXPECT_NE((float*)copyBlob->buffer(), (float*)originalBlob->buffer());
 }
+
+TEST(OVUtils, SplitAndConcatenateBlob) {
+    const std::vector<size_t> shape{3, 2, 4};
+    const InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, shape, InferenceEngine::Layout::CHW};
+    std::vector<float> data(3 * 2 * 4);
+    std::iota(data.begin(), data.end(), 0);
+    InferenceEngine::Blob::Ptr originalBlob = InferenceEngine::make_shared_blob<float>(desc, data.data());
+
+    std::vector<InferenceEngine::Blob::Ptr> shards;
+    ASSERT_EQ(ovms::splitBlob(originalBlob, shards), ovms::StatusCode::OK);
+    ASSERT_EQ(shards.size(), 3);
+    for (size_t i = 0; i < shards.size(); i++) {
+        EXPECT_THAT(shards[i]->getTensorDesc().getDims(), ElementsAre(1, 2, 4));
+        EXPECT_EQ(shards[i]->getTensorDesc().getPrecision(), InferenceEngine::Precision::FP32);
+        const float* shardData = (const float*)shards[i]->buffer();
+        EXPECT_EQ(std::vector<float>(shardData, shardData + 8), std::vector<float>(data.begin() + i * 8, data.begin() + (i + 1) * 8));
+    }
+
+    InferenceEngine::Blob::Ptr gatheredBlob;
+    ASSERT_EQ(ovms::concatenateBlobs(shards, gatheredBlob), ovms::StatusCode::OK);
+    EXPECT_EQ(gatheredBlob->getTensorDesc().getDims(), shape);
+    const float* gatheredData = (const float*)gatheredBlob->buffer();
+    EXPECT_EQ(std::vector<float>(gatheredData, gatheredData + data.size()), data);
+}
+
+TEST(OVUtils, ConcatenateBlobsWithDifferentShapes) {
+    InferenceEngine::Blob::Ptr first = InferenceEngine::make_shared_blob<float>({InferenceEngine::Precision::FP32, {1, 10}, InferenceEngine::Layout::NC});
+    InferenceEngine::Blob::Ptr second = InferenceEngine::make_shared_blob<float>({InferenceEngine::Precision::FP32, {1, 5}, InferenceEngine::Layout::NC});
+    first->allocate();
+    second->allocate();
+    InferenceEngine::Blob::Ptr gatheredBlob;
+    EXPECT_EQ(ovms::concatenateBlobs({first, second}, gatheredBlob), ovms::StatusCode::PIPELINE_INCONSISTENT_SHARD_DIMENSIONS);
+}
+
+TEST(OVUtils, SplitScalarBlob) {
+    InferenceEngine::Blob::Ptr scalar = InferenceEngine::make_shared_blob<float>({InferenceEngine::Precision::FP32, {}, InferenceEngine::Layout::SCALAR});
+    scalar->allocate();
+    std::vector<InferenceEngine::Blob::Ptr> shards;
+    EXPECT_EQ(ovms::splitBlob(scalar, shards), ovms::StatusCode::INVALID_SHAPE);
+}
@@ -24,8 +24,6 @@
 #include <gtest/gtest.h>
 
 #include "../ovinferrequestsqueue.hpp"
-#define DEBUG
-#include "../timer.hpp"
 
 using namespace testing;
 
@@ -54,7 +52,6 @@ void releaseStream(ovms::OVInferRequestsQueue& requestsQueue) {
 }
 
 TEST(OVInferRequestQueue, FullQueue) {
-    Timer timer;
     InferenceEngine::Core engine;
     InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
     InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
@@ -63,13 +60,13 @@ TEST(OVInferRequestQueue, FullQueue) {
     for (int i = 0; i < 50; i++) {
         reqid = inferRequestsQueue.getIdleStream().get();
     }
-    timer.start("queue");
+    auto start = std::chrono::steady_clock::now();
     std::thread th(&releaseStream, std::ref(inferRequestsQueue));
     th.detach();
     reqid = inferRequestsQueue.getIdleStream().get();  // it should wait 1s for released request
-    timer.stop("queue");
+    auto elapsed = std::chrono::steady_clock::now() - start;
 
-    EXPECT_GT(timer.elapsed<std::chrono::microseconds>("queue"), 1'000'000);
+    EXPECT_GT(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(), 1'000'000);
     EXPECT_EQ(reqid, 3);
 }
 
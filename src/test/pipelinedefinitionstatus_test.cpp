@@ -20,7 +20,6 @@
 #include "../pipelinedefinitionstatus.hpp"
 #include "../prediction_service_utils.hpp"
 #include "../status.hpp"
-#include "../timer.hpp"
 #include "test_utils.hpp"
 
 using namespace ovms;
@@ -128,6 +128,13 @@ TEST_F(PredictValidation, RequestWrongInputName) {
     EXPECT_EQ(status, ovms::StatusCode::INVALID_MISSING_INPUT);
 }
 
+TEST_F(PredictValidation, RequestOutputFilterWithMissingOutput) {
+    request.add_output_filter("Some_Output");
+
+    auto status = instance.validate(&request);
+    EXPECT_EQ(status, ovms::StatusCode::INVALID_MISSING_OUTPUT);
+}
+
 TEST_F(PredictValidation, RequestTooManyShapeDimensions) {
     auto& input = (*request.mutable_inputs())["Input_FP32_1_3_224_224_NHWC"];
     input.mutable_tensor_shape()->add_dim()->set_size(16);
@@ -479,4 +479,34 @@ TEST_F(TestPredict, ChangeBatchSizeViaRequestAndConfigChange) {
     ASSERT_EQ(performInferenceWithBatchSize(response, 3), StatusCode::OK);
     checkOutputShape(response, {3, 10});
 }
+
+/**
+ * Scenario - perform inferences with results cache enabled
+ * 
+ * 1. Load model with bs=auto and results cache enabled
+ * 2. Do the inference twice with the same request - expect single cache entry and equal responses
+ * 3. Do the inference with (2,10) shape - expect model reload dropping previously cached results
+ */
+TEST_F(TestPredict, SameRequestServedFromResultCache) {
+    using namespace ovms;
+
+    ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setBatchingParams("auto");
+    config.setResultCacheSize(1024 * 1024);
+    ASSERT_EQ(manager.reloadModelWithVersions(config), StatusCode::OK);
+    auto instance = manager.findModelByName("dummy")->getDefaultModelInstance();
+    ASSERT_NE(instance->getResultCache(), nullptr);
+
+    tensorflow::serving::PredictResponse firstResponse, secondResponse;
+    ASSERT_EQ(performInferenceWithBatchSize(firstResponse, 1), StatusCode::OK);
+    EXPECT_EQ(instance->getResultCache()->getEntriesCount(), 1);
+    ASSERT_EQ(performInferenceWithBatchSize(secondResponse, 1), StatusCode::OK);
+    EXPECT_EQ(instance->getResultCache()->getEntriesCount(), 1);
+    checkOutputShape(secondResponse, {1, 10});
+    EXPECT_EQ(firstResponse.outputs().at("a").tensor_content(), secondResponse.outputs().at("a").tensor_content());
+
+    ASSERT_EQ(performInferenceWithBatchSize(secondResponse, 2), StatusCode::OK);
+    checkOutputShape(secondResponse, {2, 10});
+    EXPECT_EQ(instance->getResultCache()->getEntriesCount(), 1);
+}
 #pragma GCC diagnostic pop
@@ -0,0 +1,344 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../cloudfilecache.hpp"
+#include "../crc32c.hpp"
+#include "../downloadscheduler.hpp"
+#include "../inmemoryfiles.hpp"
+#include "../rangeddownloader.hpp"
+#include "test_utils.hpp"
+
+using ovms::CloudFileCache;
+using ovms::DownloadScheduler;
+using ovms::RangedDownloader;
+using ovms::RangedDownloadFile;
+using ovms::range_writer_t;
+using ovms::StatusCode;
+
+namespace {
+// In-memory stand-in for object storage serving ranged reads
+class FakeObjectStorage {
+    std::map<std::string, std::string> objects;
+
+public:
+    std::atomic<int> requests{0};
+    std::atomic<int> activeRequests{0};
+    std::atomic<int> maxActiveRequests{0};
+    size_t chunkSize = 3;
+
+    void put(const std::string& path, const std::string& content) {
+        objects[path] = content;
+    }
+
+    StatusCode readRange(const std::string& path, uint64_t offset, uint64_t size, const range_writer_t& writer) {
+        requests++;
+        int active = ++activeRequests;
+        for (int max = maxActiveRequests; active > max && !maxActiveRequests.compare_exchange_weak(max, active);) {
+        }
+        auto status = readObjectRange(path, offset, size, writer);
+        activeRequests--;
+        return status;
+    }
+
+    StatusCode readObjectRange(const std::string& path, uint64_t offset, uint64_t size, const range_writer_t& writer) {
+        auto it = objects.find(path);
+        if (it == objects.end()) {
+            return StatusCode::S3_FAILED_GET_OBJECT;
+        }
+        std::string range = offset < it->second.size() ? it->second.substr(offset, size) : "";
+        for (size_t i = 0; i < range.size(); i += chunkSize) {
+            auto chunk = range.substr(i, chunkSize);
+            if (!writer(chunk.data(), chunk.size())) {
+                return StatusCode::S3_FAILED_GET_OBJECT;
+            }
+        }
+        return StatusCode::OK;
+    }
+
+    ovms::range_reader_t reader() {
+        return [this](const std::string& path, uint64_t offset, uint64_t size, const range_writer_t& writer) {
+            return readRange(path, offset, size, writer);
+        };
+    }
+};
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+uint32_t computeCrc32c(const std::string& content) {
+    ovms::Crc32c checksum;
+    checksum.update(content.data(), content.size());
+    return checksum.get();
+}
+
+std::string createContent(size_t size) {
+    std::string content(size, '\0');
+    for (size_t i = 0; i < size; i++) {
+        content[i] = static_cast<char>('a' + i % 26);
+    }
+    return content;
+}
+}  // namespace
+
+class RangedDownloaderTest : public TestWithTempDir {
+protected:
+    FakeObjectStorage storage;
+};
+
+TEST_F(RangedDownloaderTest, DownloadsFilesInParts) {
+    const std::string model = createContent(1000);
+    const std::string weights = createContent(4097);
+    storage.put("s3://bucket/1/model.xml", model);
+    storage.put("s3://bucket/1/model.bin", weights);
+    std::vector<RangedDownloadFile> files{
+        {"s3://bucket/1/model.xml", directoryPath + "/model.xml", model.size()},
+        {"s3://bucket/1/model.bin", directoryPath + "/model.bin", weights.size()}};
+
+    RangedDownloader downloader(100, 4);
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(readFile(directoryPath + "/model.xml"), model);
+    EXPECT_EQ(readFile(directoryPath + "/model.bin"), weights);
+    EXPECT_EQ(storage.requests, 10 + 41);
+}
+
+TEST_F(RangedDownloaderTest, SingleThreadDownloadsWholeFile) {
+    const std::string content = createContent(257);
+    storage.put("s3://bucket/model.onnx", content);
+    std::vector<RangedDownloadFile> files{{"s3://bucket/model.onnx", directoryPath + "/model.onnx", content.size()}};
+
+    RangedDownloader downloader(1024, 1);
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(readFile(directoryPath + "/model.onnx"), content);
+    EXPECT_EQ(storage.requests, 1);
+}
+
+TEST_F(RangedDownloaderTest, CreatesEmptyFileWithoutRequests) {
+    storage.put("s3://bucket/empty", "");
+    std::vector<RangedDownloadFile> files{{"s3://bucket/empty", directoryPath + "/empty", 0}};
+
+    RangedDownloader downloader(16, 4);
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_TRUE(std::filesystem::exists(directoryPath + "/empty"));
+    EXPECT_EQ(readFile(directoryPath + "/empty"), "");
+    EXPECT_EQ(storage.requests, 0);
+}
+
+TEST_F(RangedDownloaderTest, ReaderErrorIsReturned) {
+    storage.put("s3://bucket/model.xml", createContent(100));
+    std::vector<RangedDownloadFile> files{
+        {"s3://bucket/model.xml", directoryPath + "/model.xml", 100},
+        {"s3://bucket/missing.bin", directoryPath + "/model.bin", 100}};
+
+    RangedDownloader downloader(10, 4);
+    EXPECT_EQ(downloader.download(files, storage.reader()), StatusCode::S3_FAILED_GET_OBJECT);
+}
+
+TEST_F(RangedDownloaderTest, IncompleteRangeFails) {
+    storage.put("s3://bucket/model.bin", createContent(50));
+    // Remote file is shorter than the size reported by metadata
+    std::vector<RangedDownloadFile> files{{"s3://bucket/model.bin", directoryPath + "/model.bin", 100}};
+
+    RangedDownloader downloader(30, 2);
+    EXPECT_EQ(downloader.download(files, storage.reader()), StatusCode::FILESYSTEM_ERROR);
+}
+
+TEST_F(RangedDownloaderTest, OversizedRangeFails) {
+    std::vector<RangedDownloadFile> files{{"s3://bucket/model.bin", directoryPath + "/model.bin", 10}};
+    RangedDownloader downloader(10, 1);
+    auto reader = [](const std::string&, uint64_t, uint64_t size, const range_writer_t& writer) {
+        std::string data(size + 1, 'x');
+        return writer(data.data(), data.size()) ? StatusCode::OK : StatusCode::S3_FAILED_GET_OBJECT;
+    };
+    EXPECT_EQ(downloader.download(files, reader), StatusCode::FILESYSTEM_ERROR);
+}
+
+TEST_F(RangedDownloaderTest, NotWritableLocalPathFails) {
+    storage.put("s3://bucket/model.bin", createContent(10));
+    std::vector<RangedDownloadFile> files{{"s3://bucket/model.bin", directoryPath + "/not_existing_dir/model.bin", 10}};
+
+    RangedDownloader downloader(10, 1);
+    EXPECT_EQ(downloader.download(files, storage.reader()), StatusCode::FILESYSTEM_ERROR);
+    EXPECT_EQ(storage.requests, 0);
+}
+
+TEST_F(RangedDownloaderTest, UnchangedFilesAreRestoredFromCache) {
+    const std::string content = createContent(300);
+    storage.put("s3://bucket/1/model.bin", content);
+    CloudFileCache cache(directoryPath + "/cache", 0);
+    RangedDownloader downloader(100, 2, &cache);
+    const std::string modelsPath = directoryPath + "/models";
+    std::filesystem::create_directories(modelsPath);
+    std::vector<RangedDownloadFile> files{{"s3://bucket/1/model.bin", modelsPath + "/model.bin", content.size(), "etag1"}};
+
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(storage.requests, 3);
+    EXPECT_EQ(cache.getStores(), 1);
+
+    std::filesystem::remove_all(modelsPath);
+    std::filesystem::create_directories(modelsPath);
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(storage.requests, 3);
+    EXPECT_EQ(cache.getHits(), 1);
+    EXPECT_EQ(readFile(modelsPath + "/model.bin"), content);
+}
+
+TEST_F(RangedDownloaderTest, ChangedFileIsDownloadedWithoutModifyingCachedVersion) {
+    const std::string content = createContent(300);
+    storage.put("s3://bucket/1/model.bin", content);
+    CloudFileCache cache(directoryPath + "/cache", 0);
+    RangedDownloader downloader(100, 2, &cache);
+    std::vector<RangedDownloadFile> files{{"s3://bucket/1/model.bin", directoryPath + "/model.bin", content.size(), "etag1"}};
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+
+    const std::string changedContent(300, 'z');
+    storage.put("s3://bucket/1/model.bin", changedContent);
+    files[0].version = "etag2";
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(readFile(directoryPath + "/model.bin"), changedContent);
+
+    files[0].version = "etag1";
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(readFile(directoryPath + "/model.bin"), content);
+}
+
+TEST_F(RangedDownloaderTest, FilesWithoutVersionAreNotCached) {
+    storage.put("s3://bucket/model.bin", createContent(10));
+    CloudFileCache cache(directoryPath + "/cache", 0);
+    RangedDownloader downloader(100, 1, &cache);
+    std::vector<RangedDownloadFile> files{{"s3://bucket/model.bin", directoryPath + "/model.bin", 10}};
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(storage.requests, 2);
+    EXPECT_EQ(cache.getStores(), 0);
+}
+
+TEST_F(RangedDownloaderTest, DownloadsFilesToMemory) {
+    const std::string content = createContent(250);
+    storage.put("s3://bucket/1/model.bin", content);
+    const std::string localPath = directoryPath + "/model.bin";
+    std::vector<RangedDownloadFile> files{{"s3://bucket/1/model.bin", localPath, content.size()}};
+
+    RangedDownloader downloader(100, 2, nullptr, true);
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_TRUE(std::filesystem::is_symlink(localPath));
+    EXPECT_EQ(readFile(localPath), content);
+    EXPECT_EQ(ovms::InMemoryFiles::instance().release(directoryPath), 1);
+}
+
+TEST_F(RangedDownloaderTest, FilesDownloadedToMemoryAreCachedOnDisk) {
+    const std::string content = createContent(250);
+    storage.put("s3://bucket/1/model.bin", content);
+    CloudFileCache cache(directoryPath + "/cache", 0);
+    std::vector<RangedDownloadFile> files{{"s3://bucket/1/model.bin", directoryPath + "/model.bin", content.size(), "etag"}};
+
+    RangedDownloader downloader(100, 2, &cache, true);
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    ovms::InMemoryFiles::instance().release(directoryPath);
+    std::filesystem::remove(directoryPath + "/model.bin");
+
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(cache.getHits(), 1);
+    EXPECT_EQ(readFile(directoryPath + "/model.bin"), content);
+}
+
+TEST_F(RangedDownloaderTest, SchedulerLimitsConcurrentRequests) {
+    const std::string content = createContent(2000);
+    storage.put("s3://bucket/model.bin", content);
+    std::vector<RangedDownloadFile> files{{"s3://bucket/model.bin", directoryPath + "/model.bin", content.size()}};
+
+    DownloadScheduler scheduler(1, 0);
+    RangedDownloader downloader(100, 8, nullptr, false, &scheduler);
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(readFile(directoryPath + "/model.bin"), content);
+    EXPECT_EQ(storage.requests, 20);
+    EXPECT_EQ(storage.maxActiveRequests, 1);
+    EXPECT_EQ(scheduler.getActiveConnections(), 0);
+}
+
+TEST_F(RangedDownloaderTest, ChecksumOfFileDownloadedInPartsIsVerified) {
+    const std::string content = createContent(1050);
+    storage.put("s3://bucket/model.bin", content);
+    std::vector<RangedDownloadFile> files{{"s3://bucket/model.bin", directoryPath + "/model.bin", content.size(), "", computeCrc32c(content)}};
+
+    RangedDownloader downloader(100, 4);
+    EXPECT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+
+    files[0].crc32c = computeCrc32c(content) ^ 1;
+    EXPECT_EQ(downloader.download(files, storage.reader()), StatusCode::FILE_CHECKSUM_MISMATCH);
+}
+
+TEST_F(RangedDownloaderTest, FileWithWrongChecksumIsNotCached) {
+    const std::string content = createContent(300);
+    storage.put("s3://bucket/model.bin", content);
+    CloudFileCache cache(directoryPath + "/cache", 0);
+    std::vector<RangedDownloadFile> files{{"s3://bucket/model.bin", directoryPath + "/model.bin", content.size(), "etag", computeCrc32c("other")}};
+
+    RangedDownloader downloader(100, 2, &cache);
+    EXPECT_EQ(downloader.download(files, storage.reader()), StatusCode::FILE_CHECKSUM_MISMATCH);
+    EXPECT_EQ(cache.getStores(), 0);
+}
+
+TEST_F(RangedDownloaderTest, ChecksumsFromManifestAreVerified) {
+    const std::string weights = createContent(500);
+    const std::string model = createContent(120);
+    storage.put("s3://bucket/1/model.bin", weights);
+    storage.put("s3://bucket/1/model.xml", model);
+    const std::string manifest = "{\"crc32c\": {\"model.bin\": \"" + ovms::Crc32c(computeCrc32c(weights)).toHexString() + "\"}}";
+    storage.put("s3://bucket/1/checksums.json", manifest);
+    std::filesystem::create_directories(directoryPath + "/1");
+    std::vector<RangedDownloadFile> files{
+        {"s3://bucket/1/model.bin", directoryPath + "/1/model.bin", weights.size()},
+        {"s3://bucket/1/checksums.json", directoryPath + "/1/checksums.json", manifest.size()},
+        {"s3://bucket/1/model.xml", directoryPath + "/1/model.xml", model.size()}};
+
+    RangedDownloader downloader(100, 2);
+    ASSERT_EQ(downloader.download(files, storage.reader()), StatusCode::OK);
+    EXPECT_EQ(readFile(directoryPath + "/1/model.bin"), weights);
+    EXPECT_EQ(readFile(directoryPath + "/1/model.xml"), model);
+
+    storage.put("s3://bucket/1/model.bin", std::string(500, 'z'));
+    EXPECT_EQ(downloader.download(files, storage.reader()), StatusCode::FILE_CHECKSUM_MISMATCH);
+}
+
+TEST_F(RangedDownloaderTest, InvalidManifestFails) {
+    const std::string manifest = "{\"crc32c\": {\"model.bin\": \"xyz\"}}";
+    storage.put("s3://bucket/checksums.json", manifest);
+    storage.put("s3://bucket/model.bin", createContent(10));
+    std::vector<RangedDownloadFile> files{
+        {"s3://bucket/checksums.json", directoryPath + "/checksums.json", manifest.size()},
+        {"s3://bucket/model.bin", directoryPath + "/model.bin", 10}};
+
+    RangedDownloader downloader(100, 1);
+    EXPECT_EQ(downloader.download(files, storage.reader()), StatusCode::JSON_INVALID);
+    EXPECT_EQ(storage.requests, 1);
+}
+
+TEST(RangedDownloader, ZeroSettingsAreClampedToOne) {
+    RangedDownloader downloader(0, 0);
+    EXPECT_EQ(downloader.getPartSize(), 1);
+    EXPECT_EQ(downloader.getThreads(), 1);
+}
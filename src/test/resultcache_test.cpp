@@ -0,0 +1,178 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../resultcache.hpp"
+
+using namespace ovms;
+
+namespace {
+InferenceEngine::Blob::Ptr createBlob(const std::vector<float>& data) {
+    InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, {1, data.size()}, InferenceEngine::Layout::NC};
+    auto blob = InferenceEngine::make_shared_blob<float>(desc);
+    blob->allocate();
+    std::copy(data.begin(), data.end(), (float*)blob->buffer());
+    return blob;
+}
+
+void computeAndCommit(ResultCache& cache, const std::string& key, size_t floatsCount) {
+    cached_outputs_t outputs;
+    std::unique_ptr<ResultCacheMissGuard> guard;
+    ASSERT_FALSE(cache.lookup(key, outputs, guard));
+    ASSERT_NE(guard, nullptr);
+    guard->commit({{"out", createBlob(std::vector<float>(floatsCount, 1.0))}});
+}
+}  // namespace
+
+TEST(ResultCache, MissThenHit) {
+    auto cache = std::make_shared<ResultCache>(1024);
+    computeAndCommit(*cache, "key", 10);
+    EXPECT_EQ(cache->getEntriesCount(), 1);
+
+    cached_outputs_t outputs;
+    std::unique_ptr<ResultCacheMissGuard> guard;
+    ASSERT_TRUE(cache->lookup("key", outputs, guard));
+    EXPECT_EQ(guard, nullptr);
+    ASSERT_EQ(outputs.count("out"), 1);
+    EXPECT_EQ(outputs.at("out")->byteSize(), 10 * sizeof(float));
+}
+
+TEST(ResultCache, LeastRecentlyUsedEvictedWhenOverBudget) {
+    const size_t entrySize = 3 + 3 + 10 * sizeof(float);
+    auto cache = std::make_shared<ResultCache>(2 * entrySize);
+    computeAndCommit(*cache, "k_1", 10);
+    computeAndCommit(*cache, "k_2", 10);
+    EXPECT_EQ(cache->getUsedBytes(), 2 * entrySize);
+
+    // Touch first entry so the second one becomes least recently used
+    cached_outputs_t outputs;
+    std::unique_ptr<ResultCacheMissGuard> guard;
+    ASSERT_TRUE(cache->lookup("k_1", outputs, guard));
+
+    computeAndCommit(*cache, "k_3", 10);
+    EXPECT_EQ(cache->getEntriesCount(), 2);
+    EXPECT_EQ(cache->getUsedBytes(), 2 * entrySize);
+    EXPECT_TRUE(cache->lookup("k_1", outputs, guard));
+    EXPECT_TRUE(cache->lookup("k_3", outputs, guard));
+    EXPECT_FALSE(cache->lookup("k_2", outputs, guard));
+}
+
+TEST(ResultCache, EntryLargerThanCapacityIsNotCached) {
+    auto cache = std::make_shared<ResultCache>(16);
+    computeAndCommit(*cache, "key", 10);
+    EXPECT_EQ(cache->getEntriesCount(), 0);
+    EXPECT_EQ(cache->getUsedBytes(), 0);
+}
+
+TEST(ResultCache, AbandonedKeyCanBeComputedAgain) {
+    auto cache = std::make_shared<ResultCache>(1024);
+    cached_outputs_t outputs;
+    {
+        std::unique_ptr<ResultCacheMissGuard> guard;
+        ASSERT_FALSE(cache->lookup("key", outputs, guard));
+        ASSERT_NE(guard, nullptr);
+        std::unique_ptr<ResultCacheMissGuard> otherGuard;
+        EXPECT_FALSE(cache->lookup("key", outputs, otherGuard, false));
+        EXPECT_EQ(otherGuard, nullptr) << "Only one caller should be responsible for computing results";
+    }
+    std::unique_ptr<ResultCacheMissGuard> guard;
+    EXPECT_FALSE(cache->lookup("key", outputs, guard));
+    EXPECT_NE(guard, nullptr);
+}
+
+TEST(ResultCache, ConcurrentLookupWaitsForPendingResults) {
+    auto cache = std::make_shared<ResultCache>(1024);
+    cached_outputs_t outputs;
+    std::unique_ptr<ResultCacheMissGuard> guard;
+    ASSERT_FALSE(cache->lookup("key", outputs, guard));
+
+    auto waiting = std::async(std::launch::async, [&cache]() {
+        cached_outputs_t outputs;
+        std::unique_ptr<ResultCacheMissGuard> guard;
+        return cache->lookup("key", outputs, guard);
+    });
+    EXPECT_EQ(waiting.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+    guard->commit({{"out", createBlob({1.0})}});
+    EXPECT_TRUE(waiting.get());
+}
+
+TEST(ResultCache, ClearDropsEntries) {
+    auto cache = std::make_shared<ResultCache>(1024);
+    computeAndCommit(*cache, "key", 10);
+    cache->clear();
+    EXPECT_EQ(cache->getEntriesCount(), 0);
+    EXPECT_EQ(cache->getUsedBytes(), 0);
+}
+
+TEST(ResultCache, BlobKeyDependsOnContentShapeAndVersion) {
+    cached_outputs_t inputs{{"in", createBlob({1.0, 2.0})}};
+    cached_outputs_t sameInputs{{"in", createBlob({1.0, 2.0})}};
+    cached_outputs_t otherContent{{"in", createBlob({1.0, 3.0})}};
+    cached_outputs_t otherShape{{"in", createBlob({1.0, 2.0, 0.0})}};
+    EXPECT_EQ(ResultCache::createKey(inputs, 1), ResultCache::createKey(sameInputs, 1));
+    EXPECT_NE(ResultCache::createKey(inputs, 1), ResultCache::createKey(inputs, 2));
+    EXPECT_NE(ResultCache::createKey(inputs, 1), ResultCache::createKey(otherContent, 1));
+    EXPECT_NE(ResultCache::createKey(inputs, 1), ResultCache::createKey(otherShape, 1));
+}
+
+TEST(ResultCache, RequestKeyDoesNotDependOnInputsOrder) {
+    tensorflow::serving::PredictRequest first, second;
+    (*first.mutable_inputs())["a"].set_tensor_content("1");
+    (*first.mutable_inputs())["b"].set_tensor_content("2");
+    (*second.mutable_inputs())["b"].set_tensor_content("2");
+    (*second.mutable_inputs())["a"].set_tensor_content("1");
+    EXPECT_EQ(ResultCache::createKey(first, 1), ResultCache::createKey(second, 1));
+    (*second.mutable_inputs())["a"].set_tensor_content("3");
+    EXPECT_NE(ResultCache::createKey(first, 1), ResultCache::createKey(second, 1));
+}
+
+TEST(ResultCache, KeyContainsWholeInputsContent) {
+    std::vector<float> data(100000, 1.0);
+    cached_outputs_t inputs{{"in", createBlob(data)}};
+    data.back() = 2.0;
+    cached_outputs_t otherLastValue{{"in", createBlob(data)}};
+    const auto key = ResultCache::createKey(inputs, 1);
+    EXPECT_GE(key.size(), data.size() * sizeof(float));
+    EXPECT_NE(key, ResultCache::createKey(otherLastValue, 1));
+
+    auto cache = std::make_shared<ResultCache>(key.size() + 1024);
+    computeAndCommit(*cache, key, 10);
+    cached_outputs_t outputs;
+    std::unique_ptr<ResultCacheMissGuard> guard;
+    EXPECT_FALSE(cache->lookup(ResultCache::createKey(otherLastValue, 1), outputs, guard));
+    EXPECT_TRUE(cache->lookup(key, outputs, guard));
+}
+
+TEST(ResultCache, MissGuardKeepsCacheAlive) {
+    auto cache = std::make_shared<ResultCache>(1024);
+    cached_outputs_t outputs;
+    std::unique_ptr<ResultCacheMissGuard> guard;
+    ASSERT_FALSE(cache->lookup("key", outputs, guard));
+    std::weak_ptr<ResultCache> released = cache;
+    cache.reset();
+    EXPECT_FALSE(released.expired());
+    guard->commit({{"out", createBlob({1.0})}});
+    guard.reset();
+    EXPECT_TRUE(released.expired());
+}
@@ -13,6 +13,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <cstdio>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -606,6 +608,36 @@ TEST(SchemaTest, PipelineConfigNodesInputsInvalid) {
     EXPECT_EQ(result, ovms::StatusCode::JSON_INVALID);
 }
 
+TEST(SchemaTest, ModelConfigWarmupIterationsOutOfRange) {
+    const char* modelConfigWarmupIterationsTemplate = R"(
+    {
+        "model_config_list": [
+            {
+                "config": {
+                    "name": "dummy",
+                    "base_path": "/ovms/src/test/dummy",
+                    "warmup_iterations": %d
+                }
+            }
+        ]
+    })";
+
+    for (int iterations : {0, 1000}) {
+        char config[512];
+        std::snprintf(config, sizeof(config), modelConfigWarmupIterationsTemplate, iterations);
+        rapidjson::Document configParsed;
+        configParsed.Parse(config);
+        EXPECT_EQ(ovms::validateJsonAgainstSchema(configParsed, ovms::MODELS_CONFIG_SCHEMA), ovms::StatusCode::OK) << iterations;
+    }
+    for (int iterations : {-1, 1001}) {
+        char config[512];
+        std::snprintf(config, sizeof(config), modelConfigWarmupIterationsTemplate, iterations);
+        rapidjson::Document configParsed;
+        configParsed.Parse(config);
+        EXPECT_EQ(ovms::validateJsonAgainstSchema(configParsed, ovms::MODELS_CONFIG_SCHEMA), ovms::StatusCode::JSON_INVALID) << iterations;
+    }
+}
+
 TEST(SchemaTest, parseModelMappingWhenJsonMatchSchema) {
     const char* mappingConfigMatchSchema = R"({
        "inputs":{
@@ -210,6 +210,36 @@ TEST_P(SerializeTFGRPCPredictResponse, ShouldSuccessForSupportedPrecision) {
     EXPECT_TRUE(status.ok());
 }
 
+TEST_F(SerializeTFGRPCPredictResponse, ShouldSkipOutputsNotInOutputFilter) {
+    auto inputs = getInputs(Precision::FP32);
+    InferenceEngine::InferRequest inferRequest = std::get<0>(inputs);
+    // Using overloaded cast operator from InferRequest
+    InferenceEngine::IInferRequest::Ptr& mInferRequestPtr(inferRequest);
+    MockIInferRequestProperGetBlob* mInferRequest = static_cast<MockIInferRequestProperGetBlob*>(mInferRequestPtr.get());
+    EXPECT_CALL(*mInferRequest, GetBlob_mocked(_, _, _)).Times(0);
+    PredictRequest request;
+    request.add_output_filter("Second");
+    PredictResponse response;
+    auto status = serializePredictResponse(inferRequest, std::get<1>(inputs), &response, request.output_filter());
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(response.outputs_size(), 0);
+}
+
+TEST_F(SerializeTFGRPCPredictResponse, ShouldSerializeOutputsInOutputFilter) {
+    auto inputs = getInputs(Precision::FP32);
+    InferenceEngine::InferRequest inferRequest = std::get<0>(inputs);
+    // Using overloaded cast operator from InferRequest
+    InferenceEngine::IInferRequest::Ptr& mInferRequestPtr(inferRequest);
+    MockIInferRequestProperGetBlob* mInferRequest = static_cast<MockIInferRequestProperGetBlob*>(mInferRequestPtr.get());
+    EXPECT_CALL(*mInferRequest, GetBlob_mocked(_, _, _));
+    PredictRequest request;
+    request.add_output_filter("First");
+    PredictResponse response;
+    auto status = serializePredictResponse(inferRequest, std::get<1>(inputs), &response, request.output_filter());
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(response.outputs().count("First"), 1);
+}
+
 class SerializeTFGRPCPredictResponseNegative : public SerializeTFGRPCPredictResponse {};
 
 TEST_P(SerializeTFGRPCPredictResponseNegative, ShouldFailForUnsupportedPrecision) {
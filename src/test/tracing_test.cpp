@@ -0,0 +1,203 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../metrics.hpp"
+#include "../tracing.hpp"
+
+using ovms::MetricsRegistry;
+using ovms::RequestTrace;
+using ovms::ScopedSpan;
+using ovms::SpanExporter;
+using ovms::SpanRecord;
+using ovms::SpanRingBuffer;
+using ovms::SpanTimer;
+using ovms::TraceParent;
+using ovms::TraceSpan;
+
+TEST(SpanRingBuffer, DrainsRecordsInOrder) {
+    SpanRingBuffer buffer;
+    buffer.push({1, 10, TraceSpan::DESERIALIZE});
+    buffer.push({2, 20, TraceSpan::INFERENCE});
+
+    std::vector<SpanRecord> drained;
+    EXPECT_EQ(buffer.drain([&drained](const SpanRecord& record) { drained.push_back(record); }), 2);
+    ASSERT_EQ(drained.size(), 2);
+    EXPECT_EQ(drained[0].span, TraceSpan::DESERIALIZE);
+    EXPECT_EQ(drained[0].durationNs, 10);
+    EXPECT_EQ(drained[1].span, TraceSpan::INFERENCE);
+    EXPECT_EQ(drained[1].startNs, 2);
+    EXPECT_EQ(buffer.drain([](const SpanRecord&) {}), 0);
+}
+
+TEST(SpanRingBuffer, DropsRecordsWhenFull) {
+    SpanRingBuffer buffer;
+    for (size_t i = 0; i < SpanRingBuffer::CAPACITY + 3; i++) {
+        buffer.push({i, 1, TraceSpan::INFERENCE});
+    }
+    EXPECT_EQ(buffer.takeDropped(), 3);
+    EXPECT_EQ(buffer.takeDropped(), 0);
+
+    uint64_t lastStart = 0;
+    EXPECT_EQ(buffer.drain([&lastStart](const SpanRecord& record) { lastStart = record.startNs; }), SpanRingBuffer::CAPACITY);
+    EXPECT_EQ(lastStart, SpanRingBuffer::CAPACITY - 1);
+
+    buffer.push({0, 1, TraceSpan::INFERENCE});
+    EXPECT_EQ(buffer.takeDropped(), 0);
+}
+
+TEST(SpanTimer, MeasuresSpans) {
+    SpanTimer timer;
+    timer.start(TraceSpan::INFERENCE);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    timer.stop(TraceSpan::INFERENCE);
+    EXPECT_GE(timer.elapsedMicroseconds(TraceSpan::INFERENCE), 2000);
+    EXPECT_EQ(timer.elapsedMicroseconds(TraceSpan::SERIALIZE), 0);
+}
+
+TEST(SpanExporter, AggregatesSpansIntoHistograms) {
+    MetricsRegistry registry;
+    SpanExporter exporter(registry);
+    auto firstBuffer = std::make_shared<SpanRingBuffer>();
+    auto secondBuffer = std::make_shared<SpanRingBuffer>();
+    exporter.registerBuffer(firstBuffer);
+    exporter.registerBuffer(secondBuffer);
+
+    firstBuffer->push({0, 75'000, TraceSpan::DESERIALIZE});
+    secondBuffer->push({0, 3'000'000, TraceSpan::DESERIALIZE});
+    secondBuffer->push({0, 1'000, TraceSpan::SERIALIZE});
+    EXPECT_EQ(exporter.exportSpans(), 3);
+    EXPECT_EQ(exporter.exportSpans(), 0);
+
+    auto deserialization = registry.getLatencyHistogram("ovms_span_duration_seconds", "", {{"span", "deserialize"}});
+    EXPECT_EQ(deserialization->getCount(), 2);
+    EXPECT_EQ(deserialization->getSum(), 3075);
+    EXPECT_EQ(registry.getLatencyHistogram("ovms_span_duration_seconds", "", {{"span", "serialize"}})->getCount(), 1);
+    EXPECT_EQ(registry.getLatencyHistogram("ovms_span_duration_seconds", "", {{"span", "inference"}})->getCount(), 0);
+}
+
+TEST(SpanExporter, ExportsBuffersOfFinishedThreadsForTheLastTime) {
+    MetricsRegistry registry;
+    SpanExporter exporter(registry);
+    auto buffer = std::make_shared<SpanRingBuffer>();
+    exporter.registerBuffer(buffer);
+    buffer->push({0, 1'000, TraceSpan::INFERENCE});
+    for (size_t i = 0; i < SpanRingBuffer::CAPACITY; i++) {
+        buffer->push({0, 1'000, TraceSpan::INFERENCE});
+    }
+    std::weak_ptr<SpanRingBuffer> released = buffer;
+    buffer.reset();
+
+    EXPECT_EQ(exporter.exportSpans(), SpanRingBuffer::CAPACITY);
+    EXPECT_TRUE(released.expired());
+    EXPECT_EQ(registry.getCounter("ovms_spans_dropped_total", "", {})->get(), 1);
+}
+
+TEST(TraceParent, ParsesValidHeader) {
+    auto traceParent = TraceParent::parse("00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01");
+    ASSERT_TRUE(traceParent.has_value());
+    EXPECT_EQ(traceParent->traceId, "0af7651916cd43dd8448eb211c80319c");
+    EXPECT_EQ(traceParent->parentSpanId, "b7ad6b7169203331");
+    EXPECT_TRUE(traceParent->sampled);
+
+    traceParent = TraceParent::parse("00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-00");
+    ASSERT_TRUE(traceParent.has_value());
+    EXPECT_FALSE(traceParent->sampled);
+
+    // Future versions may append fields
+    EXPECT_TRUE(TraceParent::parse("01-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01-extra").has_value());
+}
+
+TEST(TraceParent, RejectsInvalidHeader) {
+    EXPECT_FALSE(TraceParent::parse("").has_value());
+    EXPECT_FALSE(TraceParent::parse("00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331").has_value());
+    EXPECT_FALSE(TraceParent::parse("00-0AF7651916CD43DD8448EB211C80319C-b7ad6b7169203331-01").has_value());
+    EXPECT_FALSE(TraceParent::parse("00-00000000000000000000000000000000-b7ad6b7169203331-01").has_value());
+    EXPECT_FALSE(TraceParent::parse("00-0af7651916cd43dd8448eb211c80319c-0000000000000000-01").has_value());
+    EXPECT_FALSE(TraceParent::parse("ff-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01").has_value());
+    EXPECT_FALSE(TraceParent::parse("00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01-extra").has_value());
+    EXPECT_FALSE(TraceParent::parse("00_0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01").has_value());
+}
+
+TEST(RequestTrace, CollectsSpansOfCurrentRequest) {
+    if (!ovms::TRACING_ENABLED) {
+        GTEST_SKIP();
+    }
+    RequestTrace trace("grpc predict dummy", "0af7651916cd43dd8448eb211c80319c", "00f067aa0ba902b7", "b7ad6b7169203331");
+    ovms::currentRequestTrace = &trace;
+    {
+        ScopedSpan span(TraceSpan::NODE_EXECUTE, "node \"1\"");
+    }
+    ovms::currentRequestTrace = nullptr;
+    {
+        ScopedSpan span(TraceSpan::NODE_EXECUTE, "other request");
+    }
+    trace.finish();
+
+    ASSERT_EQ(trace.getSpans().size(), 1);
+    EXPECT_EQ(trace.getSpans()[0].span, TraceSpan::NODE_EXECUTE);
+    EXPECT_EQ(trace.getSpans()[0].detail, "node \"1\"");
+    EXPECT_EQ(trace.getSpans()[0].threadId, ovms::getTraceThreadId());
+
+    std::stringstream output;
+    trace.writeChromeTraceEvents(output, 7);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(output, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_EQ(lines[0].rfind("{\"name\":\"grpc predict dummy\",\"cat\":\"ovms\",\"ph\":\"X\",\"ts\":", 0), 0);
+    EXPECT_NE(lines[0].find("\"pid\":7,"), std::string::npos);
+    EXPECT_NE(lines[0].find("\"args\":{\"trace_id\":\"0af7651916cd43dd8448eb211c80319c\",\"span_id\":\"00f067aa0ba902b7\",\"parent_span_id\":\"b7ad6b7169203331\"}},"), std::string::npos);
+    EXPECT_EQ(lines[1].rfind("{\"name\":\"node_execute\",", 0), 0);
+    EXPECT_NE(lines[1].find("\"args\":{\"trace_id\":\"0af7651916cd43dd8448eb211c80319c\",\"node\":\"node \\\"1\\\"\"}},"), std::string::npos);
+}
+
+TEST(SpanExporter, WritesSubmittedRequestTraces) {
+    MetricsRegistry registry;
+    SpanExporter exporter(registry);
+    auto output = std::make_unique<std::stringstream>();
+    auto& outputRef = *output;
+    exporter.enableRequestTracing(std::move(output), 0);
+    EXPECT_TRUE(exporter.isRequestTracingEnabled());
+    EXPECT_FALSE(exporter.sampleRequest());
+
+    auto trace = std::make_unique<RequestTrace>("rest predict", "0af7651916cd43dd8448eb211c80319c", "00f067aa0ba902b7", "");
+    trace->addSpan(TraceSpan::DESERIALIZE, 1'000'000, 2'500);
+    trace->finish();
+    exporter.submitRequestTrace(std::move(trace));
+    exporter.exportSpans();
+
+    const std::string written = outputRef.str();
+    EXPECT_EQ(written.rfind("[\n{\"name\":\"rest predict\"", 0), 0);
+    EXPECT_NE(written.find("{\"name\":\"deserialize\",\"cat\":\"ovms\",\"ph\":\"X\",\"ts\":1000.0,\"dur\":2.5,"), std::string::npos);
+}
+
+TEST(SpanExporter, SamplesAllRequestsWithFullRate) {
+    MetricsRegistry registry;
+    SpanExporter exporter(registry);
+    exporter.enableRequestTracing(std::make_unique<std::stringstream>(), 1);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_TRUE(exporter.sampleRequest());
+    }
+}
@@ -0,0 +1,290 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "tracing.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <initializer_list>
+#include <random>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ovms {
+
+const std::chrono::milliseconds SpanExporter::EXPORT_INTERVAL{200};
+
+SpanRingBuffer& getThreadSpanBuffer() {
+    thread_local std::shared_ptr<SpanRingBuffer> buffer = []() {
+        auto created = std::make_shared<SpanRingBuffer>();
+        SpanExporter::instance().registerBuffer(created);
+        return created;
+    }();
+    return *buffer;
+}
+
+uint32_t getTraceThreadId() {
+    thread_local const uint32_t threadId = syscall(SYS_gettid);
+    return threadId;
+}
+
+namespace {
+bool isLowercaseHex(std::string_view value) {
+    return std::all_of(value.begin(), value.end(), [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); });
+}
+
+bool isAllZeros(std::string_view value) {
+    return std::all_of(value.begin(), value.end(), [](char c) { return c == '0'; });
+}
+
+std::string generateTraceIdentifier(size_t bytes) {
+    thread_local std::mt19937_64 generator{std::random_device{}()};
+    std::string identifier;
+    while (identifier.size() < bytes * 2) {
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(generator()));
+        identifier += hex;
+    }
+    identifier.resize(bytes * 2);
+    return identifier;
+}
+
+void writeJsonString(std::ostream& output, std::string_view value) {
+    output << '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            output << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[7];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            output << escaped;
+        } else {
+            output << c;
+        }
+    }
+    output << '"';
+}
+
+void writeChromeTraceEvent(std::ostream& output, std::string_view name, uint64_t startNs, uint64_t durationNs, int processId, uint32_t threadId,
+    std::initializer_list<std::pair<std::string_view, std::string_view>> arguments) {
+    output << "{\"name\":";
+    writeJsonString(output, name);
+    output << ",\"cat\":\"ovms\",\"ph\":\"X\",\"ts\":" << startNs / 1000 << "." << (startNs % 1000) / 100
+           << ",\"dur\":" << durationNs / 1000 << "." << (durationNs % 1000) / 100
+           << ",\"pid\":" << processId << ",\"tid\":" << threadId << ",\"args\":{";
+    bool first = true;
+    for (const auto& [argumentName, argumentValue] : arguments) {
+        if (argumentValue.empty()) {
+            continue;
+        }
+        if (!first) {
+            output << ",";
+        }
+        first = false;
+        writeJsonString(output, argumentName);
+        output << ":";
+        writeJsonString(output, argumentValue);
+    }
+    output << "}},\n";
+}
+}  // namespace
+
+std::optional<TraceParent> TraceParent::parse(std::string_view header) {
+    // version-traceid-parentid-flags, future versions may append more fields
+    if (header.size() < 55 || header[2] != '-' || header[35] != '-' || header[52] != '-' ||
+        (header.size() > 55 && (header.substr(0, 2) == "00" || header[55] != '-'))) {
+        return std::nullopt;
+    }
+    const auto version = header.substr(0, 2);
+    const auto traceId = header.substr(3, 32);
+    const auto parentSpanId = header.substr(36, 16);
+    const auto flags = header.substr(53, 2);
+    if (!isLowercaseHex(version) || version == "ff" || !isLowercaseHex(traceId) || isAllZeros(traceId) ||
+        !isLowercaseHex(parentSpanId) || isAllZeros(parentSpanId) || !isLowercaseHex(flags)) {
+        return std::nullopt;
+    }
+    TraceParent traceParent;
+    traceParent.traceId = traceId;
+    traceParent.parentSpanId = parentSpanId;
+    traceParent.sampled = std::stoi(std::string(flags), nullptr, 16) & 0x01;
+    return traceParent;
+}
+
+RequestTrace::RequestTrace(const std::string& name, const std::string& traceId, const std::string& spanId, const std::string& parentSpanId) :
+    name(name),
+    traceId(traceId),
+    spanId(spanId),
+    parentSpanId(parentSpanId),
+    threadId(getTraceThreadId()),
+    startNs(getTraceTimestampNs()) {}
+
+void RequestTrace::writeChromeTraceEvents(std::ostream& output, int processId) const {
+    writeChromeTraceEvent(output, name, startNs, durationNs, processId, threadId,
+        {{"trace_id", traceId}, {"span_id", spanId}, {"parent_span_id", parentSpanId}});
+    for (const auto& span : spans) {
+        writeChromeTraceEvent(output, getTraceSpanName(span.span), span.startNs, span.durationNs, processId, span.threadId,
+            {{"trace_id", traceId}, {"node", span.detail}});
+    }
+}
+
+RequestTraceScope::RequestTraceScope(std::initializer_list<std::string_view> nameParts, std::string_view traceParentHeader) {
+    if (!TRACING_ENABLED) {
+        return;
+    }
+    auto& exporter = SpanExporter::instance();
+    if (!exporter.isRequestTracingEnabled()) {
+        return;
+    }
+    auto traceParent = TraceParent::parse(traceParentHeader);
+    if (!(traceParent && traceParent->sampled) && !exporter.sampleRequest()) {
+        return;
+    }
+    std::string name;
+    for (const auto& part : nameParts) {
+        name.append(part);
+    }
+    trace = std::make_unique<RequestTrace>(name,
+        traceParent ? traceParent->traceId : generateTraceIdentifier(16),
+        generateTraceIdentifier(8),
+        traceParent ? traceParent->parentSpanId : "");
+    previous = currentRequestTrace;
+    currentRequestTrace = trace.get();
+}
+
+RequestTraceScope::~RequestTraceScope() {
+    if (trace == nullptr) {
+        return;
+    }
+    currentRequestTrace = previous;
+    trace->finish();
+    SpanExporter::instance().submitRequestTrace(std::move(trace));
+}
+
+SpanExporter::SpanExporter(MetricsRegistry& registry) {
+    for (size_t i = 0; i < TRACE_SPANS_COUNT; i++) {
+        histograms[i] = registry.getLatencyHistogram("ovms_span_duration_seconds", "Time of processing stages of requests", {{"span", TRACE_SPAN_NAMES[i]}});
+    }
+    droppedSpans = registry.getCounter("ovms_spans_dropped_total", "Number of spans dropped due to full trace buffers", {});
+    droppedTraces = registry.getCounter("ovms_request_traces_dropped_total", "Number of sampled request traces dropped due to too many traces waiting for export", {});
+}
+
+SpanExporter::~SpanExporter() {
+    join();
+}
+
+SpanExporter& SpanExporter::instance() {
+    static SpanExporter exporter(MetricsRegistry::instance());
+    return exporter;
+}
+
+void SpanExporter::registerBuffer(std::shared_ptr<SpanRingBuffer> buffer) {
+    std::unique_lock lock(buffersMtx);
+    buffers.emplace_back(std::move(buffer));
+}
+
+void SpanExporter::setSamplingRate(double rate) {
+    std::unique_lock lock(exportMtx);
+    samplingRate = std::clamp(rate, 0.0, 1.0);
+}
+
+void SpanExporter::enableRequestTracing(std::unique_ptr<std::ostream> output, double rate) {
+    std::unique_lock lock(exportMtx);
+    requestTraceOutput = std::move(output);
+    *requestTraceOutput << "[\n";
+    requestSamplingRate.store(std::clamp(rate, 0.0, 1.0), std::memory_order_relaxed);
+    requestTracingEnabled.store(true, std::memory_order_relaxed);
+}
+
+bool SpanExporter::sampleRequest() const {
+    const double rate = requestSamplingRate.load(std::memory_order_relaxed);
+    if (rate <= 0) {
+        return false;
+    }
+    thread_local std::mt19937 generator{std::random_device{}()};
+    return std::uniform_real_distribution<double>(0, 1)(generator) < rate;
+}
+
+void SpanExporter::submitRequestTrace(std::unique_ptr<RequestTrace> trace) {
+    std::unique_lock lock(pendingTracesMtx);
+    if (pendingTraces.size() >= MAX_PENDING_REQUEST_TRACES) {
+        droppedTraces->increment();
+        return;
+    }
+    pendingTraces.emplace_back(std::move(trace));
+}
+
+size_t SpanExporter::exportSpans() {
+    std::vector<std::shared_ptr<SpanRingBuffer>> currentBuffers;
+    {
+        std::unique_lock lock(buffersMtx);
+        currentBuffers = buffers;
+        // Buffers referenced only by the exporter belong to finished threads, they are drained for the last time now
+        buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                          [](const std::shared_ptr<SpanRingBuffer>& buffer) { return buffer.use_count() == 2; }),
+            buffers.end());
+    }
+    std::unique_lock lock(exportMtx);
+    size_t exported = 0;
+    for (const auto& buffer : currentBuffers) {
+        exported += buffer->drain([this](const SpanRecord& record) {
+            histograms[static_cast<size_t>(record.span)]->observe(record.durationNs / 1000);
+            samplingCredit += samplingRate;
+            if (samplingCredit >= 1) {
+                samplingCredit -= 1;
+                SPDLOG_DEBUG("Span: {}; start: {} ns; duration: {:.3f} ms", getTraceSpanName(record.span), record.startNs, record.durationNs / 1'000'000.0);
+            }
+        });
+        droppedSpans->increment(buffer->takeDropped());
+    }
+
+    std::vector<std::unique_ptr<RequestTrace>> traces;
+    {
+        std::unique_lock tracesLock(pendingTracesMtx);
+        traces.swap(pendingTraces);
+    }
+    if (requestTraceOutput != nullptr && !traces.empty()) {
+        const int processId = getpid();
+        for (const auto& trace : traces) {
+            trace->writeChromeTraceEvents(*requestTraceOutput, processId);
+        }
+        requestTraceOutput->flush();
+    }
+    return exported;
+}
+
+void SpanExporter::start() {
+    if (!TRACING_ENABLED || thread.joinable()) {
+        return;
+    }
+    exit = std::promise<void>();
+    thread = std::thread([this, exitSignal = exit.get_future()]() {
+        while (exitSignal.wait_for(EXPORT_INTERVAL) == std::future_status::timeout) {
+            exportSpans();
+        }
+        exportSpans();
+    });
+}
+
+void SpanExporter::join() {
+    if (thread.joinable()) {
+        exit.set_value();
+        thread.join();
+    }
+}
+
+}  // namespace ovms
@@ -0,0 +1,406 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <time.h>
+
+#include "metrics.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Tracing is compiled in unless OVMS_DISABLE_TRACING is defined, e.g. with bazel build --config=notracing
+ */
+#ifdef OVMS_DISABLE_TRACING
+constexpr bool TRACING_ENABLED = false;
+#else
+constexpr bool TRACING_ENABLED = true;
+#endif
+
+/**
+ * @brief Identifiers of traced spans, names of spans are defined in TRACE_SPAN_NAMES
+ */
+enum class TraceSpan : uint8_t {
+    GRPC_REQUEST,
+    REST_REQUEST,
+    REST_PARSE,
+    REST_CONVERT,
+    REST_MAKE_JSON,
+    CACHE_LOOKUP,
+    INFER_REQUEST_WAIT,
+    DESERIALIZE,
+    INFERENCE,
+    SERIALIZE,
+    MODEL_LOOKUP,
+    PIPELINE_CREATE,
+    PIPELINE_WAIT,
+    NODE_EXECUTE,
+    NODE_FETCH_RESULTS,
+    NODE_STREAM_WAIT,
+    BLOB_CLONE,
+    COUNT
+};
+
+const size_t TRACE_SPANS_COUNT = static_cast<size_t>(TraceSpan::COUNT);
+
+constexpr std::array<const char*, TRACE_SPANS_COUNT> TRACE_SPAN_NAMES = {
+    "grpc_request",
+    "rest_request",
+    "rest_parse",
+    "rest_convert",
+    "rest_make_json",
+    "cache_lookup",
+    "infer_request_wait",
+    "deserialize",
+    "inference",
+    "serialize",
+    "model_lookup",
+    "pipeline_create",
+    "pipeline_wait",
+    "node_execute",
+    "node_fetch_results",
+    "node_stream_wait",
+    "blob_clone"};
+
+constexpr const char* getTraceSpanName(TraceSpan span) {
+    return TRACE_SPAN_NAMES[static_cast<size_t>(span)];
+}
+
+/**
+ * @brief Gets monotonic timestamp in nanoseconds, not affected by NTP adjustments
+ */
+inline uint64_t getTraceTimestampNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+struct SpanRecord {
+    uint64_t startNs;
+    uint64_t durationNs;
+    TraceSpan span;
+};
+
+/**
+ * @brief Ring buffer of spans recorded by a single thread and drained by a single exporter.
+ * Spans are dropped when the buffer is full so recording never blocks nor allocates.
+ */
+class SpanRingBuffer {
+public:
+    static constexpr size_t CAPACITY = 4096;
+
+private:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity has to be a power of 2");
+
+    std::array<SpanRecord, CAPACITY> records;
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+
+public:
+    void push(const SpanRecord& record) {
+        const uint64_t position = head.load(std::memory_order_relaxed);
+        if (position - tail.load(std::memory_order_acquire) >= CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        records[position & (CAPACITY - 1)] = record;
+        head.store(position + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Passes all recorded spans to consumer and frees their space in the buffer
+     *
+     * @return number of drained spans
+     */
+    template <typename Consumer>
+    size_t drain(Consumer&& consumer) {
+        const uint64_t begin = tail.load(std::memory_order_relaxed);
+        const uint64_t end = head.load(std::memory_order_acquire);
+        for (uint64_t position = begin; position < end; position++) {
+            consumer(records[position & (CAPACITY - 1)]);
+        }
+        tail.store(end, std::memory_order_release);
+        return end - begin;
+    }
+
+    uint64_t takeDropped() {
+        return dropped.exchange(0, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Gets span buffer of the calling thread, registered in the exporter on first use
+ */
+SpanRingBuffer& getThreadSpanBuffer();
+
+/**
+ * @brief Gets identifier of the calling thread as seen by the operating system
+ */
+uint32_t getTraceThreadId();
+
+/**
+ * @brief W3C trace context received in traceparent header, e.g. 00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01
+ */
+struct TraceParent {
+    std::string traceId;
+    std::string parentSpanId;
+    bool sampled = false;
+
+    static std::optional<TraceParent> parse(std::string_view header);
+};
+
+/**
+ * @brief Spans of a single sampled request, exported as a whole to request trace file once the request is finished.
+ * Spans are added by the thread processing the request, stages executed by other threads are not included.
+ */
+class RequestTrace {
+public:
+    struct Span {
+        TraceSpan span;
+        uint64_t startNs;
+        uint64_t durationNs;
+        uint32_t threadId;
+        std::string detail;
+    };
+
+private:
+    const std::string name;
+    const std::string traceId;
+    const std::string spanId;
+    const std::string parentSpanId;
+    const uint32_t threadId;
+    const uint64_t startNs;
+    uint64_t durationNs = 0;
+    std::vector<Span> spans;
+
+public:
+    RequestTrace(const std::string& name, const std::string& traceId, const std::string& spanId, const std::string& parentSpanId);
+
+    void addSpan(TraceSpan span, uint64_t startNs, uint64_t durationNs, std::string_view detail = {}) {
+        spans.push_back({span, startNs, durationNs, getTraceThreadId(), std::string(detail)});
+    }
+
+    void finish() {
+        durationNs = getTraceTimestampNs() - startNs;
+    }
+
+    const std::string& getTraceId() const {
+        return traceId;
+    }
+
+    const std::vector<Span>& getSpans() const {
+        return spans;
+    }
+
+    /**
+     * @brief Writes request and its spans as complete events of Chrome trace event format, each followed by comma and new line
+     */
+    void writeChromeTraceEvents(std::ostream& output, int processId) const;
+};
+
+/**
+ * @brief Request trace of the request processed by the calling thread, nullptr when request is not sampled
+ */
+inline thread_local RequestTrace* currentRequestTrace = nullptr;
+
+/**
+ * @brief Records finished span in buffer of the calling thread and in the current request trace
+ */
+inline void recordSpan(TraceSpan span, uint64_t startNs, uint64_t durationNs, std::string_view detail = {}) {
+#ifndef OVMS_DISABLE_TRACING
+    getThreadSpanBuffer().push({startNs, durationNs, span});
+    if (currentRequestTrace != nullptr) {
+        currentRequestTrace->addSpan(span, startNs, durationNs, detail);
+    }
+#endif
+}
+
+/**
+ * @brief Measures spans of a single request, replaces string keyed timers on the request path.
+ * Timestamps are kept in fixed arrays indexed by span identifier and finished spans are pushed to buffer of the calling thread.
+ * With tracing disabled durations are still measured for model metrics, only recording of spans compiles to nothing.
+ */
+class SpanTimer {
+    std::array<uint64_t, TRACE_SPANS_COUNT> startTimestamps{};
+    std::array<uint64_t, TRACE_SPANS_COUNT> durations{};
+
+public:
+    void start(TraceSpan span) {
+        startTimestamps[static_cast<size_t>(span)] = getTraceTimestampNs();
+    }
+
+    /**
+     * @brief Finishes span, has to be called by the thread which started it
+     */
+    void stop(TraceSpan span) {
+        const size_t index = static_cast<size_t>(span);
+        durations[index] = getTraceTimestampNs() - startTimestamps[index];
+        recordSpan(span, startTimestamps[index], durations[index]);
+    }
+
+    /**
+     * @brief Gets duration of finished span in microseconds
+     */
+    double elapsedMicroseconds(TraceSpan span) const {
+        return durations[static_cast<size_t>(span)] / 1000.0;
+    }
+};
+
+/**
+ * @brief Measures span lasting until the end of scope
+ */
+class ScopedSpan {
+#ifndef OVMS_DISABLE_TRACING
+    const TraceSpan span;
+    const std::string_view detail;
+    const uint64_t startNs;
+#endif
+
+public:
+    /**
+     * @param span
+     * @param detail e.g. node name, has to outlive the span
+     */
+    explicit ScopedSpan(TraceSpan span, std::string_view detail = {})
+#ifndef OVMS_DISABLE_TRACING
+        :
+        span(span),
+        detail(detail),
+        startNs(getTraceTimestampNs())
+#endif
+    {
+    }
+
+    ~ScopedSpan() {
+#ifndef OVMS_DISABLE_TRACING
+        recordSpan(span, startNs, getTraceTimestampNs() - startNs, detail);
+#endif
+    }
+};
+
+/**
+ * @brief Starts request trace when request is sampled and makes it current for the calling thread until the end of scope.
+ * Finished trace is passed to the exporter.
+ */
+class RequestTraceScope {
+    std::unique_ptr<RequestTrace> trace;
+    RequestTrace* previous = nullptr;
+
+public:
+    /**
+     * @param nameParts e.g. protocol and model name, concatenated only when request is traced
+     * @param traceParent value of traceparent header, empty if not received
+     */
+    RequestTraceScope(std::initializer_list<std::string_view> nameParts, std::string_view traceParent);
+    ~RequestTraceScope();
+
+    RequestTrace* getTrace() const {
+        return trace.get();
+    }
+};
+
+/**
+ * @brief Periodically drains span buffers of all threads, aggregates span durations into histograms of metrics registry
+ * and writes sampled spans to debug log. Sampled request traces are appended to request trace file in Chrome trace event format.
+ */
+class SpanExporter {
+    std::mutex buffersMtx;
+    std::vector<std::shared_ptr<SpanRingBuffer>> buffers;
+
+    std::array<std::shared_ptr<MetricHistogram>, TRACE_SPANS_COUNT> histograms;
+    std::shared_ptr<MetricCounter> droppedSpans;
+
+    std::mutex exportMtx;
+    double samplingRate = 0;
+    double samplingCredit = 0;
+
+    std::atomic<bool> requestTracingEnabled{false};
+    std::atomic<double> requestSamplingRate{0};
+    std::unique_ptr<std::ostream> requestTraceOutput;
+    std::mutex pendingTracesMtx;
+    std::vector<std::unique_ptr<RequestTrace>> pendingTraces;
+    std::shared_ptr<MetricCounter> droppedTraces;
+
+    std::thread thread;
+    std::promise<void> exit;
+
+public:
+    static const std::chrono::milliseconds EXPORT_INTERVAL;
+    static const size_t MAX_PENDING_REQUEST_TRACES = 10000;
+
+    explicit SpanExporter(MetricsRegistry& registry);
+    ~SpanExporter();
+
+    static SpanExporter& instance();
+
+    void registerBuffer(std::shared_ptr<SpanRingBuffer> buffer);
+
+    /**
+     * @brief Sets ratio of spans written to debug log, from 0 to 1
+     */
+    void setSamplingRate(double rate);
+
+    /**
+     * @brief Enables request tracing
+     *
+     * @param output stream receiving request traces in Chrome trace event format
+     * @param rate ratio of sampled requests, from 0 to 1. Requests with sampled flag in traceparent header are always sampled.
+     */
+    void enableRequestTracing(std::unique_ptr<std::ostream> output, double rate);
+
+    bool isRequestTracingEnabled() const {
+        return requestTracingEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Decides whether request without sampled flag in traceparent header is traced
+     */
+    bool sampleRequest() const;
+
+    void submitRequestTrace(std::unique_ptr<RequestTrace> trace);
+
+    /**
+     * @brief Drains all registered buffers once and writes finished request traces. Buffers of finished threads are released afterwards.
+     *
+     * @return number of exported spans
+     */
+    size_t exportSpans();
+
+    /**
+     * @brief Starts background thread exporting spans every EXPORT_INTERVAL, does nothing with tracing disabled
+     */
+    void start();
+
+    void join();
+};
+
+}  // namespace ovms